@@ -0,0 +1,167 @@
+#include "../linmath/vec.hpp"
+#include "../linmath/bounds.hpp"
+#include "../linmath/ray.hpp"
+#include "../linmath/bvh.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using highres_clock = std::chrono::high_resolution_clock;
+
+// ---------------- escape ----------------
+template<typename T>
+inline void escape(const T& v) {
+#ifdef _MSC_VER
+    volatile const T* p = &v;
+    (void)p;
+#else
+    asm volatile("" : : "g"(v) : "memory");
+#endif
+}
+
+#if !defined(LMATH_FREESTANDING)
+
+// ---------------- bench ----------------
+// best of `reps` runs, so page faults and thread start-up drop out
+template<typename Fn>
+double run_best(Fn&& fn, int reps) {
+    double best = 1e30;
+    for (int r = 0; r < reps; ++r) {
+        auto t0 = highres_clock::now();
+        fn();
+        auto t1 = highres_clock::now();
+        const double ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        if (ms < best) best = ms;
+    }
+    return best;
+}
+
+// ---------------- mesh ----------------
+// rolling terrain, gx * gy quads split into two triangles each
+static std::vector<lm::vec3> make_mesh(std::size_t gx, std::size_t gy) {
+    auto height = [](float x, float y) {
+        return 4.f * std::sin(x * 0.05f) * std::cos(y * 0.07f) + std::sin(x * 0.31f + y * 0.23f);
+    };
+    std::vector<lm::vec3> tris;
+    tris.reserve(gx * gy * 6);
+    for (std::size_t j = 0; j < gy; ++j)
+        for (std::size_t i = 0; i < gx; ++i) {
+            const float x0 = float(i), x1 = float(i + 1), y0 = float(j), y1 = float(j + 1);
+            const lm::vec3 a{ x0, y0, height(x0, y0) }, b{ x1, y0, height(x1, y0) };
+            const lm::vec3 c{ x1, y1, height(x1, y1) }, d{ x0, y1, height(x0, y1) };
+            tris.push_back(a); tris.push_back(b); tris.push_back(c);
+            tris.push_back(a); tris.push_back(c); tris.push_back(d);
+        }
+    return tris;
+}
+
+// ---------------- main ----------------
+int main() {
+    constexpr std::size_t gx = 1000, gy = 500;          // 1M triangles
+    constexpr std::size_t n = 2 * gx * gy;
+    constexpr std::size_t ray_count = 1'000'000;
+    constexpr std::size_t query_count = 100'000;
+    constexpr int reps = 3;
+
+    const std::vector<lm::vec3> tris = make_mesh(gx, gy);
+    std::vector<lm::aabb3> boxes(n);
+    lm::bvh_triangle_bounds(tris.data(), n, boxes.data());
+
+    std::uint32_t seed = 1u;
+    auto rnd = [&seed](float lo, float hi) {
+        seed = seed * 1664525u + 1013904223u;
+        return lo + (hi - lo) * float(seed >> 8) * (1.f / 16777216.f);
+    };
+    // rays from above at grazing-to-steep angles, boxes a few cells wide
+    std::vector<lm::ray3> rays(ray_count);
+    for (lm::ray3& r : rays) {
+        r.o = { rnd(0.f, float(gx)), rnd(0.f, float(gy)), 20.f };
+        r.d = { rnd(-1.f, 1.f), rnd(-1.f, 1.f), rnd(-1.f, -0.1f) };
+    }
+    std::vector<lm::aabb3> queries(query_count);
+    for (lm::aabb3& Q : queries) {
+        const lm::vec3 c{ rnd(0.f, float(gx)), rnd(0.f, float(gy)), rnd(-5.f, 5.f) };
+        const lm::vec3 e{ rnd(0.5f, 4.f), rnd(0.5f, 4.f), rnd(0.5f, 4.f) };
+        Q = { lm::vec_sub(c, e), lm::vec_add(c, e) };
+    }
+
+    std::size_t max_threads = std::thread::hardware_concurrency();
+    if (max_threads == 0) max_threads = 1;
+
+    std::printf("Current SIMD for `lm::` is: %s, %zu hardware threads, %zu triangles\n",
+                lm::simd::level_string(lm::simd::max_level()), max_threads, n);
+
+    // ---- build ----
+    std::vector<lm::bvh_node> nodes(lm::bvh_node_capacity(n));
+    std::vector<std::uint32_t> prims(n);
+    std::size_t count = 0;
+    const double serial_ms = run_best([&] {
+        count = lm::bvh_build(boxes.data(), n, nodes.data(), prims.data());
+        escape(nodes[0]);
+    }, reps);
+    std::printf("%-22s %10.2f ms  (%zu nodes, %zu bytes)\n", "build, 1 thread", serial_ms,
+                count, count * sizeof(lm::bvh_node));
+    {
+        lm::thread_pool threads(max_threads);
+        const double ms = run_best([&] {
+            count = lm::bvh_build(boxes.data(), n, nodes.data(), prims.data(), threads.pool());
+            escape(nodes[0]);
+        }, reps);
+        std::printf("build, %-3zu threads     %10.2f ms  (%4.1fx)\n", max_threads, ms, serial_ms / ms);
+    }
+    const lm::bvh tree{ nodes.data(), prims.data(), count };
+
+    std::vector<lm::bvh_wide_node<4>> w4(count / 2 + 1);
+    std::vector<lm::bvh_wide_node<8>> w8(count / 2 + 1);
+    lm::bvh4 tree4{ w4.data(), prims.data(), 0 };
+    lm::bvh8 tree8{ w8.data(), prims.data(), 0 };
+    const double c4 = run_best([&] { tree4.node_count = lm::bvh_collapse<4>(tree, w4.data()); }, reps);
+    const double c8 = run_best([&] { tree8.node_count = lm::bvh_collapse<8>(tree, w8.data()); }, reps);
+    std::printf("%-22s %10.2f ms  (%zu nodes)\n", "collapse to bvh4", c4, tree4.node_count);
+    std::printf("%-22s %10.2f ms  (%zu nodes)\n", "collapse to bvh8", c8, tree8.node_count);
+
+    // ---- queries, one thread ----
+    auto ray_bench = [&](const char* name, const auto& T) {
+        std::size_t hits = 0;
+        const double ms = run_best([&] {
+            hits = 0;
+            for (const lm::ray3& R : rays) {
+                float t = 1e30f;
+                hits += lm::bvh_intersect(T, tris.data(), R, t) != lm::bvh_none;
+                escape(t);
+            }
+        }, reps);
+        std::printf("%-22s %10.2f ms  %7.2f Mrays/s  (%zu hits)\n", name, ms,
+                    double(ray_count) / ms * 1e-3, hits);
+    };
+    auto box_bench = [&](const char* name, const auto& T) {
+        std::vector<std::uint32_t> out(256);
+        std::size_t found = 0;
+        const double ms = run_best([&] {
+            found = 0;
+            for (const lm::aabb3& Q : queries)
+                found += lm::bvh_overlap(T, boxes.data(), Q, out.data(), out.size());
+            escape(out[0]);
+        }, reps);
+        std::printf("%-22s %10.2f ms  %7.2f Mqueries/s  (%zu found)\n", name, ms,
+                    double(query_count) / ms * 1e-3, found);
+    };
+
+    ray_bench("rays, binary", tree);
+    ray_bench("rays, bvh4", tree4);
+    ray_bench("rays, bvh8", tree8);
+    box_bench("boxes, binary", tree);
+    box_bench("boxes, bvh4", tree4);
+    box_bench("boxes, bvh8", tree8);
+}
+
+#else
+
+int main() {
+    std::printf("lm::par is compiled out (LMATH_FREESTANDING)\n");
+}
+
+#endif
@@ -4,11 +4,13 @@
 #include "../linmath/vec.hpp"
 #include "../linmath/mat.hpp"
 #include "../linmath/quat.hpp"
+#include "../linmath/affine.hpp"
 extern "C" {
 #   include "../3rd-party/linmath.h" // original copy
 }
 #include "../3rd-party/glm-1.0.3/glm/glm.hpp" // 3rd-party 'glm'
 #include "../3rd-party/glm-1.0.3/glm/gtc/matrix_transform.hpp"
+#include "../3rd-party/glm-1.0.3/glm/gtc/type_ptr.hpp"
 
 template<typename T>
 inline void escape(const T& v) {
@@ -39,6 +41,7 @@ static glm::vec4 glm_dummy_vec4;
 
 #include <chrono>
 #include <cstdio>
+#include <cstring>
 
 using highres_clock = std::chrono::high_resolution_clock;
 
@@ -342,6 +345,94 @@ bench_result bench_mat4_rotate_x_c(std::size_t iters) {
     }, iters);
 }
 
+// rigid transforms, cycled so the call can't be hoisted out of the loop
+constexpr std::size_t inv_n = 64;
+static lm::mat4  lm_inv_in[inv_n];
+static glm::mat4 glm_inv_in[inv_n];
+static ::mat4x4  c_inv_in[inv_n];
+
+static void fill_inverse_in() {
+    for (std::size_t i = 0; i < inv_n; ++i) {
+        lm_inv_in[i] = lm::mat4_mul(lm::mat4_translate(1.f, 2.f, float(i)), lm::mat4_rotate_y(0.1f * float(i)));
+        glm_inv_in[i] = glm::make_mat4(lm_inv_in[i][0].data());
+        std::memcpy(c_inv_in[i], &lm_inv_in[i], sizeof(lm::mat4));
+    }
+}
+
+bench_result bench_mat4_inverse_lm(std::size_t iters) {
+    fill_inverse_in();
+    std::size_t k = 0;
+    lm::mat4 R{};
+    return run_bench("lm::mat4 inverse", [&] {
+        R = lm::mat4_inverse(lm_inv_in[k]);
+        lm_dummy_mat4 = R;
+        escape(lm_dummy_mat4);
+
+        k = (k + 1) % inv_n;
+    }, iters);
+}
+
+bench_result bench_mat4_inverse_glm(std::size_t iters) {
+    fill_inverse_in();
+    std::size_t k = 0;
+    glm::mat4 R{};
+    return run_bench("glm::mat4 inverse", [&] {
+        R = glm::inverse(glm_inv_in[k]);
+        glm_dummy_mat4 = R;
+        escape(glm_dummy_mat4);
+
+        k = (k + 1) % inv_n;
+    }, iters);
+}
+
+bench_result bench_mat4_inverse_c(std::size_t iters) {
+    fill_inverse_in();
+    std::size_t k = 0;
+    ::mat4x4 R{};
+    return run_bench("linmath mat4 invert", [&] {
+        ::mat4x4_invert(R, c_inv_in[k]);
+        ::mat4x4_dup(c_dummy_mat4, R);
+        escape(c_dummy_mat4);
+
+        k = (k + 1) % inv_n;
+    }, iters);
+}
+
+// world[k] = world[k-1] * local[k] around a ring of inv_n slots
+static lm::affine3x4 lm_aff_in[inv_n];
+static lm::affine3x4 lm_aff_world[inv_n];
+static lm::mat4      lm_mat4_world[inv_n];
+
+bench_result bench_affine_mul_chain_lm(std::size_t iters) {
+    fill_inverse_in();
+    for (std::size_t i = 0; i < inv_n; ++i) {
+        lm_aff_in[i] = lm::affine_from_mat4(lm_inv_in[i]);
+        lm_aff_world[i] = lm::affine_identity();
+    }
+    std::size_t k = 0;
+    return run_bench("lm::affine3x4 mul chain", [&] {
+        const std::size_t next = (k + 1) % inv_n;
+        lm_aff_world[next] = lm::affine_mul(lm_aff_world[k], lm_aff_in[next]);
+        escape(lm_aff_world[next]);
+
+        k = next;
+    }, iters);
+}
+
+bench_result bench_mat4_mul_chain_lm(std::size_t iters) {
+    fill_inverse_in();
+    for (std::size_t i = 0; i < inv_n; ++i)
+        lm_mat4_world[i] = lm::mat4_identity();
+    std::size_t k = 0;
+    return run_bench("lm::mat4 mul chain", [&] {
+        const std::size_t next = (k + 1) % inv_n;
+        lm_mat4_world[next] = lm::mat4_mul(lm_mat4_world[k], lm_inv_in[next]);
+        escape(lm_mat4_world[next]);
+
+        k = next;
+    }, iters);
+}
+
 bench_result bench_mat4_look_at_lm(std::size_t iters) {
     lm::vec3 eye{ 1.5f, -2.0f, 4.0f };
     lm::vec3 center{ 0.5f, 1.0f, -3.0f };
@@ -416,6 +507,12 @@ int main() {
         bench_mat4_vec4_glm(iters),
         bench_mat4_vec4_c(iters),
 
+        bench_mat4_inverse_lm(iters),
+        bench_mat4_inverse_glm(iters),
+        bench_mat4_inverse_c(iters),
+        bench_affine_mul_chain_lm(iters),
+        bench_mat4_mul_chain_lm(iters),
+
         bench_mat4_look_at_lm(iters),
         bench_mat4_look_at_glm(iters),
         bench_mat4_look_at_c(iters),
@@ -0,0 +1,88 @@
+#include "../linmath/vec.hpp"
+#include "../linmath/mat.hpp"
+#include "../linmath/soa.hpp"
+#include "../linmath/par_kernels.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using highres_clock = std::chrono::high_resolution_clock;
+
+// ---------------- escape ----------------
+template<typename T>
+inline void escape(const T& v) {
+#ifdef _MSC_VER
+    volatile const T* p = &v;
+    (void)p;
+#else
+    asm volatile("" : : "g"(v) : "memory");
+#endif
+}
+
+#if !defined(LMATH_FREESTANDING)
+
+// ---------------- bench ----------------
+// best of `reps` runs, so page faults and thread start-up drop out
+template<typename Fn>
+double run_best(Fn&& fn, int reps) {
+    double best = 1e30;
+    for (int r = 0; r < reps; ++r) {
+        auto t0 = highres_clock::now();
+        fn();
+        auto t1 = highres_clock::now();
+        const double ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        if (ms < best) best = ms;
+    }
+    return best;
+}
+
+// ---------------- main ----------------
+int main() {
+    constexpr std::size_t n = 10'000'000;
+    constexpr int reps = 5;
+
+    std::vector<lm::vec3> in3(n), out3(n);
+    std::vector<lm::vec4> in4(n), out4(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const float t = float(i % 1000);
+        in3[i] = { t, 1.f - t, 0.5f * t };
+        in4[i] = { t, 1.f - t, 0.5f * t, 1.f };
+    }
+    const lm::mat4 M = lm::mat4_mul(lm::mat4_translate(1.f, 2.f, 3.f), lm::mat4_rotate_y(0.5f));
+
+    std::size_t max_threads = std::thread::hardware_concurrency();
+    if (max_threads == 0) max_threads = 1;
+
+    std::printf("Current SIMD for `lm::` is: %s, %zu hardware threads, n = %zu\n",
+                lm::simd::level_string(lm::simd::max_level()), max_threads, n);
+    std::printf("%-8s %14s %14s %14s\n", "threads", "points ms", "norm ms", "m4*v4 ms");
+
+    double base[3] = {};
+    for (std::size_t t = 1; t <= max_threads; t = t < max_threads && t * 2 > max_threads ? max_threads : t * 2) {
+        lm::thread_pool threads(t);
+        const lm::worker_pool pool = threads.pool();
+
+        const double ms[3] = {
+            run_best([&] { lm::mat4_transform_points(M, in3.data(), out3.data(), n, pool); escape(out3[n - 1]); }, reps),
+            run_best([&] { lm::vec3_norm_batch(in3.data(), out3.data(), n, pool); escape(out3[n - 1]); }, reps),
+            run_best([&] { lm::mat4_mul_vec_batch(M, in4.data(), out4.data(), n, pool); escape(out4[n - 1]); }, reps),
+        };
+        if (t == 1)
+            for (int k = 0; k < 3; ++k) base[k] = ms[k];
+
+        std::printf("%-8zu %8.2f (%4.1fx) %8.2f (%4.1fx) %8.2f (%4.1fx)\n", t,
+                    ms[0], base[0] / ms[0], ms[1], base[1] / ms[1], ms[2], base[2] / ms[2]);
+        if (t == max_threads)
+            break;
+    }
+}
+
+#else
+
+int main() {
+    std::printf("lm::par is compiled out (LMATH_FREESTANDING)\n");
+}
+
+#endif
@@ -1,14 +1,29 @@
 #define GLM_FORCE_SIMD
+#define GLM_FORCE_INLINE
+#define GLM_ENABLE_EXPERIMENTAL
 
 #include "../linmath/vec.hpp"
 #include "../linmath/mat.hpp"
 #include "../linmath/quat.hpp"
+#include "../linmath/dualquat.hpp"
+#include "../linmath/trs.hpp"
+#include "../linmath/soa.hpp"
+#include "../linmath/affine.hpp"
+#include "../linmath/hierarchy.hpp"
+#include "../linmath/frustum.hpp"
+#include "../linmath/bounds.hpp"
+#include "../linmath/ray.hpp"
 
 #include "../3rd-party/glm-1.0.3/glm/glm.hpp"
 #include "../3rd-party/glm-1.0.3/glm/gtc/matrix_transform.hpp"
+#include "../3rd-party/glm-1.0.3/glm/gtc/quaternion.hpp"
+#include "../3rd-party/glm-1.0.3/glm/gtc/type_ptr.hpp"
+#include "../3rd-party/glm-1.0.3/glm/gtx/dual_quaternion.hpp"
+#include "../3rd-party/glm-1.0.3/glm/gtx/matrix_decompose.hpp"
 
 #include <chrono>
 #include <cstdio>
+#include <cstring>
 
 using highres_clock = std::chrono::high_resolution_clock;
 
@@ -101,6 +116,34 @@ bench_result bench_vec3_dot_glm(std::size_t iters) {
     }, iters);
 }
 
+// ---------------- sin (8 values per call) ----------------
+// x sweeps [90, 107): lm::sinf range-reduces with loops, sin8 doesn't care
+
+bench_result bench_sinf_x8_lm(std::size_t iters) {
+    float x = 90.f;
+    lm::vec<float, 8> r{};
+    return run_bench("lm::sinf x8 scalar", [&] {
+        for (std::size_t i = 0; i < 8; ++i)
+            r[i] = lm::sinf(x + float(i));
+        escape(r);
+        x += 0.0001f;
+        if (x > 100.f) x = 90.f;
+    }, iters / 8);
+}
+
+bench_result bench_sin8_lm(std::size_t iters) {
+    float x = 90.f;
+    lm::vec<float, 8> in{}, r{};
+    return run_bench("lm::sin8 SIMD", [&] {
+        for (std::size_t i = 0; i < 8; ++i)
+            in[i] = x + float(i);
+        r = lm::sin8(in);
+        escape(r);
+        x += 0.0001f;
+        if (x > 100.f) x = 90.f;
+    }, iters / 8);
+}
+
 // ---------------- mat4 mul ----------------
 bench_result bench_mat4_mul_lm(std::size_t iters) {
     lm::mat4 A = lm::mat4_rotate_x(0.7f);
@@ -124,6 +167,384 @@ bench_result bench_mat4_mul_glm(std::size_t iters) {
     }, iters);
 }
 
+// ---------------- mat4 inverse ----------------
+// rigid transforms, cycled so the call can't be hoisted out of the loop
+constexpr std::size_t inv_n = 64;
+static lm::mat4  lm_inv_in[inv_n];
+static glm::mat4 glm_inv_in[inv_n];
+
+static void fill_inverse_in() {
+    for (std::size_t i = 0; i < inv_n; ++i) {
+        lm_inv_in[i] = lm::mat4_mul(lm::mat4_translate(1.f, 2.f, float(i)), lm::mat4_rotate_y(0.1f * float(i)));
+        glm_inv_in[i] = glm::make_mat4(lm_inv_in[i][0].data());
+    }
+}
+
+bench_result bench_mat4_inverse_lm(std::size_t iters) {
+    fill_inverse_in();
+    std::size_t k = 0;
+    lm::mat4 R{};
+    return run_bench("lm::mat4 inverse SIMD", [&] {
+        R = lm::mat4_inverse(lm_inv_in[k]);
+        escape(R);
+        lm_dummy_mat4 = R;
+
+        k = (k + 1) % inv_n;
+    }, iters);
+}
+
+bench_result bench_mat4_inverse_affine_lm(std::size_t iters) {
+    fill_inverse_in();
+    std::size_t k = 0;
+    lm::mat4 R{};
+    return run_bench("lm::mat4 inverse affine", [&] {
+        R = lm::mat4_inverse_affine(lm_inv_in[k]);
+        escape(R);
+        lm_dummy_mat4 = R;
+
+        k = (k + 1) % inv_n;
+    }, iters);
+}
+
+bench_result bench_mat4_inverse_rigid_lm(std::size_t iters) {
+    fill_inverse_in();
+    std::size_t k = 0;
+    lm::mat4 R{};
+    return run_bench("lm::mat4 inverse rigid", [&] {
+        R = lm::mat4_inverse_rigid(lm_inv_in[k]);
+        escape(R);
+        lm_dummy_mat4 = R;
+
+        k = (k + 1) % inv_n;
+    }, iters);
+}
+
+bench_result bench_mat4_inverse_glm(std::size_t iters) {
+    fill_inverse_in();
+    std::size_t k = 0;
+    glm::mat4 R{};
+    return run_bench("glm::mat4 inverse SIMD", [&] {
+        R = glm::inverse(glm_inv_in[k]);
+        escape(R);
+        glm_dummy_mat4 = R;
+
+        k = (k + 1) % inv_n;
+    }, iters);
+}
+
+// ---------------- affine3x4 compose ----------------
+// world[k] = world[k-1] * local[k] around a ring of inv_n slots, as when
+// walking down a transform hierarchy; each call depends on the previous one
+static lm::affine3x4 lm_aff_in[inv_n];
+static lm::affine3x4 lm_aff_world[inv_n];
+static lm::mat4      lm_mat4_world[inv_n];
+
+bench_result bench_affine_mul_chain_lm(std::size_t iters) {
+    fill_inverse_in();
+    for (std::size_t i = 0; i < inv_n; ++i) {
+        lm_aff_in[i] = lm::affine_from_mat4(lm_inv_in[i]);
+        lm_aff_world[i] = lm::affine_identity();
+    }
+    std::size_t k = 0;
+    return run_bench("lm::affine3x4 mul chain", [&] {
+        const std::size_t next = (k + 1) % inv_n;
+        lm_aff_world[next] = lm::affine_mul(lm_aff_world[k], lm_aff_in[next]);
+        escape(lm_aff_world[next]);
+
+        k = next;
+    }, iters);
+}
+
+bench_result bench_mat4_mul_chain_lm(std::size_t iters) {
+    fill_inverse_in();
+    for (std::size_t i = 0; i < inv_n; ++i)
+        lm_mat4_world[i] = lm::mat4_identity();
+    std::size_t k = 0;
+    return run_bench("lm::mat4 mul chain", [&] {
+        const std::size_t next = (k + 1) % inv_n;
+        lm_mat4_world[next] = lm::mat4_mul(lm_mat4_world[k], lm_inv_in[next]);
+        escape(lm_mat4_world[next]);
+
+        k = next;
+    }, iters);
+}
+
+// ---------------- mat4 determinant[] ----------------
+static constexpr std::size_t det_n = 1024;
+static lm::mat4 lm_det_in[det_n];
+static float    lm_det_out[det_n];
+
+static void fill_det_in() {
+    for (std::size_t i = 0; i < det_n; ++i)
+        lm_det_in[i] = lm::mat4_mul(lm::mat4_translate(1.f, 2.f, float(i)), lm::mat4_rotate_y(0.01f * float(i)));
+}
+
+bench_result bench_mat4_det_loop_lm(std::size_t iters) {
+    fill_det_in();
+    return run_bench("lm::mat4 det loop", [&] {
+        for (std::size_t i = 0; i < det_n; ++i)
+            lm_det_out[i] = lm::mat_determinant(lm_det_in[i]);
+        escape(lm_det_out[0]);
+    }, iters / det_n);
+}
+
+bench_result bench_mat4_det_batch_lm(std::size_t iters) {
+    fill_det_in();
+    return run_bench("lm::mat4 det batch", [&] {
+        lm::mat_determinant_batch(lm_det_in, lm_det_out, det_n);
+        escape(lm_det_out[0]);
+    }, iters / det_n);
+}
+
+// ---------------- mat4 * mat4[] ----------------
+// world[i] = parent[i] * local[i] over arrays larger than L2, as in a
+// scene-graph level update; the output isn't read back within the pass
+static constexpr std::size_t mul_n = 1 << 16;
+alignas(64) static lm::mat4 lm_mul_parent[mul_n];
+alignas(64) static lm::mat4 lm_mul_local[mul_n];
+alignas(64) static lm::mat4 lm_mul_world[mul_n];
+
+static void fill_mul_in() {
+    for (std::size_t i = 0; i < mul_n; ++i) {
+        lm_mul_parent[i] = lm::mat4_mul(lm::mat4_translate(1.f, 2.f, float(i)), lm::mat4_rotate_y(0.01f * float(i)));
+        lm_mul_local[i] = lm::mat4_mul(lm::mat4_rotate_x(0.02f * float(i)), lm::mat4_translate(-1.f, 0.5f, 2.f));
+    }
+}
+
+bench_result bench_mat4_mul_loop_lm(std::size_t iters) {
+    fill_mul_in();
+    return run_bench("lm::mat4 mul loop", [&] {
+        for (std::size_t i = 0; i < mul_n; ++i)
+            lm_mul_world[i] = lm::mat4_mul(lm_mul_parent[i], lm_mul_local[i]);
+        escape(lm_mul_world[0]);
+    }, iters / mul_n);
+}
+
+bench_result bench_mat4_mul_batch_lm(std::size_t iters) {
+    fill_mul_in();
+    return run_bench("lm::mat4 mul batch", [&] {
+        lm::mat4_mul_batch(lm_mul_parent, lm_mul_local, lm_mul_world, mul_n);
+        escape(lm_mul_world[0]);
+    }, iters / mul_n);
+}
+
+bench_result bench_mat4_mul_batch_stream_lm(std::size_t iters) {
+    fill_mul_in();
+    return run_bench("lm::mat4 mul batch stream", [&] {
+        lm::mat4_mul_batch(lm_mul_parent, lm_mul_local, lm_mul_world, mul_n, lm::store_mode::streaming);
+        escape(lm_mul_world[0]);
+    }, iters / mul_n);
+}
+
+bench_result bench_mat4_mul_batch_left_lm(std::size_t iters) {
+    fill_mul_in();
+    return run_bench("lm::mat4 mul batch left", [&] {
+        lm::mat4_mul_batch_left(lm_mul_parent[0], lm_mul_local, lm_mul_world, mul_n);
+        escape(lm_mul_world[0]);
+    }, iters / mul_n);
+}
+
+// ---------------- transform hierarchy ----------------
+// 100k nodes, random parents (wide, ~6 levels); incremental updates touch
+// 16 subtrees near the leaves
+static constexpr std::size_t tree_n = 100000;
+static std::uint32_t tree_in_parent[tree_n];
+static std::uint32_t tree_order[tree_n];
+static std::uint32_t tree_parent[tree_n];
+static std::uint32_t tree_level[tree_n + 1];
+static std::uint32_t tree_scratch[2 * tree_n + 1];
+static std::uint8_t  tree_dirty[tree_n];
+static lm::mat4      tree_local[tree_n];
+static lm::mat4      tree_world[tree_n];
+
+static lm::hierarchy fill_tree() {
+    std::uint32_t seed = 1u;
+    for (std::size_t i = 0; i < tree_n; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        tree_in_parent[i] = i < 4 ? lm::hierarchy_root : std::uint32_t((seed >> 8) % ((i + 7) / 8));
+    }
+    const std::size_t levels = lm::hierarchy_sort(tree_in_parent, tree_n, tree_order, tree_parent,
+                                                  tree_level, tree_scratch);
+    for (std::size_t k = 0; k < tree_n; ++k)
+        tree_local[k] = lm::mat4_mul(lm::mat4_translate(1.f, 0.f, 0.01f * float(k)), lm::mat4_rotate_y(0.001f * float(k)));
+    return { tree_parent, tree_local, tree_world, nullptr, tree_level, levels };
+}
+
+bench_result bench_hierarchy_serial_lm(std::size_t iters) {
+    const lm::hierarchy H = fill_tree();
+    return run_bench("lm::hierarchy full serial", [&] {
+        lm::hierarchy_update(H, lm::serial_pool());
+        escape(tree_world[tree_n - 1]);
+    }, iters / tree_n);
+}
+
+bench_result bench_hierarchy_pool_lm(std::size_t iters) {
+    const lm::hierarchy H = fill_tree();
+    return run_bench("lm::hierarchy full pool", [&] {
+        lm::hierarchy_update(H);
+        escape(tree_world[tree_n - 1]);
+    }, iters / tree_n);
+}
+
+bench_result bench_hierarchy_dirty_lm(std::size_t iters) {
+    lm::hierarchy H = fill_tree();
+    H.dirty = tree_dirty;
+    std::size_t k = 0;
+    return run_bench("lm::hierarchy 16 dirty", [&] {
+        for (int j = 0; j < 16; ++j)
+            tree_dirty[tree_n / 2 + (k + std::size_t(j) * 2731) % (tree_n / 2)] = 1;
+        lm::hierarchy_update(H);
+        escape(tree_world[tree_n - 1]);
+        ++k;
+    }, iters / tree_n);
+}
+
+// ---------------- frustum culling ----------------
+// 1M bounding spheres scattered around the camera, about a third visible
+static constexpr std::size_t cull_n = 1 << 20;
+static float         cull_x[cull_n], cull_y[cull_n], cull_z[cull_n], cull_r[cull_n];
+static std::uint32_t cull_visible[cull_n / 32];
+
+static lm::frustum fill_cull() {
+    std::uint32_t seed = 3u;
+    auto rnd = [&seed](float lo, float hi) {
+        seed = seed * 1664525u + 1013904223u;
+        return lo + (hi - lo) * float(seed >> 8) * (1.f / 16777216.f);
+    };
+    for (std::size_t i = 0; i < cull_n; ++i) {
+        cull_x[i] = rnd(-200.f, 200.f);
+        cull_y[i] = rnd(-100.f, 100.f);
+        cull_z[i] = rnd(-200.f, 50.f);
+        cull_r[i] = rnd(0.1f, 4.f);
+    }
+    const lm::mat4 V = lm::mat4_look_at({ 0.f, 2.f, 10.f }, { 0.f, 0.f, 0.f }, { 0.f, 1.f, 0.f });
+    return lm::frustum_from_mat4(lm::mat4_mul(lm::mat4_perspective(1.2f, 16.f / 9.f, 0.1f, 250.f), V));
+}
+
+bench_result bench_cull_spheres_loop_lm(std::size_t iters) {
+    const lm::frustum F = fill_cull();
+    return run_bench("lm::cull spheres loop", [&] {
+        for (std::size_t w = 0; w < cull_n / 32; ++w) {
+            std::uint32_t bits = 0;
+            for (std::size_t j = 0; j < 32; ++j) {
+                const std::size_t i = w * 32 + j;
+                bits |= std::uint32_t(lm::frustum_test_sphere(F, { cull_x[i], cull_y[i], cull_z[i] }, cull_r[i])) << j;
+            }
+            cull_visible[w] = bits;
+        }
+        escape(cull_visible[0]);
+    }, iters / cull_n);
+}
+
+bench_result bench_cull_spheres_batch_lm(std::size_t iters) {
+    const lm::frustum F = fill_cull();
+    const lm::vec4_soa S{ { cull_x, cull_y, cull_z, cull_r }, cull_n };
+    return run_bench("lm::cull spheres batch", [&] {
+        lm::frustum_cull_spheres(F, S, cull_visible);
+        escape(cull_visible[0]);
+    }, iters / cull_n);
+}
+
+bench_result bench_cull_aabbs_batch_lm(std::size_t iters) {
+    const lm::frustum F = fill_cull();
+    // boxes reuse the sphere streams: lo = (x, y, z), hi = (x, y, z) + r
+    static float hx[cull_n], hy[cull_n], hz[cull_n];
+    for (std::size_t i = 0; i < cull_n; ++i) {
+        hx[i] = cull_x[i] + cull_r[i];
+        hy[i] = cull_y[i] + cull_r[i];
+        hz[i] = cull_z[i] + cull_r[i];
+    }
+    const lm::vec3_soa lo{ { cull_x, cull_y, cull_z }, cull_n };
+    const lm::vec3_soa hi{ { hx, hy, hz }, cull_n };
+    return run_bench("lm::cull aabbs batch", [&] {
+        lm::frustum_cull_aabbs(F, lo, hi, cull_visible);
+        escape(cull_visible[0]);
+    }, iters / cull_n);
+}
+
+// ---------------- bounds ----------------
+// 64k boxes through one affine transform (Arvo), one at a time vs SoA batch
+static constexpr std::size_t box_n = 1 << 16;
+static float box_lo[3][box_n], box_hi[3][box_n], box_out[6][box_n];
+
+static lm::mat4 fill_boxes() {
+    for (std::size_t i = 0; i < box_n; ++i)
+        for (std::size_t c = 0; c < 3; ++c) {
+            box_lo[c][i] = float(i % (97 + c)) - 50.f;
+            box_hi[c][i] = box_lo[c][i] + float(1 + i % 5);
+        }
+    return lm::mat4_mul(lm::mat4_translate(1.f, 2.f, 3.f), lm::mat4_rotate_y(0.3f));
+}
+
+bench_result bench_aabb_transform_loop_lm(std::size_t iters) {
+    const lm::mat4 M = fill_boxes();
+    return run_bench("lm::aabb_transform loop", [&] {
+        for (std::size_t i = 0; i < box_n; ++i) {
+            const lm::aabb3 B = lm::aabb_transform(M, { { box_lo[0][i], box_lo[1][i], box_lo[2][i] },
+                                                        { box_hi[0][i], box_hi[1][i], box_hi[2][i] } });
+            for (std::size_t c = 0; c < 3; ++c) {
+                box_out[c][i] = B.lo[c];
+                box_out[3 + c][i] = B.hi[c];
+            }
+        }
+        escape(box_out[0][0]);
+    }, iters / box_n);
+}
+
+bench_result bench_aabb_transform_batch_lm(std::size_t iters) {
+    const lm::mat4 M = fill_boxes();
+    const lm::vec3_soa lo{ { box_lo[0], box_lo[1], box_lo[2] }, box_n };
+    const lm::vec3_soa hi{ { box_hi[0], box_hi[1], box_hi[2] }, box_n };
+    const lm::vec3_soa olo{ { box_out[0], box_out[1], box_out[2] }, box_n };
+    const lm::vec3_soa ohi{ { box_out[3], box_out[4], box_out[5] }, box_n };
+    return run_bench("lm::aabb_transform batch", [&] {
+        lm::aabb_transform_batch(M, lo, hi, olo, ohi);
+        escape(box_out[0][0]);
+    }, iters / box_n);
+}
+
+// ---------------- rays ----------------
+// 8 rays against 4k triangles, nearest hit: one ray at a time vs one packet
+static constexpr std::size_t ray_tris = 1 << 12;
+static lm::vec3 ray_tri[3 * ray_tris];
+static lm::ray3 ray_rays[8];
+
+static void fill_rays() {
+    for (std::size_t i = 0; i < ray_tris; ++i) {
+        const float x = float(i % 64) - 32.f, y = float(i / 64) - 32.f, z = -float(i % 7);
+        ray_tri[3 * i]     = { x,       y,       z };
+        ray_tri[3 * i + 1] = { x + 1.f, y,       z };
+        ray_tri[3 * i + 2] = { x,       y + 1.f, z };
+    }
+    for (std::size_t i = 0; i < 8; ++i)
+        ray_rays[i] = { { 0.3f * float(i), -0.2f * float(i), 10.f }, { 0.01f * float(i), 0.02f, -1.f } };
+}
+
+bench_result bench_ray_triangle_loop_lm(std::size_t iters) {
+    fill_rays();
+    return run_bench("lm::ray_triangle loop x8", [&] {
+        float t[8];
+        for (std::size_t r = 0; r < 8; ++r) {
+            t[r] = 1e30f;
+            for (std::size_t k = 0; k < ray_tris; ++k)
+                (void)lm::ray_triangle(ray_rays[r], ray_tri[3 * k], ray_tri[3 * k + 1], ray_tri[3 * k + 2], t[r]);
+        }
+        escape(t);
+    }, iters / (8 * ray_tris));
+}
+
+bench_result bench_ray_triangle_packet_lm(std::size_t iters) {
+    fill_rays();
+    const lm::ray_packet8 P = lm::ray_packet_load<8>(ray_rays);
+    return run_bench("lm::ray_triangle packet8", [&] {
+        lm::vec<float, 8> t;
+        for (std::size_t r = 0; r < 8; ++r) t[r] = 1e30f;
+        for (std::size_t k = 0; k < ray_tris; ++k)
+            (void)lm::ray_triangle_packet(P, ray_tri[3 * k], ray_tri[3 * k + 1], ray_tri[3 * k + 2], t);
+        escape(t);
+    }, iters / (8 * ray_tris));
+}
+
 // ---------------- mat4 * vec4 ----------------
 bench_result bench_mat4_vec4_lm(std::size_t iters) {
     lm::mat4 M = lm::mat4_translate(1.f, 2.f, 3.f);
@@ -147,6 +568,138 @@ bench_result bench_mat4_vec4_glm(std::size_t iters) {
     }, iters);
 }
 
+// ---------------- mat4 * vec4[] ----------------
+// each call transforms `batch_n` vertices, so iters / batch_n calls
+// cover the same vertex count as the single-vector benches above
+static constexpr std::size_t batch_n = 4096;
+static lm::vec4 lm_batch_in[batch_n];
+static lm::vec4 lm_batch_out[batch_n];
+
+static void fill_batch_in() {
+    for (std::size_t i = 0; i < batch_n; ++i)
+        lm_batch_in[i] = { float(i), 2.f, 3.f, 1.f };
+}
+
+bench_result bench_mat4_vec4_loop_lm(std::size_t iters) {
+    lm::mat4 M = lm::mat4_translate(1.f, 2.f, 3.f);
+    fill_batch_in();
+    return run_bench("lm::mat4 * vec4 loop", [&] {
+        for (std::size_t i = 0; i < batch_n; ++i)
+            lm_batch_out[i] = lm::mat4_mul_vec(M, lm_batch_in[i]);
+        escape(lm_batch_out[0]);
+    }, iters / batch_n);
+}
+
+bench_result bench_mat4_vec4_batch_lm(std::size_t iters) {
+    lm::mat4 M = lm::mat4_translate(1.f, 2.f, 3.f);
+    fill_batch_in();
+    return run_bench("lm::mat4 * vec4 batch", [&] {
+        lm::mat4_mul_vec_batch(M, lm_batch_in, lm_batch_out, batch_n);
+        escape(lm_batch_out[0]);
+    }, iters / batch_n);
+}
+
+// ---------------- dispatch overhead ----------------
+// same loop as "lm::mat4 * vec4 loop" (a switch on simd::max_level() per
+// call), but going through simd::dispatch_table: looked up per call, and
+// fetched once per batch
+
+bench_result bench_dispatch_table_lm(std::size_t iters) {
+    lm::mat4 M = lm::mat4_translate(1.f, 2.f, 3.f);
+    fill_batch_in();
+    return run_bench("lm::dispatch per call", [&] {
+        for (std::size_t i = 0; i < batch_n; ++i)
+            lm_batch_out[i] = lm::simd::dispatch().mat4_mul_vec(M, lm_batch_in[i]);
+        escape(lm_batch_out[0]);
+    }, iters / batch_n);
+}
+
+bench_result bench_dispatch_hoisted_lm(std::size_t iters) {
+    lm::mat4 M = lm::mat4_translate(1.f, 2.f, 3.f);
+    fill_batch_in();
+    return run_bench("lm::dispatch hoisted", [&] {
+        const auto mul = lm::simd::dispatch().mat4_mul_vec;
+        for (std::size_t i = 0; i < batch_n; ++i)
+            lm_batch_out[i] = mul(M, lm_batch_in[i]);
+        escape(lm_batch_out[0]);
+    }, iters / batch_n);
+}
+
+// ---------------- rsqrt over float[] ----------------
+static float lm_floats_in[batch_n];
+static float lm_floats_out[batch_n];
+
+static void fill_floats_in() {
+    for (std::size_t i = 0; i < batch_n; ++i)
+        lm_floats_in[i] = 1.f + 0.5f * float(i);
+}
+
+bench_result bench_rsqrtf_loop_lm(std::size_t iters) {
+    fill_floats_in();
+    return run_bench("lm::rsqrtf loop", [&] {
+        for (std::size_t i = 0; i < batch_n; ++i)
+            lm_floats_out[i] = lm::rsqrtf(lm_floats_in[i]);
+        escape(lm_floats_out[0]);
+    }, iters / batch_n);
+}
+
+template<lm::sqrt_precision P>
+bench_result bench_rsqrt_batch_lm(const char* name, std::size_t iters) {
+    fill_floats_in();
+    return run_bench(name, [&] {
+        lm::rsqrt_batch(lm_floats_in, lm_floats_out, batch_n, P);
+        escape(lm_floats_out[0]);
+    }, iters / batch_n);
+}
+
+// ---------------- mat4 * vec3[] (packed points) ----------------
+static lm::vec3 lm_points_in[batch_n];
+static lm::vec3 lm_points_out[batch_n];
+
+static void fill_points_in() {
+    for (std::size_t i = 0; i < batch_n; ++i)
+        lm_points_in[i] = { float(i), 2.f, 3.f };
+}
+
+bench_result bench_mat4_points_widen_lm(std::size_t iters) {
+    lm::mat4 M = lm::mat4_translate(1.f, 2.f, 3.f);
+    fill_points_in();
+    return run_bench("lm::mat4 * vec3 widen", [&] {
+        for (std::size_t i = 0; i < batch_n; ++i) {
+            const lm::vec3& p = lm_points_in[i];
+            const lm::vec4 r = lm::mat4_mul_vec(M, { p[0], p[1], p[2], 1.f });
+            lm_points_out[i] = { r[0], r[1], r[2] };
+        }
+        escape(lm_points_out[0]);
+    }, iters / batch_n);
+}
+
+bench_result bench_mat4_points_batch_lm(std::size_t iters) {
+    lm::mat4 M = lm::mat4_translate(1.f, 2.f, 3.f);
+    fill_points_in();
+    return run_bench("lm::mat4 points batch", [&] {
+        lm::mat4_transform_points(M, lm_points_in, lm_points_out, batch_n);
+        escape(lm_points_out[0]);
+    }, iters / batch_n);
+}
+
+bench_result bench_vec3_norm_loop_lm(std::size_t iters) {
+    fill_points_in();
+    return run_bench("lm::vec3 norm loop", [&] {
+        for (std::size_t i = 0; i < batch_n; ++i)
+            lm_points_out[i] = lm::vec3_norm(lm_points_in[i]);
+        escape(lm_points_out[0]);
+    }, iters / batch_n);
+}
+
+bench_result bench_vec3_norm_batch_lm(std::size_t iters) {
+    fill_points_in();
+    return run_bench("lm::vec3 norm batch", [&] {
+        lm::vec3_norm_batch(lm_points_in, lm_points_out, batch_n);
+        escape(lm_points_out[0]);
+    }, iters / batch_n);
+}
+
 bench_result bench_mat4_look_at_lm(std::size_t iters) {
     lm::vec3 eye{ 1.5f, -2.0f, 4.0f };
     lm::vec3 center{ 0.5f, 1.0f, -3.0f };
@@ -171,6 +724,294 @@ bench_result bench_mat4_look_at_glm(std::size_t iters) {
     }, iters);
 }
 
+// ---------------- quat mul / rotate, arrays ----------------
+static lm::quat lm_quat_a[batch_n];
+static lm::quat lm_quat_b[batch_n];
+static lm::quat lm_quat_out[batch_n];
+static glm::quat glm_quat_a[batch_n];
+static glm::quat glm_quat_b[batch_n];
+static glm::quat glm_quat_out[batch_n];
+static glm::vec3 glm_points_in[batch_n];
+static glm::vec3 glm_points_out[batch_n];
+
+static void fill_quat_in() {
+    fill_points_in();
+    for (std::size_t i = 0; i < batch_n; ++i) {
+        lm_quat_a[i] = lm::quat_rotate(0.001f * float(i), lm::vec3{ 1.f, 2.f, 3.f });
+        lm_quat_b[i] = lm::quat_rotate(0.5f - 0.002f * float(i), lm::vec3{ -2.f, 1.f, 0.5f });
+        const lm::quat& a = lm_quat_a[i];
+        const lm::quat& b = lm_quat_b[i];
+        glm_quat_a[i] = glm::quat(a.w, a.v[0], a.v[1], a.v[2]);
+        glm_quat_b[i] = glm::quat(b.w, b.v[0], b.v[1], b.v[2]);
+        glm_points_in[i] = { lm_points_in[i][0], lm_points_in[i][1], lm_points_in[i][2] };
+    }
+}
+
+bench_result bench_quat_mul_loop_lm(std::size_t iters) {
+    fill_quat_in();
+    return run_bench("lm::quat mul loop", [&] {
+        for (std::size_t i = 0; i < batch_n; ++i)
+            lm_quat_out[i] = lm::quat_mul(lm_quat_a[i], lm_quat_b[i]);
+        escape(lm_quat_out[0]);
+    }, iters / batch_n);
+}
+
+bench_result bench_quat_mul_batch_lm(std::size_t iters) {
+    fill_quat_in();
+    return run_bench("lm::quat mul batch", [&] {
+        lm::quat_mul_batch(lm_quat_a, lm_quat_b, lm_quat_out, batch_n);
+        escape(lm_quat_out[0]);
+    }, iters / batch_n);
+}
+
+bench_result bench_quat_mul_loop_glm(std::size_t iters) {
+    fill_quat_in();
+    return run_bench("glm::quat mul loop", [&] {
+        for (std::size_t i = 0; i < batch_n; ++i)
+            glm_quat_out[i] = glm_quat_a[i] * glm_quat_b[i];
+        escape(glm_quat_out[0]);
+    }, iters / batch_n);
+}
+
+bench_result bench_quat_rotate_loop_lm(std::size_t iters) {
+    fill_quat_in();
+    const lm::quat Q = lm_quat_a[100];
+    return run_bench("lm::quat rotate loop", [&] {
+        for (std::size_t i = 0; i < batch_n; ++i)
+            lm_points_out[i] = lm::quat_mul_vec3(Q, lm_points_in[i]);
+        escape(lm_points_out[0]);
+    }, iters / batch_n);
+}
+
+bench_result bench_quat_rotate_batch_lm(std::size_t iters) {
+    fill_quat_in();
+    const lm::quat Q = lm_quat_a[100];
+    return run_bench("lm::quat rotate batch", [&] {
+        lm::quat_mul_vec3_batch(Q, lm_points_in, lm_points_out, batch_n);
+        escape(lm_points_out[0]);
+    }, iters / batch_n);
+}
+
+bench_result bench_quat_rotate_loop_glm(std::size_t iters) {
+    fill_quat_in();
+    const glm::quat Q = glm_quat_a[100];
+    return run_bench("glm::quat rotate loop", [&] {
+        for (std::size_t i = 0; i < batch_n; ++i)
+            glm_points_out[i] = Q * glm_points_in[i];
+        escape(glm_points_out[0]);
+    }, iters / batch_n);
+}
+
+// ---------------- quat slerp, arrays ----------------
+static float quat_soa_a[4][batch_n];
+static float quat_soa_b[4][batch_n];
+static float quat_soa_out[4][batch_n];
+static float slerp_t[batch_n];
+
+static void fill_slerp_in() {
+    fill_quat_in();
+    for (std::size_t i = 0; i < batch_n; ++i) {
+        for (std::size_t k = 0; k < 4; ++k) {
+            quat_soa_a[k][i] = lm_quat_a[i][k];
+            quat_soa_b[k][i] = lm_quat_b[i][k];
+        }
+        slerp_t[i] = float(i % 97) * (1.f / 96.f);
+    }
+}
+
+bench_result bench_quat_slerp_loop_lm(std::size_t iters) {
+    fill_slerp_in();
+    return run_bench("lm::quat slerp loop", [&] {
+        for (std::size_t i = 0; i < batch_n; ++i)
+            lm_quat_out[i] = lm::quat_slerp(lm_quat_a[i], lm_quat_b[i], slerp_t[i]);
+        escape(lm_quat_out[0]);
+    }, iters / batch_n);
+}
+
+bench_result bench_quat_slerp_soa_lm(std::size_t iters) {
+    fill_slerp_in();
+    const lm::quat_soa A{ { quat_soa_a[0], quat_soa_a[1], quat_soa_a[2], quat_soa_a[3] }, batch_n };
+    const lm::quat_soa B{ { quat_soa_b[0], quat_soa_b[1], quat_soa_b[2], quat_soa_b[3] }, batch_n };
+    const lm::quat_soa R{ { quat_soa_out[0], quat_soa_out[1], quat_soa_out[2], quat_soa_out[3] }, batch_n };
+    return run_bench("lm::quat slerp SoA", [&] {
+        lm::quat_soa_slerp(A, B, slerp_t, R);
+        escape(quat_soa_out[0][0]);
+    }, iters / batch_n);
+}
+
+bench_result bench_quat_slerp_fast_soa_lm(std::size_t iters) {
+    fill_slerp_in();
+    const lm::quat_soa A{ { quat_soa_a[0], quat_soa_a[1], quat_soa_a[2], quat_soa_a[3] }, batch_n };
+    const lm::quat_soa B{ { quat_soa_b[0], quat_soa_b[1], quat_soa_b[2], quat_soa_b[3] }, batch_n };
+    const lm::quat_soa R{ { quat_soa_out[0], quat_soa_out[1], quat_soa_out[2], quat_soa_out[3] }, batch_n };
+    return run_bench("lm::quat slerp_fast SoA", [&] {
+        lm::quat_soa_slerp_fast(A, B, slerp_t, R);
+        escape(quat_soa_out[0][0]);
+    }, iters / batch_n);
+}
+
+bench_result bench_quat_slerp_loop_glm(std::size_t iters) {
+    fill_slerp_in();
+    return run_bench("glm::quat slerp loop", [&] {
+        for (std::size_t i = 0; i < batch_n; ++i)
+            glm_quat_out[i] = glm::slerp(glm_quat_a[i], glm_quat_b[i], slerp_t[i]);
+        escape(glm_quat_out[0]);
+    }, iters / batch_n);
+}
+
+// ---------------- dualquat, arrays ----------------
+static lm::dualquat lm_dq_a[batch_n];
+static lm::dualquat lm_dq_b[batch_n];
+static lm::dualquat lm_dq_out[batch_n];
+static glm::dualquat glm_dq_a[batch_n];
+static glm::dualquat glm_dq_b[batch_n];
+static glm::dualquat glm_dq_out[batch_n];
+
+static void fill_dq_in() {
+    fill_quat_in();
+    for (std::size_t i = 0; i < batch_n; ++i) {
+        const lm::vec3 t{ 0.01f * float(i), 1.f, -2.f };
+        lm_dq_a[i] = lm::dualquat_from_rt(lm_quat_a[i], t);
+        lm_dq_b[i] = lm::dualquat_from_rt(lm_quat_b[i], lm::vec3{ 3.f, -0.5f, 0.002f * float(i) });
+        const lm::dualquat& a = lm_dq_a[i];
+        const lm::dualquat& b = lm_dq_b[i];
+        glm_dq_a[i] = glm::dualquat(glm::quat(a.real.w, a.real.v[0], a.real.v[1], a.real.v[2]),
+                                    glm::quat(a.dual.w, a.dual.v[0], a.dual.v[1], a.dual.v[2]));
+        glm_dq_b[i] = glm::dualquat(glm::quat(b.real.w, b.real.v[0], b.real.v[1], b.real.v[2]),
+                                    glm::quat(b.dual.w, b.dual.v[0], b.dual.v[1], b.dual.v[2]));
+    }
+}
+
+bench_result bench_dualquat_mul_loop_lm(std::size_t iters) {
+    fill_dq_in();
+    return run_bench("lm::dualquat mul loop", [&] {
+        for (std::size_t i = 0; i < batch_n; ++i)
+            lm_dq_out[i] = lm::dualquat_mul(lm_dq_a[i], lm_dq_b[i]);
+        escape(lm_dq_out[0]);
+    }, iters / batch_n);
+}
+
+bench_result bench_dualquat_mul_batch_lm(std::size_t iters) {
+    fill_dq_in();
+    return run_bench("lm::dualquat mul batch", [&] {
+        lm::dualquat_mul_batch(lm_dq_a, lm_dq_b, lm_dq_out, batch_n);
+        escape(lm_dq_out[0]);
+    }, iters / batch_n);
+}
+
+bench_result bench_dualquat_mul_loop_glm(std::size_t iters) {
+    fill_dq_in();
+    return run_bench("glm::dualquat mul loop", [&] {
+        for (std::size_t i = 0; i < batch_n; ++i)
+            glm_dq_out[i] = glm_dq_a[i] * glm_dq_b[i];
+        escape(glm_dq_out[0]);
+    }, iters / batch_n);
+}
+
+bench_result bench_dualquat_point_loop_lm(std::size_t iters) {
+    fill_dq_in();
+    return run_bench("lm::dualquat point loop", [&] {
+        for (std::size_t i = 0; i < batch_n; ++i)
+            lm_points_out[i] = lm::dualquat_transform_point(lm_dq_a[i], lm_points_in[i]);
+        escape(lm_points_out[0]);
+    }, iters / batch_n);
+}
+
+bench_result bench_dualquat_point_batch_lm(std::size_t iters) {
+    fill_dq_in();
+    return run_bench("lm::dualquat point batch", [&] {
+        lm::dualquat_transform_point_batch(lm_dq_a, lm_points_in, lm_points_out, batch_n);
+        escape(lm_points_out[0]);
+    }, iters / batch_n);
+}
+
+bench_result bench_dualquat_point_loop_glm(std::size_t iters) {
+    fill_dq_in();
+    return run_bench("glm::dualquat point loop", [&] {
+        for (std::size_t i = 0; i < batch_n; ++i)
+            glm_points_out[i] = glm_dq_a[i] * glm_points_in[i];
+        escape(glm_points_out[0]);
+    }, iters / batch_n);
+}
+
+static lm::trs lm_trs_in[batch_n];
+static lm::trs lm_trs_out[batch_n];
+static lm::mat4 lm_trs_mat[batch_n];
+static glm::vec3 glm_trs_t[batch_n];
+static glm::quat glm_trs_r[batch_n];
+static glm::vec3 glm_trs_s[batch_n];
+static glm::mat4 glm_trs_mat[batch_n];
+
+static void fill_trs_in() {
+    fill_quat_in();
+    for (std::size_t i = 0; i < batch_n; ++i) {
+        lm_trs_in[i].t = { 0.01f * float(i), 1.f, -2.f };
+        lm_trs_in[i].r = lm_quat_a[i];
+        lm_trs_in[i].s = { 1.f + 0.0005f * float(i), 2.f, 0.5f };
+        lm_trs_mat[i] = lm::mat4_from_trs(lm_trs_in[i]);
+        const lm::trs& X = lm_trs_in[i];
+        glm_trs_t[i] = { X.t[0], X.t[1], X.t[2] };
+        glm_trs_r[i] = glm_quat_a[i];
+        glm_trs_s[i] = { X.s[0], X.s[1], X.s[2] };
+        glm_trs_mat[i] = glm::make_mat4(lm_trs_mat[i][0].data());
+    }
+}
+
+bench_result bench_trs_to_mat4_loop_lm(std::size_t iters) {
+    fill_trs_in();
+    return run_bench("lm::mat4_from_trs loop", [&] {
+        for (std::size_t i = 0; i < batch_n; ++i)
+            lm_trs_mat[i] = lm::mat4_from_trs(lm_trs_in[i]);
+        escape(lm_trs_mat[0]);
+    }, iters / batch_n);
+}
+
+bench_result bench_trs_to_mat4_batch_lm(std::size_t iters) {
+    fill_trs_in();
+    return run_bench("lm::trs_to_mat4 batch", [&] {
+        lm::trs_to_mat4_batch(lm_trs_in, lm_trs_mat, batch_n);
+        escape(lm_trs_mat[0]);
+    }, iters / batch_n);
+}
+
+bench_result bench_trs_to_mat4_loop_glm(std::size_t iters) {
+    fill_trs_in();
+    return run_bench("glm T*R*S loop", [&] {
+        for (std::size_t i = 0; i < batch_n; ++i)
+            glm_trs_mat[i] = glm::scale(glm::translate(glm::mat4(1.f), glm_trs_t[i]) * glm::mat4_cast(glm_trs_r[i]),
+                                        glm_trs_s[i]);
+        escape(glm_trs_mat[0]);
+    }, iters / batch_n);
+}
+
+bench_result bench_mat4_decompose_loop_lm(std::size_t iters) {
+    fill_trs_in();
+    return run_bench("lm::mat4_decompose loop", [&] {
+        for (std::size_t i = 0; i < batch_n; ++i)
+            lm_trs_out[i] = lm::mat4_decompose(lm_trs_mat[i]);
+        escape(lm_trs_out[0]);
+    }, iters / batch_n);
+}
+
+bench_result bench_mat4_decompose_batch_lm(std::size_t iters) {
+    fill_trs_in();
+    return run_bench("lm::mat4_decompose batch", [&] {
+        lm::mat4_decompose_batch(lm_trs_mat, lm_trs_out, batch_n);
+        escape(lm_trs_out[0]);
+    }, iters / batch_n);
+}
+
+bench_result bench_mat4_decompose_loop_glm(std::size_t iters) {
+    fill_trs_in();
+    return run_bench("glm::decompose loop", [&] {
+        glm::vec3 skew;
+        glm::vec4 persp;
+        for (std::size_t i = 0; i < batch_n; ++i)
+            glm::decompose(glm_trs_mat[i], glm_trs_s[i], glm_trs_r[i], glm_trs_t[i], skew, persp);
+        escape(glm_trs_r[0]);
+    }, iters / batch_n);
+}
+
 // ---------------- main ----------------
 int main() {
     std::printf("Current SIMD for `lm::` is: %s\n", lm::simd::level_string(lm::simd::max_level()));
@@ -180,16 +1021,80 @@ int main() {
     bench_result results[] = {
         bench_sqrtf_lm(iters),
         bench_rsqrtf_lm(iters),
+        bench_sinf_x8_lm(iters),
+        bench_sin8_lm(iters),
 
         bench_vec3_dot_lm(iters),
         bench_vec3_dot_glm(iters),
         
         bench_mat4_mul_lm(iters),
         bench_mat4_mul_glm(iters),
+
+        bench_mat4_inverse_lm(iters),
+        bench_mat4_inverse_affine_lm(iters),
+        bench_mat4_inverse_rigid_lm(iters),
+        bench_mat4_inverse_glm(iters),
+        bench_affine_mul_chain_lm(iters),
+        bench_mat4_mul_chain_lm(iters),
+        bench_mat4_det_loop_lm(iters),
+        bench_mat4_det_batch_lm(iters),
+        bench_mat4_mul_loop_lm(iters),
+        bench_mat4_mul_batch_lm(iters),
+        bench_mat4_mul_batch_stream_lm(iters),
+        bench_mat4_mul_batch_left_lm(iters),
+        bench_hierarchy_serial_lm(iters),
+        bench_hierarchy_pool_lm(iters),
+        bench_hierarchy_dirty_lm(iters),
+        bench_cull_spheres_loop_lm(iters),
+        bench_cull_spheres_batch_lm(iters),
+        bench_cull_aabbs_batch_lm(iters),
+        bench_aabb_transform_loop_lm(iters),
+        bench_aabb_transform_batch_lm(iters),
+        bench_ray_triangle_loop_lm(iters),
+        bench_ray_triangle_packet_lm(iters),
         
         bench_mat4_vec4_lm(iters),
         bench_mat4_vec4_glm(iters),
 
+        bench_mat4_vec4_loop_lm(iters),
+        bench_mat4_vec4_batch_lm(iters),
+        bench_dispatch_table_lm(iters),
+        bench_dispatch_hoisted_lm(iters),
+
+        bench_rsqrtf_loop_lm(iters),
+        bench_rsqrt_batch_lm<lm::sqrt_precision::estimate>("lm::rsqrt_batch est", iters),
+        bench_rsqrt_batch_lm<lm::sqrt_precision::newton>("lm::rsqrt_batch newton", iters),
+        bench_rsqrt_batch_lm<lm::sqrt_precision::exact>("lm::rsqrt_batch exact", iters),
+
+        bench_mat4_points_widen_lm(iters),
+        bench_mat4_points_batch_lm(iters),
+
+        bench_vec3_norm_loop_lm(iters),
+        bench_vec3_norm_batch_lm(iters),
+
+        bench_quat_mul_loop_lm(iters),
+        bench_quat_mul_batch_lm(iters),
+        bench_quat_mul_loop_glm(iters),
+        bench_quat_rotate_loop_lm(iters),
+        bench_quat_rotate_batch_lm(iters),
+        bench_quat_rotate_loop_glm(iters),
+        bench_quat_slerp_loop_lm(iters),
+        bench_quat_slerp_soa_lm(iters),
+        bench_quat_slerp_fast_soa_lm(iters),
+        bench_quat_slerp_loop_glm(iters),
+        bench_dualquat_mul_loop_lm(iters),
+        bench_dualquat_mul_batch_lm(iters),
+        bench_dualquat_mul_loop_glm(iters),
+        bench_dualquat_point_loop_lm(iters),
+        bench_dualquat_point_batch_lm(iters),
+        bench_dualquat_point_loop_glm(iters),
+        bench_trs_to_mat4_loop_lm(iters),
+        bench_trs_to_mat4_batch_lm(iters),
+        bench_trs_to_mat4_loop_glm(iters),
+        bench_mat4_decompose_loop_lm(iters),
+        bench_mat4_decompose_batch_lm(iters),
+        bench_mat4_decompose_loop_glm(iters),
+
         bench_mat4_look_at_lm(iters),
         bench_mat4_look_at_glm(iters),
     };
@@ -0,0 +1,156 @@
+#include "../linmath/vec.hpp"
+#include "../linmath/mat.hpp"
+#include "../linmath/skinning.hpp"
+#include "../linmath/par_kernels.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using highres_clock = std::chrono::high_resolution_clock;
+
+// ---------------- escape ----------------
+template<typename T>
+inline void escape(const T& v) {
+#ifdef _MSC_VER
+    volatile const T* p = &v;
+    (void)p;
+#else
+    asm volatile("" : : "g"(v) : "memory");
+#endif
+}
+
+#if !defined(LMATH_FREESTANDING)
+
+// ---------------- bench ----------------
+// best of `reps` runs, so page faults and thread start-up drop out
+template<typename Fn>
+double run_best(Fn&& fn, int reps) {
+    double best = 1e30;
+    for (int r = 0; r < reps; ++r) {
+        auto t0 = highres_clock::now();
+        fn();
+        auto t1 = highres_clock::now();
+        const double ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        if (ms < best) best = ms;
+    }
+    return best;
+}
+
+// ---------------- reference ----------------
+// what skinning code looks like without skin_lbs: every influence through
+// mat4_mul_vec, results scaled by the weights and summed
+static void skin_reference(const lm::mat4* palette, const lm::vec3* pos, const lm::vec3* nrm,
+                           const std::uint16_t* joints, const float* weights,
+                           lm::vec3* out_pos, lm::vec3* out_nrm, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        const lm::vec4 p{ pos[i][0], pos[i][1], pos[i][2], 1.f };
+        const lm::vec4 d{ nrm[i][0], nrm[i][1], nrm[i][2], 0.f };
+        lm::vec4 sp{}, sn{};
+        for (int k = 0; k < 4; ++k) {
+            const lm::mat4& M = palette[joints[4 * i + k]];
+            sp = sp + lm::mat4_mul_vec(M, p) * weights[4 * i + k];
+            sn = sn + lm::mat4_mul_vec(M, d) * weights[4 * i + k];
+        }
+        out_pos[i] = { sp[0], sp[1], sp[2] };
+        out_nrm[i] = { sn[0], sn[1], sn[2] };
+    }
+}
+
+// ---------------- main ----------------
+int main() {
+    constexpr std::size_t n = 500'000;       // vertices
+    constexpr std::size_t joint_count = 128;
+    constexpr int reps = 5;
+
+    std::uint32_t seed = 1u;
+    auto rnd = [&seed](float lo, float hi) {
+        seed = seed * 1664525u + 1013904223u;
+        return lo + (hi - lo) * float(seed >> 8) * (1.f / 16777216.f);
+    };
+
+    std::vector<lm::mat4> palette(joint_count);
+    for (lm::mat4& M : palette) {
+        M = lm::mat4_mul(lm::mat4_mul(lm::mat4_rotate_x(rnd(-3.f, 3.f)), lm::mat4_rotate_y(rnd(-3.f, 3.f))),
+                         lm::mat4_rotate_z(rnd(-3.f, 3.f)));
+        M[3] = { rnd(-1.f, 1.f), rnd(-1.f, 1.f), rnd(-1.f, 1.f), 1.f };
+    }
+
+    // four influences per vertex, neighbouring joints as in a real rig
+    std::vector<lm::vec3> pos(n), nrm(n), out_pos(n), out_nrm(n), ref_pos(n), ref_nrm(n);
+    std::vector<std::uint16_t> joints16(4 * n);
+    std::vector<std::uint8_t> joints8(4 * n);
+    std::vector<float> weights(4 * n);
+    for (std::size_t i = 0; i < n; ++i) {
+        pos[i] = { rnd(-1.f, 1.f), rnd(-1.f, 1.f), rnd(-1.f, 1.f) };
+        nrm[i] = lm::vec_norm(lm::vec3{ rnd(-1.f, 1.f), rnd(-1.f, 1.f), rnd(0.1f, 1.f) });
+        const std::size_t base = (i * joint_count) / n;
+        float w[4] = { rnd(0.f, 1.f), rnd(0.f, 1.f), rnd(0.f, 0.5f), rnd(0.f, 0.25f) };
+        const float sum = ((w[0] + w[1]) + w[2]) + w[3];
+        for (int k = 0; k < 4; ++k) {
+            const std::size_t j = (base + std::size_t(k)) % joint_count;
+            joints16[4 * i + k] = std::uint16_t(j);
+            joints8[4 * i + k] = std::uint8_t(j);
+            weights[4 * i + k] = w[k] / sum;
+        }
+    }
+
+    std::size_t max_threads = std::thread::hardware_concurrency();
+    if (max_threads == 0) max_threads = 1;
+
+    std::printf("Current SIMD for `lm::` is: %s, %zu hardware threads, %zu vertices, %zu joints\n",
+                lm::simd::level_string(lm::simd::max_level()), max_threads, n, joint_count);
+
+    const double ref_ms = run_best([&] {
+        skin_reference(palette.data(), pos.data(), nrm.data(), joints16.data(), weights.data(),
+                       ref_pos.data(), ref_nrm.data(), n);
+        escape(ref_pos[0]);
+    }, reps);
+    std::printf("%-30s %8.2f ms\n", "reference (mat4_mul_vec loop)", ref_ms);
+
+    auto report = [&](const char* name, double ms) {
+        float err = 0.f;
+        for (std::size_t i = 0; i < n; ++i)
+            for (int k = 0; k < 3; ++k) {
+                err = std::fmax(err, std::fabs(out_pos[i][k] - ref_pos[i][k]));
+                err = std::fmax(err, std::fabs(out_nrm[i][k] - ref_nrm[i][k]));
+            }
+        std::printf("%-30s %8.2f ms  (%5.2fx, max |diff| %.2g)\n", name, ms, ref_ms / ms, double(err));
+    };
+
+    report("skin_lbs_scalar", run_best([&] {
+        lm::skin_lbs_scalar(palette.data(), pos.data(), nrm.data(), joints16.data(), weights.data(),
+                            out_pos.data(), out_nrm.data(), n);
+        escape(out_pos[0]);
+    }, reps));
+    report("skin_lbs, u16 joints", run_best([&] {
+        lm::skin_lbs(palette.data(), pos.data(), nrm.data(), joints16.data(), weights.data(),
+                     out_pos.data(), out_nrm.data(), n);
+        escape(out_pos[0]);
+    }, reps));
+    report("skin_lbs, u8 joints", run_best([&] {
+        lm::skin_lbs(palette.data(), pos.data(), nrm.data(), joints8.data(), weights.data(),
+                     out_pos.data(), out_nrm.data(), n);
+        escape(out_pos[0]);
+    }, reps));
+    {
+        lm::thread_pool threads(max_threads);
+        char name[64];
+        std::snprintf(name, sizeof(name), "skin_lbs, %zu threads", max_threads);
+        report(name, run_best([&] {
+            lm::skin_lbs(palette.data(), pos.data(), nrm.data(), joints16.data(), weights.data(),
+                         out_pos.data(), out_nrm.data(), n, threads.pool());
+            escape(out_pos[0]);
+        }, reps));
+    }
+}
+
+#else
+
+int main() {
+    std::printf("lm::par is compiled out (LMATH_FREESTANDING)\n");
+}
+
+#endif
@@ -0,0 +1,415 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "detail/feature_detection.hpp"
+
+#include "libc_integration.hpp"
+#include "vec.hpp"
+#include "mat.hpp"
+
+namespace lm {
+
+    // ============================================================
+    // Affine 3x4 (column-major, bottom row implied)
+    //
+    // mat<T,4,3>: columns 0..2 are the linear part L, column 3 the
+    // translation t; the row (0, 0, 0, 1) of the equivalent mat4 is not
+    // stored. 48 bytes instead of 64, and composing two of them skips the
+    // fourth row of every column. Converting to and from mat4 is exact for
+    // matrices whose bottom row is (0, 0, 0, 1).
+    //
+    // Each SIMD path follows the scalar operation order, so all levels
+    // agree bit for bit (-ffp-contract=off), and the results match the
+    // mat4 equivalents (mat4_mul, mat4_inverse_affine, ...) up to the sign
+    // of zero entries.
+    // ============================================================
+
+    template<typename T> using affine3x4_of = mat<T,4,3>;
+
+    using affine3x4 = affine3x4_of<float>;
+
+    static_assert(sizeof(affine3x4) == 12 * sizeof(float), "affine3x4 must be 12 packed floats");
+
+    namespace detail {
+
+        // ============================================================
+        // Register layout: one column per register, lane 3 unused.
+        // The 12 floats move as three 16-byte chunks
+        //     q0 = c0x c0y c0z c1x   q1 = c1y c1z c2x c2y   q2 = c2z tx ty tz
+        // and are shuffled to / from columns in registers. Loading whole
+        // columns straight from memory would straddle those chunks, which
+        // defeats store forwarding when the result of one call feeds the
+        // next (chained transforms).
+        // ============================================================
+#if defined(__SSE2__)
+        LMATH_FORCE_INLINE void affine_load_sse2(const ::lm::affine3x4& A, __m128 (&C)[4]) noexcept {
+            const float* p = A[0].data();
+            const __m128 q0 = _mm_loadu_ps(p);
+            const __m128 q1 = _mm_loadu_ps(p + 4);
+            const __m128 q2 = _mm_loadu_ps(p + 8);
+
+            const __m128 t = _mm_shuffle_ps(q0, q1, _MM_SHUFFLE(1, 0, 3, 3)); // c1x c1x c1y c1z
+            C[0] = q0;
+            C[1] = _mm_shuffle_ps(t, t, _MM_SHUFFLE(3, 3, 2, 0));
+            C[2] = _mm_shuffle_ps(q1, q2, _MM_SHUFFLE(0, 0, 3, 2));
+            C[3] = _mm_shuffle_ps(q2, q2, _MM_SHUFFLE(0, 3, 2, 1));
+        }
+
+        // columns -> the three chunks q0, q1, q2
+        LMATH_FORCE_INLINE void affine_pack_sse2(const __m128 (&C)[4], __m128 (&q)[3]) noexcept {
+            const __m128 t0 = _mm_shuffle_ps(C[1], C[0], _MM_SHUFFLE(2, 2, 0, 0)); // c1x c1x c0z c0z
+            const __m128 t2 = _mm_shuffle_ps(C[2], C[3], _MM_SHUFFLE(0, 0, 2, 2)); // c2z c2z tx tx
+            q[0] = _mm_shuffle_ps(C[0], t0, _MM_SHUFFLE(0, 2, 1, 0));
+            q[1] = _mm_shuffle_ps(C[1], C[2], _MM_SHUFFLE(1, 0, 2, 1));
+            q[2] = _mm_shuffle_ps(t2, C[3], _MM_SHUFFLE(2, 1, 2, 0));
+        }
+
+        LMATH_FORCE_INLINE ::lm::affine3x4 affine_store_sse2(const __m128 (&C)[4]) noexcept {
+            __m128 q[3];
+            affine_pack_sse2(C, q);
+
+            ::lm::affine3x4 R{};
+            float* p = R[0].data();
+            _mm_storeu_ps(p,     q[0]);
+            _mm_storeu_ps(p + 4, q[1]);
+            _mm_storeu_ps(p + 8, q[2]);
+            return R;
+        }
+
+        // (a0 b0 + a1 b1) + a2 b2 for column b of B
+        LMATH_FORCE_INLINE __m128 affine_mul_col_sse2(const __m128 (&a)[4], const ::lm::vec3& b) noexcept {
+            return _mm_add_ps(_mm_add_ps(_mm_mul_ps(a[0], _mm_set1_ps(b[0])),
+                                         _mm_mul_ps(a[1], _mm_set1_ps(b[1]))),
+                              _mm_mul_ps(a[2], _mm_set1_ps(b[2])));
+        }
+
+        LMATH_FORCE_INLINE void affine_mul_cols_sse2(const ::lm::affine3x4& A, const ::lm::affine3x4& B,
+                                                     __m128 (&C)[4]) noexcept {
+            __m128 a[4];
+            affine_load_sse2(A, a);
+            C[0] = affine_mul_col_sse2(a, B[0]);
+            C[1] = affine_mul_col_sse2(a, B[1]);
+            C[2] = affine_mul_col_sse2(a, B[2]);
+            C[3] = _mm_add_ps(affine_mul_col_sse2(a, B[3]), a[3]);
+        }
+
+        LMATH_FORCE_INLINE void affine_inverse_cols_sse2(const ::lm::affine3x4& A, __m128 (&C)[4]) noexcept {
+            __m128 a[4], r[3];
+            affine_load_sse2(A, a);
+            inverse3_rows_sse2(a[0], a[1], a[2], r);
+            inverse_affine_cols_sse2(r[0], r[1], r[2], A[3].data(), C);
+        }
+
+        LMATH_FORCE_INLINE void affine_inverse_rigid_cols_sse2(const ::lm::affine3x4& A, __m128 (&C)[4]) noexcept {
+            __m128 a[4];
+            affine_load_sse2(A, a);
+            inverse_affine_cols_sse2(a[0], a[1], a[2], A[3].data(), C);
+        }
+
+        LMATH_FORCE_INLINE ::lm::affine3x4 affine_mul_sse2(const ::lm::affine3x4& A,
+                                                           const ::lm::affine3x4& B) noexcept {
+            __m128 C[4];
+            affine_mul_cols_sse2(A, B, C);
+            return affine_store_sse2(C);
+        }
+
+        LMATH_FORCE_INLINE ::lm::affine3x4 affine_inverse_sse2(const ::lm::affine3x4& A) noexcept {
+            __m128 C[4];
+            affine_inverse_cols_sse2(A, C);
+            return affine_store_sse2(C);
+        }
+
+        LMATH_FORCE_INLINE ::lm::affine3x4 affine_inverse_rigid_sse2(const ::lm::affine3x4& A) noexcept {
+            __m128 C[4];
+            affine_inverse_rigid_cols_sse2(A, C);
+            return affine_store_sse2(C);
+        }
+#endif
+
+#if defined(__AVX__)
+        // Same kernels, but q0 and q1 go out as one 32-byte store. With AVX
+        // enabled compilers copy a 48-byte struct as 32 + 16 bytes, and a
+        // 32-byte load can't be forwarded from two 16-byte stores; that stall
+        // doubled the cost of a chained affine_mul.
+        LMATH_FORCE_INLINE ::lm::affine3x4 affine_store_avx(const __m128 (&C)[4]) noexcept {
+            __m128 q[3];
+            affine_pack_sse2(C, q);
+
+            ::lm::affine3x4 R{};
+            float* p = R[0].data();
+            _mm256_storeu_ps(p, _mm256_insertf128_ps(_mm256_castps128_ps256(q[0]), q[1], 1));
+            _mm_storeu_ps(p + 8, q[2]);
+            return R;
+        }
+
+        LMATH_FORCE_INLINE ::lm::affine3x4 affine_mul_avx(const ::lm::affine3x4& A,
+                                                          const ::lm::affine3x4& B) noexcept {
+            __m128 C[4];
+            affine_mul_cols_sse2(A, B, C);
+            return affine_store_avx(C);
+        }
+
+        LMATH_FORCE_INLINE ::lm::affine3x4 affine_inverse_avx(const ::lm::affine3x4& A) noexcept {
+            __m128 C[4];
+            affine_inverse_cols_sse2(A, C);
+            return affine_store_avx(C);
+        }
+
+        LMATH_FORCE_INLINE ::lm::affine3x4 affine_inverse_rigid_avx(const ::lm::affine3x4& A) noexcept {
+            __m128 C[4];
+            affine_inverse_rigid_cols_sse2(A, C);
+            return affine_store_avx(C);
+        }
+#endif
+
+#if defined(__ARM_NEON)
+        LMATH_FORCE_INLINE void affine_load_neon(const ::lm::affine3x4& A, float32x4_t (&C)[4]) noexcept {
+            const float* p = A[0].data();
+            const float32x4_t q0 = vld1q_f32(p);
+            const float32x4_t q1 = vld1q_f32(p + 4);
+            const float32x4_t q2 = vld1q_f32(p + 8);
+
+            C[0] = q0;
+            C[1] = vextq_f32(q0, q1, 3);
+            C[2] = vextq_f32(q1, q2, 2);
+            C[3] = vextq_f32(q2, q2, 1);
+        }
+
+        LMATH_FORCE_INLINE ::lm::affine3x4 affine_store_neon(const float32x4_t (&C)[4]) noexcept {
+            ::lm::affine3x4 R{};
+            float* p = R[0].data();
+            vst1q_f32(p,     vsetq_lane_f32(vgetq_lane_f32(C[1], 0), C[0], 3));
+            vst1q_f32(p + 4, vcombine_f32(vget_low_f32(vextq_f32(C[1], C[1], 1)), vget_low_f32(C[2])));
+            vst1q_f32(p + 8, vextq_f32(vextq_f32(C[2], C[2], 3), C[3], 3));
+            return R;
+        }
+
+        LMATH_FORCE_INLINE float32x4_t affine_mul_col_neon(const float32x4_t (&a)[4], const ::lm::vec3& b) noexcept {
+            return vaddq_f32(vaddq_f32(vmulq_n_f32(a[0], b[0]), vmulq_n_f32(a[1], b[1])),
+                             vmulq_n_f32(a[2], b[2]));
+        }
+
+        LMATH_FORCE_INLINE ::lm::affine3x4 affine_mul_neon(const ::lm::affine3x4& A,
+                                                           const ::lm::affine3x4& B) noexcept {
+            float32x4_t a[4];
+            affine_load_neon(A, a);
+            const float32x4_t R[4] = {
+                affine_mul_col_neon(a, B[0]),
+                affine_mul_col_neon(a, B[1]),
+                affine_mul_col_neon(a, B[2]),
+                vaddq_f32(affine_mul_col_neon(a, B[3]), a[3])
+            };
+            return affine_store_neon(R);
+        }
+
+        LMATH_FORCE_INLINE ::lm::affine3x4 affine_inverse_neon(const ::lm::affine3x4& A) noexcept {
+            float32x4_t a[4], r[3], C[4];
+            affine_load_neon(A, a);
+            inverse3_rows_neon(a[0], a[1], a[2], r);
+            inverse_affine_cols_neon(r[0], r[1], r[2], A[3].data(), C);
+            return affine_store_neon(C);
+        }
+
+        LMATH_FORCE_INLINE ::lm::affine3x4 affine_inverse_rigid_neon(const ::lm::affine3x4& A) noexcept {
+            float32x4_t a[4], C[4];
+            affine_load_neon(A, a);
+            inverse_affine_cols_neon(a[0], a[1], a[2], A[3].data(), C);
+            return affine_store_neon(C);
+        }
+#endif
+
+    } // namespace detail
+
+    // ============================================================
+    // Identity / conversion
+    // ============================================================
+
+    LMATH_OUT affine3x4 affine_identity() noexcept {
+        return { {
+            { 1.f, 0.f, 0.f },
+            { 0.f, 1.f, 0.f },
+            { 0.f, 0.f, 1.f },
+            { 0.f, 0.f, 0.f }
+        } };
+    }
+
+    // drops the bottom row, which is taken to be (0, 0, 0, 1)
+    LMATH_OUT affine3x4 affine_from_mat4(const mat4& M) noexcept {
+        affine3x4 A{};
+        for (int c = 0; c < 4; ++c)
+            for (int r = 0; r < 3; ++r)
+                A[c][r] = M[c][r];
+        return A;
+    }
+
+    LMATH_OUT mat4 mat4_from_affine(const affine3x4& A) noexcept {
+        mat4 M{};
+        for (int c = 0; c < 4; ++c)
+            for (int r = 0; r < 3; ++r)
+                M[c][r] = A[c][r];
+        M[3][3] = 1.f;
+        return M;
+    }
+
+    // ============================================================
+    // Compose: A * B applies B first
+    // ============================================================
+
+    /* A34*A34 scalar */LMATH_OUT affine3x4
+    affine_mul_scalar(const affine3x4& A, const affine3x4& B) noexcept {
+        affine3x4 R{};
+        for (int c = 0; c < 4; ++c) {
+            const float b0 = B[c][0];
+            const float b1 = B[c][1];
+            const float b2 = B[c][2];
+
+            R[c][0] = A[0][0] * b0 + A[1][0] * b1 + A[2][0] * b2;
+            R[c][1] = A[0][1] * b0 + A[1][1] * b1 + A[2][1] * b2;
+            R[c][2] = A[0][2] * b0 + A[1][2] * b1 + A[2][2] * b2;
+        }
+        R[3][0] += A[3][0];
+        R[3][1] += A[3][1];
+        R[3][2] += A[3][2];
+        return R;
+    }
+
+    /* A34*A34 SIMD */LMATH_NO_DISCARD inline affine3x4
+    affine_mul(const affine3x4& A, const affine3x4& B) noexcept {
+#if defined(LMATH_FORCE_NO_SIMD)
+        return affine_mul_scalar(A, B);
+#else
+        switch (simd::max_level()) {
+#if defined(__ARM_NEON)
+        case simd::Level::neon:
+            return detail::affine_mul_neon(A, B);
+#endif
+#if defined(__AVX__)
+        // one column per register; 8-wide gains nothing for a single matrix
+        case simd::Level::avx:
+        case simd::Level::avx2:
+        case simd::Level::avx512:
+            return detail::affine_mul_avx(A, B);
+#endif
+#if defined(__SSE2__)
+        case simd::Level::sse2:
+            return detail::affine_mul_sse2(A, B);
+#endif
+        default:
+            return affine_mul_scalar(A, B);
+        } // switch
+#endif // LMATH_FORCE_NO_SIMD
+    } // affine_mul
+
+    // ============================================================
+    // Transform
+    //
+    // Points get the translation, dirs do not. Same operation order as
+    // mat4_transform_points / mat4_transform_dirs, which the array versions
+    // forward to (one dispatch per call).
+    // ============================================================
+
+    LMATH_OUT vec3 affine_transform_point(const affine3x4& A, const vec3& p) noexcept {
+        vec3 R{};
+        for (int r = 0; r < 3; ++r)
+            R[r] = A[0][r] * p[0] + A[1][r] * p[1] + A[2][r] * p[2] + A[3][r];
+        return R;
+    }
+
+    LMATH_OUT vec3 affine_transform_dir(const affine3x4& A, const vec3& d) noexcept {
+        vec3 R{};
+        for (int r = 0; r < 3; ++r)
+            R[r] = A[0][r] * d[0] + A[1][r] * d[1] + A[2][r] * d[2];
+        return R;
+    }
+
+    /* A34*P3[] SIMD */inline void
+    affine_transform_points(const affine3x4& A, const vec3* in, vec3* out, std::size_t n) noexcept {
+        mat4_transform_points(mat4_from_affine(A), in, out, n);
+    }
+
+    /* A34*D3[] SIMD */inline void
+    affine_transform_dirs(const affine3x4& A, const vec3* in, vec3* out, std::size_t n) noexcept {
+        mat4_transform_dirs(mat4_from_affine(A), in, out, n);
+    }
+
+    // ============================================================
+    // Inverse
+    //
+    // affine_inverse assumes L is invertible; rigid assumes L is a pure
+    // rotation. Both equal the mat4_inverse_affine / _rigid results with
+    // the bottom row dropped.
+    // ============================================================
+
+    /* A34^-1 scalar */LMATH_OUT affine3x4
+    affine_inverse_scalar(const affine3x4& A) noexcept {
+        return affine_from_mat4(mat4_inverse_affine_scalar(mat4_from_affine(A)));
+    }
+
+    /* A34^-1 SIMD */LMATH_NO_DISCARD inline affine3x4
+    affine_inverse(const affine3x4& A) noexcept {
+#if defined(LMATH_FORCE_NO_SIMD)
+        return affine_inverse_scalar(A);
+#else
+        switch (simd::max_level()) {
+#if defined(__ARM_NEON)
+        case simd::Level::neon:
+            return detail::affine_inverse_neon(A);
+#endif
+#if defined(__AVX__)
+        case simd::Level::avx:
+        case simd::Level::avx2:
+        case simd::Level::avx512:
+            return detail::affine_inverse_avx(A);
+#endif
+#if defined(__SSE2__)
+        case simd::Level::sse2:
+            return detail::affine_inverse_sse2(A);
+#endif
+        default:
+            return affine_inverse_scalar(A);
+        } // switch
+#endif // LMATH_FORCE_NO_SIMD
+    } // affine_inverse
+
+    /* rigid A34^-1 scalar */LMATH_OUT affine3x4
+    affine_inverse_rigid_scalar(const affine3x4& A) noexcept {
+        return affine_from_mat4(mat4_inverse_rigid_scalar(mat4_from_affine(A)));
+    }
+
+    /* rigid A34^-1 SIMD */LMATH_NO_DISCARD inline affine3x4
+    affine_inverse_rigid(const affine3x4& A) noexcept {
+#if defined(LMATH_FORCE_NO_SIMD)
+        return affine_inverse_rigid_scalar(A);
+#else
+        switch (simd::max_level()) {
+#if defined(__ARM_NEON)
+        case simd::Level::neon:
+            return detail::affine_inverse_rigid_neon(A);
+#endif
+#if defined(__AVX__)
+        case simd::Level::avx:
+        case simd::Level::avx2:
+        case simd::Level::avx512:
+            return detail::affine_inverse_rigid_avx(A);
+#endif
+#if defined(__SSE2__)
+        case simd::Level::sse2:
+            return detail::affine_inverse_rigid_sse2(A);
+#endif
+        default:
+            return affine_inverse_rigid_scalar(A);
+        } // switch
+#endif // LMATH_FORCE_NO_SIMD
+    } // affine_inverse_rigid
+
+    // ============================================================
+    // overloaded operators
+    // ============================================================
+
+    LMATH_NO_DISCARD inline affine3x4 operator*(const affine3x4& A, const affine3x4& B) noexcept {
+        return affine_mul(A, B);
+    }
+
+} // namespace lm
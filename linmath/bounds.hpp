@@ -0,0 +1,454 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "detail/feature_detection.hpp"
+#include "detail/simd_integration.hpp"
+#include "detail/simd_lanes.hpp"
+
+#include "libc_integration.hpp"
+#include "vec.hpp"
+#include "mat.hpp"
+#include "soa.hpp"
+
+namespace lm {
+
+    // ============================================================
+    // Bounding volumes
+    //
+    // aabb3   : axis-aligned box [lo, hi]. A box with lo > hi on any axis
+    //           is empty; aabb_empty() is the identity of aabb_merge.
+    // sphere3 : center c, radius r >= 0.
+    //
+    // Boundaries count as inside: boxes that touch overlap, and every
+    // volume contains itself.
+    // ============================================================
+
+    struct aabb3 {
+        vec3 lo{};
+        vec3 hi{};
+    };
+
+    struct sphere3 {
+        vec3  c{};
+        float r{};
+    };
+
+    // lo = +FLT_MAX, hi = -FLT_MAX: finite, so the batch tests below never
+    // compute inf - inf
+    LMATH_OUT aabb3 aabb_empty() noexcept {
+        return { {  3.402823466e+38f,  3.402823466e+38f,  3.402823466e+38f },
+                 { -3.402823466e+38f, -3.402823466e+38f, -3.402823466e+38f } };
+    }
+
+    // ============================================================
+    // Single objects
+    // ============================================================
+
+    LMATH_OUT aabb3 aabb_merge(const aabb3& A, const aabb3& B) noexcept {
+        return { vec_min(A.lo, B.lo), vec_max(A.hi, B.hi) };
+    }
+
+    LMATH_OUT aabb3 aabb_merge(const aabb3& A, const vec3& p) noexcept {
+        return { vec_min(A.lo, p), vec_max(A.hi, p) };
+    }
+
+    LMATH_OUT vec3 aabb_center(const aabb3& A) noexcept {
+        return vec_scale(vec_add(A.lo, A.hi), 0.5f);
+    }
+
+    // half size along each axis
+    LMATH_OUT vec3 aabb_extent(const aabb3& A) noexcept {
+        return vec_scale(vec_sub(A.hi, A.lo), 0.5f);
+    }
+
+    LMATH_OUT bool aabb_overlaps(const aabb3& A, const aabb3& B) noexcept {
+        return A.lo[0] <= B.hi[0] && B.lo[0] <= A.hi[0] &&
+               A.lo[1] <= B.hi[1] && B.lo[1] <= A.hi[1] &&
+               A.lo[2] <= B.hi[2] && B.lo[2] <= A.hi[2];
+    }
+
+    // B entirely inside A
+    LMATH_OUT bool aabb_contains(const aabb3& A, const aabb3& B) noexcept {
+        return A.lo[0] <= B.lo[0] && B.hi[0] <= A.hi[0] &&
+               A.lo[1] <= B.lo[1] && B.hi[1] <= A.hi[1] &&
+               A.lo[2] <= B.lo[2] && B.hi[2] <= A.hi[2];
+    }
+
+    LMATH_OUT bool aabb_contains(const aabb3& A, const vec3& p) noexcept {
+        return A.lo[0] <= p[0] && p[0] <= A.hi[0] &&
+               A.lo[1] <= p[1] && p[1] <= A.hi[1] &&
+               A.lo[2] <= p[2] && p[2] <= A.hi[2];
+    }
+
+    LMATH_OUT aabb3 aabb_from_sphere(const sphere3& S) noexcept {
+        return { { S.c[0] - S.r, S.c[1] - S.r, S.c[2] - S.r },
+                 { S.c[0] + S.r, S.c[1] + S.r, S.c[2] + S.r } };
+    }
+
+    LMATH_OUT bool sphere_overlaps(const sphere3& A, const sphere3& B) noexcept {
+        const vec3 d = vec_sub(B.c, A.c);
+        const float r = A.r + B.r;
+        return vec_dot(d, d) <= r * r;
+    }
+
+    // B entirely inside A
+    LMATH_OUT bool sphere_contains(const sphere3& A, const sphere3& B) noexcept {
+        const vec3 d = vec_sub(B.c, A.c);
+        const float r = A.r - B.r;
+        return r >= 0.f && vec_dot(d, d) <= r * r;
+    }
+
+    LMATH_OUT bool sphere_contains(const sphere3& A, const vec3& p) noexcept {
+        const vec3 d = vec_sub(p, A.c);
+        return vec_dot(d, d) <= A.r * A.r;
+    }
+
+    // distance from the center to the closest point of the box (Arvo)
+    LMATH_OUT bool sphere_overlaps(const sphere3& S, const aabb3& B) noexcept {
+        float d2 = 0.f;
+        for (std::size_t c = 0; c < 3; ++c) {
+            const float d = S.c[c] < B.lo[c] ? B.lo[c] - S.c[c]
+                          : S.c[c] > B.hi[c] ? S.c[c] - B.hi[c] : 0.f;
+            d2 += d * d;
+        }
+        return d2 <= S.r * S.r;
+    }
+
+    // circumscribed sphere
+    LMATH_NO_DISCARD inline sphere3 sphere_from_aabb(const aabb3& A) noexcept {
+        const vec3 e = aabb_extent(A);
+        return { aabb_center(A), ::lm::sqrtf(vec_dot(e, e)) };
+    }
+
+    // smallest sphere containing both
+    LMATH_NO_DISCARD inline sphere3 sphere_merge(const sphere3& A, const sphere3& B) noexcept {
+        const vec3 d = vec_sub(B.c, A.c);
+        const float dist = ::lm::sqrtf(vec_dot(d, d));
+        if (dist + B.r <= A.r) return A;
+        if (dist + A.r <= B.r) return B;
+
+        const float r = (dist + A.r + B.r) * 0.5f;
+        return { vec_add(A.c, vec_scale(d, (r - A.r) / dist)), r };
+    }
+
+    namespace detail {
+
+        // Arvo: row r of the result starts at the translation, and column c
+        // adds the smaller / larger of M[c][r] * lo[c] and M[c][r] * hi[c].
+        // Lanes are objects here; aabb_transform_sse2/neon run the same
+        // steps with lanes as rows.
+        template<typename V>
+        LMATH_FORCE_INLINE void aabb_transform_lanes(const mat4& M,
+                                                     const typename V::reg (&lo)[3],
+                                                     const typename V::reg (&hi)[3],
+                                                     typename V::reg (&out_lo)[3],
+                                                     typename V::reg (&out_hi)[3]) noexcept {
+            for (std::size_t r = 0; r < 3; ++r) {
+                auto l = V::set1(M[3][r]);
+                auto h = l;
+                for (std::size_t c = 0; c < 3; ++c) {
+                    const auto m = V::set1(M[c][r]);
+                    const auto a = V::mul(m, lo[c]);
+                    const auto b = V::mul(m, hi[c]);
+                    l = V::add(l, V::min(a, b));
+                    h = V::add(h, V::max(a, b));
+                }
+                out_lo[r] = l;
+                out_hi[r] = h;
+            }
+        }
+
+        LMATH_FORCE_INLINE aabb3 aabb_transform_scalar(const mat4& M, const aabb3& A) noexcept {
+            float lo[3], hi[3];
+            aabb_transform_lanes<lanes_scalar>(M, A.lo.v, A.hi.v, lo, hi);
+            return { { lo[0], lo[1], lo[2] }, { hi[0], hi[1], hi[2] } };
+        }
+
+#if defined(__SSE2__)
+        LMATH_FORCE_INLINE aabb3 aabb_transform_sse2(const mat4& M, const aabb3& A) noexcept {
+            __m128 l = _mm_loadu_ps(M[3].data());
+            __m128 h = l;
+            for (std::size_t c = 0; c < 3; ++c) {
+                const __m128 m = _mm_loadu_ps(M[c].data());
+                const __m128 a = _mm_mul_ps(m, _mm_set1_ps(A.lo[c]));
+                const __m128 b = _mm_mul_ps(m, _mm_set1_ps(A.hi[c]));
+                l = _mm_add_ps(l, _mm_min_ps(a, b));
+                h = _mm_add_ps(h, _mm_max_ps(a, b));
+            }
+            float lo[4], hi[4];
+            _mm_storeu_ps(lo, l);
+            _mm_storeu_ps(hi, h);
+            return { { lo[0], lo[1], lo[2] }, { hi[0], hi[1], hi[2] } };
+        }
+#endif
+
+#if defined(__ARM_NEON)
+        LMATH_FORCE_INLINE aabb3 aabb_transform_neon(const mat4& M, const aabb3& A) noexcept {
+            float32x4_t l = vld1q_f32(M[3].data());
+            float32x4_t h = l;
+            for (std::size_t c = 0; c < 3; ++c) {
+                const float32x4_t m = vld1q_f32(M[c].data());
+                const float32x4_t a = vmulq_n_f32(m, A.lo[c]);
+                const float32x4_t b = vmulq_n_f32(m, A.hi[c]);
+                l = vaddq_f32(l, vminq_f32(a, b));
+                h = vaddq_f32(h, vmaxq_f32(a, b));
+            }
+            float lo[4], hi[4];
+            vst1q_f32(lo, l);
+            vst1q_f32(hi, h);
+            return { { lo[0], lo[1], lo[2] }, { hi[0], hi[1], hi[2] } };
+        }
+#endif
+
+        // length of the longest column of M's linear part: the radius
+        // factor of sphere_transform
+        inline float mat4_max_scale(const mat4& M) noexcept {
+            float s2 = 0.f;
+            for (std::size_t c = 0; c < 3; ++c) {
+                const float l2 = M[c][0] * M[c][0] + M[c][1] * M[c][1] + M[c][2] * M[c][2];
+                s2 = l2 > s2 ? l2 : s2;
+            }
+            return lanes_scalar::sqrt(s2);
+        }
+
+    } // namespace detail
+
+    // Tight box of the 8 transformed corners (Arvo), for affine M. An empty
+    // box does not stay empty; skip those.
+    inline aabb3 aabb_transform(const mat4& M, const aabb3& A) noexcept {
+#ifdef LMATH_FORCE_NO_SIMD
+        return detail::aabb_transform_scalar(M, A);
+#else
+        switch (simd::max_level()) {
+
+#if defined(__ARM_NEON)
+        case simd::Level::neon:
+            return detail::aabb_transform_neon(M, A);
+#endif
+
+#if defined(__SSE2__)
+        case simd::Level::sse2:
+        case simd::Level::avx:
+        case simd::Level::avx2:
+        case simd::Level::avx512:
+            return detail::aabb_transform_sse2(M, A);
+#endif
+
+        default:
+            return detail::aabb_transform_scalar(M, A);
+        } // switch
+#endif // LMATH_FORCE_NO_SIMD
+    } // aabb_transform
+
+    // Center as a point (mat4_transform_points), radius times the largest
+    // axis scale of M: exact for similarity transforms, conservative under
+    // non-uniform scale.
+    inline sphere3 sphere_transform(const mat4& M, const sphere3& S) noexcept {
+        sphere3 R;
+        mat4_transform_points_scalar(M, &S.c, &R.c, 1);
+        R.r = S.r * detail::mat4_max_scale(M);
+        return R;
+    }
+
+    // ============================================================
+    // Batches (SoA)
+    //
+    // Same streams as frustum culling: boxes as lo / hi vec3_soa, spheres
+    // as (x, y, z, radius) vec4_soa. 8 lanes on AVX/AVX2, 4 on SSE2/NEON,
+    // scalar tail. Results match the single-object functions above bit
+    // for bit.
+    //
+    // Tests write a bitmask like frustum_cull_*: bit i % 32 of
+    // mask[i / 32] is set if object i passes; (n + 31) / 32 words.
+    // ============================================================
+
+    namespace detail {
+
+        // folds load(V{}, i, lo, hi) over [0, n) into R with min / max
+        template<typename V, typename Load>
+        LMATH_FORCE_INLINE void aabb_reduce_lanes(std::size_t n, aabb3& R, Load&& load) noexcept {
+            typename V::reg l[3], h[3];
+            for (std::size_t c = 0; c < 3; ++c) {
+                l[c] = V::set1(R.lo[c]);
+                h[c] = V::set1(R.hi[c]);
+            }
+
+            const std::size_t nw = n - n % V::width;
+            for (std::size_t i = 0; i < nw; i += V::width) {
+                typename V::reg a[3], b[3];
+                load(V{}, i, a, b);
+                for (std::size_t c = 0; c < 3; ++c) {
+                    l[c] = V::min(l[c], a[c]);
+                    h[c] = V::max(h[c], b[c]);
+                }
+            }
+
+            float tl[V::width], th[V::width];
+            for (std::size_t c = 0; c < 3; ++c) {
+                V::store(tl, l[c]);
+                V::store(th, h[c]);
+                for (std::size_t j = 0; j < V::width; ++j) {
+                    R.lo[c] = tl[j] < R.lo[c] ? tl[j] : R.lo[c];
+                    R.hi[c] = th[j] > R.hi[c] ? th[j] : R.hi[c];
+                }
+            }
+
+            for (std::size_t i = nw; i < n; ++i) {
+                float a[3], b[3];
+                load(lanes_scalar{}, i, a, b);
+                R = aabb_merge(R, aabb3{ { a[0], a[1], a[2] }, { b[0], b[1], b[2] } });
+            }
+        }
+
+    } // namespace detail
+
+    // Union of boxes [lo[i], hi[i]]; n = hi.n, aabb_empty() when n == 0.
+    inline aabb3 aabb_merge_batch(const vec3_soa& lo, const vec3_soa& hi) noexcept {
+        aabb3 R = aabb_empty();
+        detail::with_lanes([&](auto L) {
+            detail::aabb_reduce_lanes<decltype(L)>(hi.n, R, [&](auto V_, std::size_t i, auto& a, auto& b) {
+                using V = decltype(V_);
+                for (std::size_t c = 0; c < 3; ++c) {
+                    a[c] = V::load(lo[c] + i);
+                    b[c] = V::load(hi[c] + i);
+                }
+            });
+        });
+        return R;
+    }
+
+    // Bounds of points; aabb_empty() when n == 0.
+    inline aabb3 aabb_from_points(const vec3_soa& P) noexcept {
+        return aabb_merge_batch(P, P);
+    }
+
+    inline aabb3 aabb_from_points(const vec3* p, std::size_t n) noexcept {
+        aabb3 R = aabb_empty();
+        detail::with_lanes([&](auto L) {
+            detail::aabb_reduce_lanes<decltype(L)>(n, R, [&](auto V_, std::size_t i, auto& a, auto& b) {
+                using V = decltype(V_);
+                vec_pack<3, V::width> P;
+                detail::soa_transpose_in(V_, p + i, vec_soa_view(P), 0);
+                for (std::size_t c = 0; c < 3; ++c)
+                    a[c] = b[c] = V::load(P.lane[c]);
+            });
+        });
+        return R;
+    }
+
+    // out[i] = aabb_transform(M, [lo[i], hi[i]]); n = out_lo.n. Outputs
+    // may alias inputs.
+    inline void aabb_transform_batch(const mat4& M, const vec3_soa& lo, const vec3_soa& hi,
+                                     const vec3_soa& out_lo, const vec3_soa& out_hi) noexcept {
+        detail::with_lanes([&](auto L) {
+            detail::for_lanes<decltype(L)>(out_lo.n, [&](auto V_, std::size_t i) {
+                using V = decltype(V_);
+                typename V::reg l[3], h[3], ol[3], oh[3];
+                for (std::size_t c = 0; c < 3; ++c) {
+                    l[c] = V::load(lo[c] + i);
+                    h[c] = V::load(hi[c] + i);
+                }
+                detail::aabb_transform_lanes<V>(M, l, h, ol, oh);
+                for (std::size_t c = 0; c < 3; ++c) {
+                    V::store(out_lo[c] + i, ol[c]);
+                    V::store(out_hi[c] + i, oh[c]);
+                }
+            });
+        });
+    }
+
+    // out[i] = sphere_transform(M, S[i]); n = out.n. `out` may alias `S`.
+    inline void sphere_transform_batch(const mat4& M, const vec4_soa& S, const vec4_soa& out) noexcept {
+        const float scale = detail::mat4_max_scale(M);
+        detail::with_lanes([&](auto L) {
+            detail::for_lanes<decltype(L)>(out.n, [&](auto V_, std::size_t i) {
+                using V = decltype(V_);
+                const auto x = V::load(S[0] + i);
+                const auto y = V::load(S[1] + i);
+                const auto z = V::load(S[2] + i);
+                const auto r = V::load(S[3] + i);
+                for (std::size_t k = 0; k < 3; ++k)
+                    V::store(out[k] + i, V::add(V::add(V::add(V::mul(V::set1(M[0][k]), x),
+                                                              V::mul(V::set1(M[1][k]), y)),
+                                                       V::mul(V::set1(M[2][k]), z)),
+                                                V::set1(M[3][k])));
+                V::store(out[3] + i, V::mul(r, V::set1(scale)));
+            });
+        });
+    }
+
+    // Bit i: aabb_overlaps(Q, box i); n = hi.n.
+    inline void aabb_overlap_batch(const aabb3& Q, const vec3_soa& lo, const vec3_soa& hi,
+                                   std::uint32_t* mask) noexcept {
+        detail::with_lanes([&](auto L) {
+            detail::for_lanes_mask<decltype(L)>(hi.n, mask, [&](auto V_, std::size_t i) {
+                using V = decltype(V_);
+                // largest gap between the boxes over all axes; a - b > 0
+                // exactly when a > b, so this agrees with the compares
+                auto gap = V::max(V::sub(V::set1(Q.lo[0]), V::load(hi[0] + i)),
+                                  V::sub(V::load(lo[0] + i), V::set1(Q.hi[0])));
+                for (std::size_t c = 1; c < 3; ++c)
+                    gap = V::max(gap, V::max(V::sub(V::set1(Q.lo[c]), V::load(hi[c] + i)),
+                                             V::sub(V::load(lo[c] + i), V::set1(Q.hi[c]))));
+                return ~V::movemask(V::cmpgt(gap, V::zero())) & detail::lanes_all_bits<V>();
+            });
+        });
+    }
+
+    // Bit i: aabb_contains(Q, box i); n = hi.n.
+    inline void aabb_contains_batch(const aabb3& Q, const vec3_soa& lo, const vec3_soa& hi,
+                                    std::uint32_t* mask) noexcept {
+        detail::with_lanes([&](auto L) {
+            detail::for_lanes_mask<decltype(L)>(hi.n, mask, [&](auto V_, std::size_t i) {
+                using V = decltype(V_);
+                auto out = V::max(V::sub(V::set1(Q.lo[0]), V::load(lo[0] + i)),
+                                  V::sub(V::load(hi[0] + i), V::set1(Q.hi[0])));
+                for (std::size_t c = 1; c < 3; ++c)
+                    out = V::max(out, V::max(V::sub(V::set1(Q.lo[c]), V::load(lo[c] + i)),
+                                             V::sub(V::load(hi[c] + i), V::set1(Q.hi[c]))));
+                return ~V::movemask(V::cmpgt(out, V::zero())) & detail::lanes_all_bits<V>();
+            });
+        });
+    }
+
+    namespace detail {
+        // |c - Q.c|^2 in vec_dot order
+        template<typename V>
+        LMATH_FORCE_INLINE typename V::reg sphere_dist2_lanes(const sphere3& Q, const vec4_soa& S,
+                                                              std::size_t i) noexcept {
+            const auto dx = V::sub(V::load(S[0] + i), V::set1(Q.c[0]));
+            const auto dy = V::sub(V::load(S[1] + i), V::set1(Q.c[1]));
+            const auto dz = V::sub(V::load(S[2] + i), V::set1(Q.c[2]));
+            return V::add(V::add(V::mul(dx, dx), V::mul(dy, dy)), V::mul(dz, dz));
+        }
+    } // namespace detail
+
+    // Bit i: sphere_overlaps(Q, sphere i); n = S.n.
+    inline void sphere_overlap_batch(const sphere3& Q, const vec4_soa& S, std::uint32_t* mask) noexcept {
+        detail::with_lanes([&](auto L) {
+            detail::for_lanes_mask<decltype(L)>(S.n, mask, [&](auto V_, std::size_t i) {
+                using V = decltype(V_);
+                const auto r = V::add(V::set1(Q.r), V::load(S[3] + i));
+                const auto d2 = detail::sphere_dist2_lanes<V>(Q, S, i);
+                return ~V::movemask(V::cmpgt(d2, V::mul(r, r))) & detail::lanes_all_bits<V>();
+            });
+        });
+    }
+
+    // Bit i: sphere_contains(Q, sphere i); n = S.n.
+    inline void sphere_contains_batch(const sphere3& Q, const vec4_soa& S, std::uint32_t* mask) noexcept {
+        detail::with_lanes([&](auto L) {
+            detail::for_lanes_mask<decltype(L)>(S.n, mask, [&](auto V_, std::size_t i) {
+                using V = decltype(V_);
+                const auto r = V::sub(V::set1(Q.r), V::load(S[3] + i));
+                const auto d2 = detail::sphere_dist2_lanes<V>(Q, S, i);
+                const int fail = V::movemask(V::cmplt(r, V::zero())) |
+                                 V::movemask(V::cmpgt(d2, V::mul(r, r)));
+                return ~fail & detail::lanes_all_bits<V>();
+            });
+        });
+    }
+
+} // namespace lm
@@ -0,0 +1,605 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "detail/feature_detection.hpp"
+#include "detail/simd_lanes.hpp"
+
+#include "vec.hpp"
+#include "bounds.hpp"
+#include "ray.hpp"
+#include "par.hpp"
+#include "worker_pool.hpp"
+
+namespace lm {
+
+    // ============================================================
+    // Bounding volume hierarchy
+    //
+    // Non-owning view of a binary BVH over n boxes, in two caller-owned
+    // arrays filled by bvh_build():
+    //
+    //   nodes[]  32-byte nodes, root at 0. count == 0 marks an inner node
+    //            whose children are nodes[first] and nodes[first + 1];
+    //            otherwise the node is a leaf over prims[first .. first + count).
+    //   prims[]  permutation of [0, n): the input index of each leaf entry.
+    //
+    // Splits use the surface area heuristic over bvh_bins centroid bins
+    // per axis. Leaves hold at most bvh_max_leaf prims, except below
+    // depth bvh_max_depth, where whatever is left becomes one leaf.
+    //
+    // bvh_collapse() turns the binary tree into a wide one (bvh4, bvh8)
+    // whose nodes store W child boxes as SoA rows, so one ray or box is
+    // tested against all children with one SIMD compare.
+    //
+    // Triangle meshes are triangle soups here: prim i is the triangle
+    // tris[3i], tris[3i + 1], tris[3i + 2]; bvh_triangle_bounds() gives
+    // the boxes to build from.
+    // ============================================================
+
+    LMATH_CONSTEXPR_VAR std::uint32_t bvh_none = 0xffffffffu;
+    LMATH_CONSTEXPR_VAR std::size_t   bvh_bins = 16;
+    LMATH_CONSTEXPR_VAR std::size_t   bvh_max_leaf = 8;
+    LMATH_CONSTEXPR_VAR std::size_t   bvh_max_depth = 64;
+
+    // Two nodes per cache line when nodes[] is 64-byte aligned. The type
+    // itself is not over-aligned, so std::vector<bvh_node> works in C++14.
+    struct bvh_node {
+        vec3          lo;
+        std::uint32_t first;
+        vec3          hi;
+        std::uint32_t count;
+    };
+    static_assert(sizeof(bvh_node) == 32, "bvh_node must stay half a cache line");
+
+    struct bvh {
+        const bvh_node*      nodes{};
+        const std::uint32_t* prims{};
+        std::size_t          node_count{};
+    };
+
+    // nodes[] entries bvh_build() may need for n prims
+    LMATH_OUT std::size_t bvh_node_capacity(std::size_t n) noexcept {
+        return 2 * n + 1024;
+    }
+
+    inline void bvh_triangle_bounds(const vec3* tris, std::size_t n, aabb3* out) noexcept {
+        for (std::size_t i = 0; i < n; ++i) {
+            const vec3* v = tris + 3 * i;
+            out[i] = aabb_merge(aabb3{ vec_min(v[0], v[1]), vec_max(v[0], v[1]) }, v[2]);
+        }
+    }
+
+    namespace detail {
+
+        // half the surface area; SAH only compares ratios
+        LMATH_OUT float bvh_half_area(const vec3& lo, const vec3& hi) noexcept {
+            const vec3 e = vec_sub(hi, lo);
+            return e[0] * e[1] + e[1] * e[2] + e[2] * e[0];
+        }
+
+        // Box of prims[b, e) into N, and the box of their centroids
+        // (doubled: lo + hi, which bins the same).
+        inline void bvh_range_bounds(const aabb3* boxes, const std::uint32_t* prims,
+                                     std::size_t b, std::size_t e,
+                                     bvh_node& N, aabb3& cent) noexcept {
+            aabb3 box = aabb_empty();
+            cent = aabb_empty();
+            for (std::size_t i = b; i < e; ++i) {
+                const aabb3& B = boxes[prims[i]];
+                box = aabb_merge(box, B);
+                cent = aabb_merge(cent, vec_add(B.lo, B.hi));
+            }
+            N.lo = box.lo;
+            N.hi = box.hi;
+        }
+
+        LMATH_OUT std::size_t bvh_bin_of(float c, float lo, float scale) noexcept {
+            const std::size_t k = std::size_t((c - lo) * scale);
+            return k < bvh_bins ? k : bvh_bins - 1;
+        }
+
+        // Split point of prims[b, e) (reordered so [b, mid) goes left), or
+        // e to make N a leaf. N holds the range's box.
+        inline std::size_t bvh_split(const aabb3* boxes, std::uint32_t* prims,
+                                     std::size_t b, std::size_t e,
+                                     const bvh_node& N, const aabb3& cent) noexcept {
+            const std::size_t m = e - b;
+
+            struct bin {
+                aabb3       box;
+                std::size_t count;
+            };
+            float best_cost = 3.402823466e+38f;
+            std::size_t best_axis = 3, best_bin = 0;
+            for (std::size_t a = 0; a < 3; ++a) {
+                const float extent = cent.hi[a] - cent.lo[a];
+                if (!(extent > 0.f))
+                    continue;
+                const float scale = float(bvh_bins) / extent;
+
+                bin bins[bvh_bins];
+                for (std::size_t k = 0; k < bvh_bins; ++k)
+                    bins[k] = { aabb_empty(), 0 };
+                for (std::size_t i = b; i < e; ++i) {
+                    const aabb3& B = boxes[prims[i]];
+                    bin& K = bins[bvh_bin_of(B.lo[a] + B.hi[a], cent.lo[a], scale)];
+                    K.box = aabb_merge(K.box, B);
+                    ++K.count;
+                }
+
+                // right-to-left sweep, then left-to-right; split s sends
+                // bins [0, s) left
+                float right_area[bvh_bins];
+                aabb3 acc = aabb_empty();
+                for (std::size_t k = bvh_bins - 1; k > 0; --k) {
+                    acc = aabb_merge(acc, bins[k].box);
+                    right_area[k] = bvh_half_area(acc.lo, acc.hi);
+                }
+                acc = aabb_empty();
+                std::size_t left = 0;
+                for (std::size_t s = 1; s < bvh_bins; ++s) {
+                    acc = aabb_merge(acc, bins[s - 1].box);
+                    left += bins[s - 1].count;
+                    if (left == 0 || left == m)
+                        continue;
+                    const float cost = bvh_half_area(acc.lo, acc.hi) * float(left) +
+                                       right_area[s] * float(m - left);
+                    if (cost < best_cost) {
+                        best_cost = cost;
+                        best_axis = a;
+                        best_bin = s;
+                    }
+                }
+            }
+
+            if (best_axis == 3)
+                // all centroids coincide: no bin split exists
+                return m <= bvh_max_leaf ? e : b + m / 2;
+
+            // leaf cost m * area vs. one traversal step plus both children
+            const float area = bvh_half_area(N.lo, N.hi);
+            if (m <= bvh_max_leaf && float(m) * area <= area + best_cost)
+                return e;
+
+            const std::size_t a = best_axis;
+            const float scale = float(bvh_bins) / (cent.hi[a] - cent.lo[a]);
+            std::size_t i = b, j = e;
+            while (i < j) {
+                const aabb3& B = boxes[prims[i]];
+                if (bvh_bin_of(B.lo[a] + B.hi[a], cent.lo[a], scale) < best_bin) {
+                    ++i;
+                } else {
+                    --j;
+                    const std::uint32_t p = prims[i];
+                    prims[i] = prims[j];
+                    prims[j] = p;
+                }
+            }
+            return i;
+        }
+
+        struct bvh_task {
+            std::uint32_t node;
+            std::uint32_t depth;
+            std::size_t   b, e;
+        };
+
+        // Builds the subtree of job root `root` over prims[J.b, J.e),
+        // allocating its descendants from nodes[next]. Returns the number
+        // of nodes allocated.
+        inline std::size_t bvh_build_subtree(const aabb3* boxes, bvh_node* nodes,
+                                             std::uint32_t* prims, const bvh_task& J,
+                                             std::size_t next) noexcept {
+            const std::size_t start = next;
+            bvh_task stack[bvh_max_depth + 2];
+            std::size_t sp = 0;
+            stack[sp++] = J;
+            while (sp) {
+                const bvh_task T = stack[--sp];
+                bvh_node& N = nodes[T.node];
+                aabb3 cent;
+                bvh_range_bounds(boxes, prims, T.b, T.e, N, cent);
+                const std::size_t mid = T.depth < bvh_max_depth
+                                      ? bvh_split(boxes, prims, T.b, T.e, N, cent) : T.e;
+                if (mid == T.e) {
+                    N.first = std::uint32_t(T.b);
+                    N.count = std::uint32_t(T.e - T.b);
+                    continue;
+                }
+                N.first = std::uint32_t(next);
+                N.count = 0;
+                stack[sp++] = { std::uint32_t(next + 1), T.depth + 1, mid, T.e };
+                stack[sp++] = { std::uint32_t(next), T.depth + 1, T.b, mid };
+                next += 2;
+            }
+            return next - start;
+        }
+
+        LMATH_CONSTEXPR_VAR std::size_t bvh_max_jobs = 512;
+
+    } // namespace detail
+
+    // Builds a BVH over boxes[0, n) into nodes[0, bvh_node_capacity(n))
+    // and prims[0, n); returns the node count (0 for n = 0).
+    //
+    // The top of the tree is split on the calling thread until it falls
+    // apart into at most 512 subtrees of a few thousand prims or more;
+    // those are built as independent jobs on `pool`, each into its own
+    // slice of nodes[], and then packed behind the top levels. The tree
+    // is the same, node for node, on any pool.
+    inline std::size_t bvh_build(const aabb3* boxes, std::size_t n, bvh_node* nodes,
+                                 std::uint32_t* prims, worker_pool pool = serial_pool()) noexcept {
+        using detail::bvh_task;
+        if (n == 0)
+            return 0;
+        for (std::size_t i = 0; i < n; ++i)
+            prims[i] = std::uint32_t(i);
+
+        const std::size_t max_jobs = detail::bvh_max_jobs;
+        std::size_t grain = (n + 255) / 256;
+        if (grain < 4096)
+            grain = 4096;
+
+        // top levels, depth first, left child first: jobs come out in
+        // prim order. A node is split only while every pending node could
+        // still become a job.
+        bvh_task jobs[max_jobs];
+        bvh_task stack[max_jobs];
+        std::size_t job_count = 0, sp = 0;
+        std::size_t top = 1;
+        stack[sp++] = { 0, 0, 0, n };
+        while (sp) {
+            const bvh_task T = stack[--sp];
+            if (T.e - T.b <= grain || T.depth >= bvh_max_depth ||
+                job_count + sp + 2 > max_jobs) {
+                jobs[job_count++] = T;
+                continue;
+            }
+            bvh_node& N = nodes[T.node];
+            aabb3 cent;
+            detail::bvh_range_bounds(boxes, prims, T.b, T.e, N, cent);
+            const std::size_t mid = detail::bvh_split(boxes, prims, T.b, T.e, N, cent);
+            if (mid == T.e) {
+                // only reachable for tiny grains; kept for safety
+                jobs[job_count++] = T;
+                continue;
+            }
+            N.first = std::uint32_t(top);
+            N.count = 0;
+            stack[sp++] = { std::uint32_t(top + 1), T.depth + 1, mid, T.e };
+            stack[sp++] = { std::uint32_t(top), T.depth + 1, T.b, mid };
+            top += 2;
+        }
+
+        // job j fills nodes[top + 2 b_j ...): a subtree over m prims has at
+        // most 2 (m - 1) nodes below its root
+        std::size_t used[max_jobs];
+        par::parallel_for(pool, job_count, 1, [&](std::size_t b, std::size_t e) {
+            for (std::size_t j = b; j < e; ++j)
+                used[j] = detail::bvh_build_subtree(boxes, nodes, prims, jobs[j],
+                                                    top + 2 * jobs[j].b);
+        });
+
+        // pack the slices behind the top levels, in order
+        std::size_t count = top;
+        for (std::size_t j = 0; j < job_count; ++j) {
+            const std::size_t from = top + 2 * jobs[j].b;
+            const std::uint32_t delta = std::uint32_t(from - count);
+            bvh_node& root = nodes[jobs[j].node];
+            if (root.count == 0)
+                root.first -= delta;
+            for (std::size_t k = 0; k < used[j]; ++k) {
+                bvh_node N = nodes[from + k];
+                if (N.count == 0)
+                    N.first -= delta;
+                nodes[count + k] = N;
+            }
+            count += used[j];
+        }
+        return count;
+    } // bvh_build
+
+    // ============================================================
+    // Wide BVH
+    //
+    // Node with up to W children as SoA rows. child[i] is a node index
+    // when count[i] == 0 and the first prim of a leaf otherwise; unused
+    // slots come last, with child = bvh_none and an empty box at +FLT_MAX.
+    // 128 bytes for W = 4, 256 for W = 8; rows are read with unaligned
+    // loads, so like bvh_node the type is not over-aligned.
+    // ============================================================
+
+    template<std::size_t W>
+    struct bvh_wide_node {
+        float         lo[3][W];
+        float         hi[3][W];
+        std::uint32_t child[W];
+        std::uint32_t count[W];
+    };
+
+    template<std::size_t W>
+    struct bvh_wide {
+        const bvh_wide_node<W>* nodes{};
+        const std::uint32_t*    prims{};
+        std::size_t             node_count{};
+    };
+
+    using bvh4 = bvh_wide<4>;
+    using bvh8 = bvh_wide<8>;
+
+    // Collapses T into W-wide nodes, out[0] the root: each wide node
+    // takes a binary node's children and keeps opening the inner child
+    // with the largest area until W slots are used. prims[] is shared
+    // with T. out holds up to T.node_count / 2 + 1 nodes; returns the
+    // count used.
+    template<std::size_t W>
+    inline std::size_t bvh_collapse(const bvh& T, bvh_wide_node<W>* out) noexcept {
+        static_assert(W == 4 || W == 8, "wide BVHs are 4 or 8 wide");
+        if (T.node_count == 0)
+            return 0;
+
+        struct entry {
+            std::uint32_t wide, node;
+        };
+        entry stack[(W - 1) * bvh_max_depth + W];
+        std::size_t sp = 0, count = 1;
+        stack[sp++] = { 0, 0 };
+        while (sp) {
+            const entry E = stack[--sp];
+            std::uint32_t slot[W];
+            std::size_t used = 1;
+            slot[0] = E.node;
+            while (used < W) {
+                std::size_t pick = W;
+                float pick_area = -1.f;
+                for (std::size_t i = 0; i < used; ++i) {
+                    const bvh_node& C = T.nodes[slot[i]];
+                    const float area = detail::bvh_half_area(C.lo, C.hi);
+                    if (C.count == 0 && area > pick_area) {
+                        pick = i;
+                        pick_area = area;
+                    }
+                }
+                if (pick == W)
+                    break;
+                const std::uint32_t first = T.nodes[slot[pick]].first;
+                slot[pick] = first;
+                slot[used++] = first + 1;
+            }
+
+            bvh_wide_node<W>& O = out[E.wide];
+            for (std::size_t i = 0; i < W; ++i) {
+                if (i >= used) {
+                    for (std::size_t k = 0; k < 3; ++k)
+                        O.lo[k][i] = O.hi[k][i] = 3.402823466e+38f;
+                    O.child[i] = bvh_none;
+                    O.count[i] = 0;
+                    continue;
+                }
+                const bvh_node& C = T.nodes[slot[i]];
+                for (std::size_t k = 0; k < 3; ++k) {
+                    O.lo[k][i] = C.lo[k];
+                    O.hi[k][i] = C.hi[k];
+                }
+                O.count[i] = C.count;
+                if (C.count) {
+                    O.child[i] = C.first;
+                } else {
+                    O.child[i] = std::uint32_t(count);
+                    stack[sp++] = { std::uint32_t(count++), slot[i] };
+                }
+            }
+        }
+        return count;
+    }
+
+    // ============================================================
+    // Queries
+    //
+    // bvh_intersect: nearest triangle closer than t, for a BVH built
+    //   over bvh_triangle_bounds(tris). Returns its prim index and lowers
+    //   t to the hit distance, or returns bvh_none and leaves t alone.
+    //   Children are visited near first and skipped once t is closer
+    //   than their entry distance; triangles use ray_triangle, so hits
+    //   match a brute-force loop bit for bit.
+    // bvh_overlap: prims whose box overlaps Q. Writes the first `cap`
+    //   indices to out and returns how many there are in total.
+    // ============================================================
+
+    inline std::uint32_t bvh_intersect(const bvh& T, const vec3* tris, const ray3& R,
+                                       float& t) noexcept {
+        if (T.node_count == 0)
+            return bvh_none;
+        struct entry {
+            std::uint32_t node;
+            float         t_near;
+        };
+        const vec3 inv = detail::ray_inv_dir(R.d);
+        std::uint32_t hit = bvh_none;
+        entry stack[bvh_max_depth + 2];
+        std::size_t sp = 0;
+        float tn;
+        {
+            const bvh_node& N = T.nodes[0];
+            if (detail::ray_aabb_inv(R.o, inv, aabb3{ N.lo, N.hi }, t, tn))
+                stack[sp++] = { 0, tn };
+        }
+        while (sp) {
+            const entry E = stack[--sp];
+            if (E.t_near > t)
+                continue;
+            const bvh_node& N = T.nodes[E.node];
+            if (N.count) {
+                for (std::uint32_t i = N.first; i < N.first + N.count; ++i) {
+                    const std::uint32_t p = T.prims[i];
+                    if (ray_triangle(R, tris[3 * p], tris[3 * p + 1], tris[3 * p + 2], t))
+                        hit = p;
+                }
+                continue;
+            }
+            const bvh_node& A = T.nodes[N.first];
+            const bvh_node& B = T.nodes[N.first + 1];
+            float ta, tb;
+            const bool ha = detail::ray_aabb_inv(R.o, inv, aabb3{ A.lo, A.hi }, t, ta);
+            const bool hb = detail::ray_aabb_inv(R.o, inv, aabb3{ B.lo, B.hi }, t, tb);
+            if (ha && hb) {
+                // far child below the near one
+                if (ta <= tb) {
+                    stack[sp++] = { N.first + 1, tb };
+                    stack[sp++] = { N.first, ta };
+                } else {
+                    stack[sp++] = { N.first, ta };
+                    stack[sp++] = { N.first + 1, tb };
+                }
+            } else if (ha) {
+                stack[sp++] = { N.first, ta };
+            } else if (hb) {
+                stack[sp++] = { N.first + 1, tb };
+            }
+        }
+        return hit;
+    }
+
+    template<std::size_t W>
+    inline std::uint32_t bvh_intersect(const bvh_wide<W>& T, const vec3* tris, const ray3& R,
+                                       float& t) noexcept {
+        if (T.node_count == 0)
+            return bvh_none;
+        struct entry {
+            std::uint32_t node;
+            std::uint32_t count;
+            float         t_near;
+        };
+        const vec3 inv = detail::ray_inv_dir(R.d);
+        std::uint32_t hit = bvh_none;
+        entry stack[(W - 1) * bvh_max_depth + W];
+        std::size_t sp = 0;
+        stack[sp++] = { 0, 0, 0.f };
+        while (sp) {
+            const entry E = stack[--sp];
+            if (E.t_near > t)
+                continue;
+            if (E.count) {
+                for (std::uint32_t i = E.node; i < E.node + E.count; ++i) {
+                    const std::uint32_t p = T.prims[i];
+                    if (ray_triangle(R, tris[3 * p], tris[3 * p + 1], tris[3 * p + 2], t))
+                        hit = p;
+                }
+                continue;
+            }
+
+            // slab test against all W children, as in ray_aabb_packet
+            const bvh_wide_node<W>& N = T.nodes[E.node];
+            alignas(32) float t_near[W];
+            int mask = detail::packet_lanes<W>([&](auto V_, std::size_t i) {
+                using V = decltype(V_);
+                using reg = typename V::reg;
+                reg lo = V::zero();
+                reg hi = V::set1(t);
+                for (std::size_t k = 0; k < 3; ++k) {
+                    const reg o = V::set1(R.o[k]);
+                    const reg iv = V::set1(inv[k]);
+                    const reg t1 = V::mul(V::sub(V::load(N.lo[k] + i), o), iv);
+                    const reg t2 = V::mul(V::sub(V::load(N.hi[k] + i), o), iv);
+                    lo = V::max(V::min(t1, t2), lo);
+                    hi = V::min(V::max(t1, t2), hi);
+                }
+                V::store(t_near + i, lo);
+                return V::movemask(V::cmple(lo, hi));
+            });
+
+            // push hits far to near; insertion keeps the top of the stack
+            // sorted for the few entries one node adds
+            const std::size_t base = sp;
+            for (std::size_t i = 0; i < W; ++i) {
+                if (!(mask >> i & 1) || N.child[i] == bvh_none)
+                    continue;
+                std::size_t k = sp++;
+                while (k > base && stack[k - 1].t_near < t_near[i]) {
+                    stack[k] = stack[k - 1];
+                    --k;
+                }
+                stack[k] = { N.child[i], N.count[i], t_near[i] };
+            }
+        }
+        return hit;
+    }
+
+    inline std::size_t bvh_overlap(const bvh& T, const aabb3* boxes, const aabb3& Q,
+                                   std::uint32_t* out, std::size_t cap) noexcept {
+        if (T.node_count == 0)
+            return 0;
+        std::size_t found = 0;
+        std::uint32_t stack[bvh_max_depth + 2];
+        std::size_t sp = 0;
+        stack[sp++] = 0;
+        while (sp) {
+            const bvh_node& N = T.nodes[stack[--sp]];
+            if (!aabb_overlaps(Q, aabb3{ N.lo, N.hi }))
+                continue;
+            if (N.count) {
+                for (std::uint32_t i = N.first; i < N.first + N.count; ++i) {
+                    const std::uint32_t p = T.prims[i];
+                    if (aabb_overlaps(Q, boxes[p])) {
+                        if (found < cap)
+                            out[found] = p;
+                        ++found;
+                    }
+                }
+                continue;
+            }
+            stack[sp++] = N.first + 1;
+            stack[sp++] = N.first;
+        }
+        return found;
+    }
+
+    template<std::size_t W>
+    inline std::size_t bvh_overlap(const bvh_wide<W>& T, const aabb3* boxes, const aabb3& Q,
+                                   std::uint32_t* out, std::size_t cap) noexcept {
+        if (T.node_count == 0)
+            return 0;
+        struct entry {
+            std::uint32_t node;
+            std::uint32_t count;
+        };
+        std::size_t found = 0;
+        entry stack[(W - 1) * bvh_max_depth + W];
+        std::size_t sp = 0;
+        stack[sp++] = { 0, 0 };
+        while (sp) {
+            const entry E = stack[--sp];
+            if (E.count) {
+                for (std::uint32_t i = E.node; i < E.node + E.count; ++i) {
+                    const std::uint32_t p = T.prims[i];
+                    if (aabb_overlaps(Q, boxes[p])) {
+                        if (found < cap)
+                            out[found] = p;
+                        ++found;
+                    }
+                }
+                continue;
+            }
+
+            const bvh_wide_node<W>& N = T.nodes[E.node];
+            const int mask = detail::packet_lanes<W>([&](auto V_, std::size_t i) {
+                using V = decltype(V_);
+                auto m = V::cmple(V::load(N.lo[0] + i), V::set1(Q.hi[0]));
+                for (std::size_t k = 0; k < 3; ++k) {
+                    if (k)
+                        m = V::mask_and(m, V::cmple(V::load(N.lo[k] + i), V::set1(Q.hi[k])));
+                    m = V::mask_and(m, V::cmple(V::set1(Q.lo[k]), V::load(N.hi[k] + i)));
+                }
+                return V::movemask(m);
+            });
+            // reversed, so children are visited in slot order
+            for (std::size_t i = W; i-- > 0;)
+                if ((mask >> i & 1) && N.child[i] != bvh_none)
+                    stack[sp++] = { N.child[i], N.count[i] };
+        }
+        return found;
+    }
+
+} // namespace lm
@@ -15,6 +15,8 @@
 #   define LMATH_HAS_SSE2 0
 #   define LMATH_HAS_AVX  0
 #   define LMATH_HAS_AVX2 0
+#   define LMATH_HAS_AVX512 0
+#   define LMATH_HAS_FMA  0
 #   define LMATH_HAS_NEON 0
 #else
 #   if defined(__x86_64__) || defined(_M_X64)
@@ -37,6 +39,18 @@
 #       define LMATH_HAS_AVX2 0
 #   endif
 
+#   if defined(__AVX512F__) && defined(__AVX512VL__)
+#       define LMATH_HAS_AVX512 1
+#   else
+#       define LMATH_HAS_AVX512 0
+#   endif
+
+#   if defined(__FMA__) || (defined(__ARM_NEON) && defined(__ARM_FEATURE_FMA))
+#       define LMATH_HAS_FMA 1
+#   else
+#       define LMATH_HAS_FMA 0
+#   endif
+
 #   if defined(__ARM_NEON) || defined(__aarch64__)
 #       define LMATH_HAS_NEON 1
 #   else
@@ -54,6 +68,7 @@ namespace simd {
         sse2,
         avx,
         avx2,
+        avx512, // AVX-512 F + VL
     };
 
     const char* level_string(Level lvl) noexcept {
@@ -62,6 +77,7 @@ namespace simd {
         case Level::sse2: return "SSE2";
         case Level::avx:  return "AVX";
         case Level::avx2: return "AVX2";
+        case Level::avx512: return "AVX-512";
         case Level::neon: return "NEON";
         default: return "*none*";
         }
@@ -130,6 +146,14 @@ namespace simd {
             if (ymm_enabled) {
 #if LMATH_HAS_AVX2
                 cpuid(7, 0, eax, ebx, ecx, edx);
+#if LMATH_HAS_AVX512
+                // F (bit 16) + VL (bit 31); XCR0 must also enable the
+                // opmask and both ZMM state components
+                const bool zmm_enabled = (xcr0 & 0xE6) == 0xE6;
+                if (zmm_enabled && (ebx & (1u << 5)) &&
+                    (ebx & (1u << 16)) && (ebx & (1u << 31)))
+                    return Level::avx512;
+#endif
                 if (ebx & (1u << 5))
                     return Level::avx2;
 #endif
@@ -160,6 +184,31 @@ namespace simd {
         return lvl;
     }
 
+    // FMA3 on x86 (needs the OS to save YMM state), vfmaq_f32 on ARM.
+    // Only consulted when LMATH_USE_FMA is defined; see README.
+    static inline bool runtime_fma() noexcept {
+#if !LMATH_HAS_FMA
+        return false;
+#elif defined(__ARM_NEON)
+        return true;
+#else
+        uint32_t eax = 0, ebx = 0, ecx = 0, edx = 0;
+        cpuid(1, 0, eax, ebx, ecx, edx);
+
+        const bool hw_fma  = (ecx & (1u << 12)) != 0;
+        const bool hw_avx  = (ecx & (1u << 28)) != 0;
+        const bool osxsave = (ecx & (1u << 27)) != 0;
+        if (!(hw_fma && hw_avx && osxsave))
+            return false;
+        return (xgetbv(0) & 0x6) == 0x6;
+#endif
+    } // runtime_fma
+
+    inline bool has_fma() noexcept {
+        static bool fma = runtime_fma();
+        return fma;
+    }
+
 } // namespace simd
 } // namespace lm
 #endif // LMATH_FORCE_NO_SIMD
\ No newline at end of file
@@ -0,0 +1,380 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "feature_detection.hpp"
+#include "simd_integration.hpp"
+#include "../libc_integration.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386) || defined(_M_IX86)
+#   include <xmmintrin.h>
+#   include <immintrin.h>
+#elif defined(__ARM_NEON)
+#   include <arm_neon.h>
+#endif
+
+// ----------------------------------------------------------------------------
+// Lane traits for array kernels.
+//
+// A batch kernel is written once as a template over `L` and runs `L::width`
+// elements per step; the scalar lane (width 1) handles tails and the no-SIMD
+// build. `with_lanes()` picks the widest lane type for simd::max_level().
+//
+// Masks are whatever the ISA compares into (all-ones per true lane).
+// Compares are ordered: any NaN operand gives false.
+// ----------------------------------------------------------------------------
+
+namespace lm {
+namespace detail {
+
+    struct lanes_scalar {
+        using reg  = float;
+        using mask = bool;
+        static constexpr std::size_t width = 1;
+
+        static LMATH_FORCE_INLINE reg  load(const float* p) noexcept { return *p; }
+        static LMATH_FORCE_INLINE void store(float* p, reg v) noexcept { *p = v; }
+        static LMATH_FORCE_INLINE reg  set1(float s) noexcept { return s; }
+        static LMATH_FORCE_INLINE reg  zero() noexcept { return 0.f; }
+
+        static LMATH_FORCE_INLINE reg add(reg a, reg b) noexcept { return a + b; }
+        static LMATH_FORCE_INLINE reg sub(reg a, reg b) noexcept { return a - b; }
+        static LMATH_FORCE_INLINE reg mul(reg a, reg b) noexcept { return a * b; }
+        static LMATH_FORCE_INLINE reg div(reg a, reg b) noexcept { return a / b; }
+        static LMATH_FORCE_INLINE reg min(reg a, reg b) noexcept { return a < b ? a : b; }
+        static LMATH_FORCE_INLINE reg max(reg a, reg b) noexcept { return a > b ? a : b; }
+
+        // estimate + one Newton step, undefined for x <= 0 (mask it out)
+        static LMATH_FORCE_INLINE reg rsqrt(reg x) noexcept { return ::lm::rsqrtf(x); }
+        // no raw estimate without SIMD: same as rsqrt
+        static LMATH_FORCE_INLINE reg rsqrt_est(reg x) noexcept { return ::lm::rsqrtf(x); }
+        // IEEE sqrt
+        static LMATH_FORCE_INLINE reg sqrt(reg x) noexcept {
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+            return _mm_cvtss_f32(_mm_sqrt_ss(_mm_set_ss(x)));
+#elif defined(__GNUC__) || defined(__clang__)
+            return __builtin_sqrtf(x);
+#else
+            return ::lm::sqrtf(x); // no IEEE sqrt without libm here
+#endif
+        }
+
+        // nearest integer (ties to even, as every vector lane); |x| >= 2^23
+        // returned as is
+        static LMATH_FORCE_INLINE reg round(reg x) noexcept { return ::lm::roundevenf(x); }
+
+        static LMATH_FORCE_INLINE mask cmpgt(reg a, reg b) noexcept { return a > b; }
+        static LMATH_FORCE_INLINE mask cmplt(reg a, reg b) noexcept { return a < b; }
+        static LMATH_FORCE_INLINE mask cmpge(reg a, reg b) noexcept { return a >= b; }
+        static LMATH_FORCE_INLINE mask cmple(reg a, reg b) noexcept { return a <= b; }
+        static LMATH_FORCE_INLINE mask mask_and(mask a, mask b) noexcept { return a && b; }
+        static LMATH_FORCE_INLINE reg  select(mask m, reg a, reg b) noexcept { return m ? a : b; }
+        static LMATH_FORCE_INLINE int  movemask(mask m) noexcept { return m ? 1 : 0; }
+    };
+
+#if defined(__SSE2__)
+    struct lanes_sse2 {
+        using reg  = __m128;
+        using mask = __m128;
+        static constexpr std::size_t width = 4;
+
+        static LMATH_FORCE_INLINE reg  load(const float* p) noexcept { return _mm_loadu_ps(p); }
+        static LMATH_FORCE_INLINE void store(float* p, reg v) noexcept { _mm_storeu_ps(p, v); }
+        static LMATH_FORCE_INLINE reg  set1(float s) noexcept { return _mm_set1_ps(s); }
+        static LMATH_FORCE_INLINE reg  zero() noexcept { return _mm_setzero_ps(); }
+
+        static LMATH_FORCE_INLINE reg add(reg a, reg b) noexcept { return _mm_add_ps(a, b); }
+        static LMATH_FORCE_INLINE reg sub(reg a, reg b) noexcept { return _mm_sub_ps(a, b); }
+        static LMATH_FORCE_INLINE reg mul(reg a, reg b) noexcept { return _mm_mul_ps(a, b); }
+        static LMATH_FORCE_INLINE reg div(reg a, reg b) noexcept { return _mm_div_ps(a, b); }
+        static LMATH_FORCE_INLINE reg min(reg a, reg b) noexcept { return _mm_min_ps(a, b); }
+        static LMATH_FORCE_INLINE reg max(reg a, reg b) noexcept { return _mm_max_ps(a, b); }
+
+        // same refinement as lm::rsqrtf: y * (1.5 - 0.5 * x * y*y)
+        static LMATH_FORCE_INLINE reg rsqrt(reg x) noexcept {
+            const reg y = _mm_rsqrt_ps(x);
+            const reg xy2 = _mm_mul_ps(x, _mm_mul_ps(y, y));
+            return _mm_mul_ps(y, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(_mm_set1_ps(0.5f), xy2)));
+        }
+
+        static LMATH_FORCE_INLINE reg rsqrt_est(reg x) noexcept { return _mm_rsqrt_ps(x); }
+        static LMATH_FORCE_INLINE reg sqrt(reg x) noexcept { return _mm_sqrt_ps(x); }
+
+        // nearest integer (ties to even); |x| >= 2^23 is already integral
+        // and returned as is
+        static LMATH_FORCE_INLINE reg round(reg x) noexcept {
+            const __m128 r = _mm_cvtepi32_ps(_mm_cvtps_epi32(x));
+            const __m128 a = _mm_andnot_ps(_mm_set1_ps(-0.f), x);
+            const __m128 m = _mm_cmplt_ps(a, _mm_set1_ps(8388608.f));
+            return _mm_or_ps(_mm_and_ps(m, r), _mm_andnot_ps(m, x));
+        }
+
+        static LMATH_FORCE_INLINE mask cmpgt(reg a, reg b) noexcept { return _mm_cmpgt_ps(a, b); }
+        static LMATH_FORCE_INLINE mask cmplt(reg a, reg b) noexcept { return _mm_cmplt_ps(a, b); }
+        static LMATH_FORCE_INLINE mask cmpge(reg a, reg b) noexcept { return _mm_cmpge_ps(a, b); }
+        static LMATH_FORCE_INLINE mask cmple(reg a, reg b) noexcept { return _mm_cmple_ps(a, b); }
+        static LMATH_FORCE_INLINE mask mask_and(mask a, mask b) noexcept { return _mm_and_ps(a, b); }
+        static LMATH_FORCE_INLINE reg  select(mask m, reg a, reg b) noexcept {
+            return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b));
+        }
+        static LMATH_FORCE_INLINE int movemask(mask m) noexcept { return _mm_movemask_ps(m); }
+    };
+#endif
+
+#if defined(__AVX__)
+    struct lanes_avx {
+        using reg  = __m256;
+        using mask = __m256;
+        static constexpr std::size_t width = 8;
+
+        static LMATH_FORCE_INLINE reg  load(const float* p) noexcept { return _mm256_loadu_ps(p); }
+        static LMATH_FORCE_INLINE void store(float* p, reg v) noexcept { _mm256_storeu_ps(p, v); }
+        static LMATH_FORCE_INLINE reg  set1(float s) noexcept { return _mm256_set1_ps(s); }
+        static LMATH_FORCE_INLINE reg  zero() noexcept { return _mm256_setzero_ps(); }
+
+        static LMATH_FORCE_INLINE reg add(reg a, reg b) noexcept { return _mm256_add_ps(a, b); }
+        static LMATH_FORCE_INLINE reg sub(reg a, reg b) noexcept { return _mm256_sub_ps(a, b); }
+        static LMATH_FORCE_INLINE reg mul(reg a, reg b) noexcept { return _mm256_mul_ps(a, b); }
+        static LMATH_FORCE_INLINE reg div(reg a, reg b) noexcept { return _mm256_div_ps(a, b); }
+        static LMATH_FORCE_INLINE reg min(reg a, reg b) noexcept { return _mm256_min_ps(a, b); }
+        static LMATH_FORCE_INLINE reg max(reg a, reg b) noexcept { return _mm256_max_ps(a, b); }
+
+        static LMATH_FORCE_INLINE reg rsqrt(reg x) noexcept {
+            const reg y = _mm256_rsqrt_ps(x);
+            const reg xy2 = _mm256_mul_ps(x, _mm256_mul_ps(y, y));
+            return _mm256_mul_ps(y, _mm256_sub_ps(_mm256_set1_ps(1.5f), _mm256_mul_ps(_mm256_set1_ps(0.5f), xy2)));
+        }
+
+        static LMATH_FORCE_INLINE reg rsqrt_est(reg x) noexcept { return _mm256_rsqrt_ps(x); }
+        static LMATH_FORCE_INLINE reg sqrt(reg x) noexcept { return _mm256_sqrt_ps(x); }
+
+        // nearest integer (ties to even)
+        static LMATH_FORCE_INLINE reg round(reg x) noexcept {
+            return _mm256_round_ps(x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        }
+
+        static LMATH_FORCE_INLINE mask cmpgt(reg a, reg b) noexcept { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+        static LMATH_FORCE_INLINE mask cmplt(reg a, reg b) noexcept { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+        static LMATH_FORCE_INLINE mask cmpge(reg a, reg b) noexcept { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+        static LMATH_FORCE_INLINE mask cmple(reg a, reg b) noexcept { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+        static LMATH_FORCE_INLINE mask mask_and(mask a, mask b) noexcept { return _mm256_and_ps(a, b); }
+        static LMATH_FORCE_INLINE reg  select(mask m, reg a, reg b) noexcept { return _mm256_blendv_ps(b, a, m); }
+        static LMATH_FORCE_INLINE int  movemask(mask m) noexcept { return _mm256_movemask_ps(m); }
+    };
+#endif
+
+#if defined(__ARM_NEON)
+    struct lanes_neon {
+        using reg  = float32x4_t;
+        using mask = uint32x4_t;
+        static constexpr std::size_t width = 4;
+
+        static LMATH_FORCE_INLINE reg  load(const float* p) noexcept { return vld1q_f32(p); }
+        static LMATH_FORCE_INLINE void store(float* p, reg v) noexcept { vst1q_f32(p, v); }
+        static LMATH_FORCE_INLINE reg  set1(float s) noexcept { return vdupq_n_f32(s); }
+        static LMATH_FORCE_INLINE reg  zero() noexcept { return vdupq_n_f32(0.f); }
+
+        static LMATH_FORCE_INLINE reg add(reg a, reg b) noexcept { return vaddq_f32(a, b); }
+        static LMATH_FORCE_INLINE reg sub(reg a, reg b) noexcept { return vsubq_f32(a, b); }
+        static LMATH_FORCE_INLINE reg mul(reg a, reg b) noexcept { return vmulq_f32(a, b); }
+        static LMATH_FORCE_INLINE reg div(reg a, reg b) noexcept {
+#if defined(__aarch64__)
+            return vdivq_f32(a, b);
+#else
+            reg r = vrecpeq_f32(b);
+            r = vmulq_f32(r, vrecpsq_f32(b, r));
+            r = vmulq_f32(r, vrecpsq_f32(b, r));
+            return vmulq_f32(a, r);
+#endif
+        }
+        static LMATH_FORCE_INLINE reg min(reg a, reg b) noexcept { return vminq_f32(a, b); }
+        static LMATH_FORCE_INLINE reg max(reg a, reg b) noexcept { return vmaxq_f32(a, b); }
+
+        static LMATH_FORCE_INLINE reg rsqrt(reg x) noexcept {
+            const reg y = vrsqrteq_f32(x);
+            return vmulq_f32(y, vrsqrtsq_f32(vmulq_f32(x, y), y));
+        }
+
+        static LMATH_FORCE_INLINE reg rsqrt_est(reg x) noexcept { return vrsqrteq_f32(x); }
+        static LMATH_FORCE_INLINE reg sqrt(reg x) noexcept {
+#if defined(__aarch64__)
+            return vsqrtq_f32(x);
+#else
+            // no vector sqrt on ARMv7: VFP per lane
+            reg r = x;
+            r = vsetq_lane_f32(__builtin_sqrtf(vgetq_lane_f32(x, 0)), r, 0);
+            r = vsetq_lane_f32(__builtin_sqrtf(vgetq_lane_f32(x, 1)), r, 1);
+            r = vsetq_lane_f32(__builtin_sqrtf(vgetq_lane_f32(x, 2)), r, 2);
+            r = vsetq_lane_f32(__builtin_sqrtf(vgetq_lane_f32(x, 3)), r, 3);
+            return r;
+#endif
+        }
+
+        static LMATH_FORCE_INLINE reg round(reg x) noexcept {
+#if defined(__aarch64__)
+            return vrndnq_f32(x); // ties to even
+#else
+            // ties to even: adding and removing +-2^23 leaves no fraction bits
+            // and NEON always rounds to nearest even; |x| >= 2^23 returned as is
+            const float32x4_t big = vbslq_f32(vdupq_n_u32(0x80000000u), x, vdupq_n_f32(8388608.f));
+            const float32x4_t r = vsubq_f32(vaddq_f32(x, big), big);
+            return vbslq_f32(vcaltq_f32(x, vdupq_n_f32(8388608.f)), r, x);
+#endif
+        }
+
+        static LMATH_FORCE_INLINE mask cmpgt(reg a, reg b) noexcept { return vcgtq_f32(a, b); }
+        static LMATH_FORCE_INLINE mask cmplt(reg a, reg b) noexcept { return vcltq_f32(a, b); }
+        static LMATH_FORCE_INLINE mask cmpge(reg a, reg b) noexcept { return vcgeq_f32(a, b); }
+        static LMATH_FORCE_INLINE mask cmple(reg a, reg b) noexcept { return vcleq_f32(a, b); }
+        static LMATH_FORCE_INLINE mask mask_and(mask a, mask b) noexcept { return vandq_u32(a, b); }
+        static LMATH_FORCE_INLINE reg  select(mask m, reg a, reg b) noexcept { return vbslq_f32(m, a, b); }
+        static LMATH_FORCE_INLINE int  movemask(mask m) noexcept {
+            const uint32x4_t bits = vshrq_n_u32(m, 31);
+            return int(vgetq_lane_u32(bits, 0)      | (vgetq_lane_u32(bits, 1) << 1) |
+                      (vgetq_lane_u32(bits, 2) << 2) | (vgetq_lane_u32(bits, 3) << 3));
+        }
+    };
+#endif
+
+    // ------------------------------------------------------------------
+    // sin / cos on L::width lanes
+    //
+    // Cody-Waite reduction by pi/2 with a three-part constant (j * DP1 is
+    // exact for |j| < 2^16), then the cephes minimax polynomials on
+    // [-pi/4, pi/4]. Branch-free: the quadrant only drives selects, so the
+    // cost is the same for every input. Accuracy is documented at sin4().
+    // lm::sincosf() is the scalar copy of these steps.
+    // ------------------------------------------------------------------
+    template<typename L>
+    LMATH_FORCE_INLINE void sincos_lanes(typename L::reg x,
+                                         typename L::reg& s,
+                                         typename L::reg& c) noexcept {
+        using reg = typename L::reg;
+
+        const reg j = L::round(L::mul(x, L::set1(0.636619772367581343f))); // 2/pi
+        reg r = L::sub(x, L::mul(j, L::set1(1.5703125f)));
+        r = L::sub(r, L::mul(j, L::set1(4.837512969970703125e-4f)));
+        r = L::sub(r, L::mul(j, L::set1(7.54978995489188216e-8f)));
+        const reg r2 = L::mul(r, r);
+
+        // sin(r) = r + r^3 * P(r^2)
+        reg ps = L::set1(-1.9515295891e-4f);
+        ps = L::add(L::mul(ps, r2), L::set1(8.3321608736e-3f));
+        ps = L::add(L::mul(ps, r2), L::set1(-1.6666654611e-1f));
+        ps = L::add(L::mul(L::mul(ps, r2), r), r);
+
+        // cos(r) = 1 - r^2/2 + r^4 * Q(r^2)
+        reg pc = L::set1(2.443315711809948e-5f);
+        pc = L::add(L::mul(pc, r2), L::set1(-1.388731625493765e-3f));
+        pc = L::add(L::mul(pc, r2), L::set1(4.166664568298827e-2f));
+        pc = L::add(L::sub(L::mul(L::mul(pc, r2), r2), L::mul(r2, L::set1(0.5f))), L::set1(1.f));
+
+        // quadrant q = j mod 4 in [0, 3]; j/4 - 3/8 is never a tie
+        const reg q = L::sub(j, L::mul(L::set1(4.f),
+                             L::round(L::sub(L::mul(j, L::set1(0.25f)), L::set1(0.375f)))));
+        // odd q swaps sin/cos: q/2 - round(q/2 - 1/4) is 0.5 for odd q, else 0
+        const typename L::mask odd = L::cmpgt(
+            L::sub(L::mul(q, L::set1(0.5f)), L::round(L::sub(L::mul(q, L::set1(0.5f)), L::set1(0.25f)))),
+            L::set1(0.25f));
+        // sin < 0 for q in {2, 3}, cos < 0 for q in {1, 2}
+        const typename L::mask sin_neg = L::cmpgt(q, L::set1(1.5f));
+        const reg qc = L::sub(q, L::set1(1.5f));
+        const typename L::mask cos_neg = L::cmplt(L::max(qc, L::sub(L::zero(), qc)), L::set1(1.f));
+
+        const reg one = L::set1(1.f);
+        const reg minus_one = L::set1(-1.f);
+        s = L::mul(L::select(odd, pc, ps), L::select(sin_neg, minus_one, one));
+        c = L::mul(L::select(odd, ps, pc), L::select(cos_neg, minus_one, one));
+    } // sincos_lanes
+
+    // Calls fn(L{}) with the widest lane type available at runtime.
+    template<typename Fn>
+    LMATH_FORCE_INLINE void with_lanes(Fn&& fn) noexcept {
+#if defined(LMATH_FORCE_NO_SIMD)
+        fn(lanes_scalar{});
+#else
+        switch (simd::max_level()) {
+#if defined(__ARM_NEON)
+        case simd::Level::neon:
+            fn(lanes_neon{});
+            return;
+#endif
+#if defined(__AVX__)
+        case simd::Level::avx:
+#if defined(__AVX2__)
+        case simd::Level::avx2:
+#if defined(__AVX512F__)
+        case simd::Level::avx512:
+#endif
+#endif
+            fn(lanes_avx{});
+            return;
+#endif
+#if defined(__SSE2__)
+        case simd::Level::sse2:
+            fn(lanes_sse2{});
+            return;
+#endif
+        default:
+            fn(lanes_scalar{});
+            return;
+        } // switch
+#endif // LMATH_FORCE_NO_SIMD
+    } // with_lanes
+
+    // The lane type half as wide: 4-wide SSE2 under AVX, else scalar.
+    template<typename L>
+    struct lanes_half { using type = lanes_scalar; };
+#if defined(__AVX__)
+    template<>
+    struct lanes_half<lanes_avx> { using type = lanes_sse2; };
+#endif
+
+    // Calls body(L{}, i) for each full block of L::width elements in [0, n),
+    // then body(lanes_half<L>::type{}, i) for full blocks of what is left
+    // (so 4..7 leftover elements still get one 4-wide step on AVX), then
+    // body(lanes_scalar{}, i) for the tail.
+    template<typename L, typename Body>
+    LMATH_FORCE_INLINE void for_lanes(std::size_t n, Body&& body) noexcept {
+        using H = typename lanes_half<L>::type;
+        const std::size_t nw = n - n % L::width;
+        const std::size_t nh = H::width > 1 ? n - n % H::width : nw; // one H block at most
+        std::size_t i = 0;
+        for (; i < nw; i += L::width) body(L{}, i);
+        for (; i < nh; i += H::width) body(H{}, i);
+        for (; i < n; ++i)            body(lanes_scalar{}, i);
+    }
+
+    // Bitmask variant: test(L{}, i) returns one bit per element of
+    // [i, i + L::width), which lands in bits i % 32 onward of out[i / 32].
+    // The rest goes through lanes_half<L> blocks, then test(lanes_scalar{}, i).
+    // Every word of (n + 31) / 32 is written once; unused high bits of the
+    // last word are cleared.
+    template<typename L, typename Test>
+    LMATH_FORCE_INLINE void for_lanes_mask(std::size_t n, std::uint32_t* out, Test&& test) noexcept {
+        for (std::size_t i = 0; i < n; i += 32) {
+            const std::size_t e = n - i < 32 ? n : i + 32;
+            std::uint32_t bits = 0;
+            using H = typename lanes_half<L>::type;
+            const std::size_t ew = e - (e - i) % L::width;
+            const std::size_t eh = H::width > 1 ? e - (e - i) % H::width : ew;
+            std::size_t j = i;
+            for (; j < ew; j += L::width)
+                bits |= std::uint32_t(test(L{}, j)) << (j - i);
+            for (; j < eh; j += H::width)
+                bits |= std::uint32_t(test(H{}, j)) << (j - i);
+            for (; j < e; ++j)
+                bits |= std::uint32_t(test(lanes_scalar{}, j)) << (j - i);
+            out[i / 32] = bits;
+        }
+    }
+
+    // movemask of an all-true mask
+    template<typename L>
+    LMATH_FORCE_INLINE int lanes_all_bits() noexcept {
+        return int((1u << L::width) - 1u);
+    }
+
+} // namespace detail
+} // namespace lm
@@ -0,0 +1,373 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "detail/feature_detection.hpp"
+#include "detail/simd_lanes.hpp"
+#include "libc_integration.hpp"
+#include "vec.hpp"
+#include "mat.hpp"
+#include "quat.hpp"
+#include "soa.hpp"
+
+namespace lm {
+
+    // ============================================================
+    // Dual quaternion (rigid transform)
+    //
+    // real = rotation r, dual = t r / 2 with t = (tx, ty, tz, 0), so a
+    // unit dual quaternion is 8 floats for rotation plus translation. A * B
+    // applies B first, as for quat and mat4. Unless noted, functions
+    // expect unit inputs (|real| = 1, dot(real, dual) = 0); dualquat_norm
+    // restores that after blending or long chains of products.
+    // ============================================================
+
+    template<typename T>
+    struct dualquat_of {
+        quat_of<T> real{}; // rotation
+        quat_of<T> dual{}; // t * real / 2
+    };
+
+    using dualquat = dualquat_of<float>;
+
+    static_assert(sizeof(dualquat) == 8 * sizeof(float), "dualquat must be eight packed floats");
+
+    // ============================================================
+    // Construction / conversion
+    // ============================================================
+
+    template<typename T = float>
+    LMATH_OUT dualquat_of<T> dualquat_identity() noexcept {
+        return { quat_identity<T>(), quat_of<T>{} };
+    }
+
+    // rotate by R, then translate by t
+    template<typename T>
+    LMATH_OUT dualquat_of<T> dualquat_from_rt(const quat_of<T>& R, const vec<T,3>& t) noexcept {
+        return { R, quat_scale(quat_mul<T>(quat_of<T>{ t, T(0) }, R), T(0.5)) };
+    }
+
+    template<typename T>
+    LMATH_OUT quat_of<T> dualquat_rotation(const dualquat_of<T>& D) noexcept {
+        return D.real;
+    }
+
+    // 2 (dual * conj(real)).xyz
+    template<typename T>
+    LMATH_OUT vec<T,3> dualquat_translation(const dualquat_of<T>& D) noexcept {
+        const vec<T,3> t = (D.dual.v * D.real.w - D.real.v * D.dual.w) + vec3_cross(D.real.v, D.dual.v);
+        return t * T(2);
+    }
+
+    template<typename T>
+    LMATH_OUT mat4_of<T> mat4_from_dualquat(const dualquat_of<T>& D) noexcept {
+        mat4_of<T> M = mat4_from_quat(D.real);
+        const vec<T,3> t = dualquat_translation(D);
+        M[3][0] = t[0];
+        M[3][1] = t[1];
+        M[3][2] = t[2];
+        return M;
+    }
+
+    // M must be rigid (orthonormal upper 3x3, bottom row 0 0 0 1)
+    template<typename T>
+    LMATH_OUT dualquat_of<T> dualquat_from_mat4(const mat4_of<T>& M) noexcept {
+        return dualquat_from_rt(quat_from_mat4(M), vec<T,3>{ M[3][0], M[3][1], M[3][2] });
+    }
+
+    // ============================================================
+    // Basic ops
+    // ============================================================
+
+    // inverse of a unit dual quaternion
+    template<typename T>
+    LMATH_OUT dualquat_of<T> dualquat_conj(const dualquat_of<T>& D) noexcept {
+        return { quat_conj(D.real), quat_conj(D.dual) };
+    }
+
+    // |real| -> 1 and dual projected to be orthogonal to real; a zero
+    // real part gives the zero dual quaternion, as quat_norm does
+    template<typename T>
+    LMATH_OUT dualquat_of<T> dualquat_norm(const dualquat_of<T>& D) noexcept {
+        const T LEN = quat_len(D.real);
+        if (LEN == T(0)) return {};
+        const T inv = T(1) / LEN;
+        const quat_of<T> r = quat_scale(D.real, inv);
+        const quat_of<T> d = quat_scale(D.dual, inv);
+        return { r, quat_sub(d, quat_scale(r, quat_dot(r, d))) };
+    }
+
+    // A * B: real = Ar Br, dual = Ar Bd + Ad Br
+    template<typename T>
+    LMATH_OUT dualquat_of<T> dualquat_mul(const dualquat_of<T>& A, const dualquat_of<T>& B) noexcept {
+        return { quat_mul<T>(A.real, B.real),
+                 quat_add(quat_mul<T>(A.real, B.dual), quat_mul<T>(A.dual, B.real)) };
+    }
+
+    template<typename T>
+    LMATH_OUT vec<T,3> dualquat_transform_point(const dualquat_of<T>& D, const vec<T,3>& p) noexcept {
+        return quat_mul_vec3<T>(D.real, p) + dualquat_translation(D);
+    }
+
+    template<typename T>
+    LMATH_OUT vec<T,3> dualquat_transform_dir(const dualquat_of<T>& D, const vec<T,3>& d) noexcept {
+        return quat_mul_vec3<T>(D.real, d);
+    }
+
+    // Dual-quaternion linear blending (Kavan et al.): sum w[i] D[i], each
+    // flipped to D[0]'s hemisphere, then normalized. The skinning blend.
+    template<typename T>
+    LMATH_OUT dualquat_of<T> dualquat_blend(const dualquat_of<T>* D, const T* w, std::size_t n) noexcept {
+        dualquat_of<T> S{};
+        for (std::size_t i = 0; i < n; ++i) {
+            const T s = quat_dot(D[0].real, D[i].real) < T(0) ? -w[i] : w[i];
+            S.real = quat_add(S.real, quat_scale(D[i].real, s));
+            S.dual = quat_add(S.dual, quat_scale(D[i].dual, s));
+        }
+        return dualquat_norm(S);
+    }
+
+    // ============================================================
+    // dualquat (float): SIMD
+    //
+    // One dual quaternion is two quat registers, so dualquat_mul is three
+    // quat_mul kernels and an add, and dualquat_transform_point is the
+    // quat_mul_vec3 kernel plus the translation. The batches use the lane
+    // traits (4 or 8 dual quaternions per register set, component-wise).
+    // Same operation order as the templates above, so all paths agree bit
+    // for bit with dualquat_mul_scalar / dualquat_transform_point_scalar.
+    // ============================================================
+
+    LMATH_OUT dualquat dualquat_mul_scalar(const dualquat& A, const dualquat& B) noexcept {
+        return dualquat_mul<float>(A, B);
+    }
+
+    LMATH_OUT vec3 dualquat_transform_point_scalar(const dualquat& D, const vec3& p) noexcept {
+        return dualquat_transform_point<float>(D, p);
+    }
+
+    namespace detail {
+
+#if defined(__SSE2__)
+        LMATH_FORCE_INLINE dualquat dualquat_mul_sse2(const dualquat& A, const dualquat& B) noexcept {
+            const __m128 ar = _mm_loadu_ps(A.real.v.data()), ad = _mm_loadu_ps(A.dual.v.data());
+            const __m128 br = _mm_loadu_ps(B.real.v.data()), bd = _mm_loadu_ps(B.dual.v.data());
+            dualquat R;
+            _mm_storeu_ps(R.real.v.data(), quat_mul_sse2(ar, br));
+            _mm_storeu_ps(R.dual.v.data(), _mm_add_ps(quat_mul_sse2(ar, bd), quat_mul_sse2(ad, br)));
+            return R;
+        }
+
+        LMATH_FORCE_INLINE vec3 dualquat_transform_point_sse2(const dualquat& D, const vec3& P) noexcept {
+            const __m128 r = _mm_loadu_ps(D.real.v.data());
+            const __m128 d = _mm_loadu_ps(D.dual.v.data());
+            const __m128 p = _mm_set_ps(0.f, P[2], P[1], P[0]);
+            const __m128 rw = _mm_shuffle_ps(r, r, _MM_SHUFFLE(3, 3, 3, 3));
+            const __m128 dw = _mm_shuffle_ps(d, d, _MM_SHUFFLE(3, 3, 3, 3));
+
+            // quat_mul_vec3_sse2
+            const __m128 c = _mm_mul_ps(quat_cross_sse2(r, p), _mm_set1_ps(2.f));
+            const __m128 v = _mm_add_ps(_mm_add_ps(p, _mm_mul_ps(c, rw)), quat_cross_sse2(r, c));
+
+            // translation
+            __m128 t = _mm_sub_ps(_mm_mul_ps(d, rw), _mm_mul_ps(r, dw));
+            t = _mm_mul_ps(_mm_add_ps(t, quat_cross_sse2(r, d)), _mm_set1_ps(2.f));
+
+            alignas(16) float out[4];
+            _mm_store_ps(out, _mm_add_ps(v, t));
+            return { out[0], out[1], out[2] };
+        }
+#endif
+
+#if defined(__ARM_NEON)
+        LMATH_FORCE_INLINE dualquat dualquat_mul_neon(const dualquat& A, const dualquat& B) noexcept {
+            const quat x = quat_mul_neon(A.real, B.dual);
+            const quat y = quat_mul_neon(A.dual, B.real);
+            dualquat R;
+            R.real = quat_mul_neon(A.real, B.real);
+            vst1q_f32(R.dual.v.data(), vaddq_f32(vld1q_f32(x.v.data()), vld1q_f32(y.v.data())));
+            return R;
+        }
+
+        LMATH_FORCE_INLINE vec3 dualquat_transform_point_neon(const dualquat& D, const vec3& P) noexcept {
+            const float32x4_t r = vld1q_f32(D.real.v.data());
+            const float32x4_t d = vld1q_f32(D.dual.v.data());
+            const float lanes[4] = { P[0], P[1], P[2], 0.f };
+            const float32x4_t p = vld1q_f32(lanes);
+
+            const float32x4_t c = vmulq_n_f32(quat_cross_neon(r, p), 2.f);
+            const float32x4_t v = vaddq_f32(vaddq_f32(p, vmulq_n_f32(c, D.real.w)), quat_cross_neon(r, c));
+
+            float32x4_t t = vsubq_f32(vmulq_n_f32(d, D.real.w), vmulq_n_f32(r, D.dual.w));
+            t = vmulq_n_f32(vaddq_f32(t, quat_cross_neon(r, d)), 2.f);
+
+            float out[4];
+            vst1q_f32(out, vaddq_f32(v, t));
+            return { out[0], out[1], out[2] };
+        }
+#endif
+
+        // ------------------------------------------------------------
+        // Lane kernels, one component per register
+        // ------------------------------------------------------------
+        template<typename V>
+        LMATH_FORCE_INLINE void dualquat_mul_lanes(const typename V::reg (&ar)[4], const typename V::reg (&ad)[4],
+                                                   const typename V::reg (&br)[4], const typename V::reg (&bd)[4],
+                                                   typename V::reg (&rr)[4], typename V::reg (&rd)[4]) noexcept {
+            typename V::reg x[4], y[4];
+            quat_mul_lanes<V>(ar, br, rr);
+            quat_mul_lanes<V>(ar, bd, x);
+            quat_mul_lanes<V>(ad, br, y);
+            for (std::size_t k = 0; k < 4; ++k) rd[k] = V::add(x[k], y[k]);
+        }
+
+        // p -> D p, in place
+        template<typename V>
+        LMATH_FORCE_INLINE void dualquat_transform_point_lanes(const typename V::reg (&r)[4],
+                                                               const typename V::reg (&d)[4],
+                                                               typename V::reg (&p)[3]) noexcept {
+            const typename V::reg dv[3] = { d[0], d[1], d[2] };
+            typename V::reg c[3];
+            quat_cross_lanes<V>(r, dv, c);
+            quat_mul_vec3_lanes<V>(r, p);
+            for (std::size_t k = 0; k < 3; ++k) {
+                const typename V::reg t = V::add(V::sub(V::mul(d[k], r[3]), V::mul(r[k], d[3])), c[k]);
+                p[k] = V::add(p[k], V::mul(t, V::set1(2.f)));
+            }
+        }
+
+        // real / dual parts of W dual quaternions into component registers
+        template<typename V>
+        LMATH_FORCE_INLINE void dualquat_load_lanes(V S, const dualquat* D, typename V::reg (&r)[4],
+                                                    typename V::reg (&d)[4]) noexcept {
+            vec4 re[V::width], du[V::width];
+            for (std::size_t j = 0; j < V::width; ++j) {
+                re[j] = *quat_as_vec4(&D[j].real);
+                du[j] = *quat_as_vec4(&D[j].dual);
+            }
+            vec_pack<4, V::width> PR, PD;
+            soa_transpose_in(S, re, vec_soa_view(PR), 0);
+            soa_transpose_in(S, du, vec_soa_view(PD), 0);
+            for (std::size_t k = 0; k < 4; ++k) {
+                r[k] = V::load(PR.lane[k]);
+                d[k] = V::load(PD.lane[k]);
+            }
+        }
+
+    } // namespace detail
+
+    /* DQ*DQ SIMD */LMATH_NO_DISCARD inline dualquat
+    dualquat_mul(const dualquat& A, const dualquat& B) noexcept {
+#if defined(LMATH_FORCE_NO_SIMD)
+        return dualquat_mul_scalar(A, B);
+#else
+        switch (simd::max_level()) {
+#if defined(__ARM_NEON)
+        case simd::Level::neon:
+            return detail::dualquat_mul_neon(A, B);
+#endif
+#if defined(__SSE2__)
+        case simd::Level::sse2:
+#if defined(__AVX__)
+        case simd::Level::avx:
+        case simd::Level::avx2:
+        case simd::Level::avx512:
+#endif
+            return detail::dualquat_mul_sse2(A, B);
+#endif
+        default:
+            return dualquat_mul_scalar(A, B);
+        } // switch
+#endif // LMATH_FORCE_NO_SIMD
+    } // dualquat_mul
+
+    /* DQ*P3 SIMD */LMATH_NO_DISCARD inline vec3
+    dualquat_transform_point(const dualquat& D, const vec3& p) noexcept {
+#if defined(LMATH_FORCE_NO_SIMD)
+        return dualquat_transform_point_scalar(D, p);
+#else
+        switch (simd::max_level()) {
+#if defined(__ARM_NEON)
+        case simd::Level::neon:
+            return detail::dualquat_transform_point_neon(D, p);
+#endif
+#if defined(__SSE2__)
+        case simd::Level::sse2:
+#if defined(__AVX__)
+        case simd::Level::avx:
+        case simd::Level::avx2:
+        case simd::Level::avx512:
+#endif
+            return detail::dualquat_transform_point_sse2(D, p);
+#endif
+        default:
+            return dualquat_transform_point_scalar(D, p);
+        } // switch
+#endif // LMATH_FORCE_NO_SIMD
+    } // dualquat_transform_point
+
+    // out[i] = dualquat_mul(A[i], B[i]); `out` may alias either input
+    /* DQ*DQ[] SIMD */inline void
+    dualquat_mul_batch(const dualquat* A, const dualquat* B, dualquat* out, std::size_t n) noexcept {
+        detail::with_lanes([&](auto L) {
+            detail::for_lanes<decltype(L)>(n, [&](auto S, std::size_t i) {
+                using V = decltype(S);
+                typename V::reg ar[4], ad[4], br[4], bd[4], rr[4], rd[4];
+                detail::dualquat_load_lanes(S, A + i, ar, ad);
+                detail::dualquat_load_lanes(S, B + i, br, bd);
+                detail::dualquat_mul_lanes<V>(ar, ad, br, bd, rr, rd);
+
+                vec_pack<4, V::width> PR, PD;
+                for (std::size_t k = 0; k < 4; ++k) {
+                    V::store(PR.lane[k], rr[k]);
+                    V::store(PD.lane[k], rd[k]);
+                }
+                vec4 re[V::width], du[V::width];
+                detail::soa_transpose_out(S, vec_soa_view(PR), 0, re);
+                detail::soa_transpose_out(S, vec_soa_view(PD), 0, du);
+                for (std::size_t j = 0; j < V::width; ++j) {
+                    *detail::quat_as_vec4(&out[i + j].real) = re[j];
+                    *detail::quat_as_vec4(&out[i + j].dual) = du[j];
+                }
+            });
+        });
+    }
+
+    // out[i] = dualquat_transform_point(D[i], in[i]): the per-vertex half
+    // of dual-quaternion skinning, after dualquat_blend. `out` may alias `in`
+    /* DQ*P3[] SIMD */inline void
+    dualquat_transform_point_batch(const dualquat* D, const vec3* in, vec3* out, std::size_t n) noexcept {
+        detail::with_lanes([&](auto L) {
+            detail::for_lanes<decltype(L)>(n, [&](auto S, std::size_t i) {
+                using V = decltype(S);
+                typename V::reg r[4], d[4];
+                detail::dualquat_load_lanes(S, D + i, r, d);
+
+                vec_pack<3, V::width> P;
+                const vec_soa<3> tmp = vec_soa_view(P);
+                detail::soa_transpose_in(S, in + i, tmp, 0);
+                typename V::reg p[3];
+                for (std::size_t k = 0; k < 3; ++k) p[k] = V::load(P.lane[k]);
+                detail::dualquat_transform_point_lanes<V>(r, d, p);
+                for (std::size_t k = 0; k < 3; ++k) V::store(P.lane[k], p[k]);
+                detail::soa_transpose_out(S, tmp, 0, out + i);
+            });
+        });
+    }
+
+    // ============================================================
+    // Operators
+    // ============================================================
+
+    template<typename T>
+    LMATH_OUT dualquat_of<T> operator* (const dualquat_of<T>& A,
+                                        const dualquat_of<T>& B) noexcept { return dualquat_mul(A,B); }
+    template<typename T>
+    LMATH_OUT bool operator== (const dualquat_of<T>& A,
+                               const dualquat_of<T>& B) noexcept { return A.real==B.real && A.dual==B.dual; }
+    template<typename T>
+    LMATH_OUT bool operator!= (const dualquat_of<T>& A,
+                               const dualquat_of<T>& B) noexcept { return !(A==B); }
+
+} // namespace lm
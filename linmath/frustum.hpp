@@ -0,0 +1,165 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "detail/feature_detection.hpp"
+#include "detail/simd_lanes.hpp"
+
+#include "libc_integration.hpp"
+#include "vec.hpp"
+#include "mat.hpp"
+#include "soa.hpp"
+#include "bounds.hpp"
+
+namespace lm {
+
+    // ============================================================
+    // View frustum
+    //
+    // Six planes (a, b, c, d) in the order left, right, bottom, top,
+    // near, far, with unit normals (a, b, c) pointing inwards: a point p
+    // is inside a plane when a*p.x + b*p.y + c*p.z + d >= 0, and that sum
+    // is its signed distance.
+    // ============================================================
+
+    struct frustum {
+        vec4 planes[6]{};
+    };
+
+    // Planes of the clip volume -w <= x, y, z <= w of a view-projection
+    // matrix (mat4_perspective / mat4_ortho times mat4_look_at), in the
+    // space the matrix maps from (Gribb & Hartmann). Normals are scaled
+    // to unit length, so distances are in world units.
+    inline frustum frustum_from_mat4(const mat4& M) noexcept {
+        // row r of M is (M[0][r], M[1][r], M[2][r], M[3][r])
+        const auto row = [&](std::size_t r) noexcept {
+            return vec4{ M[0][r], M[1][r], M[2][r], M[3][r] };
+        };
+        const vec4 x = row(0), y = row(1), z = row(2), w = row(3);
+
+        frustum F;
+        F.planes[0] = vec_add(w, x);
+        F.planes[1] = vec_sub(w, x);
+        F.planes[2] = vec_add(w, y);
+        F.planes[3] = vec_sub(w, y);
+        F.planes[4] = vec_add(w, z);
+        F.planes[5] = vec_sub(w, z);
+
+        for (vec4& p : F.planes) {
+            const float len2 = p[0] * p[0] + p[1] * p[1] + p[2] * p[2];
+            p = vec_scale(p, 1.f / detail::lanes_scalar::sqrt(len2)); // IEEE, not lm::sqrtf
+        }
+        return F;
+    }
+
+    // ============================================================
+    // Single objects
+    //
+    // Conservative tests: false only when the object lies entirely
+    // outside one plane. Objects that straddle a corner outside the
+    // frustum still count as visible.
+    // ============================================================
+
+    LMATH_OUT float plane_dist(const vec4& P, float x, float y, float z) noexcept {
+        return P[0] * x + P[1] * y + P[2] * z + P[3];
+    }
+
+    LMATH_OUT bool frustum_test_sphere(const frustum& F, const vec3& c, float r) noexcept {
+        for (const vec4& p : F.planes)
+            if (plane_dist(p, c[0], c[1], c[2]) < -r)
+                return false;
+        return true;
+    }
+
+    // Box [lo, hi]: each plane is tested against the corner furthest
+    // along its normal.
+    LMATH_OUT bool frustum_test_aabb(const frustum& F, const vec3& lo, const vec3& hi) noexcept {
+        for (const vec4& p : F.planes) {
+            const float x = p[0] >= 0.f ? hi[0] : lo[0];
+            const float y = p[1] >= 0.f ? hi[1] : lo[1];
+            const float z = p[2] >= 0.f ? hi[2] : lo[2];
+            if (plane_dist(p, x, y, z) < 0.f)
+                return false;
+        }
+        return true;
+    }
+
+    LMATH_OUT bool frustum_test_sphere(const frustum& F, const sphere3& S) noexcept {
+        return frustum_test_sphere(F, S.c, S.r);
+    }
+
+    LMATH_OUT bool frustum_test_aabb(const frustum& F, const aabb3& A) noexcept {
+        return frustum_test_aabb(F, A.lo, A.hi);
+    }
+
+    // ============================================================
+    // Batch culling (SoA)
+    //
+    // Objects come as separate float streams; results go to a bitmask,
+    // bit i % 32 of visible[i / 32] set if object i passes the test
+    // above (same arithmetic, so batch and single results agree).
+    // `visible` holds (n + 31) / 32 words; unused high bits of the last
+    // word are cleared.
+    //
+    // 8 lanes on AVX/AVX2, 4 on SSE2/NEON: each step takes the smallest
+    // distance over the six planes, so one compare and one movemask
+    // decide a whole block.
+    // ============================================================
+
+    namespace detail {
+
+        // a*x + b*y + c*z + d for a broadcast plane, same order as plane_dist
+        template<typename V>
+        LMATH_FORCE_INLINE typename V::reg plane_dist_lanes(const vec4& P, typename V::reg x,
+                                                            typename V::reg y, typename V::reg z) noexcept {
+            return V::add(V::add(V::add(V::mul(V::set1(P[0]), x), V::mul(V::set1(P[1]), y)),
+                                 V::mul(V::set1(P[2]), z)),
+                          V::set1(P[3]));
+        }
+
+    } // namespace detail
+
+    // Spheres as (x, y, z, radius) streams; n = S.n.
+    inline void frustum_cull_spheres(const frustum& F, const vec4_soa& S, std::uint32_t* visible) noexcept {
+        detail::with_lanes([&](auto L) {
+            detail::for_lanes_mask<decltype(L)>(S.n, visible, [&](auto V_, std::size_t i) {
+                using V = decltype(V_);
+                const auto x = V::load(S[0] + i);
+                const auto y = V::load(S[1] + i);
+                const auto z = V::load(S[2] + i);
+                const auto r = V::load(S[3] + i);
+
+                auto d = detail::plane_dist_lanes<V>(F.planes[0], x, y, z);
+                for (std::size_t k = 1; k < 6; ++k)
+                    d = V::min(d, detail::plane_dist_lanes<V>(F.planes[k], x, y, z));
+                return ~V::movemask(V::cmplt(d, V::sub(V::zero(), r))) & detail::lanes_all_bits<V>();
+            });
+        });
+    }
+
+    // Boxes as lo and hi corner streams; n = hi.n.
+    inline void frustum_cull_aabbs(const frustum& F, const vec3_soa& lo, const vec3_soa& hi,
+                                   std::uint32_t* visible) noexcept {
+        // the furthest corner along each normal only depends on its signs
+        const float* far_corner[6][3];
+        for (std::size_t k = 0; k < 6; ++k)
+            for (std::size_t c = 0; c < 3; ++c)
+                far_corner[k][c] = F.planes[k][c] >= 0.f ? hi[c] : lo[c];
+
+        detail::with_lanes([&](auto L) {
+            detail::for_lanes_mask<decltype(L)>(hi.n, visible, [&](auto V_, std::size_t i) {
+                using V = decltype(V_);
+                auto d = detail::plane_dist_lanes<V>(F.planes[0], V::load(far_corner[0][0] + i),
+                                                     V::load(far_corner[0][1] + i),
+                                                     V::load(far_corner[0][2] + i));
+                for (std::size_t k = 1; k < 6; ++k)
+                    d = V::min(d, detail::plane_dist_lanes<V>(F.planes[k], V::load(far_corner[k][0] + i),
+                                                              V::load(far_corner[k][1] + i),
+                                                              V::load(far_corner[k][2] + i)));
+                return ~V::movemask(V::cmplt(d, V::zero())) & detail::lanes_all_bits<V>();
+            });
+        });
+    }
+
+} // namespace lm
@@ -0,0 +1,236 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "detail/feature_detection.hpp"
+
+#include "mat.hpp"
+#include "worker_pool.hpp"
+
+namespace lm {
+
+    // ============================================================
+    // Transform hierarchy
+    //
+    // Non-owning view of a forest of transforms stored breadth-first, as
+    // parallel arrays (SoA): level l holds nodes [level[l], level[l + 1]),
+    // roots make up level 0, and siblings sit next to each other in the
+    // order of their parents. Every parent is therefore finished before
+    // its children's level starts, and the nodes of one level are
+    // independent of each other. hierarchy_sort() builds the order from
+    // an arbitrary parent array.
+    //
+    //   parent[i]  index of i's parent (hierarchy_root for roots)
+    //   local[i]   transform relative to the parent
+    //   world[i]   world[parent[i]] * local[i], or local[i] for roots
+    //   dirty[i]   nonzero if local[i] changed since the last update;
+    //              nullptr recomputes every node
+    //   level[l]   first node of level l, level[levels] = node count
+    // ============================================================
+
+    LMATH_CONSTEXPR_VAR std::uint32_t hierarchy_root = 0xffffffffu;
+
+    struct hierarchy {
+        const std::uint32_t* parent{};
+        const mat4*          local{};
+        mat4*                world{};
+        std::uint8_t*        dirty{};
+        const std::uint32_t* level{};
+        std::size_t          levels{};
+    };
+
+    // Breadth-first order for n nodes with parents `in_parent` (any order,
+    // hierarchy_root for roots). Writes
+    //   order[k]   original index of the node placed at k
+    //   parent[k]  its parent as a new index
+    //   level[]    level offsets, up to n + 1 entries
+    // and returns the level count, or 0 if some node can't be reached
+    // from a root (a cycle or an out-of-range parent). Roots, and the
+    // children of each node, keep their original relative order.
+    // `scratch` holds 2n + 1 entries. local[] is permuted by the caller:
+    // local_sorted[k] = local_in[order[k]].
+    inline std::size_t hierarchy_sort(const std::uint32_t* in_parent, std::size_t n,
+                                      std::uint32_t* order, std::uint32_t* parent,
+                                      std::uint32_t* level, std::uint32_t* scratch) noexcept {
+        // child lists, bucketed by parent in original order; once filled,
+        // node p's children are child[end[p - 1] .. end[p]) (from 0 for p = 0)
+        std::uint32_t* end = scratch;
+        std::uint32_t* child = scratch + n + 1;
+
+        for (std::size_t i = 0; i <= n; ++i) end[i] = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            const std::uint32_t p = in_parent[i];
+            if (p != hierarchy_root) {
+                if (p >= n) return 0;
+                ++end[p + 1];
+            }
+        }
+        for (std::size_t i = 0; i < n; ++i) end[i + 1] += end[i];
+        for (std::size_t i = 0; i < n; ++i) {
+            const std::uint32_t p = in_parent[i];
+            if (p != hierarchy_root)
+                child[end[p]++] = std::uint32_t(i);
+        }
+
+        // breadth-first walk; `order` doubles as the queue
+        std::size_t placed = 0;
+        for (std::size_t i = 0; i < n; ++i)
+            if (in_parent[i] == hierarchy_root)
+                order[placed++] = std::uint32_t(i);
+
+        std::size_t levels = 0;
+        std::size_t begin = 0;
+        while (begin < placed) {
+            const std::size_t stop = placed;
+            level[levels++] = std::uint32_t(begin);
+            for (std::size_t k = begin; k < stop; ++k) {
+                const std::uint32_t p = order[k];
+                for (std::uint32_t c = p ? end[p - 1] : 0; c < end[p]; ++c)
+                    order[placed++] = child[c];
+            }
+            begin = stop;
+        }
+        level[levels] = std::uint32_t(placed);
+        if (placed != n)
+            return 0;
+
+        // new index of every original node, reusing child[]
+        std::uint32_t* index = child;
+        for (std::size_t k = 0; k < n; ++k) index[order[k]] = std::uint32_t(k);
+        for (std::size_t k = 0; k < n; ++k) {
+            const std::uint32_t p = in_parent[order[k]];
+            parent[k] = p == hierarchy_root ? hierarchy_root : index[p];
+        }
+        return levels;
+    } // hierarchy_sort
+
+    namespace detail {
+
+        // world[i] for i in [begin, end) of one level past the roots, one
+        // mat4_mul_batch_left per run of siblings, so full and incremental
+        // updates round the same. With dirty flags, children of a changed
+        // parent are all recomputed, the others only if they changed
+        // themselves; every recomputed node is flagged for its children.
+        inline void hierarchy_update_runs(const hierarchy& H,
+                                          std::size_t begin, std::size_t end) noexcept {
+            std::size_t i = begin;
+            while (i < end) {
+                const std::uint32_t p = H.parent[i];
+                std::size_t run = i + 1;
+                while (run < end && H.parent[run] == p) ++run;
+
+                if (!H.dirty || H.dirty[p]) {
+                    mat4_mul_batch_left(H.world[p], H.local + i, H.world + i, run - i);
+                    if (H.dirty)
+                        for (std::size_t k = i; k < run; ++k) H.dirty[k] = 1;
+                } else {
+                    // consecutive changed siblings still share one call
+                    std::size_t k = i;
+                    while (k < run) {
+                        if (!H.dirty[k]) { ++k; continue; }
+                        std::size_t k_end = k + 1;
+                        while (k_end < run && H.dirty[k_end]) ++k_end;
+                        mat4_mul_batch_left(H.world[p], H.local + k, H.world + k, k_end - k);
+                        k = k_end;
+                    }
+                }
+                i = run;
+            }
+        }
+
+        // any nonzero byte in f[0, n), 16 at a time where SIMD is available
+        LMATH_FORCE_INLINE bool any_flag(const std::uint8_t* f, std::size_t n) noexcept {
+            std::size_t i = 0;
+#if !defined(LMATH_FORCE_NO_SIMD) && defined(__SSE2__)
+            const __m128i zero = _mm_setzero_si128();
+            for (; i + 16 <= n; i += 16) {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(f + i));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero)) != 0xffff)
+                    return true;
+            }
+#elif !defined(LMATH_FORCE_NO_SIMD) && defined(__ARM_NEON) && defined(__aarch64__)
+            for (; i + 16 <= n; i += 16)
+                if (vmaxvq_u8(vld1q_u8(f + i)) != 0)
+                    return true;
+#endif
+            std::uint8_t acc = 0;
+            for (; i < n; ++i) acc |= f[i];
+            return acc != 0;
+        }
+
+        // Parents are sorted within a level, so a block's parents are one
+        // contiguous range of the level above: a block with no flag set in
+        // either range lies in clean subtrees and is skipped whole.
+        inline void hierarchy_update_range(const hierarchy& H,
+                                           std::size_t begin, std::size_t end) noexcept {
+            if (!H.dirty) {
+                hierarchy_update_runs(H, begin, end);
+                return;
+            }
+            constexpr std::size_t block = 64;
+            for (std::size_t b = begin; b < end; b += block) {
+                const std::size_t e = end - b < block ? end : b + block;
+                const std::uint32_t p0 = H.parent[b];
+                const std::uint32_t p1 = H.parent[e - 1];
+                if (any_flag(H.dirty + b, e - b) || any_flag(H.dirty + p0, p1 - p0 + 1))
+                    hierarchy_update_runs(H, b, e);
+            }
+        }
+
+        struct hierarchy_level_job {
+            const hierarchy* H;
+            std::size_t      begin;
+            std::size_t      end;
+            std::size_t      chunk;
+        };
+
+        inline void hierarchy_level_task(void* ctx, std::size_t task) noexcept {
+            const hierarchy_level_job& J = *static_cast<const hierarchy_level_job*>(ctx);
+            const std::size_t b = J.begin + task * J.chunk;
+            const std::size_t e = J.end - b < J.chunk ? J.end : b + J.chunk;
+            hierarchy_update_range(*J.H, b, e);
+        }
+
+    } // namespace detail
+
+    // Nodes per task when a level is split across the pool; smaller levels
+    // run on the calling thread, where waking workers would cost more than
+    // the multiplies.
+    LMATH_CONSTEXPR_VAR std::size_t hierarchy_min_chunk = 2048;
+
+    // World matrices for every node, level by level; each level is split
+    // into contiguous chunks across `pool`. With dirty flags, only changed
+    // nodes and their descendants are recomputed (clean subtrees cost one
+    // flag test per node), and all flags are cleared on return.
+    inline void hierarchy_update(const hierarchy& H, worker_pool pool = default_pool()) noexcept {
+        if (H.levels == 0)
+            return;
+
+        for (std::size_t i = H.level[0]; i < H.level[1]; ++i)
+            if (!H.dirty || H.dirty[i])
+                H.world[i] = H.local[i];
+
+        for (std::size_t l = 1; l < H.levels; ++l) {
+            const std::size_t begin = H.level[l];
+            const std::size_t end = H.level[l + 1];
+            const std::size_t n = end - begin;
+
+            const std::size_t tasks_max = n / hierarchy_min_chunk;
+            const std::size_t tasks = pool.workers < tasks_max ? pool.workers : tasks_max;
+            if (tasks <= 1) {
+                detail::hierarchy_update_range(H, begin, end);
+            } else {
+                detail::hierarchy_level_job job{ &H, begin, end, (n + tasks - 1) / tasks };
+                pool.run(pool.self, tasks, &detail::hierarchy_level_task, &job);
+            }
+
+            // the previous level's flags were only needed by this one
+            if (H.dirty)
+                for (std::size_t i = H.level[l - 1]; i < begin; ++i) H.dirty[i] = 0;
+        }
+        if (H.dirty)
+            for (std::size_t i = H.level[H.levels - 1]; i < H.level[H.levels]; ++i) H.dirty[i] = 0;
+    } // hierarchy_update
+
+} // namespace lm
@@ -5,6 +5,10 @@
 #include "detail/feature_detection.hpp"
 #include "detail/simd_integration.hpp"
 
+#if defined(__SSE__)
+#   include <xmmintrin.h>
+#endif
+
 namespace lm {
     LMATH_CONSTEXPR_VAR float PI = 3.14159265359f;
     LMATH_CONSTEXPR_VAR float PI_HALF = 1.57079632679f;
@@ -20,6 +24,12 @@ namespace lm {
     LMATH_OUT float tanf(float X) noexcept;
     LMATH_OUT float sqrtf(float X) noexcept; // Only one iteration. ~0.175 ulp.
     LMATH_OUT float floorf(float X) noexcept;
+    LMATH_OUT float roundf(float X) noexcept; // ties away from zero
+    LMATH_OUT float roundevenf(float X) noexcept; // ties to even, as the SIMD lanes
+
+    struct sincos_f { float s; float c; };
+    LMATH_OUT sincos_f sincosf(float X) noexcept;
+    void sincosf(float X, float* S, float* C) noexcept;
 
 
     // ------------------------ Functions impl --------------------------------
@@ -46,6 +56,42 @@ namespace lm {
 
     LMATH_OUT float cosf(float X) noexcept { return sinf(X + PI_HALF); }
 
+    // sin and cos from one range reduction. Cody-Waite by pi/2 and cephes
+    // minimax polynomials, the same steps as the lane kernel behind sin4 /
+    // sin8 (detail::sincos_lanes), so the accuracy notes there apply:
+    // 2 ulp for |X| <= 8192. Plain arithmetic, usable in constant
+    // expressions (C++17).
+    LMATH_OUT sincos_f sincosf(float X) noexcept {
+        const float j = roundevenf(X * 0.636619772367581343f); // 2/pi, ties as the lanes
+        float r = X - j * 1.5703125f;
+        r = r - j * 4.837512969970703125e-4f;
+        r = r - j * 7.54978995489188216e-8f;
+        const float r2 = r * r;
+
+        float ps = -1.9515295891e-4f;
+        ps = ps * r2 + 8.3321608736e-3f;
+        ps = ps * r2 + -1.6666654611e-1f;
+        ps = ps * r2 * r + r;
+
+        float pc = 2.443315711809948e-5f;
+        pc = pc * r2 + -1.388731625493765e-3f;
+        pc = pc * r2 + 4.166664568298827e-2f;
+        pc = (pc * r2 * r2 - r2 * 0.5f) + 1.f;
+
+        // quadrant j mod 4
+        const float q = j - 4.f * roundevenf(j * 0.25f - 0.375f);
+        const bool odd = q == 1.f || q == 3.f;
+        const float s = odd ? pc : ps;
+        const float c = odd ? ps : pc;
+        return { q >= 2.f ? -s : s, (q == 1.f || q == 2.f) ? -c : c };
+    } // sincosf
+
+    inline void sincosf(float X, float* S, float* C) noexcept {
+        const sincos_f sc = sincosf(X);
+        *S = sc.s;
+        *C = sc.c;
+    }
+
 
     LMATH_OUT float tanf(float X) noexcept {
         const float x2 = X * X;
@@ -74,43 +120,55 @@ namespace lm {
     }
 
 
+#if !defined(LMATH_FORCE_NO_SIMD) && defined(__SSE__)
+    LMATH_FORCE_INLINE
+    LMATH_NO_DISCARD float rsqrtf_sse(float x) noexcept {
+        if (x <= 0.f) return 0.f;
+        __m128 v = _mm_set_ss(x);
+        __m128 y = _mm_rsqrt_ss(v);
+
+        // one Newton refinement
+        const __m128 half = _mm_set_ss(0.5f);
+        const __m128 three_halfs = _mm_set_ss(1.5f);
+
+        __m128 y2 = _mm_mul_ss(y, y);
+        __m128 xy2 = _mm_mul_ss(v, y2);
+        __m128 term = _mm_sub_ss(three_halfs, _mm_mul_ss(half, xy2));
+        y = _mm_mul_ss(y, term);
+
+        return _mm_cvtss_f32(y);
+    }
+#endif
+
     LMATH_FORCE_INLINE
     LMATH_NO_DISCARD float rsqrtf(float x) noexcept {
         if (x <= 0.f) return 0.f;
-#if !defined(__SSE__)
+#if defined(LMATH_FORCE_NO_SIMD) || !defined(__SSE__)
         return rsqrtf_scalar(x);
 #else
         switch (simd::max_level()) {
         case simd::Level::sse2:
         case simd::Level::avx:
-        case simd::Level::avx2: {
-            __m128 v = _mm_set_ss(x);
-            __m128 y = _mm_rsqrt_ss(v);
-
-            // one Newton refinement
-            const __m128 half = _mm_set_ss(0.5f);
-            const __m128 three_halfs = _mm_set_ss(1.5f);
-
-            __m128 y2 = _mm_mul_ss(y, y);
-            __m128 xy2 = _mm_mul_ss(v, y2);
-            __m128 term = _mm_sub_ss(three_halfs, _mm_mul_ss(half, xy2));
-            y = _mm_mul_ss(y, term);
-
-            return _mm_cvtss_f32(y);
-        }
+        case simd::Level::avx2:
+        case simd::Level::avx512:
+            return rsqrtf_sse(x);
         default: return rsqrtf_scalar(x);
         }
-    }
 #endif
     }
 
     LMATH_FORCE_INLINE
     LMATH_NO_DISCARD float rsqrtf_pos(float x) noexcept {
-    #if !defined(__SSE__)
+    #if defined(LMATH_FORCE_NO_SIMD) || !defined(__SSE__)
         return rsqrtf_scalar(x);
     #else
         __m128 v = _mm_set_ss(x);
         __m128 y = _mm_rsqrt_ss(v);
+
+        // one Newton refinement (raw estimate is only ~12 bits)
+        __m128 xy2 = _mm_mul_ss(_mm_mul_ss(v, y), y);
+        y = _mm_mul_ss(_mm_mul_ss(_mm_set_ss(0.5f), y),
+                       _mm_sub_ss(_mm_set_ss(3.f), xy2));
         return _mm_cvtss_f32(y);
     #endif
     }
@@ -126,4 +184,24 @@ namespace lm {
         if (X < 0.0f && X != static_cast<float>(i)) --i;
         return static_cast<float>(i);
     } // floorf
+
+    LMATH_OUT float roundf(float X) noexcept {
+        // |X| >= 2^23 is already integral (and may not fit an int)
+        if (!(X < 8388608.f && X > -8388608.f)) return X;
+        int i = (int)X;
+        const float f = X - static_cast<float>(i);
+        if (f >= 0.5f) ++i;
+        else if (f <= -0.5f) --i;
+        return static_cast<float>(i);
+    } // roundf
+
+    LMATH_OUT float roundevenf(float X) noexcept {
+        // |X| >= 2^23 is already integral (and may not fit an int)
+        if (!(X < 8388608.f && X > -8388608.f)) return X;
+        int i = (int)X;
+        const float f = X - static_cast<float>(i); // exact
+        if (f > 0.5f || (f == 0.5f && (i & 1))) ++i;
+        else if (f < -0.5f || (f == -0.5f && (i & 1))) --i;
+        return static_cast<float>(i);
+    } // roundevenf
 } // namespace lm
\ No newline at end of file
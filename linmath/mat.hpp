@@ -8,13 +8,11 @@
 #include "libc_integration.hpp"
 #include "vec.hpp"
 
-#if !defined(LMATH_FORCE_NO_SIMD)
-#   if defined(__SSE2__)
-#      include <emmintrin.h>
-#   endif
-#   if defined(__ARM_NEON)
-#      include <arm_neon.h>
-#   endif
+#if defined(__SSE2__)
+#   include <emmintrin.h>
+#endif
+#if defined(__ARM_NEON)
+#   include <arm_neon.h>
 #endif
 
 namespace lm {
@@ -41,6 +39,24 @@ namespace lm {
     using mat3   = mat3_of<float>;
     using mat4   = mat4_of<float>;
 
+    // ============================================================
+    // Batch store policy
+    // ============================================================
+    // How array kernels write their output:
+    //   cached     ordinary stores
+    //   streaming  non-temporal stores that bypass the cache, for outputs
+    //              that won't be read again soon (large arrays handed to
+    //              the GPU or the next frame)
+    //
+    // streaming needs `out` aligned to the vector width (16 bytes on SSE2,
+    // 32 on AVX, 64 on AVX-512) and falls back to cached stores otherwise.
+    // NEON has no non-temporal store and always uses cached.
+
+    enum class store_mode {
+        cached,
+        streaming,
+    };
+
 
     namespace detail {
 
@@ -136,187 +152,1122 @@ namespace lm {
 
 
         // ============================================================
-        // mat4 × mat4
+        // mat4 × vec4[] (batch)
+        //
+        // Columns stay in registers for the whole batch. Each kernel keeps
+        // the same add order as its single-vector twin above, so a batch
+        // is bit-identical to a loop of mat4_mul_vec() on the same level.
         // ============================================================
-
 #if defined(__SSE2__)
-        LMATH_FORCE_INLINE::lm::mat4 mat4_mul_sse2(const ::lm::mat4& A,
-            const ::lm::mat4& B) noexcept {
-            ::lm::mat4 R{};
+        inline void mat4_mul_vec_batch_sse2(const ::lm::mat4& M,
+                                            const ::lm::vec4* in,
+                                                  ::lm::vec4* out,
+                                            std::size_t n) noexcept {
+            const __m128 c0 = _mm_loadu_ps(M[0].data());
+            const __m128 c1 = _mm_loadu_ps(M[1].data());
+            const __m128 c2 = _mm_loadu_ps(M[2].data());
+            const __m128 c3 = _mm_loadu_ps(M[3].data());
 
-            const __m128 a0 = _mm_loadu_ps(A[0].data());
-            const __m128 a1 = _mm_loadu_ps(A[1].data());
-            const __m128 a2 = _mm_loadu_ps(A[2].data());
-            const __m128 a3 = _mm_loadu_ps(A[3].data());
+            auto xform = [&](__m128 v) noexcept -> __m128 {
+                const __m128 x = _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
+                const __m128 y = _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+                const __m128 z = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+                const __m128 w = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+                return _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(c0, x), _mm_mul_ps(c1, y)),
+                    _mm_add_ps(_mm_mul_ps(c2, z), _mm_mul_ps(c3, w))
+                );
+            };
 
-            {
-                const __m128 b0 = _mm_set1_ps(B[0][0]);
-                const __m128 b1 = _mm_set1_ps(B[0][1]);
-                const __m128 b2 = _mm_set1_ps(B[0][2]);
-                const __m128 b3 = _mm_set1_ps(B[0][3]);
-
-                const __m128 r =
-                    _mm_add_ps(
-                        _mm_add_ps(_mm_mul_ps(a0, b0), _mm_mul_ps(a1, b1)),
-                        _mm_add_ps(_mm_mul_ps(a2, b2), _mm_mul_ps(a3, b3))
-                    );
-
-                _mm_storeu_ps(R[0].data(), r);
+            const std::size_t n4 = n & ~std::size_t(3);
+            std::size_t i = 0;
+            for (; i < n4; i += 4) {
+                const __m128 v0 = _mm_loadu_ps(in[i + 0].data());
+                const __m128 v1 = _mm_loadu_ps(in[i + 1].data());
+                const __m128 v2 = _mm_loadu_ps(in[i + 2].data());
+                const __m128 v3 = _mm_loadu_ps(in[i + 3].data());
+                _mm_storeu_ps(out[i + 0].data(), xform(v0));
+                _mm_storeu_ps(out[i + 1].data(), xform(v1));
+                _mm_storeu_ps(out[i + 2].data(), xform(v2));
+                _mm_storeu_ps(out[i + 3].data(), xform(v3));
             }
+            for (; i < n; ++i)
+                _mm_storeu_ps(out[i].data(), xform(_mm_loadu_ps(in[i].data())));
+        }
+#endif
 
-            {
-                const __m128 b0 = _mm_set1_ps(B[1][0]);
-                const __m128 b1 = _mm_set1_ps(B[1][1]);
-                const __m128 b2 = _mm_set1_ps(B[1][2]);
-                const __m128 b3 = _mm_set1_ps(B[1][3]);
-
-                const __m128 r =
-                    _mm_add_ps(
-                        _mm_add_ps(_mm_mul_ps(a0, b0), _mm_mul_ps(a1, b1)),
-                        _mm_add_ps(_mm_mul_ps(a2, b2), _mm_mul_ps(a3, b3))
-                    );
-
-                _mm_storeu_ps(R[1].data(), r);
+#if defined(__ARM_NEON)
+        inline void mat4_mul_vec_batch_neon(const ::lm::mat4& M,
+                                            const ::lm::vec4* in,
+                                                  ::lm::vec4* out,
+                                            std::size_t n) noexcept {
+            const float32x4_t c0 = vld1q_f32(M[0].data());
+            const float32x4_t c1 = vld1q_f32(M[1].data());
+            const float32x4_t c2 = vld1q_f32(M[2].data());
+            const float32x4_t c3 = vld1q_f32(M[3].data());
+
+            auto xform = [&](float32x4_t v) noexcept -> float32x4_t {
+                const float32x2_t lo = vget_low_f32(v);
+                const float32x2_t hi = vget_high_f32(v);
+                float32x4_t r = vmulq_lane_f32(c0, lo, 0);
+                r = vmlaq_lane_f32(r, c1, lo, 1);
+                r = vmlaq_lane_f32(r, c2, hi, 0);
+                r = vmlaq_lane_f32(r, c3, hi, 1);
+                return r;
+            };
+
+            const std::size_t n4 = n & ~std::size_t(3);
+            std::size_t i = 0;
+            for (; i < n4; i += 4) {
+                const float32x4_t v0 = vld1q_f32(in[i + 0].data());
+                const float32x4_t v1 = vld1q_f32(in[i + 1].data());
+                const float32x4_t v2 = vld1q_f32(in[i + 2].data());
+                const float32x4_t v3 = vld1q_f32(in[i + 3].data());
+                vst1q_f32(out[i + 0].data(), xform(v0));
+                vst1q_f32(out[i + 1].data(), xform(v1));
+                vst1q_f32(out[i + 2].data(), xform(v2));
+                vst1q_f32(out[i + 3].data(), xform(v3));
             }
+            for (; i < n; ++i)
+                vst1q_f32(out[i].data(), xform(vld1q_f32(in[i].data())));
+        }
+#endif
 
-            {
-                const __m128 b0 = _mm_set1_ps(B[2][0]);
-                const __m128 b1 = _mm_set1_ps(B[2][1]);
-                const __m128 b2 = _mm_set1_ps(B[2][2]);
-                const __m128 b3 = _mm_set1_ps(B[2][3]);
-
-                const __m128 r =
-                    _mm_add_ps(
-                        _mm_add_ps(_mm_mul_ps(a0, b0), _mm_mul_ps(a1, b1)),
-                        _mm_add_ps(_mm_mul_ps(a2, b2), _mm_mul_ps(a3, b3))
-                    );
-
-                _mm_storeu_ps(R[2].data(), r);
+#if defined(__AVX__)
+        inline void mat4_mul_vec_batch_avx(const ::lm::mat4& M,
+                                           const ::lm::vec4* in,
+                                                 ::lm::vec4* out,
+                                           std::size_t n) noexcept {
+            const __m128 c0_128 = _mm_loadu_ps(M[0].data());
+            const __m128 c1_128 = _mm_loadu_ps(M[1].data());
+            const __m128 c2_128 = _mm_loadu_ps(M[2].data());
+            const __m128 c3_128 = _mm_loadu_ps(M[3].data());
+
+            // [Mcol | Mcol]: one vertex per 128-bit lane
+            const __m256 c0 = _mm256_insertf128_ps(_mm256_castps128_ps256(c0_128), c0_128, 1);
+            const __m256 c1 = _mm256_insertf128_ps(_mm256_castps128_ps256(c1_128), c1_128, 1);
+            const __m256 c2 = _mm256_insertf128_ps(_mm256_castps128_ps256(c2_128), c2_128, 1);
+            const __m256 c3 = _mm256_insertf128_ps(_mm256_castps128_ps256(c3_128), c3_128, 1);
+
+            // two vertices: (c0*x + c2*z) + (c1*y + c3*w), same order as mat4_mul_vec_avx
+            auto xform2 = [&](__m256 v) noexcept -> __m256 {
+                const __m256 x = _mm256_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
+                const __m256 y = _mm256_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+                const __m256 z = _mm256_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+                const __m256 w = _mm256_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+                return _mm256_add_ps(
+                    _mm256_add_ps(_mm256_mul_ps(c0, x), _mm256_mul_ps(c2, z)),
+                    _mm256_add_ps(_mm256_mul_ps(c1, y), _mm256_mul_ps(c3, w))
+                );
+            };
+
+            const std::size_t n4 = n & ~std::size_t(3);
+            std::size_t i = 0;
+            for (; i < n4; i += 4) {
+                const __m256 v01 = _mm256_loadu_ps(in[i + 0].data());
+                const __m256 v23 = _mm256_loadu_ps(in[i + 2].data());
+                _mm256_storeu_ps(out[i + 0].data(), xform2(v01));
+                _mm256_storeu_ps(out[i + 2].data(), xform2(v23));
+            }
+            if (i + 2 <= n) {
+                _mm256_storeu_ps(out[i].data(), xform2(_mm256_loadu_ps(in[i].data())));
+                i += 2;
             }
+            if (i < n)
+                out[i] = mat4_mul_vec_avx(M, in[i]);
+        }
+#endif
 
-            {
-                const __m128 b0 = _mm_set1_ps(B[3][0]);
-                const __m128 b1 = _mm_set1_ps(B[3][1]);
-                const __m128 b2 = _mm_set1_ps(B[3][2]);
-                const __m128 b3 = _mm_set1_ps(B[3][3]);
-
-                const __m128 r =
-                    _mm_add_ps(
-                        _mm_add_ps(_mm_mul_ps(a0, b0), _mm_mul_ps(a1, b1)),
-                        _mm_add_ps(_mm_mul_ps(a2, b2), _mm_mul_ps(a3, b3))
-                    );
-
-                _mm_storeu_ps(R[3].data(), r);
+#if defined(__AVX512F__)
+        // The unmasked _mm512_broadcast_f32x4 / _mm512_permute_ps pass GCC's
+        // self-initialized _mm512_undefined_ps() as merge source, which
+        // -Wall reports as uninitialized. All-ones masks over a defined
+        // source emit the same instruction.
+
+        // [x | x | x | x]
+        LMATH_FORCE_INLINE __m512 avx512_broadcast_f32x4(__m128 x) noexcept {
+            return _mm512_mask_broadcast_f32x4(_mm512_castps128_ps512(x), __mmask16(0xFFFF), x);
+        }
+
+        // element k of every 128-bit lane, splatted within the lane
+        template<int k>
+        LMATH_FORCE_INLINE __m512 avx512_splat_lane(__m512 v) noexcept {
+            return _mm512_mask_permute_ps(v, __mmask16(0xFFFF), v, _MM_SHUFFLE(k, k, k, k));
+        }
+
+        inline void mat4_mul_vec_batch_avx512(const ::lm::mat4& M,
+                                              const ::lm::vec4* in,
+                                                    ::lm::vec4* out,
+                                              std::size_t n) noexcept {
+            // [Mcol | Mcol | Mcol | Mcol]: one vertex per 128-bit lane
+            const __m512 c0 = avx512_broadcast_f32x4(_mm_loadu_ps(M[0].data()));
+            const __m512 c1 = avx512_broadcast_f32x4(_mm_loadu_ps(M[1].data()));
+            const __m512 c2 = avx512_broadcast_f32x4(_mm_loadu_ps(M[2].data()));
+            const __m512 c3 = avx512_broadcast_f32x4(_mm_loadu_ps(M[3].data()));
+
+            // four vertices, same add order as mat4_mul_vec_batch_avx
+            auto xform4 = [&](__m512 v) noexcept -> __m512 {
+                const __m512 x = avx512_splat_lane<0>(v);
+                const __m512 y = avx512_splat_lane<1>(v);
+                const __m512 z = avx512_splat_lane<2>(v);
+                const __m512 w = avx512_splat_lane<3>(v);
+                return _mm512_add_ps(
+                    _mm512_add_ps(_mm512_mul_ps(c0, x), _mm512_mul_ps(c2, z)),
+                    _mm512_add_ps(_mm512_mul_ps(c1, y), _mm512_mul_ps(c3, w))
+                );
+            };
+
+            const std::size_t n8 = n & ~std::size_t(7);
+            std::size_t i = 0;
+            for (; i < n8; i += 8) {
+                const __m512 v0 = _mm512_loadu_ps(in[i + 0].data());
+                const __m512 v4 = _mm512_loadu_ps(in[i + 4].data());
+                _mm512_storeu_ps(out[i + 0].data(), xform4(v0));
+                _mm512_storeu_ps(out[i + 4].data(), xform4(v4));
+            }
+            if (i + 4 <= n) {
+                _mm512_storeu_ps(out[i].data(), xform4(_mm512_loadu_ps(in[i].data())));
+                i += 4;
+            }
+            if (i < n)
+                mat4_mul_vec_batch_avx(M, in + i, out + i, n - i);
+        }
+#endif
+
+
+
+        // ============================================================
+        // mat4 × vec3[] (packed, w implied: 1 for points, 0 for dirs)
+        //
+        // Four (SSE2/NEON) or eight (AVX) vertices are transposed to SoA,
+        // transformed with broadcast matrix entries and transposed back.
+        // Every path uses the scalar add order, so all levels agree bit
+        // for bit. Tails shorter than a block go through the scalar loop,
+        // so nothing is read or written past `n`.
+        // ============================================================
+        template<bool Point>
+        inline void mat4_transform_vec3_scalar(const ::lm::mat4& M,
+                                               const ::lm::vec3* in,
+                                                     ::lm::vec3* out,
+                                               std::size_t n) noexcept {
+            for (std::size_t i = 0; i < n; ++i) {
+                const float x = in[i][0];
+                const float y = in[i][1];
+                const float z = in[i][2];
+                for (int r = 0; r < 3; ++r) {
+                    float s = M[0][r] * x + M[1][r] * y + M[2][r] * z;
+                    if (Point) s += M[3][r];
+                    out[i][r] = s;
+                }
+            }
+        }
+
+#if defined(__SSE2__)
+        template<bool Point>
+        inline void mat4_transform_vec3_sse2(const ::lm::mat4& M,
+                                             const ::lm::vec3* in,
+                                                   ::lm::vec3* out,
+                                             std::size_t n) noexcept {
+            __m128 m[4][3];
+            for (int c = 0; c < 4; ++c)
+                for (int r = 0; r < 3; ++r)
+                    m[c][r] = _mm_set1_ps(M[c][r]);
+
+            const std::size_t n4 = n & ~std::size_t(3);
+            for (std::size_t i = 0; i < n4; i += 4) {
+                __m128 x, y, z;
+                vec3x4_load_sse2(in[i].data(), x, y, z);
+
+                __m128 r[3];
+                for (int k = 0; k < 3; ++k) {
+                    r[k] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m[0][k], x), _mm_mul_ps(m[1][k], y)),
+                                      _mm_mul_ps(m[2][k], z));
+                    if (Point) r[k] = _mm_add_ps(r[k], m[3][k]);
+                }
+
+                vec3x4_store_sse2(out[i].data(), r[0], r[1], r[2]);
+            }
+            mat4_transform_vec3_scalar<Point>(M, in + n4, out + n4, n - n4);
+        }
+#endif
+
+#if defined(__ARM_NEON)
+        template<bool Point>
+        inline void mat4_transform_vec3_neon(const ::lm::mat4& M,
+                                             const ::lm::vec3* in,
+                                                   ::lm::vec3* out,
+                                             std::size_t n) noexcept {
+            const std::size_t n4 = n & ~std::size_t(3);
+            for (std::size_t i = 0; i < n4; i += 4) {
+                // vld3q/vst3q do the AoS <-> SoA shuffle for free
+                const float32x4x3_t v = vld3q_f32(in[i].data());
+                float32x4x3_t r;
+                for (int k = 0; k < 3; ++k) {
+                    float32x4_t s = vmulq_n_f32(v.val[0], M[0][k]);
+                    s = vmlaq_n_f32(s, v.val[1], M[1][k]);
+                    s = vmlaq_n_f32(s, v.val[2], M[2][k]);
+                    if (Point) s = vaddq_f32(s, vdupq_n_f32(M[3][k]));
+                    r.val[k] = s;
+                }
+                vst3q_f32(out[i].data(), r);
+            }
+            mat4_transform_vec3_scalar<Point>(M, in + n4, out + n4, n - n4);
+        }
+#endif
+
+#if defined(__AVX__)
+        template<bool Point>
+        inline void mat4_transform_vec3_avx(const ::lm::mat4& M,
+                                            const ::lm::vec3* in,
+                                                  ::lm::vec3* out,
+                                            std::size_t n) noexcept {
+            __m256 m[4][3];
+            for (int c = 0; c < 4; ++c)
+                for (int r = 0; r < 3; ++r)
+                    m[c][r] = _mm256_set1_ps(M[c][r]);
+
+            const std::size_t n8 = n & ~std::size_t(7);
+            for (std::size_t i = 0; i < n8; i += 8) {
+                __m256 x, y, z;
+                vec3x8_load_avx(in[i].data(), x, y, z);
+
+                __m256 r[3];
+                for (int k = 0; k < 3; ++k) {
+                    r[k] = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m[0][k], x), _mm256_mul_ps(m[1][k], y)),
+                                         _mm256_mul_ps(m[2][k], z));
+                    if (Point) r[k] = _mm256_add_ps(r[k], m[3][k]);
+                }
+
+                vec3x8_store_avx(out[i].data(), r[0], r[1], r[2]);
             }
+            mat4_transform_vec3_sse2<Point>(M, in + n8, out + n8, n - n8);
+        }
+#endif
+
+        // ============================================================
+        // mat4 × mat4
+        //
+        // Each kernel is split into a column step over A's columns held in
+        // registers, shared with the batch kernels below.
+        // ============================================================
+
+#if defined(__SSE2__)
+        // (a0*b0 + a1*b1) + (a2*b2 + a3*b3) for one column b of B
+        LMATH_FORCE_INLINE __m128 mat4_mul_col_sse2(const __m128 (&a)[4], const float* b) noexcept {
+            return _mm_add_ps(
+                _mm_add_ps(_mm_mul_ps(a[0], _mm_set1_ps(b[0])), _mm_mul_ps(a[1], _mm_set1_ps(b[1]))),
+                _mm_add_ps(_mm_mul_ps(a[2], _mm_set1_ps(b[2])), _mm_mul_ps(a[3], _mm_set1_ps(b[3])))
+            );
+        }
+
+        LMATH_FORCE_INLINE void mat4_load_cols_sse2(const ::lm::mat4& A, __m128 (&a)[4]) noexcept {
+            a[0] = _mm_loadu_ps(A[0].data());
+            a[1] = _mm_loadu_ps(A[1].data());
+            a[2] = _mm_loadu_ps(A[2].data());
+            a[3] = _mm_loadu_ps(A[3].data());
+        }
+
+        LMATH_FORCE_INLINE::lm::mat4 mat4_mul_sse2(const ::lm::mat4& A,
+            const ::lm::mat4& B) noexcept {
+            __m128 a[4];
+            mat4_load_cols_sse2(A, a);
 
+            ::lm::mat4 R{};
+            _mm_storeu_ps(R[0].data(), mat4_mul_col_sse2(a, B[0].data()));
+            _mm_storeu_ps(R[1].data(), mat4_mul_col_sse2(a, B[1].data()));
+            _mm_storeu_ps(R[2].data(), mat4_mul_col_sse2(a, B[2].data()));
+            _mm_storeu_ps(R[3].data(), mat4_mul_col_sse2(a, B[3].data()));
             return R;
         }
 #endif
 
 #if defined(__ARM_NEON)
+        // ((a0*b0 + a1*b1) + a2*b2) + a3*b3 for one column b of B
+        LMATH_FORCE_INLINE float32x4_t mat4_mul_col_neon(const float32x4_t (&a)[4], const float* b) noexcept {
+            float32x4_t r = vmulq_n_f32(a[0], b[0]);
+            r = vmlaq_n_f32(r, a[1], b[1]);
+            r = vmlaq_n_f32(r, a[2], b[2]);
+            r = vmlaq_n_f32(r, a[3], b[3]);
+            return r;
+        }
+
+        LMATH_FORCE_INLINE void mat4_load_cols_neon(const ::lm::mat4& A, float32x4_t (&a)[4]) noexcept {
+            a[0] = vld1q_f32(A[0].data());
+            a[1] = vld1q_f32(A[1].data());
+            a[2] = vld1q_f32(A[2].data());
+            a[3] = vld1q_f32(A[3].data());
+        }
+
         LMATH_FORCE_INLINE::lm::mat4 mat4_mul_neon(const ::lm::mat4& A,
             const ::lm::mat4& B) noexcept {
+            float32x4_t a[4];
+            mat4_load_cols_neon(A, a);
+
             ::lm::mat4 R{};
+            vst1q_f32(R[0].data(), mat4_mul_col_neon(a, B[0].data()));
+            vst1q_f32(R[1].data(), mat4_mul_col_neon(a, B[1].data()));
+            vst1q_f32(R[2].data(), mat4_mul_col_neon(a, B[2].data()));
+            vst1q_f32(R[3].data(), mat4_mul_col_neon(a, B[3].data()));
+            return R;
+        }
+#endif
 
-            const float32x4_t a0 = vld1q_f32(A[0].data());
-            const float32x4_t a1 = vld1q_f32(A[1].data());
-            const float32x4_t a2 = vld1q_f32(A[2].data());
-            const float32x4_t a3 = vld1q_f32(A[3].data());
+#if defined(__AVX__)
+        // columns b and b + 4 of B at once; a = [Acol | Acol]
+        LMATH_FORCE_INLINE __m256 mat4_mul_col2_avx(const __m256 (&a)[4], const float* b) noexcept {
+            // low lane = b[k] x4, high lane = b[4 + k] x4
+            auto lane_broadcast2 = [](float x, float y) noexcept -> __m256 {
+                const __m128 lo = _mm_set1_ps(x);
+                const __m128 hi = _mm_set1_ps(y);
+                return _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1);
+            };
 
-            {
-                float32x4_t r = vmulq_n_f32(a0, B[0][0]);
-                r = vmlaq_n_f32(r, a1, B[0][1]);
-                r = vmlaq_n_f32(r, a2, B[0][2]);
-                r = vmlaq_n_f32(r, a3, B[0][3]);
-                vst1q_f32(R[0].data(), r);
-            }
+            const __m256 b0 = lane_broadcast2(b[0], b[4]);
+            const __m256 b1 = lane_broadcast2(b[1], b[5]);
+            const __m256 b2 = lane_broadcast2(b[2], b[6]);
+            const __m256 b3 = lane_broadcast2(b[3], b[7]);
 
-            {
-                float32x4_t r = vmulq_n_f32(a0, B[1][0]);
-                r = vmlaq_n_f32(r, a1, B[1][1]);
-                r = vmlaq_n_f32(r, a2, B[1][2]);
-                r = vmlaq_n_f32(r, a3, B[1][3]);
-                vst1q_f32(R[1].data(), r);
+            return _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(a[0], b0), _mm256_mul_ps(a[1], b1)),
+                _mm256_add_ps(_mm256_mul_ps(a[2], b2), _mm256_mul_ps(a[3], b3))
+            );
+        }
+
+        // duplicate each A column into both 128-bit lanes: [Acol | Acol]
+        LMATH_FORCE_INLINE void mat4_load_cols_avx(const ::lm::mat4& A, __m256 (&a)[4]) noexcept {
+            a[0] = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(A[0].data()));
+            a[1] = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(A[1].data()));
+            a[2] = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(A[2].data()));
+            a[3] = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(A[3].data()));
+        }
+
+        LMATH_FORCE_INLINE::lm::mat4 mat4_mul_avx(const ::lm::mat4& A,
+                                                  const ::lm::mat4& B) noexcept {
+            __m256 a[4];
+            mat4_load_cols_avx(A, a);
+
+            ::lm::mat4 R{};
+            _mm256_storeu_ps(R[0].data(), mat4_mul_col2_avx(a, B[0].data())); // columns 0, 1
+            _mm256_storeu_ps(R[2].data(), mat4_mul_col2_avx(a, B[2].data())); // columns 2, 3
+            return R;
+        }
+#endif
+
+#if defined(__AVX512F__)
+        // all four columns of B in one register, lane j = column j;
+        // a = [Acol | Acol | Acol | Acol]
+        LMATH_FORCE_INLINE __m512 mat4_mul_cols_avx512(const __m512 (&a)[4], __m512 b) noexcept {
+            // bk lane j = B[j][k] splatted
+            const __m512 b0 = avx512_splat_lane<0>(b);
+            const __m512 b1 = avx512_splat_lane<1>(b);
+            const __m512 b2 = avx512_splat_lane<2>(b);
+            const __m512 b3 = avx512_splat_lane<3>(b);
+
+            // same add order as mat4_mul_sse2 / mat4_mul_avx
+            return _mm512_add_ps(
+                _mm512_add_ps(_mm512_mul_ps(a[0], b0), _mm512_mul_ps(a[1], b1)),
+                _mm512_add_ps(_mm512_mul_ps(a[2], b2), _mm512_mul_ps(a[3], b3))
+            );
+        }
+
+        LMATH_FORCE_INLINE void mat4_load_cols_avx512(const ::lm::mat4& A, __m512 (&a)[4]) noexcept {
+            a[0] = avx512_broadcast_f32x4(_mm_loadu_ps(A[0].data()));
+            a[1] = avx512_broadcast_f32x4(_mm_loadu_ps(A[1].data()));
+            a[2] = avx512_broadcast_f32x4(_mm_loadu_ps(A[2].data()));
+            a[3] = avx512_broadcast_f32x4(_mm_loadu_ps(A[3].data()));
+        }
+
+        LMATH_FORCE_INLINE::lm::mat4 mat4_mul_avx512(const ::lm::mat4& A,
+                                                     const ::lm::mat4& B) noexcept {
+            __m512 a[4];
+            mat4_load_cols_avx512(A, a);
+
+            ::lm::mat4 R{};
+            _mm512_storeu_ps(R[0].data(), mat4_mul_cols_avx512(a, _mm512_loadu_ps(B[0].data())));
+            return R;
+        }
+#endif
+
+        // ============================================================
+        // mat4 × mat4[] (batch)
+        //
+        // out[i] = A[i] * B[i], or A[0] * B[i] with Left, where A's columns
+        // are loaded once for the whole batch. Two products per iteration:
+        // both are computed before either is stored, so the multiply chain
+        // of one overlaps the loads and stores of the other. The column
+        // steps are the single-call ones above, so a batch is bit-identical
+        // to a loop of mat4_mul() on the same level (FMA variants aside).
+        //
+        // With Stream, stores are non-temporal and the batch ends with an
+        // sfence; the entry points only pick it when `out` is aligned to
+        // the store width.
+        // ============================================================
+
+        LMATH_FORCE_INLINE bool is_aligned(const void* p, std::size_t align) noexcept {
+            return reinterpret_cast<std::uintptr_t>(p) % align == 0;
+        }
+
+#if defined(__SSE2__)
+        template<bool Stream>
+        LMATH_FORCE_INLINE void mat4_store_cols_sse2(::lm::mat4& R, const __m128 (&r)[4]) noexcept {
+            if (Stream) {
+                _mm_stream_ps(R[0].data(), r[0]);
+                _mm_stream_ps(R[1].data(), r[1]);
+                _mm_stream_ps(R[2].data(), r[2]);
+                _mm_stream_ps(R[3].data(), r[3]);
+            } else {
+                _mm_storeu_ps(R[0].data(), r[0]);
+                _mm_storeu_ps(R[1].data(), r[1]);
+                _mm_storeu_ps(R[2].data(), r[2]);
+                _mm_storeu_ps(R[3].data(), r[3]);
             }
+        }
 
-            {
-                float32x4_t r = vmulq_n_f32(a0, B[2][0]);
-                r = vmlaq_n_f32(r, a1, B[2][1]);
-                r = vmlaq_n_f32(r, a2, B[2][2]);
-                r = vmlaq_n_f32(r, a3, B[2][3]);
-                vst1q_f32(R[2].data(), r);
+        LMATH_FORCE_INLINE void mat4_mul_cols_sse2(const __m128 (&a)[4], const ::lm::mat4& B,
+                                                   __m128 (&r)[4]) noexcept {
+            r[0] = mat4_mul_col_sse2(a, B[0].data());
+            r[1] = mat4_mul_col_sse2(a, B[1].data());
+            r[2] = mat4_mul_col_sse2(a, B[2].data());
+            r[3] = mat4_mul_col_sse2(a, B[3].data());
+        }
+
+        template<bool Left, bool Stream>
+        inline void mat4_mul_array_sse2(const ::lm::mat4* A, const ::lm::mat4* B,
+                                        ::lm::mat4* out, std::size_t n) noexcept {
+            __m128 a[4], a0[4], a1[4];
+            if (Left) mat4_load_cols_sse2(A[0], a);
+
+            std::size_t i = 0;
+            for (; i + 2 <= n; i += 2) {
+                if (!Left) {
+                    mat4_load_cols_sse2(A[i], a0);
+                    mat4_load_cols_sse2(A[i + 1], a1);
+                }
+                __m128 r0[4], r1[4];
+                mat4_mul_cols_sse2(Left ? a : a0, B[i], r0);
+                mat4_mul_cols_sse2(Left ? a : a1, B[i + 1], r1);
+                mat4_store_cols_sse2<Stream>(out[i], r0);
+                mat4_store_cols_sse2<Stream>(out[i + 1], r1);
             }
+            if (i < n) {
+                if (!Left) mat4_load_cols_sse2(A[i], a0);
+                __m128 r0[4];
+                mat4_mul_cols_sse2(Left ? a : a0, B[i], r0);
+                mat4_store_cols_sse2<Stream>(out[i], r0);
+            }
+            if (Stream) _mm_sfence();
+        }
 
-            {
-                float32x4_t r = vmulq_n_f32(a0, B[3][0]);
-                r = vmlaq_n_f32(r, a1, B[3][1]);
-                r = vmlaq_n_f32(r, a2, B[3][2]);
-                r = vmlaq_n_f32(r, a3, B[3][3]);
-                vst1q_f32(R[3].data(), r);
+        inline void mat4_mul_batch_sse2(const ::lm::mat4* A, const ::lm::mat4* B,
+                                        ::lm::mat4* out, std::size_t n, ::lm::store_mode mode) noexcept {
+            if (mode == ::lm::store_mode::streaming && is_aligned(out, 16))
+                mat4_mul_array_sse2<false, true>(A, B, out, n);
+            else
+                mat4_mul_array_sse2<false, false>(A, B, out, n);
+        }
+
+        inline void mat4_mul_batch_left_sse2(const ::lm::mat4& A, const ::lm::mat4* B,
+                                             ::lm::mat4* out, std::size_t n, ::lm::store_mode mode) noexcept {
+            if (mode == ::lm::store_mode::streaming && is_aligned(out, 16))
+                mat4_mul_array_sse2<true, true>(&A, B, out, n);
+            else
+                mat4_mul_array_sse2<true, false>(&A, B, out, n);
+        }
+#endif
+
+#if defined(__ARM_NEON)
+        LMATH_FORCE_INLINE void mat4_mul_cols_neon(const float32x4_t (&a)[4], const ::lm::mat4& B,
+                                                   float32x4_t (&r)[4]) noexcept {
+            r[0] = mat4_mul_col_neon(a, B[0].data());
+            r[1] = mat4_mul_col_neon(a, B[1].data());
+            r[2] = mat4_mul_col_neon(a, B[2].data());
+            r[3] = mat4_mul_col_neon(a, B[3].data());
+        }
+
+        LMATH_FORCE_INLINE void mat4_store_cols_neon(::lm::mat4& R, const float32x4_t (&r)[4]) noexcept {
+            vst1q_f32(R[0].data(), r[0]);
+            vst1q_f32(R[1].data(), r[1]);
+            vst1q_f32(R[2].data(), r[2]);
+            vst1q_f32(R[3].data(), r[3]);
+        }
+
+        // no non-temporal stores on NEON: store_mode is ignored
+        template<bool Left>
+        inline void mat4_mul_array_neon(const ::lm::mat4* A, const ::lm::mat4* B,
+                                        ::lm::mat4* out, std::size_t n) noexcept {
+            float32x4_t a[4], a0[4], a1[4];
+            if (Left) mat4_load_cols_neon(A[0], a);
+
+            std::size_t i = 0;
+            for (; i + 2 <= n; i += 2) {
+                if (!Left) {
+                    mat4_load_cols_neon(A[i], a0);
+                    mat4_load_cols_neon(A[i + 1], a1);
+                }
+                float32x4_t r0[4], r1[4];
+                mat4_mul_cols_neon(Left ? a : a0, B[i], r0);
+                mat4_mul_cols_neon(Left ? a : a1, B[i + 1], r1);
+                mat4_store_cols_neon(out[i], r0);
+                mat4_store_cols_neon(out[i + 1], r1);
+            }
+            if (i < n) {
+                if (!Left) mat4_load_cols_neon(A[i], a0);
+                float32x4_t r0[4];
+                mat4_mul_cols_neon(Left ? a : a0, B[i], r0);
+                mat4_store_cols_neon(out[i], r0);
             }
+        }
 
-            return R;
+        inline void mat4_mul_batch_neon(const ::lm::mat4* A, const ::lm::mat4* B,
+                                        ::lm::mat4* out, std::size_t n, ::lm::store_mode) noexcept {
+            mat4_mul_array_neon<false>(A, B, out, n);
+        }
+
+        inline void mat4_mul_batch_left_neon(const ::lm::mat4& A, const ::lm::mat4* B,
+                                             ::lm::mat4* out, std::size_t n, ::lm::store_mode) noexcept {
+            mat4_mul_array_neon<true>(&A, B, out, n);
         }
 #endif
 
 #if defined(__AVX__)
-        LMATH_FORCE_INLINE::lm::mat4 mat4_mul_avx(const ::lm::mat4& A,
+        // columns 0, 1 in r[0] and 2, 3 in r[1]
+        template<bool Stream>
+        LMATH_FORCE_INLINE void mat4_store_cols_avx(::lm::mat4& R, const __m256 (&r)[2]) noexcept {
+            if (Stream) {
+                _mm256_stream_ps(R[0].data(), r[0]);
+                _mm256_stream_ps(R[2].data(), r[1]);
+            } else {
+                _mm256_storeu_ps(R[0].data(), r[0]);
+                _mm256_storeu_ps(R[2].data(), r[1]);
+            }
+        }
+
+        template<bool Left, bool Stream>
+        inline void mat4_mul_array_avx(const ::lm::mat4* A, const ::lm::mat4* B,
+                                       ::lm::mat4* out, std::size_t n) noexcept {
+            __m256 a[4], a0[4], a1[4];
+            if (Left) mat4_load_cols_avx(A[0], a);
+
+            std::size_t i = 0;
+            for (; i + 2 <= n; i += 2) {
+                if (!Left) {
+                    mat4_load_cols_avx(A[i], a0);
+                    mat4_load_cols_avx(A[i + 1], a1);
+                }
+                const __m256 r0[2] = {
+                    mat4_mul_col2_avx(Left ? a : a0, B[i][0].data()),
+                    mat4_mul_col2_avx(Left ? a : a0, B[i][2].data()),
+                };
+                const __m256 r1[2] = {
+                    mat4_mul_col2_avx(Left ? a : a1, B[i + 1][0].data()),
+                    mat4_mul_col2_avx(Left ? a : a1, B[i + 1][2].data()),
+                };
+                mat4_store_cols_avx<Stream>(out[i], r0);
+                mat4_store_cols_avx<Stream>(out[i + 1], r1);
+            }
+            if (i < n) {
+                if (!Left) mat4_load_cols_avx(A[i], a0);
+                const __m256 r0[2] = {
+                    mat4_mul_col2_avx(Left ? a : a0, B[i][0].data()),
+                    mat4_mul_col2_avx(Left ? a : a0, B[i][2].data()),
+                };
+                mat4_store_cols_avx<Stream>(out[i], r0);
+            }
+            if (Stream) _mm_sfence();
+        }
+
+        inline void mat4_mul_batch_avx(const ::lm::mat4* A, const ::lm::mat4* B,
+                                       ::lm::mat4* out, std::size_t n, ::lm::store_mode mode) noexcept {
+            if (mode == ::lm::store_mode::streaming && is_aligned(out, 32))
+                mat4_mul_array_avx<false, true>(A, B, out, n);
+            else
+                mat4_mul_array_avx<false, false>(A, B, out, n);
+        }
+
+        inline void mat4_mul_batch_left_avx(const ::lm::mat4& A, const ::lm::mat4* B,
+                                            ::lm::mat4* out, std::size_t n, ::lm::store_mode mode) noexcept {
+            if (mode == ::lm::store_mode::streaming && is_aligned(out, 32))
+                mat4_mul_array_avx<true, true>(&A, B, out, n);
+            else
+                mat4_mul_array_avx<true, false>(&A, B, out, n);
+        }
+#endif
+
+#if defined(__AVX512F__)
+        template<bool Stream>
+        LMATH_FORCE_INLINE void mat4_store_cols_avx512(::lm::mat4& R, __m512 r) noexcept {
+            if (Stream) _mm512_stream_ps(R[0].data(), r);
+            else        _mm512_storeu_ps(R[0].data(), r);
+        }
+
+        template<bool Left, bool Stream>
+        inline void mat4_mul_array_avx512(const ::lm::mat4* A, const ::lm::mat4* B,
+                                          ::lm::mat4* out, std::size_t n) noexcept {
+            __m512 a[4], a0[4], a1[4];
+            if (Left) mat4_load_cols_avx512(A[0], a);
+
+            std::size_t i = 0;
+            for (; i + 2 <= n; i += 2) {
+                if (!Left) {
+                    mat4_load_cols_avx512(A[i], a0);
+                    mat4_load_cols_avx512(A[i + 1], a1);
+                }
+                const __m512 r0 = mat4_mul_cols_avx512(Left ? a : a0, _mm512_loadu_ps(B[i][0].data()));
+                const __m512 r1 = mat4_mul_cols_avx512(Left ? a : a1, _mm512_loadu_ps(B[i + 1][0].data()));
+                mat4_store_cols_avx512<Stream>(out[i], r0);
+                mat4_store_cols_avx512<Stream>(out[i + 1], r1);
+            }
+            if (i < n) {
+                if (!Left) mat4_load_cols_avx512(A[i], a0);
+                const __m512 r0 = mat4_mul_cols_avx512(Left ? a : a0, _mm512_loadu_ps(B[i][0].data()));
+                mat4_store_cols_avx512<Stream>(out[i], r0);
+            }
+            if (Stream) _mm_sfence();
+        }
+
+        inline void mat4_mul_batch_avx512(const ::lm::mat4* A, const ::lm::mat4* B,
+                                          ::lm::mat4* out, std::size_t n, ::lm::store_mode mode) noexcept {
+            if (mode == ::lm::store_mode::streaming && is_aligned(out, 64))
+                mat4_mul_array_avx512<false, true>(A, B, out, n);
+            else
+                mat4_mul_array_avx512<false, false>(A, B, out, n);
+        }
+
+        inline void mat4_mul_batch_left_avx512(const ::lm::mat4& A, const ::lm::mat4* B,
+                                               ::lm::mat4* out, std::size_t n, ::lm::store_mode mode) noexcept {
+            if (mode == ::lm::store_mode::streaming && is_aligned(out, 64))
+                mat4_mul_array_avx512<true, true>(&A, B, out, n);
+            else
+                mat4_mul_array_avx512<true, false>(&A, B, out, n);
+        }
+#endif
+
+        // ============================================================
+        // FMA variants (LMATH_USE_FMA)
+        //
+        // Same pairing as the kernels above, with the first add of each
+        // pair fused: (a0*b0 + a1*b1) becomes fma(a1, b1, a0*b0). One
+        // rounding fewer per pair, so results differ from the separate
+        // mul/add paths (and linmath.h / glm) in the last bit.
+        // ============================================================
+#if LMATH_HAS_FMA && defined(__FMA__)
+        LMATH_FORCE_INLINE::lm::vec4 mat4_mul_vec_fma(const ::lm::mat4& M,
+                                                      const ::lm::vec4& V) noexcept {
+            const __m128 c0 = _mm_loadu_ps(M[0].data());
+            const __m128 c1 = _mm_loadu_ps(M[1].data());
+            const __m128 c2 = _mm_loadu_ps(M[2].data());
+            const __m128 c3 = _mm_loadu_ps(M[3].data());
+
+            const __m128 r01 = _mm_fmadd_ps(c1, _mm_set1_ps(V[1]), _mm_mul_ps(c0, _mm_set1_ps(V[0])));
+            const __m128 r23 = _mm_fmadd_ps(c3, _mm_set1_ps(V[3]), _mm_mul_ps(c2, _mm_set1_ps(V[2])));
+
+            ::lm::vec4 out{};
+            _mm_storeu_ps(out.data(), _mm_add_ps(r01, r23));
+            return out;
+        }
+
+        LMATH_FORCE_INLINE::lm::mat4 mat4_mul_fma(const ::lm::mat4& A,
                                                   const ::lm::mat4& B) noexcept {
-            ::lm::mat4 R{};
             const __m128 a0_128 = _mm_loadu_ps(A[0].data());
             const __m128 a1_128 = _mm_loadu_ps(A[1].data());
             const __m128 a2_128 = _mm_loadu_ps(A[2].data());
             const __m128 a3_128 = _mm_loadu_ps(A[3].data());
 
-            // duplicate each A column into both 128-bit lanes:
-            // [Acol | Acol]
+            // [Acol | Acol], two result columns per register as in mat4_mul_avx
             const __m256 a0 = _mm256_insertf128_ps(_mm256_castps128_ps256(a0_128), a0_128, 1);
             const __m256 a1 = _mm256_insertf128_ps(_mm256_castps128_ps256(a1_128), a1_128, 1);
             const __m256 a2 = _mm256_insertf128_ps(_mm256_castps128_ps256(a2_128), a2_128, 1);
             const __m256 a3 = _mm256_insertf128_ps(_mm256_castps128_ps256(a3_128), a3_128, 1);
 
-            // helper: low lane = xxxx, high lane = yyyy
             auto lane_broadcast2 = [](float x, float y) noexcept -> __m256 {
-                const __m128 lo = _mm_set1_ps(x);
-                const __m128 hi = _mm_set1_ps(y);
-                return _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1);
+                return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_set1_ps(x)), _mm_set1_ps(y), 1);
             };
 
-            // columns 0 and 1
-            {
-                const __m256 b0 = lane_broadcast2(B[0][0], B[1][0]);
-                const __m256 b1 = lane_broadcast2(B[0][1], B[1][1]);
-                const __m256 b2 = lane_broadcast2(B[0][2], B[1][2]);
-                const __m256 b3 = lane_broadcast2(B[0][3], B[1][3]);
-
-                const __m256 r =
-                    _mm256_add_ps(
-                        _mm256_add_ps(_mm256_mul_ps(a0, b0), _mm256_mul_ps(a1, b1)),
-                        _mm256_add_ps(_mm256_mul_ps(a2, b2), _mm256_mul_ps(a3, b3))
-                    );
-
-                _mm_storeu_ps(R[0].data(), _mm256_castps256_ps128(r));
-                _mm_storeu_ps(R[1].data(), _mm256_extractf128_ps(r, 1));
+            auto two_cols = [&](const ::lm::vec4& p, const ::lm::vec4& q) noexcept -> __m256 {
+                const __m256 r01 = _mm256_fmadd_ps(a1, lane_broadcast2(p[1], q[1]),
+                                                   _mm256_mul_ps(a0, lane_broadcast2(p[0], q[0])));
+                const __m256 r23 = _mm256_fmadd_ps(a3, lane_broadcast2(p[3], q[3]),
+                                                   _mm256_mul_ps(a2, lane_broadcast2(p[2], q[2])));
+                return _mm256_add_ps(r01, r23);
+            };
+
+            ::lm::mat4 R{};
+            _mm256_storeu_ps(R[0].data(), two_cols(B[0], B[1]));
+            _mm256_storeu_ps(R[2].data(), two_cols(B[2], B[3]));
+            return R;
+        }
+#endif
+
+#if LMATH_HAS_FMA && defined(__ARM_NEON)
+        LMATH_FORCE_INLINE::lm::vec4 mat4_mul_vec_fma(const ::lm::mat4& M,
+                                                      const ::lm::vec4& V) noexcept {
+            const float32x4_t r01 = vfmaq_f32(vmulq_n_f32(vld1q_f32(M[0].data()), V[0]),
+                                              vld1q_f32(M[1].data()), vdupq_n_f32(V[1]));
+            const float32x4_t r23 = vfmaq_f32(vmulq_n_f32(vld1q_f32(M[2].data()), V[2]),
+                                              vld1q_f32(M[3].data()), vdupq_n_f32(V[3]));
+            ::lm::vec4 out{};
+            vst1q_f32(out.v, vaddq_f32(r01, r23));
+            return out;
+        }
+
+        LMATH_FORCE_INLINE::lm::mat4 mat4_mul_fma(const ::lm::mat4& A,
+                                                  const ::lm::mat4& B) noexcept {
+            const float32x4_t a0 = vld1q_f32(A[0].data());
+            const float32x4_t a1 = vld1q_f32(A[1].data());
+            const float32x4_t a2 = vld1q_f32(A[2].data());
+            const float32x4_t a3 = vld1q_f32(A[3].data());
+
+            ::lm::mat4 R{};
+            for (int c = 0; c < 4; ++c) {
+                const float32x4_t r01 = vfmaq_f32(vmulq_n_f32(a0, B[c][0]), a1, vdupq_n_f32(B[c][1]));
+                const float32x4_t r23 = vfmaq_f32(vmulq_n_f32(a2, B[c][2]), a3, vdupq_n_f32(B[c][3]));
+                vst1q_f32(R[c].data(), vaddq_f32(r01, r23));
             }
+            return R;
+        }
+#endif
 
-            // columns 2 and 3
-            {
-                const __m256 b0 = lane_broadcast2(B[2][0], B[3][0]);
-                const __m256 b1 = lane_broadcast2(B[2][1], B[3][1]);
-                const __m256 b2 = lane_broadcast2(B[2][2], B[3][2]);
-                const __m256 b3 = lane_broadcast2(B[2][3], B[3][3]);
-
-                const __m256 r =
-                    _mm256_add_ps(
-                        _mm256_add_ps(_mm256_mul_ps(a0, b0), _mm256_mul_ps(a1, b1)),
-                        _mm256_add_ps(_mm256_mul_ps(a2, b2), _mm256_mul_ps(a3, b3))
-                    );
-
-                _mm_storeu_ps(R[2].data(), _mm256_castps256_ps128(r));
-                _mm_storeu_ps(R[3].data(), _mm256_extractf128_ps(r, 1));
+        // ============================================================
+        // mat4 cofactors: adjugate, determinant, inverse
+        //
+        // Cofactor expansion over the 2x2 minors of the column pairs
+        // (0,1) and (2,3), exactly as the scalar versions (and linmath.h's
+        // mat4x4_invert). Each adjugate column is a signed three-term sum
+        // per lane, evaluated in the scalar order with the sign folded into
+        // the operands, so the SIMD kernels round exactly like the scalar
+        // path, signed zeros included. The inverse is adj(M) * (1/det).
+        //
+        // With r_k = (M[1][k], M[0][k], M[3][k], M[2][k]) and
+        // F_k = (c_k, c_k, s_k, s_k):
+        //   adj[0] = ±(r1*F5 - r2*F4 + r3*F3)   signs (+,-,+,-)
+        //   adj[1] = ±(r0*F5 - r2*F2 + r3*F1)   signs (-,+,-,+)
+        //   adj[2] = ±(r0*F4 - r1*F2 + r3*F0)   signs (+,-,+,-)
+        //   adj[3] = ±(r0*F3 - r1*F1 + r2*F0)   signs (-,+,-,+)
+        // ============================================================
+#if defined(__SSE2__)
+        // (x0 y1 - y0 x1, x0 y2 - y0 x2, x0 y3 - y0 x3, x1 y2 - y1 x2)
+        LMATH_FORCE_INLINE __m128 mat4_minors03_sse2(__m128 x, __m128 y) noexcept {
+            const __m128 xi = _mm_shuffle_ps(x, x, _MM_SHUFFLE(1, 0, 0, 0));
+            const __m128 yi = _mm_shuffle_ps(y, y, _MM_SHUFFLE(1, 0, 0, 0));
+            const __m128 xj = _mm_shuffle_ps(x, x, _MM_SHUFFLE(2, 3, 2, 1));
+            const __m128 yj = _mm_shuffle_ps(y, y, _MM_SHUFFLE(2, 3, 2, 1));
+            return _mm_sub_ps(_mm_mul_ps(xi, yj), _mm_mul_ps(yi, xj));
+        }
+
+        // F_0..F_5, the determinant and the sign-folded r_k rows.
+        // Unused parts drop out once inlined (mat4_determinant_sse2 only
+        // keeps the minors).
+        struct mat4_cofactors_sse2 {
+            __m128 f[6];
+            __m128 ra[4], rb[4];       // r_k with signs (+,-,+,-) / (-,+,-,+)
+            float  det;
+        };
+
+        LMATH_FORCE_INLINE mat4_cofactors_sse2 mat4_cofactors_load_sse2(const ::lm::mat4& M) noexcept {
+            const __m128 a = _mm_loadu_ps(M[0].data());
+            const __m128 b = _mm_loadu_ps(M[1].data());
+            const __m128 c = _mm_loadu_ps(M[2].data());
+            const __m128 d = _mm_loadu_ps(M[3].data());
+
+            const __m128 s03 = mat4_minors03_sse2(a, b);
+            const __m128 c03 = mat4_minors03_sse2(c, d);
+
+            // (s4 s5 c4 c5): pairs (1,3), (2,3)
+            const __m128 xi = _mm_shuffle_ps(a, c, _MM_SHUFFLE(2, 1, 2, 1));
+            const __m128 yi = _mm_shuffle_ps(b, d, _MM_SHUFFLE(2, 1, 2, 1));
+            const __m128 xj = _mm_shuffle_ps(a, c, _MM_SHUFFLE(3, 3, 3, 3));
+            const __m128 yj = _mm_shuffle_ps(b, d, _MM_SHUFFLE(3, 3, 3, 3));
+            const __m128 sc45 = _mm_sub_ps(_mm_mul_ps(xi, yj), _mm_mul_ps(yi, xj));
+
+            mat4_cofactors_sse2 K;
+            K.f[0] = _mm_shuffle_ps(c03, s03, _MM_SHUFFLE(0, 0, 0, 0));
+            K.f[1] = _mm_shuffle_ps(c03, s03, _MM_SHUFFLE(1, 1, 1, 1));
+            K.f[2] = _mm_shuffle_ps(c03, s03, _MM_SHUFFLE(2, 2, 2, 2));
+            K.f[3] = _mm_shuffle_ps(c03, s03, _MM_SHUFFLE(3, 3, 3, 3));
+            K.f[4] = _mm_shuffle_ps(sc45, sc45, _MM_SHUFFLE(0, 0, 2, 2));
+            K.f[5] = _mm_shuffle_ps(sc45, sc45, _MM_SHUFFLE(1, 1, 3, 3));
+
+            // det = s0 c5 - s1 c4 + s2 c3 + s3 c2 - s4 c1 + s5 c0, left to right
+            const __m128 p = _mm_mul_ps(s03, _mm_shuffle_ps(sc45, c03, _MM_SHUFFLE(2, 3, 2, 3)));
+            const __m128 q = _mm_mul_ps(sc45, _mm_shuffle_ps(c03, c03, _MM_SHUFFLE(0, 1, 0, 1)));
+            __m128 det = _mm_sub_ss(p, _mm_shuffle_ps(p, p, _MM_SHUFFLE(1, 1, 1, 1)));
+            det = _mm_add_ss(det, _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 2, 2)));
+            det = _mm_add_ss(det, _mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 3, 3, 3)));
+            det = _mm_sub_ss(det, q);
+            det = _mm_add_ss(det, _mm_shuffle_ps(q, q, _MM_SHUFFLE(1, 1, 1, 1)));
+            K.det = _mm_cvtss_f32(det);
+
+            __m128 r0 = b, r1 = a, r2 = d, r3 = c;
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+            const __m128 sa = _mm_castsi128_ps(_mm_setr_epi32(0, int(0x80000000u), 0, int(0x80000000u)));
+            const __m128 sb = _mm_castsi128_ps(_mm_setr_epi32(int(0x80000000u), 0, int(0x80000000u), 0));
+            K.ra[0] = _mm_xor_ps(r0, sa); K.rb[0] = _mm_xor_ps(r0, sb);
+            K.ra[1] = _mm_xor_ps(r1, sa); K.rb[1] = _mm_xor_ps(r1, sb);
+            K.ra[2] = _mm_xor_ps(r2, sa); K.rb[2] = _mm_xor_ps(r2, sb);
+            K.ra[3] = _mm_xor_ps(r3, sa); K.rb[3] = _mm_xor_ps(r3, sb);
+            return K;
+        }
+
+        // (x*f - y*g) + z*h
+        LMATH_FORCE_INLINE __m128 mat4_cofactor3_sse2(__m128 x, __m128 f, __m128 y, __m128 g,
+                                                     __m128 z, __m128 h) noexcept {
+            return _mm_add_ps(_mm_sub_ps(_mm_mul_ps(x, f), _mm_mul_ps(y, g)), _mm_mul_ps(z, h));
+        }
+
+        LMATH_FORCE_INLINE void mat4_adjugate_cols_sse2(const mat4_cofactors_sse2& K, __m128 (&A)[4]) noexcept {
+            A[0] = mat4_cofactor3_sse2(K.ra[1], K.f[5], K.ra[2], K.f[4], K.ra[3], K.f[3]);
+            A[1] = mat4_cofactor3_sse2(K.rb[0], K.f[5], K.rb[2], K.f[2], K.rb[3], K.f[1]);
+            A[2] = mat4_cofactor3_sse2(K.ra[0], K.f[4], K.ra[1], K.f[2], K.ra[3], K.f[0]);
+            A[3] = mat4_cofactor3_sse2(K.rb[0], K.f[3], K.rb[1], K.f[1], K.rb[2], K.f[0]);
+        }
+
+        LMATH_FORCE_INLINE float mat4_determinant_sse2(const ::lm::mat4& M) noexcept {
+            return mat4_cofactors_load_sse2(M).det;
+        }
+
+        LMATH_FORCE_INLINE ::lm::mat4 mat4_adjugate_sse2(const ::lm::mat4& M) noexcept {
+            __m128 A[4];
+            mat4_adjugate_cols_sse2(mat4_cofactors_load_sse2(M), A);
+
+            ::lm::mat4 T{};
+            for (int c = 0; c < 4; ++c) _mm_storeu_ps(T[c].data(), A[c]);
+            return T;
+        }
+
+        LMATH_FORCE_INLINE ::lm::mat4 mat4_inverse_sse2(const ::lm::mat4& M) noexcept {
+            const mat4_cofactors_sse2 K = mat4_cofactors_load_sse2(M);
+            __m128 A[4];
+            mat4_adjugate_cols_sse2(K, A);
+            const __m128 idet = _mm_set1_ps(1.0f / K.det);
+
+            ::lm::mat4 T{};
+            for (int c = 0; c < 4; ++c) _mm_storeu_ps(T[c].data(), _mm_mul_ps(A[c], idet));
+            return T;
+        }
+#endif
+
+#if defined(__ARM_NEON)
+        LMATH_FORCE_INLINE float32x4_t mat4_minors03_neon(float32x4_t x, float32x4_t y) noexcept {
+            // i = (0 0 0 1), j = (1 2 3 2)
+            const float32x4_t xi = vcombine_f32(vdup_lane_f32(vget_low_f32(x), 0), vget_low_f32(x));
+            const float32x4_t yi = vcombine_f32(vdup_lane_f32(vget_low_f32(y), 0), vget_low_f32(y));
+            const float32x4_t xj = vcombine_f32(vget_low_f32(vextq_f32(x, x, 1)), vrev64_f32(vget_high_f32(x)));
+            const float32x4_t yj = vcombine_f32(vget_low_f32(vextq_f32(y, y, 1)), vrev64_f32(vget_high_f32(y)));
+            return vsubq_f32(vmulq_f32(xi, yj), vmulq_f32(yi, xj));
+        }
+
+        struct mat4_cofactors_neon {
+            float32x4_t f[6];
+            float32x4_t ra[4], rb[4];  // r_k with signs (+,-,+,-) / (-,+,-,+)
+            float       det;
+        };
+
+        LMATH_FORCE_INLINE mat4_cofactors_neon mat4_cofactors_load_neon(const ::lm::mat4& M) noexcept {
+            const float32x4_t a = vld1q_f32(M[0].data());
+            const float32x4_t b = vld1q_f32(M[1].data());
+            const float32x4_t c = vld1q_f32(M[2].data());
+            const float32x4_t d = vld1q_f32(M[3].data());
+
+            // (s4 s5 c4 c5): pairs (1,3), (2,3)
+            const float32x4_t xi = vcombine_f32(vget_low_f32(vextq_f32(a, a, 1)), vget_low_f32(vextq_f32(c, c, 1)));
+            const float32x4_t yi = vcombine_f32(vget_low_f32(vextq_f32(b, b, 1)), vget_low_f32(vextq_f32(d, d, 1)));
+            const float32x4_t xj = vcombine_f32(vdup_lane_f32(vget_high_f32(a), 1), vdup_lane_f32(vget_high_f32(c), 1));
+            const float32x4_t yj = vcombine_f32(vdup_lane_f32(vget_high_f32(b), 1), vdup_lane_f32(vget_high_f32(d), 1));
+
+            float s[4], cc[4], sc[4];
+            vst1q_f32(s,  mat4_minors03_neon(a, b));
+            vst1q_f32(cc, mat4_minors03_neon(c, d));
+            vst1q_f32(sc, vsubq_f32(vmulq_f32(xi, yj), vmulq_f32(yi, xj)));
+
+            mat4_cofactors_neon K;
+            K.det = s[0] * sc[3] - s[1] * sc[2] + s[2] * cc[3] + s[3] * cc[2] - sc[0] * cc[1] + sc[1] * cc[0];
+            for (int k = 0; k < 4; ++k)
+                K.f[k] = vcombine_f32(vdup_n_f32(cc[k]), vdup_n_f32(s[k]));
+            K.f[4] = vcombine_f32(vdup_n_f32(sc[2]), vdup_n_f32(sc[0]));
+            K.f[5] = vcombine_f32(vdup_n_f32(sc[3]), vdup_n_f32(sc[1]));
+
+            // r_k = (b[k], a[k], d[k], c[k])
+            const float32x4x2_t ba = vtrnq_f32(b, a);
+            const float32x4x2_t dc = vtrnq_f32(d, c);
+            const float32x4_t r[4] = {
+                vcombine_f32(vget_low_f32(ba.val[0]),  vget_low_f32(dc.val[0])),
+                vcombine_f32(vget_low_f32(ba.val[1]),  vget_low_f32(dc.val[1])),
+                vcombine_f32(vget_high_f32(ba.val[0]), vget_high_f32(dc.val[0])),
+                vcombine_f32(vget_high_f32(ba.val[1]), vget_high_f32(dc.val[1])),
+            };
+
+            const uint32x4_t sa = { 0u, 0x80000000u, 0u, 0x80000000u };
+            const uint32x4_t sb = { 0x80000000u, 0u, 0x80000000u, 0u };
+            for (int k = 0; k < 4; ++k) {
+                K.ra[k] = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(r[k]), sa));
+                K.rb[k] = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(r[k]), sb));
             }
+            return K;
+        }
 
-            return R;
+        // (x*f - y*g) + z*h, kept unfused so it rounds like the scalar path
+        LMATH_FORCE_INLINE float32x4_t mat4_cofactor3_neon(float32x4_t x, float32x4_t f, float32x4_t y, float32x4_t g,
+                                                           float32x4_t z, float32x4_t h) noexcept {
+            return vaddq_f32(vsubq_f32(vmulq_f32(x, f), vmulq_f32(y, g)), vmulq_f32(z, h));
+        }
+
+        LMATH_FORCE_INLINE void mat4_adjugate_cols_neon(const mat4_cofactors_neon& K, float32x4_t (&A)[4]) noexcept {
+            A[0] = mat4_cofactor3_neon(K.ra[1], K.f[5], K.ra[2], K.f[4], K.ra[3], K.f[3]);
+            A[1] = mat4_cofactor3_neon(K.rb[0], K.f[5], K.rb[2], K.f[2], K.rb[3], K.f[1]);
+            A[2] = mat4_cofactor3_neon(K.ra[0], K.f[4], K.ra[1], K.f[2], K.ra[3], K.f[0]);
+            A[3] = mat4_cofactor3_neon(K.rb[0], K.f[3], K.rb[1], K.f[1], K.rb[2], K.f[0]);
+        }
+
+        LMATH_FORCE_INLINE float mat4_determinant_neon(const ::lm::mat4& M) noexcept {
+            return mat4_cofactors_load_neon(M).det;
+        }
+
+        LMATH_FORCE_INLINE ::lm::mat4 mat4_adjugate_neon(const ::lm::mat4& M) noexcept {
+            float32x4_t A[4];
+            mat4_adjugate_cols_neon(mat4_cofactors_load_neon(M), A);
+
+            ::lm::mat4 T{};
+            for (int c = 0; c < 4; ++c) vst1q_f32(T[c].data(), A[c]);
+            return T;
+        }
+
+        LMATH_FORCE_INLINE ::lm::mat4 mat4_inverse_neon(const ::lm::mat4& M) noexcept {
+            const mat4_cofactors_neon K = mat4_cofactors_load_neon(M);
+            float32x4_t A[4];
+            mat4_adjugate_cols_neon(K, A);
+            const float32x4_t idet = vdupq_n_f32(1.0f / K.det);
+
+            ::lm::mat4 T{};
+            for (int c = 0; c < 4; ++c) vst1q_f32(T[c].data(), vmulq_f32(A[c], idet));
+            return T;
+        }
+#endif
+
+        // ============================================================
+        // Affine / rigid inverse
+        //
+        // For M = [L t; 0 1]: inv(M) = [inv(L)  -inv(L) t; 0 1].
+        // Affine: rows of inv(L) are b x c, c x a, a x b over det = a.(b x c)
+        // (a, b, c = columns of L). Rigid: inv(L) = transpose(L).
+        // Same operation order as the scalar versions.
+        // ============================================================
+#if defined(__SSE2__)
+        // cross(x, y) = yzx(x * yzx(y) - yzx(x) * y), lane 3 unused
+        LMATH_FORCE_INLINE __m128 cross3_sse2(__m128 x, __m128 y) noexcept {
+            const __m128 xs = _mm_shuffle_ps(x, x, _MM_SHUFFLE(3, 0, 2, 1));
+            const __m128 ys = _mm_shuffle_ps(y, y, _MM_SHUFFLE(3, 0, 2, 1));
+            const __m128 u = _mm_sub_ps(_mm_mul_ps(x, ys), _mm_mul_ps(xs, y));
+            return _mm_shuffle_ps(u, u, _MM_SHUFFLE(3, 0, 2, 1));
+        }
+
+        // rows of inv(L) for the linear part with columns a, b, c
+        LMATH_FORCE_INLINE void inverse3_rows_sse2(__m128 a, __m128 b, __m128 c, __m128 (&r)[3]) noexcept {
+            r[0] = cross3_sse2(b, c);
+            r[1] = cross3_sse2(c, a);
+            r[2] = cross3_sse2(a, b);
+
+            // det = (a0 r0_0 + a1 r0_1) + a2 r0_2
+            const __m128 p = _mm_mul_ps(a, r[0]);
+            const __m128 det = _mm_add_ss(_mm_add_ss(p, _mm_shuffle_ps(p, p, _MM_SHUFFLE(1, 1, 1, 1))),
+                                          _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 2, 2)));
+            const __m128 idet = _mm_set1_ps(1.0f / _mm_cvtss_f32(det));
+            for (int i = 0; i < 3; ++i) r[i] = _mm_mul_ps(r[i], idet);
+        }
+
+        // rows of inv(L) in r, transposed to columns C[0..2] (w = 0);
+        // C[3] = -inv(L) t (w = -0)
+        LMATH_FORCE_INLINE void inverse_affine_cols_sse2(__m128 r0, __m128 r1, __m128 r2,
+                                                         const float* t, __m128 (&C)[4]) noexcept {
+            __m128 r3 = _mm_setzero_ps();
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+            const __m128 it = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r0, _mm_set1_ps(t[0])),
+                                                    _mm_mul_ps(r1, _mm_set1_ps(t[1]))),
+                                         _mm_mul_ps(r2, _mm_set1_ps(t[2])));
+            C[0] = r0;
+            C[1] = r1;
+            C[2] = r2;
+            C[3] = _mm_xor_ps(it, _mm_set1_ps(-0.0f));
+        }
+
+        LMATH_FORCE_INLINE ::lm::mat4 mat4_inverse_affine_store_sse2(const __m128 (&C)[4]) noexcept {
+            ::lm::mat4 T{};
+            for (int c = 0; c < 4; ++c) _mm_storeu_ps(T[c].data(), C[c]);
+            T[3][3] = 1.f;
+            return T;
+        }
+
+        LMATH_FORCE_INLINE ::lm::mat4 mat4_inverse_affine_sse2(const ::lm::mat4& M) noexcept {
+            __m128 r[3], C[4];
+            inverse3_rows_sse2(_mm_loadu_ps(M[0].data()), _mm_loadu_ps(M[1].data()),
+                               _mm_loadu_ps(M[2].data()), r);
+            inverse_affine_cols_sse2(r[0], r[1], r[2], M[3].data(), C);
+            return mat4_inverse_affine_store_sse2(C);
+        }
+
+        LMATH_FORCE_INLINE ::lm::mat4 mat4_inverse_rigid_sse2(const ::lm::mat4& M) noexcept {
+            __m128 C[4];
+            inverse_affine_cols_sse2(_mm_loadu_ps(M[0].data()), _mm_loadu_ps(M[1].data()),
+                                     _mm_loadu_ps(M[2].data()), M[3].data(), C);
+            return mat4_inverse_affine_store_sse2(C);
+        }
+#endif
+
+#if defined(__ARM_NEON)
+        LMATH_FORCE_INLINE float32x4_t yzx_neon(float32x4_t x) noexcept {
+            return vsetq_lane_f32(vgetq_lane_f32(x, 0), vextq_f32(x, x, 1), 2);
+        }
+
+        LMATH_FORCE_INLINE float32x4_t cross3_neon(float32x4_t x, float32x4_t y) noexcept {
+            return yzx_neon(vsubq_f32(vmulq_f32(x, yzx_neon(y)), vmulq_f32(yzx_neon(x), y)));
+        }
+
+        LMATH_FORCE_INLINE void inverse3_rows_neon(float32x4_t a, float32x4_t b, float32x4_t c,
+                                                   float32x4_t (&r)[3]) noexcept {
+            r[0] = cross3_neon(b, c);
+            r[1] = cross3_neon(c, a);
+            r[2] = cross3_neon(a, b);
+
+            const float32x4_t p = vmulq_f32(a, r[0]);
+            const float det = (vgetq_lane_f32(p, 0) + vgetq_lane_f32(p, 1)) + vgetq_lane_f32(p, 2);
+            const float idet = 1.0f / det;
+            for (int i = 0; i < 3; ++i) r[i] = vmulq_n_f32(r[i], idet);
+        }
+
+        LMATH_FORCE_INLINE void inverse_affine_cols_neon(float32x4_t r0, float32x4_t r1, float32x4_t r2,
+                                                         const float* t, float32x4_t (&C)[4]) noexcept {
+            // rows (r0, r1, r2, 0) -> columns, w = 0
+            const float32x4_t z = vdupq_n_f32(0.f);
+            const float32x4x2_t t01 = vtrnq_f32(r0, r1);
+            const float32x4x2_t t23 = vtrnq_f32(r2, z);
+            C[0] = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+            C[1] = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+            C[2] = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+
+            const float32x4_t it = vaddq_f32(vaddq_f32(vmulq_n_f32(C[0], t[0]), vmulq_n_f32(C[1], t[1])),
+                                             vmulq_n_f32(C[2], t[2]));
+            C[3] = vnegq_f32(it);
+        }
+
+        LMATH_FORCE_INLINE ::lm::mat4 mat4_inverse_affine_store_neon(const float32x4_t (&C)[4]) noexcept {
+            ::lm::mat4 T{};
+            for (int c = 0; c < 4; ++c) vst1q_f32(T[c].data(), C[c]);
+            T[3][3] = 1.f;
+            return T;
+        }
+
+        LMATH_FORCE_INLINE ::lm::mat4 mat4_inverse_affine_neon(const ::lm::mat4& M) noexcept {
+            float32x4_t r[3], C[4];
+            inverse3_rows_neon(vld1q_f32(M[0].data()), vld1q_f32(M[1].data()), vld1q_f32(M[2].data()), r);
+            inverse_affine_cols_neon(r[0], r[1], r[2], M[3].data(), C);
+            return mat4_inverse_affine_store_neon(C);
+        }
+
+        LMATH_FORCE_INLINE ::lm::mat4 mat4_inverse_rigid_neon(const ::lm::mat4& M) noexcept {
+            float32x4_t C[4];
+            inverse_affine_cols_neon(vld1q_f32(M[0].data()), vld1q_f32(M[1].data()),
+                                     vld1q_f32(M[2].data()), M[3].data(), C);
+            return mat4_inverse_affine_store_neon(C);
         }
 #endif
 
@@ -451,11 +1402,19 @@ namespace lm {
 #if defined(LMATH_FORCE_NO_SIMD)
         return mat4_mul_scalar(A, B);
 #else
+#if defined(LMATH_USE_FMA) && LMATH_HAS_FMA
+        if (simd::has_fma())
+            return detail::mat4_mul_fma(A, B);
+#endif
         switch (simd::max_level()) {
 #if defined(__ARM_NEON)
         case simd::Level::neon:
             return detail::mat4_mul_neon(A, B);
 #endif
+#if defined(__AVX512F__)
+        case simd::Level::avx512:
+            return detail::mat4_mul_avx512(A, B);
+#endif
 #if defined(__AVX2__)
         case simd::Level::avx2:
 #endif
@@ -505,6 +1464,10 @@ namespace lm {
 #if defined(LMATH_FORCE_NO_SIMD)
         return mat4_mul_vec_scalar(M, V); // m4v4 fallback-specialization
 #else
+#if defined(LMATH_USE_FMA) && LMATH_HAS_FMA
+        if (simd::has_fma())
+            return detail::mat4_mul_vec_fma(M, V);
+#endif
         switch (simd::max_level()) {
 #if defined(__ARM_NEON)
         case simd::Level::neon:
@@ -514,6 +1477,9 @@ namespace lm {
         case simd::Level::avx:
 #if defined(__AVX2__)
         case simd::Level::avx2:
+#endif
+#if defined(__AVX512F__)
+        case simd::Level::avx512:
 #endif
             return detail::mat4_mul_vec_avx(M, V);
 #endif
@@ -539,6 +1505,234 @@ namespace lm {
         return R;
     }
 
+    // --- mat4 x vec4[] ---
+    // out[i] = M * in[i] for i in [0, n). `in` and `out` may be the same array.
+    // Dispatches once per call, so prefer it over a loop of mat4_mul_vec().
+
+    /* M4*V4[] scalar */inline void
+    mat4_mul_vec_batch_scalar(const mat4& M, const vec4* in, vec4* out, std::size_t n) noexcept {
+        for (std::size_t i = 0; i < n; ++i)
+            out[i] = mat4_mul_vec_scalar(M, in[i]);
+    }
+
+    // --- mat4 x mat4[] ---
+    // out[i] = A[i] * B[i] (mat4_mul_batch) or A * B[i] (mat4_mul_batch_left)
+    // for i in [0, n). `out` may be the same array as A or B; other overlaps
+    // are undefined. The left operand of _left is read once up front, so it
+    // may point into `out`. See store_mode for `mode`.
+
+    /* M4*M4[] scalar */inline void
+    mat4_mul_batch_scalar(const mat4* A, const mat4* B, mat4* out, std::size_t n,
+                          store_mode = store_mode::cached) noexcept {
+        for (std::size_t i = 0; i < n; ++i)
+            out[i] = mat4_mul_scalar(A[i], B[i]);
+    }
+
+    /* M4*M4[] scalar */inline void
+    mat4_mul_batch_left_scalar(const mat4& A, const mat4* B, mat4* out, std::size_t n,
+                               store_mode = store_mode::cached) noexcept {
+        const mat4 a = A;
+        for (std::size_t i = 0; i < n; ++i)
+            out[i] = mat4_mul_scalar(a, B[i]);
+    }
+
+    // --- mat4 x vec3[] (packed) ---
+    // Points get w = 1 (translation applied), dirs get w = 0. The projective
+    // row is ignored, so these are for affine M. `in` and `out` may be the
+    // same array; no padding past element n-1 is read or written.
+
+    /* M4*P3[] scalar */inline void
+    mat4_transform_points_scalar(const mat4& M, const vec3* in, vec3* out, std::size_t n) noexcept {
+        detail::mat4_transform_vec3_scalar<true>(M, in, out, n);
+    }
+
+    /* M4*D3[] scalar */inline void
+    mat4_transform_dirs_scalar(const mat4& M, const vec3* in, vec3* out, std::size_t n) noexcept {
+        detail::mat4_transform_vec3_scalar<false>(M, in, out, n);
+    }
+
+    // ============================================================
+    // Kernel dispatch table
+    // ============================================================
+    // Single-call entry points (mat4_mul, mat4_mul_vec, vec4_dot, rsqrtf)
+    // keep their switch so the kernel can inline into the caller; a call
+    // through a pointer costs more than the branch it saves. Array APIs and
+    // hot loops that can't batch should fetch the kernel once:
+    //
+    //     const auto mul = lm::simd::dispatch().mat4_mul_vec;
+    //     for (...) out[i] = mul(M, in[i]);
+    //
+    // GNU ifunc is not used: it needs an out-of-line symbol per entry point,
+    // which a header-only library doesn't have.
+#if !defined(LMATH_FORCE_NO_SIMD)
+namespace simd {
+
+    struct dispatch_table {
+        Level level;
+        bool  fma;
+        float (*rsqrtf)(float) noexcept;
+        float (*vec4_dot)(const vec4&, const vec4&) noexcept;
+        mat4  (*mat4_mul)(const mat4&, const mat4&) noexcept;
+        vec4  (*mat4_mul_vec)(const mat4&, const vec4&) noexcept;
+        void  (*mat4_mul_vec_batch)(const mat4&, const vec4*, vec4*, std::size_t) noexcept;
+        void  (*mat4_mul_batch)(const mat4*, const mat4*, mat4*, std::size_t, store_mode) noexcept;
+        void  (*mat4_mul_batch_left)(const mat4&, const mat4*, mat4*, std::size_t, store_mode) noexcept;
+        void  (*mat4_transform_points)(const mat4&, const vec3*, vec3*, std::size_t) noexcept;
+        void  (*mat4_transform_dirs)(const mat4&, const vec3*, vec3*, std::size_t) noexcept;
+    };
+
+    // Kernels for `lvl`, falling back to scalar for anything not compiled in.
+    // Useful on its own to pin a level (tests, benches).
+    // With `fma`, the single-call kernels use their FMA variants where the
+    // CPU has them (see LMATH_USE_FMA); the array kernels are unaffected.
+    inline dispatch_table resolve_dispatch(Level lvl, bool fma = false) noexcept {
+        dispatch_table t{
+            Level::none,
+            false,
+            [](float x) noexcept { return rsqrtf_scalar(x); },
+            [](const vec4& a, const vec4& b) noexcept { return vec_dot(a, b); },
+            [](const mat4& A, const mat4& B) noexcept { return mat4_mul_scalar(A, B); },
+            [](const mat4& M, const vec4& V) noexcept { return mat4_mul_vec_scalar(M, V); },
+            &mat4_mul_vec_batch_scalar,
+            &mat4_mul_batch_scalar,
+            &mat4_mul_batch_left_scalar,
+            &mat4_transform_points_scalar,
+            &mat4_transform_dirs_scalar,
+        };
+
+        switch (lvl) {
+#if defined(__ARM_NEON)
+        case Level::neon:
+            t.level = Level::neon;
+            t.vec4_dot = [](const vec4& a, const vec4& b) noexcept { return ::lm::detail::dot_neon(a.v, b.v); };
+            t.mat4_mul = [](const mat4& A, const mat4& B) noexcept { return ::lm::detail::mat4_mul_neon(A, B); };
+            t.mat4_mul_vec = [](const mat4& M, const vec4& V) noexcept { return ::lm::detail::mat4_mul_vec_neon(M, V); };
+            t.mat4_mul_vec_batch = &::lm::detail::mat4_mul_vec_batch_neon;
+            t.mat4_mul_batch = &::lm::detail::mat4_mul_batch_neon;
+            t.mat4_mul_batch_left = &::lm::detail::mat4_mul_batch_left_neon;
+            t.mat4_transform_points = &::lm::detail::mat4_transform_vec3_neon<true>;
+            t.mat4_transform_dirs = &::lm::detail::mat4_transform_vec3_neon<false>;
+            break;
+#endif
+#if defined(__AVX512F__)
+        case Level::avx512:
+            // vec3 transforms keep the 8-wide AVX kernels
+            t = resolve_dispatch(Level::avx2);
+            t.level = Level::avx512;
+            t.mat4_mul = [](const mat4& A, const mat4& B) noexcept { return ::lm::detail::mat4_mul_avx512(A, B); };
+            t.mat4_mul_vec_batch = &::lm::detail::mat4_mul_vec_batch_avx512;
+            t.mat4_mul_batch = &::lm::detail::mat4_mul_batch_avx512;
+            t.mat4_mul_batch_left = &::lm::detail::mat4_mul_batch_left_avx512;
+            break;
+#endif
+#if defined(__AVX__)
+        case Level::avx:
+#if defined(__AVX2__)
+        case Level::avx2:
+#endif
+            t.level = lvl;
+            t.rsqrtf = [](float x) noexcept { return rsqrtf_sse(x); };
+            t.vec4_dot = [](const vec4& a, const vec4& b) noexcept { return ::lm::detail::dot_sse2(a.v, b.v); };
+            t.mat4_mul = [](const mat4& A, const mat4& B) noexcept { return ::lm::detail::mat4_mul_avx(A, B); };
+            t.mat4_mul_vec = [](const mat4& M, const vec4& V) noexcept { return ::lm::detail::mat4_mul_vec_avx(M, V); };
+            t.mat4_mul_vec_batch = &::lm::detail::mat4_mul_vec_batch_avx;
+            t.mat4_mul_batch = &::lm::detail::mat4_mul_batch_avx;
+            t.mat4_mul_batch_left = &::lm::detail::mat4_mul_batch_left_avx;
+            t.mat4_transform_points = &::lm::detail::mat4_transform_vec3_avx<true>;
+            t.mat4_transform_dirs = &::lm::detail::mat4_transform_vec3_avx<false>;
+            break;
+#endif
+#if defined(__SSE2__)
+        case Level::sse2:
+            t.level = Level::sse2;
+            t.rsqrtf = [](float x) noexcept { return rsqrtf_sse(x); };
+            t.vec4_dot = [](const vec4& a, const vec4& b) noexcept { return ::lm::detail::dot_sse2(a.v, b.v); };
+            t.mat4_mul = [](const mat4& A, const mat4& B) noexcept { return ::lm::detail::mat4_mul_sse2(A, B); };
+            t.mat4_mul_vec = [](const mat4& M, const vec4& V) noexcept { return ::lm::detail::mat4_mul_vec_sse2(M, V); };
+            t.mat4_mul_vec_batch = &::lm::detail::mat4_mul_vec_batch_sse2;
+            t.mat4_mul_batch = &::lm::detail::mat4_mul_batch_sse2;
+            t.mat4_mul_batch_left = &::lm::detail::mat4_mul_batch_left_sse2;
+            t.mat4_transform_points = &::lm::detail::mat4_transform_vec3_sse2<true>;
+            t.mat4_transform_dirs = &::lm::detail::mat4_transform_vec3_sse2<false>;
+            break;
+#endif
+        default:
+            break;
+        } // switch
+
+#if LMATH_HAS_FMA
+        if (fma && t.level != Level::none && has_fma()) {
+            t.fma = true;
+            t.vec4_dot = [](const vec4& a, const vec4& b) noexcept { return ::lm::detail::dot_fma(a.v, b.v); };
+            t.mat4_mul = [](const mat4& A, const mat4& B) noexcept { return ::lm::detail::mat4_mul_fma(A, B); };
+            t.mat4_mul_vec = [](const mat4& M, const vec4& V) noexcept { return ::lm::detail::mat4_mul_vec_fma(M, V); };
+        }
+#else
+        (void)fma;
+#endif
+        return t;
+    } // resolve_dispatch
+
+    // Kernels for max_level(), resolved on first use and cached.
+    inline const dispatch_table& dispatch() noexcept {
+#if defined(LMATH_USE_FMA)
+        static const dispatch_table table = resolve_dispatch(max_level(), true);
+#else
+        static const dispatch_table table = resolve_dispatch(max_level());
+#endif
+        return table;
+    }
+
+} // namespace simd
+#endif // LMATH_FORCE_NO_SIMD
+
+    /* M4*V4[] SIMD */inline void
+    mat4_mul_vec_batch(const mat4& M, const vec4* in, vec4* out, std::size_t n) noexcept {
+#if defined(LMATH_FORCE_NO_SIMD)
+        mat4_mul_vec_batch_scalar(M, in, out, n);
+#else
+        simd::dispatch().mat4_mul_vec_batch(M, in, out, n);
+#endif
+    }
+
+    /* M4*M4[] SIMD */inline void
+    mat4_mul_batch(const mat4* A, const mat4* B, mat4* out, std::size_t n,
+                   store_mode mode = store_mode::cached) noexcept {
+#if defined(LMATH_FORCE_NO_SIMD)
+        mat4_mul_batch_scalar(A, B, out, n, mode);
+#else
+        simd::dispatch().mat4_mul_batch(A, B, out, n, mode);
+#endif
+    }
+
+    /* M4*M4[] SIMD */inline void
+    mat4_mul_batch_left(const mat4& A, const mat4* B, mat4* out, std::size_t n,
+                        store_mode mode = store_mode::cached) noexcept {
+#if defined(LMATH_FORCE_NO_SIMD)
+        mat4_mul_batch_left_scalar(A, B, out, n, mode);
+#else
+        simd::dispatch().mat4_mul_batch_left(A, B, out, n, mode);
+#endif
+    }
+
+    /* M4*P3[] SIMD */inline void
+    mat4_transform_points(const mat4& M, const vec3* in, vec3* out, std::size_t n) noexcept {
+#if defined(LMATH_FORCE_NO_SIMD)
+        mat4_transform_points_scalar(M, in, out, n);
+#else
+        simd::dispatch().mat4_transform_points(M, in, out, n);
+#endif
+    }
+
+    /* M4*D3[] SIMD */inline void
+    mat4_transform_dirs(const mat4& M, const vec3* in, vec3* out, std::size_t n) noexcept {
+#if defined(LMATH_FORCE_NO_SIMD)
+        mat4_transform_dirs_scalar(M, in, out, n);
+#else
+        simd::dispatch().mat4_transform_dirs(M, in, out, n);
+#endif
+    }
+
     // ============================================================
     // Transpose
     // ============================================================
@@ -567,6 +1761,425 @@ namespace lm {
         return Rm;
     }
 
+    // ============================================================
+    // Determinant / adjugate
+    //
+    // The mat4 versions share their 2x2 minors with mat4_inverse (scalar
+    // and SIMD cofactor kernels alike); mat3 uses column cross products.
+    // SIMD levels match the scalar versions bit for bit, as long as the
+    // compiler does not contract a*b+c into FMAs (-ffp-contract=off).
+    // ============================================================
+
+    namespace detail {
+        // 2x2 minors of the column pairs (0,1) -> s and (2,3) -> c
+        struct mat4_minors {
+            float s[6];
+            float c[6];
+        };
+
+        LMATH_OUT mat4_minors mat4_minors_scalar(const mat4& M) noexcept {
+            return { {
+                M[0][0] * M[1][1] - M[1][0] * M[0][1],
+                M[0][0] * M[1][2] - M[1][0] * M[0][2],
+                M[0][0] * M[1][3] - M[1][0] * M[0][3],
+                M[0][1] * M[1][2] - M[1][1] * M[0][2],
+                M[0][1] * M[1][3] - M[1][1] * M[0][3],
+                M[0][2] * M[1][3] - M[1][2] * M[0][3],
+            }, {
+                M[2][0] * M[3][1] - M[3][0] * M[2][1],
+                M[2][0] * M[3][2] - M[3][0] * M[2][2],
+                M[2][0] * M[3][3] - M[3][0] * M[2][3],
+                M[2][1] * M[3][2] - M[3][1] * M[2][2],
+                M[2][1] * M[3][3] - M[3][1] * M[2][3],
+                M[2][2] * M[3][3] - M[3][2] * M[2][3],
+            } };
+        }
+
+        LMATH_OUT float mat4_determinant_of(const mat4_minors& k) noexcept {
+            const float* s = k.s;
+            const float* c = k.c;
+            return s[0] * c[5] - s[1] * c[4] + s[2] * c[3] + s[3] * c[2] - s[4] * c[1] + s[5] * c[0];
+        }
+
+        LMATH_OUT mat4 mat4_adjugate_of(const mat4& M, const mat4_minors& k) noexcept {
+            const float* s = k.s;
+            const float* c = k.c;
+
+            mat4 T{};
+            T[0][0] =  M[1][1] * c[5] - M[1][2] * c[4] + M[1][3] * c[3];
+            T[0][1] = -M[0][1] * c[5] + M[0][2] * c[4] - M[0][3] * c[3];
+            T[0][2] =  M[3][1] * s[5] - M[3][2] * s[4] + M[3][3] * s[3];
+            T[0][3] = -M[2][1] * s[5] + M[2][2] * s[4] - M[2][3] * s[3];
+
+            T[1][0] = -M[1][0] * c[5] + M[1][2] * c[2] - M[1][3] * c[1];
+            T[1][1] =  M[0][0] * c[5] - M[0][2] * c[2] + M[0][3] * c[1];
+            T[1][2] = -M[3][0] * s[5] + M[3][2] * s[2] - M[3][3] * s[1];
+            T[1][3] =  M[2][0] * s[5] - M[2][2] * s[2] + M[2][3] * s[1];
+
+            T[2][0] =  M[1][0] * c[4] - M[1][1] * c[2] + M[1][3] * c[0];
+            T[2][1] = -M[0][0] * c[4] + M[0][1] * c[2] - M[0][3] * c[0];
+            T[2][2] =  M[3][0] * s[4] - M[3][1] * s[2] + M[3][3] * s[0];
+            T[2][3] = -M[2][0] * s[4] + M[2][1] * s[2] - M[2][3] * s[0];
+
+            T[3][0] = -M[1][0] * c[3] + M[1][1] * c[1] - M[1][2] * c[0];
+            T[3][1] =  M[0][0] * c[3] - M[0][1] * c[1] + M[0][2] * c[0];
+            T[3][2] = -M[3][0] * s[3] + M[3][1] * s[1] - M[3][2] * s[0];
+            T[3][3] =  M[2][0] * s[3] - M[2][1] * s[1] + M[2][2] * s[0];
+            return T;
+        }
+    } // namespace detail
+
+    // --- mat3 ---
+
+    // a . (b x c) over the columns a, b, c
+    LMATH_OUT float mat_determinant(const mat3& M) noexcept {
+        const vec3 r0 = vec3_cross(M[1], M[2]);
+        return M[0][0] * r0[0] + M[0][1] * r0[1] + M[0][2] * r0[2];
+    }
+
+    // rows b x c, c x a, a x b; M * adj(M) = det(M) * I
+    LMATH_OUT mat3 mat_adjugate(const mat3& M) noexcept {
+        const vec3 r0 = vec3_cross(M[1], M[2]);
+        const vec3 r1 = vec3_cross(M[2], M[0]);
+        const vec3 r2 = vec3_cross(M[0], M[1]);
+        return { {
+            { r0[0], r1[0], r2[0] },
+            { r0[1], r1[1], r2[1] },
+            { r0[2], r1[2], r2[2] }
+        } };
+    }
+
+    // --- mat4 ---
+
+    /* det M4 scalar */LMATH_OUT float
+    mat4_determinant_scalar(const mat4& M) noexcept {
+        return detail::mat4_determinant_of(detail::mat4_minors_scalar(M));
+    }
+
+    /* det M4 SIMD */LMATH_NO_DISCARD inline float
+    mat_determinant(const mat4& M) noexcept {
+#if defined(LMATH_FORCE_NO_SIMD)
+        return mat4_determinant_scalar(M);
+#else
+        switch (simd::max_level()) {
+#if defined(__ARM_NEON)
+        case simd::Level::neon:
+            return detail::mat4_determinant_neon(M);
+#endif
+#if defined(__SSE2__)
+        case simd::Level::sse2:
+        case simd::Level::avx:
+        case simd::Level::avx2:
+        case simd::Level::avx512:
+            return detail::mat4_determinant_sse2(M);
+#endif
+        default:
+            return mat4_determinant_scalar(M);
+        } // switch
+#endif // LMATH_FORCE_NO_SIMD
+    } // mat_determinant
+
+    /* adj M4 scalar */LMATH_OUT mat4
+    mat4_adjugate_scalar(const mat4& M) noexcept {
+        return detail::mat4_adjugate_of(M, detail::mat4_minors_scalar(M));
+    }
+
+    /* adj M4 SIMD */LMATH_NO_DISCARD inline mat4
+    mat_adjugate(const mat4& M) noexcept {
+#if defined(LMATH_FORCE_NO_SIMD)
+        return mat4_adjugate_scalar(M);
+#else
+        switch (simd::max_level()) {
+#if defined(__ARM_NEON)
+        case simd::Level::neon:
+            return detail::mat4_adjugate_neon(M);
+#endif
+#if defined(__SSE2__)
+        case simd::Level::sse2:
+        case simd::Level::avx:
+        case simd::Level::avx2:
+        case simd::Level::avx512:
+            return detail::mat4_adjugate_sse2(M);
+#endif
+        default:
+            return mat4_adjugate_scalar(M);
+        } // switch
+#endif // LMATH_FORCE_NO_SIMD
+    } // mat_adjugate
+
+    // --- batched determinant ---
+    //
+    // W matrices per block (8 on AVX, 4 on SSE2/NEON) are transposed so each
+    // register holds one entry of every matrix, then the scalar formula runs
+    // lane-wise; out[i] is byte-equal to mat_determinant(in[i]).
+
+    namespace detail {
+
+        template<typename L>
+        LMATH_FORCE_INLINE void mat4_load_lanes(L, const mat4* M, typename L::reg (&m)[4][4]) noexcept {
+            alignas(16) float tmp[L::width];
+            for (int c = 0; c < 4; ++c)
+                for (int r = 0; r < 4; ++r) {
+                    for (std::size_t j = 0; j < L::width; ++j) tmp[j] = M[j][c][r];
+                    m[c][r] = L::load(tmp);
+                }
+        }
+
+        template<typename L>
+        LMATH_FORCE_INLINE void mat3_load_lanes(L, const mat3* M, typename L::reg (&m)[3][3]) noexcept {
+            alignas(16) float tmp[L::width];
+            for (int c = 0; c < 3; ++c)
+                for (int r = 0; r < 3; ++r) {
+                    for (std::size_t j = 0; j < L::width; ++j) tmp[j] = M[j][c][r];
+                    m[c][r] = L::load(tmp);
+                }
+        }
+
+#if defined(__SSE2__)
+        LMATH_FORCE_INLINE void mat4_load_lanes(lanes_sse2, const mat4* M, __m128 (&m)[4][4]) noexcept {
+            for (int c = 0; c < 4; ++c) {
+                __m128 r0 = _mm_loadu_ps(M[0][c].data());
+                __m128 r1 = _mm_loadu_ps(M[1][c].data());
+                __m128 r2 = _mm_loadu_ps(M[2][c].data());
+                __m128 r3 = _mm_loadu_ps(M[3][c].data());
+                _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+                m[c][0] = r0; m[c][1] = r1; m[c][2] = r2; m[c][3] = r3;
+            }
+        }
+#endif
+
+#if defined(__AVX__)
+        // 4x4 transpose per 128-bit lane, lane 1 holds matrices 4..7
+        LMATH_FORCE_INLINE void mat4_load_lanes(lanes_avx, const mat4* M, __m256 (&m)[4][4]) noexcept {
+            for (int c = 0; c < 4; ++c) {
+                const __m256 r0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(M[0][c].data())), _mm_loadu_ps(M[4][c].data()), 1);
+                const __m256 r1 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(M[1][c].data())), _mm_loadu_ps(M[5][c].data()), 1);
+                const __m256 r2 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(M[2][c].data())), _mm_loadu_ps(M[6][c].data()), 1);
+                const __m256 r3 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(M[3][c].data())), _mm_loadu_ps(M[7][c].data()), 1);
+
+                const __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+                const __m256 t1 = _mm256_unpacklo_ps(r2, r3);
+                const __m256 t2 = _mm256_unpackhi_ps(r0, r1);
+                const __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+
+                m[c][0] = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+                m[c][1] = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+                m[c][2] = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+                m[c][3] = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+            }
+        }
+#endif
+
+#if defined(__ARM_NEON)
+        LMATH_FORCE_INLINE void mat4_load_lanes(lanes_neon, const mat4* M, float32x4_t (&m)[4][4]) noexcept {
+            for (int c = 0; c < 4; ++c) {
+                const float32x4x2_t t01 = vtrnq_f32(vld1q_f32(M[0][c].data()), vld1q_f32(M[1][c].data()));
+                const float32x4x2_t t23 = vtrnq_f32(vld1q_f32(M[2][c].data()), vld1q_f32(M[3][c].data()));
+                m[c][0] = vcombine_f32(vget_low_f32(t01.val[0]),  vget_low_f32(t23.val[0]));
+                m[c][1] = vcombine_f32(vget_low_f32(t01.val[1]),  vget_low_f32(t23.val[1]));
+                m[c][2] = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+                m[c][3] = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+            }
+        }
+#endif
+
+        // x0*y1 - y0*x1
+        template<typename V>
+        LMATH_FORCE_INLINE typename V::reg minor2_lanes(typename V::reg x0, typename V::reg x1,
+                                                        typename V::reg y0, typename V::reg y1) noexcept {
+            return V::sub(V::mul(x0, y1), V::mul(y0, x1));
+        }
+
+        // same order as mat4_minors_scalar / mat4_determinant_of
+        template<typename V>
+        LMATH_FORCE_INLINE typename V::reg mat4_determinant_lanes(const typename V::reg (&m)[4][4]) noexcept {
+            const auto s0 = minor2_lanes<V>(m[0][0], m[0][1], m[1][0], m[1][1]);
+            const auto s1 = minor2_lanes<V>(m[0][0], m[0][2], m[1][0], m[1][2]);
+            const auto s2 = minor2_lanes<V>(m[0][0], m[0][3], m[1][0], m[1][3]);
+            const auto s3 = minor2_lanes<V>(m[0][1], m[0][2], m[1][1], m[1][2]);
+            const auto s4 = minor2_lanes<V>(m[0][1], m[0][3], m[1][1], m[1][3]);
+            const auto s5 = minor2_lanes<V>(m[0][2], m[0][3], m[1][2], m[1][3]);
+
+            const auto c0 = minor2_lanes<V>(m[2][0], m[2][1], m[3][0], m[3][1]);
+            const auto c1 = minor2_lanes<V>(m[2][0], m[2][2], m[3][0], m[3][2]);
+            const auto c2 = minor2_lanes<V>(m[2][0], m[2][3], m[3][0], m[3][3]);
+            const auto c3 = minor2_lanes<V>(m[2][1], m[2][2], m[3][1], m[3][2]);
+            const auto c4 = minor2_lanes<V>(m[2][1], m[2][3], m[3][1], m[3][3]);
+            const auto c5 = minor2_lanes<V>(m[2][2], m[2][3], m[3][2], m[3][3]);
+
+            auto det = V::sub(V::mul(s0, c5), V::mul(s1, c4));
+            det = V::add(det, V::mul(s2, c3));
+            det = V::add(det, V::mul(s3, c2));
+            det = V::sub(det, V::mul(s4, c1));
+            return V::add(det, V::mul(s5, c0));
+        }
+
+        // same order as mat_determinant(const mat3&)
+        template<typename V>
+        LMATH_FORCE_INLINE typename V::reg mat3_determinant_lanes(const typename V::reg (&m)[3][3]) noexcept {
+            const auto x = minor2_lanes<V>(m[1][1], m[1][2], m[2][1], m[2][2]);
+            const auto y = minor2_lanes<V>(m[1][2], m[1][0], m[2][2], m[2][0]);
+            const auto z = minor2_lanes<V>(m[1][0], m[1][1], m[2][0], m[2][1]);
+            return V::add(V::add(V::mul(m[0][0], x), V::mul(m[0][1], y)), V::mul(m[0][2], z));
+        }
+
+    } // namespace detail
+
+    // out[i] = mat_determinant(in[i]) for i in [0, n)
+    inline void mat_determinant_batch(const mat4* in, float* out, std::size_t n) noexcept {
+        detail::with_lanes([&](auto L) {
+            detail::for_lanes<decltype(L)>(n, [&](auto S, std::size_t i) {
+                using V = decltype(S);
+                typename V::reg m[4][4];
+                detail::mat4_load_lanes(S, in + i, m);
+                V::store(out + i, detail::mat4_determinant_lanes<V>(m));
+            });
+        });
+    }
+
+    inline void mat_determinant_batch(const mat3* in, float* out, std::size_t n) noexcept {
+        detail::with_lanes([&](auto L) {
+            detail::for_lanes<decltype(L)>(n, [&](auto S, std::size_t i) {
+                using V = decltype(S);
+                typename V::reg m[3][3];
+                detail::mat3_load_lanes(S, in + i, m);
+                V::store(out + i, detail::mat3_determinant_lanes<V>(m));
+            });
+        });
+    }
+
+    // ============================================================
+    // Inverse
+    //
+    // mat4_inverse assumes M is invertible; a singular M gives inf/NaN
+    // entries, as linmath.h's mat4x4_invert does. The affine and rigid
+    // variants read only the upper 3x4 and take the bottom row as
+    // (0, 0, 0, 1); rigid also assumes the upper 3x3 is a pure rotation.
+    // Bit-for-bit agreement across levels as for the determinant above.
+    // ============================================================
+
+    /* M4^-1 scalar */LMATH_OUT mat4
+    mat4_inverse_scalar(const mat4& M) noexcept {
+        const detail::mat4_minors k = detail::mat4_minors_scalar(M);
+        const float idet = 1.0f / detail::mat4_determinant_of(k);
+
+        mat4 T = detail::mat4_adjugate_of(M, k);
+        for (int c = 0; c < 4; ++c)
+            for (int r = 0; r < 4; ++r)
+                T[c][r] *= idet;
+        return T;
+    }
+
+    /* M4^-1 SIMD */LMATH_NO_DISCARD inline mat4
+    mat4_inverse(const mat4& M) noexcept {
+#if defined(LMATH_FORCE_NO_SIMD)
+        return mat4_inverse_scalar(M);
+#else
+        switch (simd::max_level()) {
+#if defined(__ARM_NEON)
+        case simd::Level::neon:
+            return detail::mat4_inverse_neon(M);
+#endif
+#if defined(__SSE2__)
+        // 8-wide gains nothing for a single matrix: AVX levels run the
+        // 128-bit kernel (VEX-encoded when built with -mavx)
+        case simd::Level::sse2:
+        case simd::Level::avx:
+        case simd::Level::avx2:
+        case simd::Level::avx512:
+            return detail::mat4_inverse_sse2(M);
+#endif
+        default:
+            return mat4_inverse_scalar(M);
+        } // switch
+#endif // LMATH_FORCE_NO_SIMD
+    } // mat4_inverse
+
+    namespace detail {
+        // rows r0..r2 of inv(L) -> columns, translation -inv(L) t
+        LMATH_OUT mat4 mat4_inverse_affine_finish(const vec3& r0, const vec3& r1, const vec3& r2,
+                                                  const vec4& t) noexcept {
+            mat4 T{};
+            for (int j = 0; j < 3; ++j) {
+                T[j][0] = r0[j];
+                T[j][1] = r1[j];
+                T[j][2] = r2[j];
+            }
+            for (int i = 0; i < 3; ++i)
+                T[3][i] = -(T[0][i] * t[0] + T[1][i] * t[1] + T[2][i] * t[2]);
+            T[3][3] = 1.f;
+            return T;
+        }
+    } // namespace detail
+
+    /* affine M4^-1 scalar */LMATH_OUT mat4
+    mat4_inverse_affine_scalar(const mat4& M) noexcept {
+        const vec3 a{ M[0][0], M[0][1], M[0][2] };
+        const vec3 b{ M[1][0], M[1][1], M[1][2] };
+        const vec3 c{ M[2][0], M[2][1], M[2][2] };
+
+        const vec3 r0 = vec3_cross(b, c);
+        const vec3 r1 = vec3_cross(c, a);
+        const vec3 r2 = vec3_cross(a, b);
+        const float idet = 1.0f / (a[0] * r0[0] + a[1] * r0[1] + a[2] * r0[2]);
+
+        return detail::mat4_inverse_affine_finish(r0 * idet, r1 * idet, r2 * idet, M[3]);
+    }
+
+    /* affine M4^-1 SIMD */LMATH_NO_DISCARD inline mat4
+    mat4_inverse_affine(const mat4& M) noexcept {
+#if defined(LMATH_FORCE_NO_SIMD)
+        return mat4_inverse_affine_scalar(M);
+#else
+        switch (simd::max_level()) {
+#if defined(__ARM_NEON)
+        case simd::Level::neon:
+            return detail::mat4_inverse_affine_neon(M);
+#endif
+#if defined(__SSE2__)
+        case simd::Level::sse2:
+        case simd::Level::avx:
+        case simd::Level::avx2:
+        case simd::Level::avx512:
+            return detail::mat4_inverse_affine_sse2(M);
+#endif
+        default:
+            return mat4_inverse_affine_scalar(M);
+        } // switch
+#endif // LMATH_FORCE_NO_SIMD
+    } // mat4_inverse_affine
+
+    /* rigid M4^-1 scalar */LMATH_OUT mat4
+    mat4_inverse_rigid_scalar(const mat4& M) noexcept {
+        // rows of transpose(L) are the columns of L
+        return detail::mat4_inverse_affine_finish({ M[0][0], M[0][1], M[0][2] },
+                                                  { M[1][0], M[1][1], M[1][2] },
+                                                  { M[2][0], M[2][1], M[2][2] }, M[3]);
+    }
+
+    /* rigid M4^-1 SIMD */LMATH_NO_DISCARD inline mat4
+    mat4_inverse_rigid(const mat4& M) noexcept {
+#if defined(LMATH_FORCE_NO_SIMD)
+        return mat4_inverse_rigid_scalar(M);
+#else
+        switch (simd::max_level()) {
+#if defined(__ARM_NEON)
+        case simd::Level::neon:
+            return detail::mat4_inverse_rigid_neon(M);
+#endif
+#if defined(__SSE2__)
+        case simd::Level::sse2:
+        case simd::Level::avx:
+        case simd::Level::avx2:
+        case simd::Level::avx512:
+            return detail::mat4_inverse_rigid_sse2(M);
+#endif
+        default:
+            return mat4_inverse_rigid_scalar(M);
+        } // switch
+#endif // LMATH_FORCE_NO_SIMD
+    } // mat4_inverse_rigid
+
     // ============================================================
     // mat3 transforms
     // ============================================================
@@ -585,8 +2198,9 @@ namespace lm {
         return M;
     }
     LMATH_OUT mat3 mat3_rotate(float a) noexcept {
-        float s = ::lm::sinf(a);
-        float c = ::lm::cosf(a);
+        const sincos_f sc = ::lm::sincosf(a);
+        const float s = sc.s;
+        const float c = sc.c;
 
         mat3 M{};
         M[0][0] =  c; M[1][0] = -s;
@@ -616,8 +2230,9 @@ namespace lm {
     }
 
     LMATH_OUT mat4 mat4_rotate_x(float a) noexcept {
-        float s = ::lm::sinf(a);
-        float c = ::lm::cosf(a);
+        const sincos_f sc = ::lm::sincosf(a);
+        const float s = sc.s;
+        const float c = sc.c;
 
         return { {
             {1.f, 0.f, 0.f, 0.f},
@@ -627,8 +2242,9 @@ namespace lm {
         } };
     }
     LMATH_OUT mat4 mat4_rotate_y(float a) noexcept {
-        float s = ::lm::sinf(a);
-        float c = ::lm::cosf(a);
+        const sincos_f sc = ::lm::sincosf(a);
+        const float s = sc.s;
+        const float c = sc.c;
 
         return { {
             { c,   0.f, -s,  0.f},
@@ -638,8 +2254,9 @@ namespace lm {
         } };
     }
     LMATH_OUT mat4 mat4_rotate_z(float a) noexcept {
-        float s = ::lm::sinf(a);
-        float c = ::lm::cosf(a);
+        const sincos_f sc = ::lm::sincosf(a);
+        const float s = sc.s;
+        const float c = sc.c;
 
         return { {
             { c,   s,   0.f, 0.f},
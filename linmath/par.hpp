@@ -0,0 +1,191 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "detail/feature_detection.hpp"
+
+#include "worker_pool.hpp"
+
+#if !defined(LMATH_FREESTANDING)
+#   include <atomic>
+#   include <type_traits>
+#endif
+
+namespace lm {
+namespace par {
+
+    // ============================================================
+    // Parallel ranges
+    //
+    // parallel_for(pool, n, block, body) calls body(begin, end) over
+    // [0, n) in blocks of `block` elements (the last one may be shorter),
+    // with the blocks spread over pool.workers tasks. Each task starts
+    // with an equal share of blocks and takes them front to back; once
+    // its share is gone it steals the back half of the largest share
+    // left, so uneven blocks (culling, early-outs) still balance.
+    //
+    // block_for<T>(bytes) sizes a block to ~bytes of T, rounded up to
+    // whole cache lines: with a line-aligned output array, no two tasks
+    // write the same line.
+    //
+    // With LMATH_FREESTANDING the scheduler is compiled out and
+    // parallel_for walks the same blocks in order on the calling thread.
+    //
+    // Only the scheduler lives here; the worker_pool overloads of the
+    // batch kernels are in par_kernels.hpp.
+    // ============================================================
+
+    LMATH_CONSTEXPR_VAR std::size_t cache_line = 64;
+
+    // Default block size in bytes of output: large enough that a steal
+    // costs far less than the block, small enough to balance 10M-element
+    // arrays over dozens of cores.
+    LMATH_CONSTEXPR_VAR std::size_t default_block_bytes = 16 * 1024;
+
+    // Most tasks one parallel_for splits into; larger pools use this many.
+    LMATH_CONSTEXPR_VAR std::size_t max_tasks = 64;
+
+    namespace detail {
+        LMATH_OUT std::size_t gcd(std::size_t a, std::size_t b) noexcept {
+            while (b != 0) {
+                const std::size_t t = a % b;
+                a = b;
+                b = t;
+            }
+            return a;
+        }
+    } // namespace detail
+
+    // Elements per block for ~`bytes` of T, a multiple of the elements that
+    // fill a whole number of cache lines (16 for vec3, 4 for vec4, 1 for mat4).
+    template<typename T>
+    LMATH_OUT std::size_t block_for(std::size_t bytes = default_block_bytes) noexcept {
+        const std::size_t line_elems = cache_line / detail::gcd(cache_line, sizeof(T));
+        const std::size_t elems = (bytes + sizeof(T) - 1) / sizeof(T);
+        return (elems + line_elems - 1) / line_elems * line_elems;
+    }
+
+#if !defined(LMATH_FREESTANDING)
+    namespace detail {
+
+        // one task's remaining blocks [begin, end), packed so the owner
+        // (front) and thieves (back) race on a single CAS
+        struct alignas(cache_line) range_slot {
+            std::atomic<std::uint64_t> range;
+        };
+
+        LMATH_FORCE_INLINE std::uint64_t pack(std::uint32_t b, std::uint32_t e) noexcept {
+            return std::uint64_t(b) | (std::uint64_t(e) << 32);
+        }
+        LMATH_FORCE_INLINE std::uint32_t range_begin(std::uint64_t r) noexcept { return std::uint32_t(r); }
+        LMATH_FORCE_INLINE std::uint32_t range_end(std::uint64_t r) noexcept { return std::uint32_t(r >> 32); }
+
+        template<typename Body>
+        struct for_job {
+            Body*       body;
+            std::size_t n;
+            std::size_t block;
+            std::size_t tasks;
+            range_slot  slots[max_tasks];
+        };
+
+        // front block of `slot`, or false once it is empty
+        inline bool pop_front(range_slot& slot, std::uint32_t& block) noexcept {
+            std::uint64_t r = slot.range.load(std::memory_order_acquire);
+            for (;;) {
+                const std::uint32_t b = range_begin(r), e = range_end(r);
+                if (b >= e)
+                    return false;
+                if (slot.range.compare_exchange_weak(r, pack(b + 1, e), std::memory_order_acq_rel)) {
+                    block = b;
+                    return true;
+                }
+            }
+        }
+
+        // back half of the fullest other slot into `self`; false when
+        // every slot is empty, which ends the task
+        inline bool steal(range_slot* slots, std::size_t tasks, std::size_t self) noexcept {
+            for (;;) {
+                std::size_t victim = tasks;
+                std::uint32_t most = 0;
+                for (std::size_t k = 1; k < tasks; ++k) {
+                    const std::size_t v = (self + k) % tasks;
+                    const std::uint64_t r = slots[v].range.load(std::memory_order_relaxed);
+                    const std::uint32_t left = range_end(r) - range_begin(r);
+                    if (range_begin(r) < range_end(r) && left > most) {
+                        most = left;
+                        victim = v;
+                    }
+                }
+                if (victim == tasks)
+                    return false;
+
+                std::uint64_t r = slots[victim].range.load(std::memory_order_acquire);
+                const std::uint32_t b = range_begin(r), e = range_end(r);
+                if (b >= e)
+                    continue;
+                const std::uint32_t mid = b + (e - b) / 2;
+                if (slots[victim].range.compare_exchange_strong(r, pack(b, mid), std::memory_order_acq_rel)) {
+                    slots[self].range.store(pack(mid, e), std::memory_order_release);
+                    return true;
+                }
+            }
+        }
+
+        template<typename Body>
+        void for_task(void* ctx, std::size_t self) noexcept {
+            for_job<Body>& J = *static_cast<for_job<Body>*>(ctx);
+            std::uint32_t blk = 0;
+            do {
+                while (pop_front(J.slots[self], blk)) {
+                    const std::size_t b = std::size_t(blk) * J.block;
+                    const std::size_t e = J.n - b < J.block ? J.n : b + J.block;
+                    (*J.body)(b, e);
+                }
+            } while (steal(J.slots, J.tasks, self));
+        }
+
+    } // namespace detail
+#endif
+
+    template<typename Body>
+    void parallel_for(worker_pool pool, std::size_t n, std::size_t block, Body&& body) noexcept {
+        if (n == 0)
+            return;
+        if (block == 0)
+            block = 1;
+#if !defined(LMATH_FREESTANDING)
+        // block indices are 32-bit
+        if (n / block >= 0xffffffffu)
+            block = n / 0xffffffffu + 1;
+        const std::size_t blocks = (n + block - 1) / block;
+
+        std::size_t tasks = pool.workers < max_tasks ? pool.workers : max_tasks;
+        if (tasks > blocks)
+            tasks = blocks;
+        if (tasks > 1) {
+            using B = typename std::remove_reference<Body>::type;
+            detail::for_job<B> job;
+            job.body = &body;
+            job.n = n;
+            job.block = block;
+            job.tasks = tasks;
+            for (std::size_t t = 0; t < tasks; ++t)
+                job.slots[t].range.store(detail::pack(std::uint32_t(blocks * t / tasks),
+                                                      std::uint32_t(blocks * (t + 1) / tasks)),
+                                         std::memory_order_relaxed);
+            pool.run(pool.self, tasks, &detail::for_task<B>, &job);
+            return;
+        }
+#else
+        (void)pool;
+#endif
+        for (std::size_t b = 0; b < n; b += block)
+            body(b, n - b < block ? n : b + block);
+    }
+
+} // namespace par
+
+} // namespace lm
@@ -0,0 +1,265 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "detail/feature_detection.hpp"
+
+#include "mat.hpp"
+#include "quat.hpp"
+#include "dualquat.hpp"
+#include "skinning.hpp"
+#include "trs.hpp"
+#include "soa.hpp"
+#include "bounds.hpp"
+#include "frustum.hpp"
+#include "worker_pool.hpp"
+#include "par.hpp"
+
+namespace lm {
+
+    // ============================================================
+    // Batch kernels on a worker pool
+    //
+    // Same results as the single-threaded versions, bit for bit: each
+    // block runs the same kernel on its slice. Blocks are cache-line
+    // multiples of the output element (par::block_for).
+    // ============================================================
+
+    /* M4*V4[] par */inline void
+    mat4_mul_vec_batch(const mat4& M, const vec4* in, vec4* out, std::size_t n, worker_pool pool) noexcept {
+        par::parallel_for(pool, n, par::block_for<vec4>(), [&](std::size_t b, std::size_t e) {
+            mat4_mul_vec_batch(M, in + b, out + b, e - b);
+        });
+    }
+
+    /* M4*P3[] par */inline void
+    mat4_transform_points(const mat4& M, const vec3* in, vec3* out, std::size_t n, worker_pool pool) noexcept {
+        par::parallel_for(pool, n, par::block_for<vec3>(), [&](std::size_t b, std::size_t e) {
+            mat4_transform_points(M, in + b, out + b, e - b);
+        });
+    }
+
+    /* M4*D3[] par */inline void
+    mat4_transform_dirs(const mat4& M, const vec3* in, vec3* out, std::size_t n, worker_pool pool) noexcept {
+        par::parallel_for(pool, n, par::block_for<vec3>(), [&](std::size_t b, std::size_t e) {
+            mat4_transform_dirs(M, in + b, out + b, e - b);
+        });
+    }
+
+    /* M4*M4[] par */inline void
+    mat4_mul_batch(const mat4* A, const mat4* B, mat4* out, std::size_t n, worker_pool pool,
+                   store_mode mode = store_mode::cached) noexcept {
+        par::parallel_for(pool, n, par::block_for<mat4>(), [&](std::size_t b, std::size_t e) {
+            mat4_mul_batch(A + b, B + b, out + b, e - b, mode);
+        });
+    }
+
+    /* M4*M4[] par */inline void
+    mat4_mul_batch_left(const mat4& A, const mat4* B, mat4* out, std::size_t n, worker_pool pool,
+                        store_mode mode = store_mode::cached) noexcept {
+        par::parallel_for(pool, n, par::block_for<mat4>(), [&](std::size_t b, std::size_t e) {
+            mat4_mul_batch_left(A, B + b, out + b, e - b, mode);
+        });
+    }
+
+    inline void vec3_norm_batch(const vec3* in, vec3* out, std::size_t n, worker_pool pool) noexcept {
+        par::parallel_for(pool, n, par::block_for<vec3>(), [&](std::size_t b, std::size_t e) {
+            vec3_norm_batch(in + b, out + b, e - b);
+        });
+    }
+
+    inline void vec4_norm_batch(const vec4* in, vec4* out, std::size_t n, worker_pool pool) noexcept {
+        par::parallel_for(pool, n, par::block_for<vec4>(), [&](std::size_t b, std::size_t e) {
+            vec4_norm_batch(in + b, out + b, e - b);
+        });
+    }
+
+    /* Q*V3[] par */inline void
+    quat_mul_vec3_batch(const quat& Q, const vec3* in, vec3* out, std::size_t n, worker_pool pool) noexcept {
+        par::parallel_for(pool, n, par::block_for<vec3>(), [&](std::size_t b, std::size_t e) {
+            quat_mul_vec3_batch(Q, in + b, out + b, e - b);
+        });
+    }
+
+    /* Q*Q[] par */inline void
+    quat_mul_batch(const quat* A, const quat* B, quat* out, std::size_t n, worker_pool pool) noexcept {
+        par::parallel_for(pool, n, par::block_for<quat>(), [&](std::size_t b, std::size_t e) {
+            quat_mul_batch(A + b, B + b, out + b, e - b);
+        });
+    }
+
+    /* DQ*DQ[] par */inline void
+    dualquat_mul_batch(const dualquat* A, const dualquat* B, dualquat* out, std::size_t n,
+                       worker_pool pool) noexcept {
+        par::parallel_for(pool, n, par::block_for<dualquat>(), [&](std::size_t b, std::size_t e) {
+            dualquat_mul_batch(A + b, B + b, out + b, e - b);
+        });
+    }
+
+    /* DQ*P3[] par */inline void
+    dualquat_transform_point_batch(const dualquat* D, const vec3* in, vec3* out, std::size_t n,
+                                   worker_pool pool) noexcept {
+        par::parallel_for(pool, n, par::block_for<dualquat>(), [&](std::size_t b, std::size_t e) {
+            dualquat_transform_point_batch(D + b, in + b, out + b, e - b);
+        });
+    }
+
+    /* TRS[] par */inline void
+    trs_to_mat4_batch(const trs* in, mat4* out, std::size_t n, worker_pool pool) noexcept {
+        par::parallel_for(pool, n, par::block_for<mat4>(), [&](std::size_t b, std::size_t e) {
+            trs_to_mat4_batch(in + b, out + b, e - b);
+        });
+    }
+
+    /* M4->TRS[] par */inline void
+    mat4_decompose_batch(const mat4* in, trs* out, std::size_t n, worker_pool pool) noexcept {
+        par::parallel_for(pool, n, par::block_for<trs>(), [&](std::size_t b, std::size_t e) {
+            mat4_decompose_batch(in + b, out + b, e - b);
+        });
+    }
+
+    namespace detail {
+        // chunks of vertices; nrm / out_nrm stay null together
+        template<typename J>
+        inline void skin_lbs_par(const mat4* palette, const vec3* pos, const vec3* nrm, const J* joints,
+                                 const float* weights, vec3* out_pos, vec3* out_nrm, std::size_t n,
+                                 worker_pool pool) noexcept {
+            par::parallel_for(pool, n, par::block_for<vec3>(), [&](std::size_t b, std::size_t e) {
+                skin_lbs(palette, pos + b, nrm ? nrm + b : nullptr, joints + 4 * b, weights + 4 * b,
+                         out_pos + b, out_nrm ? out_nrm + b : nullptr, e - b);
+            });
+        }
+    } // namespace detail
+
+    /* LBS par */inline void
+    skin_lbs(const mat4* palette, const vec3* pos, const vec3* nrm,
+             const std::uint8_t* joints, const float* weights,
+             vec3* out_pos, vec3* out_nrm, std::size_t n, worker_pool pool) noexcept {
+        detail::skin_lbs_par(palette, pos, nrm, joints, weights, out_pos, out_nrm, n, pool);
+    }
+
+    /* LBS par */inline void
+    skin_lbs(const mat4* palette, const vec3* pos, const vec3* nrm,
+             const std::uint16_t* joints, const float* weights,
+             vec3* out_pos, vec3* out_nrm, std::size_t n, worker_pool pool) noexcept {
+        detail::skin_lbs_par(palette, pos, nrm, joints, weights, out_pos, out_nrm, n, pool);
+    }
+
+    namespace detail {
+        // bitmask kernels (culling, overlap tests): ~default_block_bytes of
+        // spheres, in whole cache lines of the mask (512 objects)
+        LMATH_OUT std::size_t cull_block() noexcept {
+            const std::size_t line_objs = 32 * (par::cache_line / sizeof(std::uint32_t));
+            return (par::block_for<vec4>() + line_objs - 1) / line_objs * line_objs;
+        }
+
+        template<std::size_t N>
+        LMATH_FORCE_INLINE vec_soa<N> soa_slice(const vec_soa<N>& S, std::size_t b, std::size_t e) noexcept {
+            vec_soa<N> R = S;
+            for (std::size_t c = 0; c < N; ++c) R.comp[c] += b;
+            R.n = e - b;
+            return R;
+        }
+    } // namespace detail
+
+    inline void frustum_cull_spheres(const frustum& F, const vec4_soa& S, std::uint32_t* visible,
+                                     worker_pool pool) noexcept {
+        par::parallel_for(pool, S.n, detail::cull_block(), [&](std::size_t b, std::size_t e) {
+            frustum_cull_spheres(F, detail::soa_slice(S, b, e), visible + b / 32);
+        });
+    }
+
+    inline void frustum_cull_aabbs(const frustum& F, const vec3_soa& lo, const vec3_soa& hi,
+                                   std::uint32_t* visible, worker_pool pool) noexcept {
+        par::parallel_for(pool, hi.n, detail::cull_block(), [&](std::size_t b, std::size_t e) {
+            frustum_cull_aabbs(F, detail::soa_slice(lo, b, e), detail::soa_slice(hi, b, e), visible + b / 32);
+        });
+    }
+
+    inline void aabb_transform_batch(const mat4& M, const vec3_soa& lo, const vec3_soa& hi,
+                                     const vec3_soa& out_lo, const vec3_soa& out_hi, worker_pool pool) noexcept {
+        par::parallel_for(pool, out_lo.n, par::block_for<vec3>(), [&](std::size_t b, std::size_t e) {
+            aabb_transform_batch(M, detail::soa_slice(lo, b, e), detail::soa_slice(hi, b, e),
+                                 detail::soa_slice(out_lo, b, e), detail::soa_slice(out_hi, b, e));
+        });
+    }
+
+    inline void sphere_transform_batch(const mat4& M, const vec4_soa& S, const vec4_soa& out,
+                                       worker_pool pool) noexcept {
+        par::parallel_for(pool, out.n, par::block_for<vec4>(), [&](std::size_t b, std::size_t e) {
+            sphere_transform_batch(M, detail::soa_slice(S, b, e), detail::soa_slice(out, b, e));
+        });
+    }
+
+    inline void aabb_overlap_batch(const aabb3& Q, const vec3_soa& lo, const vec3_soa& hi,
+                                   std::uint32_t* mask, worker_pool pool) noexcept {
+        par::parallel_for(pool, hi.n, detail::cull_block(), [&](std::size_t b, std::size_t e) {
+            aabb_overlap_batch(Q, detail::soa_slice(lo, b, e), detail::soa_slice(hi, b, e), mask + b / 32);
+        });
+    }
+
+    inline void aabb_contains_batch(const aabb3& Q, const vec3_soa& lo, const vec3_soa& hi,
+                                    std::uint32_t* mask, worker_pool pool) noexcept {
+        par::parallel_for(pool, hi.n, detail::cull_block(), [&](std::size_t b, std::size_t e) {
+            aabb_contains_batch(Q, detail::soa_slice(lo, b, e), detail::soa_slice(hi, b, e), mask + b / 32);
+        });
+    }
+
+    inline void sphere_overlap_batch(const sphere3& Q, const vec4_soa& S, std::uint32_t* mask,
+                                     worker_pool pool) noexcept {
+        par::parallel_for(pool, S.n, detail::cull_block(), [&](std::size_t b, std::size_t e) {
+            sphere_overlap_batch(Q, detail::soa_slice(S, b, e), mask + b / 32);
+        });
+    }
+
+    inline void sphere_contains_batch(const sphere3& Q, const vec4_soa& S, std::uint32_t* mask,
+                                      worker_pool pool) noexcept {
+        par::parallel_for(pool, S.n, detail::cull_block(), [&](std::size_t b, std::size_t e) {
+            sphere_contains_batch(Q, detail::soa_slice(S, b, e), mask + b / 32);
+        });
+    }
+
+    inline void quat_soa_nlerp(const quat_soa& A, const quat_soa& B, float t, const quat_soa& out,
+                               worker_pool pool) noexcept {
+        par::parallel_for(pool, out.n, par::block_for<quat>(), [&](std::size_t b, std::size_t e) {
+            quat_soa_nlerp(detail::soa_slice(A, b, e), detail::soa_slice(B, b, e), t, detail::soa_slice(out, b, e));
+        });
+    }
+
+    inline void quat_soa_nlerp(const quat_soa& A, const quat_soa& B, const float* t, const quat_soa& out,
+                               worker_pool pool) noexcept {
+        par::parallel_for(pool, out.n, par::block_for<quat>(), [&](std::size_t b, std::size_t e) {
+            quat_soa_nlerp(detail::soa_slice(A, b, e), detail::soa_slice(B, b, e), t + b, detail::soa_slice(out, b, e));
+        });
+    }
+
+    inline void quat_soa_slerp(const quat_soa& A, const quat_soa& B, float t, const quat_soa& out,
+                               worker_pool pool) noexcept {
+        par::parallel_for(pool, out.n, par::block_for<quat>(), [&](std::size_t b, std::size_t e) {
+            quat_soa_slerp(detail::soa_slice(A, b, e), detail::soa_slice(B, b, e), t, detail::soa_slice(out, b, e));
+        });
+    }
+
+    inline void quat_soa_slerp(const quat_soa& A, const quat_soa& B, const float* t, const quat_soa& out,
+                               worker_pool pool) noexcept {
+        par::parallel_for(pool, out.n, par::block_for<quat>(), [&](std::size_t b, std::size_t e) {
+            quat_soa_slerp(detail::soa_slice(A, b, e), detail::soa_slice(B, b, e), t + b, detail::soa_slice(out, b, e));
+        });
+    }
+
+    inline void quat_soa_slerp_fast(const quat_soa& A, const quat_soa& B, float t, const quat_soa& out,
+                                    worker_pool pool) noexcept {
+        par::parallel_for(pool, out.n, par::block_for<quat>(), [&](std::size_t b, std::size_t e) {
+            quat_soa_slerp_fast(detail::soa_slice(A, b, e), detail::soa_slice(B, b, e), t, detail::soa_slice(out, b, e));
+        });
+    }
+
+    inline void quat_soa_slerp_fast(const quat_soa& A, const quat_soa& B, const float* t, const quat_soa& out,
+                                    worker_pool pool) noexcept {
+        par::parallel_for(pool, out.n, par::block_for<quat>(), [&](std::size_t b, std::size_t e) {
+            quat_soa_slerp_fast(detail::soa_slice(A, b, e), detail::soa_slice(B, b, e), t + b, detail::soa_slice(out, b, e));
+        });
+    }
+
+} // namespace lm
@@ -4,9 +4,11 @@
 #include <cstdint>
 
 #include "detail/feature_detection.hpp"
+#include "detail/simd_lanes.hpp"
 #include "libc_integration.hpp"
 #include "vec.hpp"
 #include "mat.hpp"
+#include "soa.hpp"
 
 namespace lm {
 
@@ -106,8 +108,9 @@ namespace lm {
     LMATH_OUT quat_of<T> quat_rotate(              T angle,
                                      const vec<T,3>& axis) noexcept {
         vec<T,3> n = vec_norm(axis);
-        T s = ::lm::sinf(angle * T(0.5));
-        T c = ::lm::cosf(angle * T(0.5));
+        const sincos_f sc = ::lm::sincosf(angle * T(0.5));
+        T s = sc.s;
+        T c = sc.c;
         return { n * s, c };
     }
 
@@ -123,6 +126,353 @@ namespace lm {
         return V + C*Q.w + vec3_cross(Q.v,C);
     }
 
+    // ============================================================
+    // quat (float): SIMD
+    //
+    // quat_mul / quat_mul_vec3 stay on the constexpr templates above,
+    // and so do the batch versions: one quaternion per register, or the
+    // lane kernels behind an AoS <-> SoA transpose, both lose to the
+    // plain loop the compiler vectorizes. The kernels below serve
+    // dualquat.hpp, whose products are long enough to pay for them; they
+    // repeat the scalar operation order, so results stay bit-identical.
+    // ============================================================
+
+    namespace detail {
+
+#if defined(__SSE2__)
+        // (y, z, x, w) and (z, x, y, w)
+        LMATH_FORCE_INLINE __m128 quat_yzx_sse2(__m128 a) noexcept {
+            return _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+        }
+        LMATH_FORCE_INLINE __m128 quat_zxy_sse2(__m128 a) noexcept {
+            return _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 1, 0, 2));
+        }
+
+        // vec3_cross(a, b) in lanes x, y, z
+        LMATH_FORCE_INLINE __m128 quat_cross_sse2(__m128 a, __m128 b) noexcept {
+            return _mm_sub_ps(_mm_mul_ps(quat_yzx_sse2(a), quat_zxy_sse2(b)),
+                              _mm_mul_ps(quat_zxy_sse2(a), quat_yzx_sse2(b)));
+        }
+
+        LMATH_FORCE_INLINE __m128 quat_mul_sse2(__m128 p, __m128 q) noexcept {
+            // xyz: cross(P.v, Q.v) + P.v * Q.w + Q.v * P.w
+            __m128 v = quat_cross_sse2(p, q);
+            v = _mm_add_ps(v, _mm_mul_ps(p, _mm_shuffle_ps(q, q, _MM_SHUFFLE(3, 3, 3, 3))));
+            v = _mm_add_ps(v, _mm_mul_ps(q, _mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 3, 3, 3))));
+
+            // w: P.w * Q.w - ((x + y) + z) of P * Q, in lane 0
+            const __m128 m = _mm_mul_ps(p, q);
+            __m128 dot = _mm_add_ss(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 1, 1, 1)));
+            dot = _mm_add_ss(dot, _mm_movehl_ps(m, m));
+            const __m128 w = _mm_sub_ss(_mm_shuffle_ps(m, m, _MM_SHUFFLE(3, 3, 3, 3)), dot);
+
+            const __m128 zw = _mm_shuffle_ps(v, w, _MM_SHUFFLE(0, 0, 2, 2)); // v.z v.z w w
+            return _mm_shuffle_ps(v, zw, _MM_SHUFFLE(2, 0, 1, 0));
+        }
+#endif
+
+#if defined(__ARM_NEON)
+        // (y, z, x, x) and (z, x, y, y); lane 3 is never used
+        LMATH_FORCE_INLINE float32x4_t quat_yzx_neon(float32x4_t a) noexcept {
+            return vsetq_lane_f32(vgetq_lane_f32(a, 0), vextq_f32(a, a, 1), 2);
+        }
+        LMATH_FORCE_INLINE float32x4_t quat_zxy_neon(float32x4_t a) noexcept {
+            const float32x4_t t = vsetq_lane_f32(vgetq_lane_f32(a, 0), vextq_f32(a, a, 2), 1);
+            return vsetq_lane_f32(vgetq_lane_f32(a, 1), t, 2);
+        }
+
+        LMATH_FORCE_INLINE float32x4_t quat_cross_neon(float32x4_t a, float32x4_t b) noexcept {
+            return vsubq_f32(vmulq_f32(quat_yzx_neon(a), quat_zxy_neon(b)),
+                             vmulq_f32(quat_zxy_neon(a), quat_yzx_neon(b)));
+        }
+
+        // separate mul / add (no vmla) to keep the scalar rounding
+        LMATH_FORCE_INLINE quat quat_mul_neon(const quat& P, const quat& Q) noexcept {
+            const float32x4_t p = vld1q_f32(P.v.data());
+            const float32x4_t q = vld1q_f32(Q.v.data());
+            float32x4_t v = quat_cross_neon(p, q);
+            v = vaddq_f32(v, vmulq_n_f32(p, Q.w));
+            v = vaddq_f32(v, vmulq_n_f32(q, P.w));
+
+            const float32x4_t m = vmulq_f32(p, q);
+            const float dot = (vgetq_lane_f32(m, 0) + vgetq_lane_f32(m, 1)) + vgetq_lane_f32(m, 2);
+            v = vsetq_lane_f32(vgetq_lane_f32(m, 3) - dot, v, 3);
+
+            quat R;
+            vst1q_f32(R.v.data(), v);
+            return R;
+        }
+#endif
+
+        // ------------------------------------------------------------
+        // Lane kernels, one component per register
+        // ------------------------------------------------------------
+        template<typename V>
+        LMATH_FORCE_INLINE void quat_mul_lanes(const typename V::reg (&p)[4], const typename V::reg (&q)[4],
+                                               typename V::reg (&r)[4]) noexcept {
+            r[0] = V::add(V::add(V::sub(V::mul(p[1], q[2]), V::mul(p[2], q[1])), V::mul(p[0], q[3])), V::mul(q[0], p[3]));
+            r[1] = V::add(V::add(V::sub(V::mul(p[2], q[0]), V::mul(p[0], q[2])), V::mul(p[1], q[3])), V::mul(q[1], p[3]));
+            r[2] = V::add(V::add(V::sub(V::mul(p[0], q[1]), V::mul(p[1], q[0])), V::mul(p[2], q[3])), V::mul(q[2], p[3]));
+            r[3] = V::sub(V::mul(p[3], q[3]),
+                          V::add(V::add(V::mul(p[0], q[0]), V::mul(p[1], q[1])), V::mul(p[2], q[2])));
+        }
+
+        // q (broadcast) x a
+        template<typename V>
+        LMATH_FORCE_INLINE void quat_cross_lanes(const typename V::reg (&q)[4], const typename V::reg (&a)[3],
+                                                 typename V::reg (&r)[3]) noexcept {
+            r[0] = V::sub(V::mul(q[1], a[2]), V::mul(q[2], a[1]));
+            r[1] = V::sub(V::mul(q[2], a[0]), V::mul(q[0], a[2]));
+            r[2] = V::sub(V::mul(q[0], a[1]), V::mul(q[1], a[0]));
+        }
+
+        template<typename V>
+        LMATH_FORCE_INLINE void quat_mul_vec3_lanes(const typename V::reg (&q)[4],
+                                                    typename V::reg (&v)[3]) noexcept {
+            typename V::reg c[3], d[3];
+            quat_cross_lanes<V>(q, v, c);
+            for (std::size_t k = 0; k < 3; ++k) c[k] = V::mul(c[k], V::set1(2.f));
+            quat_cross_lanes<V>(q, c, d);
+            for (std::size_t k = 0; k < 3; ++k)
+                v[k] = V::add(V::add(v[k], V::mul(c[k], q[3])), d[k]);
+        }
+
+        // quat has vec4's layout; dualquat / trs batches reuse its AoS <-> SoA shuffles
+        static_assert(sizeof(quat) == sizeof(vec4), "quat must be four packed floats");
+
+        LMATH_FORCE_INLINE const vec4* quat_as_vec4(const quat* q) noexcept {
+            return reinterpret_cast<const vec4*>(q);
+        }
+        LMATH_FORCE_INLINE vec4* quat_as_vec4(quat* q) noexcept {
+            return reinterpret_cast<vec4*>(q);
+        }
+
+    } // namespace detail
+
+    // out[i] = quat_mul_vec3(Q, in[i]); `out` may alias `in`
+    /* Q*V3[] */inline void
+    quat_mul_vec3_batch(const quat& Q, const vec3* in, vec3* out, std::size_t n) noexcept {
+        for (std::size_t i = 0; i < n; ++i) out[i] = quat_mul_vec3(Q, in[i]);
+    }
+
+    // out[i] = quat_mul(A[i], B[i]); `out` may alias either input
+    /* Q*Q[] */inline void
+    quat_mul_batch(const quat* A, const quat* B, quat* out, std::size_t n) noexcept {
+        for (std::size_t i = 0; i < n; ++i) out[i] = quat_mul(A[i], B[i]);
+    }
+
+    // ============================================================
+    // Interpolation
+    //
+    // quat_nlerp      : normalized lerp; exact path, uneven speed.
+    // quat_slerp      : constant angular speed. Falls back to nlerp when
+    //                   the inputs are within ~1.8 degrees (|dot| > 0.9995),
+    //                   where the two agree to float precision.
+    // quat_slerp_fast : nlerp with t bent by a polynomial in t and |dot|
+    //                   (Kapoulkine, "Approximating slerp"); about 1e-3
+    //                   from slerp at the cost of one nlerp.
+    //
+    // All three take the shortest arc: when dot(A, B) < 0 they blend
+    // towards -B. The sign is applied with a select, not a branch, so
+    // lanes with mixed signs run the same instructions. Inputs are unit
+    // quaternions; t in [0, 1].
+    //
+    // The quat_soa_* versions blend whole SoA arrays (x, y, z, w streams,
+    // e.g. every joint of a skeleton) 4 or 8 lanes at a time, with one t
+    // for all or one per element. The single-quaternion functions run
+    // the same lane kernel one lane wide, so both agree bit for bit (the
+    // scalar lane rounds ties to even like the vector ones).
+    // ============================================================
+
+    // x, y, z, w streams
+    using quat_soa = vec4_soa;
+
+    namespace detail {
+
+        // flips b to a's hemisphere; returns |dot(a, b)|
+        template<typename V>
+        LMATH_FORCE_INLINE typename V::reg quat_shortest_lanes(const typename V::reg (&a)[4],
+                                                               typename V::reg (&b)[4]) noexcept {
+            // quat_dot order
+            const typename V::reg d = V::add(V::add(V::add(V::mul(a[0], b[0]), V::mul(a[1], b[1])),
+                                                    V::mul(a[2], b[2])), V::mul(a[3], b[3]));
+            const typename V::reg sign = V::select(V::cmplt(d, V::zero()), V::set1(-1.f), V::set1(1.f));
+            for (std::size_t k = 0; k < 4; ++k) b[k] = V::mul(b[k], sign);
+            return V::mul(d, sign);
+        }
+
+        // r = norm(a + (b - a) t)
+        template<typename V>
+        LMATH_FORCE_INLINE void quat_nlerp_lanes(const typename V::reg (&a)[4], const typename V::reg (&b)[4],
+                                                 typename V::reg t, typename V::reg (&r)[4]) noexcept {
+            for (std::size_t k = 0; k < 4; ++k)
+                r[k] = V::add(a[k], V::mul(V::sub(b[k], a[k]), t));
+            const typename V::reg len2 = V::add(V::add(V::add(V::mul(r[0], r[0]), V::mul(r[1], r[1])),
+                                                       V::mul(r[2], r[2])), V::mul(r[3], r[3]));
+            const typename V::reg inv = V::div(V::set1(1.f), V::sqrt(len2));
+            for (std::size_t k = 0; k < 4; ++k) r[k] = V::mul(r[k], inv);
+        }
+
+        // acos on [0, 1]: cephes asinf, via 2 asin(sqrt((1 - x) / 2)) above 0.5
+        template<typename V>
+        LMATH_FORCE_INLINE typename V::reg acos01_lanes(typename V::reg x) noexcept {
+            using reg = typename V::reg;
+            const typename V::mask big = V::cmpgt(x, V::set1(0.5f));
+            const reg zb = V::mul(V::sub(V::set1(1.f), x), V::set1(0.5f));
+            const reg z = V::select(big, zb, V::mul(x, x));
+            const reg s = V::select(big, V::sqrt(zb), x);
+
+            reg p = V::set1(4.2163199048e-2f);
+            p = V::add(V::mul(p, z), V::set1(2.4181311049e-2f));
+            p = V::add(V::mul(p, z), V::set1(4.5470025998e-2f));
+            p = V::add(V::mul(p, z), V::set1(7.4953002686e-2f));
+            p = V::add(V::mul(p, z), V::set1(1.6666752422e-1f));
+            p = V::add(V::mul(V::mul(p, z), s), s);
+            return V::select(big, V::add(p, p), V::sub(V::set1(PI_HALF), p));
+        }
+
+        template<typename V>
+        LMATH_FORCE_INLINE void quat_slerp_lanes(const typename V::reg (&a)[4], typename V::reg (&b)[4],
+                                                 typename V::reg t, typename V::reg (&r)[4]) noexcept {
+            using reg = typename V::reg;
+            const reg d = V::min(quat_shortest_lanes<V>(a, b), V::set1(1.f));
+
+            const reg theta = acos01_lanes<V>(d);
+            const reg sin_theta = V::sqrt(V::mul(V::sub(V::set1(1.f), d), V::add(V::set1(1.f), d)));
+            reg sa, sb, unused;
+            sincos_lanes<V>(V::mul(V::sub(V::set1(1.f), t), theta), sa, unused);
+            sincos_lanes<V>(V::mul(t, theta), sb, unused);
+            const reg inv = V::div(V::set1(1.f), sin_theta);
+            const reg wa = V::mul(sa, inv);
+            const reg wb = V::mul(sb, inv);
+
+            // nearly parallel: sin_theta -> 0, take nlerp (inf / NaN lanes
+            // above are dropped by the select)
+            reg n[4];
+            quat_nlerp_lanes<V>(a, b, t, n);
+            const typename V::mask close = V::cmpgt(d, V::set1(0.9995f));
+            for (std::size_t k = 0; k < 4; ++k)
+                r[k] = V::select(close, n[k], V::add(V::mul(a[k], wa), V::mul(b[k], wb)));
+        }
+
+        template<typename V>
+        LMATH_FORCE_INLINE void quat_slerp_fast_lanes(const typename V::reg (&a)[4], typename V::reg (&b)[4],
+                                                      typename V::reg t, typename V::reg (&r)[4]) noexcept {
+            using reg = typename V::reg;
+            const reg d = quat_shortest_lanes<V>(a, b);
+
+            // t' = t + t (t - 1/2) (t - 1) k,  k = A(d) (t - 1/2)^2 + B(d)
+            reg ka = V::add(V::mul(d, V::set1(-1.43519f)), V::set1(3.55645f));
+            ka = V::add(V::mul(d, ka), V::set1(-3.2452f));
+            ka = V::add(V::mul(d, ka), V::set1(1.0904f));
+            reg kb = V::add(V::mul(d, V::set1(0.215638f)), V::set1(-1.06021f));
+            kb = V::add(V::mul(d, kb), V::set1(0.848013f));
+            const reg h = V::sub(t, V::set1(0.5f));
+            const reg k = V::add(V::mul(V::mul(ka, h), h), kb);
+            const reg tt = V::add(t, V::mul(V::mul(V::mul(t, h), V::sub(t, V::set1(1.f))), k));
+
+            quat_nlerp_lanes<V>(a, b, tt, r);
+        }
+
+        struct quat_nlerp_kernel {
+            template<typename V, typename R>
+            LMATH_FORCE_INLINE void operator()(V, const R (&a)[4], R (&b)[4], R t, R (&r)[4]) const noexcept {
+                quat_shortest_lanes<V>(a, b);
+                quat_nlerp_lanes<V>(a, b, t, r);
+            }
+        };
+        struct quat_slerp_kernel {
+            template<typename V, typename R>
+            LMATH_FORCE_INLINE void operator()(V, const R (&a)[4], R (&b)[4], R t, R (&r)[4]) const noexcept {
+                quat_slerp_lanes<V>(a, b, t, r);
+            }
+        };
+        struct quat_slerp_fast_kernel {
+            template<typename V, typename R>
+            LMATH_FORCE_INLINE void operator()(V, const R (&a)[4], R (&b)[4], R t, R (&r)[4]) const noexcept {
+                quat_slerp_fast_lanes<V>(a, b, t, r);
+            }
+        };
+
+        // one quat through the one-lane kernel
+        template<typename Kernel>
+        LMATH_FORCE_INLINE quat quat_blend_one(const quat& A, const quat& B, float t) noexcept {
+            const float a[4] = { A.v[0], A.v[1], A.v[2], A.w };
+            float b[4] = { B.v[0], B.v[1], B.v[2], B.w };
+            float r[4];
+            Kernel{}(lanes_scalar{}, a, b, t, r);
+            return { { r[0], r[1], r[2] }, r[3] };
+        }
+
+        // out[i] = Kernel(A[i], B[i], t[i]); t_at(S, i) loads the block's t
+        template<typename Kernel, typename TAt>
+        inline void quat_soa_blend(const quat_soa& A, const quat_soa& B, const quat_soa& out, TAt t_at) noexcept {
+            with_lanes([&](auto L) {
+                for_lanes<decltype(L)>(out.n, [&](auto S, std::size_t i) {
+                    using V = decltype(S);
+                    typename V::reg a[4], b[4], r[4];
+                    for (std::size_t k = 0; k < 4; ++k) {
+                        a[k] = V::load(A[k] + i);
+                        b[k] = V::load(B[k] + i);
+                    }
+                    Kernel{}(S, a, b, t_at(S, i), r);
+                    for (std::size_t k = 0; k < 4; ++k) V::store(out[k] + i, r[k]);
+                });
+            });
+        }
+
+        struct quat_t_uniform {
+            float t;
+            template<typename V>
+            LMATH_FORCE_INLINE typename V::reg operator()(V, std::size_t) const noexcept { return V::set1(t); }
+        };
+        struct quat_t_stream {
+            const float* t;
+            template<typename V>
+            LMATH_FORCE_INLINE typename V::reg operator()(V, std::size_t i) const noexcept { return V::load(t + i); }
+        };
+
+    } // namespace detail
+
+    LMATH_NO_DISCARD inline quat quat_nlerp(const quat& A, const quat& B, float t) noexcept {
+        return detail::quat_blend_one<detail::quat_nlerp_kernel>(A, B, t);
+    }
+
+    LMATH_NO_DISCARD inline quat quat_slerp(const quat& A, const quat& B, float t) noexcept {
+        return detail::quat_blend_one<detail::quat_slerp_kernel>(A, B, t);
+    }
+
+    LMATH_NO_DISCARD inline quat quat_slerp_fast(const quat& A, const quat& B, float t) noexcept {
+        return detail::quat_blend_one<detail::quat_slerp_fast_kernel>(A, B, t);
+    }
+
+    // out[i] = quat_nlerp(A[i], B[i], t), for i in [0, out.n); A, B hold at least out.n
+    inline void quat_soa_nlerp(const quat_soa& A, const quat_soa& B, float t, const quat_soa& out) noexcept {
+        detail::quat_soa_blend<detail::quat_nlerp_kernel>(A, B, out, detail::quat_t_uniform{ t });
+    }
+    // out[i] = quat_nlerp(A[i], B[i], t[i])
+    inline void quat_soa_nlerp(const quat_soa& A, const quat_soa& B, const float* t, const quat_soa& out) noexcept {
+        detail::quat_soa_blend<detail::quat_nlerp_kernel>(A, B, out, detail::quat_t_stream{ t });
+    }
+
+    // out[i] = quat_slerp(A[i], B[i], t)
+    inline void quat_soa_slerp(const quat_soa& A, const quat_soa& B, float t, const quat_soa& out) noexcept {
+        detail::quat_soa_blend<detail::quat_slerp_kernel>(A, B, out, detail::quat_t_uniform{ t });
+    }
+    // out[i] = quat_slerp(A[i], B[i], t[i])
+    inline void quat_soa_slerp(const quat_soa& A, const quat_soa& B, const float* t, const quat_soa& out) noexcept {
+        detail::quat_soa_blend<detail::quat_slerp_kernel>(A, B, out, detail::quat_t_stream{ t });
+    }
+
+    // out[i] = quat_slerp_fast(A[i], B[i], t)
+    inline void quat_soa_slerp_fast(const quat_soa& A, const quat_soa& B, float t, const quat_soa& out) noexcept {
+        detail::quat_soa_blend<detail::quat_slerp_fast_kernel>(A, B, out, detail::quat_t_uniform{ t });
+    }
+    // out[i] = quat_slerp_fast(A[i], B[i], t[i])
+    inline void quat_soa_slerp_fast(const quat_soa& A, const quat_soa& B, const float* t, const quat_soa& out) noexcept {
+        detail::quat_soa_blend<detail::quat_slerp_fast_kernel>(A, B, out, detail::quat_t_stream{ t });
+    }
+
     // ============================================================
     // Quaternion <-> mat4
     // ============================================================
@@ -153,37 +503,45 @@ namespace lm {
         return M;
     }
 
+    // Rotation part of M (upper 3x3, must be orthonormal) as a unit quat.
+    // Shepperd: solves for the largest of |w|, |x|, |y|, |z| first, so the
+    // divisor never gets small. w >= 0 on the trace branch only.
     template<typename T>
     LMATH_OUT quat_of<T> quat_from_mat4(const mat4_of<T>& M) noexcept {
-        T r{};
-        int p[3]{0,1,2};
-
-        for (int i = 0; i < 3; ++i) {
-            if (M[i][i] > r) {
-                r = M[i][i];
-                p[0] = i;
-                p[1] = (i+1)%3;
-                p[2] = (i+2)%3;
-            }
+        // R(r, c) = M[c][r]
+        const T m00 = M[0][0], m11 = M[1][1], m22 = M[2][2];
+        const T tr = m00 + m11 + m22;
+
+        if (tr > T(0)) {
+            const T s = ::lm::sqrtf(tr + T(1)) * T(2); // 4w
+            const T inv = T(1) / s;
+            return { { (M[1][2] - M[2][1]) * inv,
+                       (M[2][0] - M[0][2]) * inv,
+                       (M[0][1] - M[1][0]) * inv },
+                     s * T(0.25) };
         }
-
-        r = ::lm::sqrtf(
-            T(1) + M[p[0]][p[0]] - M[p[1]][p[1]] - M[p[2]][p[2]]
-        );
-
-        if (r < T(1e-6))
-            return { {T(1),T(0),T(0)}, T(0) };
-
-        T inv = T(1) / (T(2) * r);
-
-        return {
-            {
-                r * T(0.5),
-                (M[p[0]][p[1]] - M[p[1]][p[0]]) * inv,
-                (M[p[2]][p[0]] - M[p[0]][p[2]]) * inv
-            },
-            (M[p[2]][p[1]] - M[p[1]][p[2]]) * inv
-        };
+        if (m00 >= m11 && m00 >= m22) {
+            const T s = ::lm::sqrtf(T(1) + m00 - m11 - m22) * T(2); // 4x
+            const T inv = T(1) / s;
+            return { { s * T(0.25),
+                       (M[0][1] + M[1][0]) * inv,
+                       (M[2][0] + M[0][2]) * inv },
+                     (M[1][2] - M[2][1]) * inv };
+        }
+        if (m11 >= m22) {
+            const T s = ::lm::sqrtf(T(1) + m11 - m00 - m22) * T(2); // 4y
+            const T inv = T(1) / s;
+            return { { (M[0][1] + M[1][0]) * inv,
+                       s * T(0.25),
+                       (M[1][2] + M[2][1]) * inv },
+                     (M[2][0] - M[0][2]) * inv };
+        }
+        const T s = ::lm::sqrtf(T(1) + m22 - m00 - m11) * T(2); // 4z
+        const T inv = T(1) / s;
+        return { { (M[2][0] + M[0][2]) * inv,
+                   (M[1][2] + M[2][1]) * inv,
+                   s * T(0.25) },
+                 (M[0][1] - M[1][0]) * inv };
     }
 
     // ============================================================
@@ -0,0 +1,293 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "detail/feature_detection.hpp"
+#include "detail/simd_lanes.hpp"
+
+#include "libc_integration.hpp"
+#include "vec.hpp"
+#include "soa.hpp"
+#include "bounds.hpp"
+
+namespace lm {
+
+    // ============================================================
+    // Rays
+    //
+    // ray3         : origin o, direction d (any length; t is measured in
+    //                units of |d|).
+    // ray_packet<W>: W rays as SoA packs, plus 1/d per component for the
+    //                slab test. Fill it with ray_packet_load, or set
+    //                inv_d = 1 / d yourself.
+    //
+    // Each test returns whether the ray hits closer than the given t.
+    // Triangle and sphere tests then lower t to the hit distance (keep
+    // calling them to find the nearest hit); the box test reports the
+    // entry distance separately and leaves t alone, for traversal.
+    // ============================================================
+
+    struct ray3 {
+        vec3 o{};
+        vec3 d{};
+    };
+
+    template<std::size_t W>
+    struct ray_packet {
+        vec_pack<3, W> o;
+        vec_pack<3, W> d;
+        vec_pack<3, W> inv_d;
+    };
+
+    using ray_packet4 = ray_packet<4>;
+    using ray_packet8 = ray_packet<8>;
+
+    // ============================================================
+    // Single ray
+    //
+    // Built from the vec3 ops; the packet kernels below repeat the same
+    // arithmetic lane by lane, so both agree bit for bit (x86, no FP
+    // contraction).
+    // ============================================================
+
+    // Moller-Trumbore, both faces. Hit when u, v >= 0, u + v <= 1 and
+    // 0 < t_hit < t. A degenerate triangle or a ray in its plane gives
+    // det = 0, whose inf / NaN fail those tests.
+    inline bool ray_triangle(const ray3& R, const vec3& a, const vec3& b, const vec3& c,
+                             float& t) noexcept {
+        const vec3 e1 = vec_sub(b, a);
+        const vec3 e2 = vec_sub(c, a);
+        const vec3 p = vec3_cross(R.d, e2);
+        const float inv_det = 1.f / vec_dot(e1, p);
+
+        const vec3 s = vec_sub(R.o, a);
+        const float u = vec_dot(s, p) * inv_det;
+        const vec3 q = vec3_cross(s, e1);
+        const float v = vec_dot(R.d, q) * inv_det;
+        const float th = vec_dot(e2, q) * inv_det;
+
+        if (u >= 0.f && v >= 0.f && u + v <= 1.f && th > 0.f && th < t) {
+            t = th;
+            return true;
+        }
+        return false;
+    }
+
+    // Nearest root in front of the origin: the far one when the origin is
+    // inside the sphere.
+    inline bool ray_sphere(const ray3& R, const sphere3& S, float& t) noexcept {
+        const vec3 oc = vec_sub(R.o, S.c);
+        const float a = vec_dot(R.d, R.d);
+        const float b = vec_dot(oc, R.d);
+        const float c = vec_dot(oc, oc) - S.r * S.r;
+        const float disc = b * b - a * c;
+        if (!(disc >= 0.f))
+            return false;
+
+        const float sq = detail::lanes_scalar::sqrt(disc);
+        const float t0 = (-b - sq) / a;
+        const float t1 = (-b + sq) / a;
+        const float th = t0 > 0.f ? t0 : t1;
+        if (th > 0.f && th < t) {
+            t = th;
+            return true;
+        }
+        return false;
+    }
+
+    namespace detail {
+        // slab test with 1 / d precomputed; ray_aabb and BVH traversal
+        inline bool ray_aabb_inv(const vec3& o, const vec3& inv, const aabb3& B,
+                                 float t_max, float& t_near) noexcept {
+            const vec3 dl = vec_sub(B.lo, o);
+            const vec3 dh = vec_sub(B.hi, o);
+            const vec3 t1{ dl[0] * inv[0], dl[1] * inv[1], dl[2] * inv[2] };
+            const vec3 t2{ dh[0] * inv[0], dh[1] * inv[1], dh[2] * inv[2] };
+            const vec3 tn = vec_min(t1, t2);
+            const vec3 tf = vec_max(t1, t2);
+
+            // same operand order as the packet's V::max / V::min
+            float lo = 0.f, hi = t_max;
+            for (std::size_t k = 0; k < 3; ++k) {
+                lo = tn[k] > lo ? tn[k] : lo;
+                hi = tf[k] < hi ? tf[k] : hi;
+            }
+            if (lo <= hi) {
+                t_near = lo;
+                return true;
+            }
+            return false;
+        }
+
+        LMATH_OUT vec3 ray_inv_dir(const vec3& d) noexcept {
+            return { 1.f / d[0], 1.f / d[1], 1.f / d[2] };
+        }
+    } // namespace detail
+
+    // Slab test over [0, t_max]. On a hit t_near is the entry distance,
+    // 0 when the origin is inside. With d[k] = 0 the ray is inside slab k
+    // unless its origin lies exactly on one of that slab's faces
+    // (0 * inf = NaN), which counts as a miss.
+    inline bool ray_aabb(const ray3& R, const aabb3& B, float t_max, float& t_near) noexcept {
+        return detail::ray_aabb_inv(R.o, detail::ray_inv_dir(R.d), B, t_max, t_near);
+    }
+
+    // ============================================================
+    // Packets (SoA)
+    //
+    // 8-wide packets run one AVX register (two SSE2 / NEON halves), 4-wide
+    // ones one SSE2 / NEON register. The returned mask has bit i set when
+    // ray i hits; only those lanes of t / t_near are written.
+    // ============================================================
+
+    namespace detail {
+
+        // Calls fn(V{}, i) on each V::width slice of a W-lane packet, with
+        // the widest lanes that divide W, and merges the slice masks.
+        template<std::size_t W, typename Fn>
+        LMATH_FORCE_INLINE int packet_lanes(Fn&& fn) noexcept {
+            static_assert(W % 4 == 0, "ray packets are 4 or 8 lanes wide");
+            int mask = 0;
+            const auto run = [&](auto V_) {
+                using V = decltype(V_);
+                for (std::size_t i = 0; i < W; i += V::width)
+                    mask |= fn(V_, i) << i;
+            };
+            with_lanes([&](auto L) {
+#if defined(__AVX__)
+                if (W % decltype(L)::width != 0) {
+                    run(lanes_sse2{});
+                    return;
+                }
+#endif
+                run(L);
+            });
+            return mask;
+        }
+
+        // a x b, vec3_cross order; b broadcast
+        template<typename V>
+        LMATH_FORCE_INLINE void cross_lanes(const typename V::reg (&a)[3], const vec3& b,
+                                            typename V::reg (&r)[3]) noexcept {
+            r[0] = V::sub(V::mul(a[1], V::set1(b[2])), V::mul(a[2], V::set1(b[1])));
+            r[1] = V::sub(V::mul(a[2], V::set1(b[0])), V::mul(a[0], V::set1(b[2])));
+            r[2] = V::sub(V::mul(a[0], V::set1(b[1])), V::mul(a[1], V::set1(b[0])));
+        }
+
+        // vec_dot order
+        template<typename V>
+        LMATH_FORCE_INLINE typename V::reg dot_lanes(const typename V::reg (&a)[3],
+                                                     const typename V::reg (&b)[3]) noexcept {
+            return V::add(V::add(V::mul(a[0], b[0]), V::mul(a[1], b[1])), V::mul(a[2], b[2]));
+        }
+
+        template<typename V>
+        LMATH_FORCE_INLINE typename V::reg dot_lanes(const vec3& a, const typename V::reg (&b)[3]) noexcept {
+            return V::add(V::add(V::mul(V::set1(a[0]), b[0]), V::mul(V::set1(a[1]), b[1])),
+                          V::mul(V::set1(a[2]), b[2]));
+        }
+
+    } // namespace detail
+
+    // Packs rays[0 .. W) and computes inv_d.
+    template<std::size_t W>
+    inline ray_packet<W> ray_packet_load(const ray3* rays) noexcept {
+        ray_packet<W> R;
+        for (std::size_t i = 0; i < W; ++i)
+            for (std::size_t c = 0; c < 3; ++c) {
+                R.o.lane[c][i] = rays[i].o[c];
+                R.d.lane[c][i] = rays[i].d[c];
+            }
+        detail::packet_lanes<W>([&](auto V_, std::size_t i) {
+            using V = decltype(V_);
+            for (std::size_t c = 0; c < 3; ++c)
+                V::store(R.inv_d.lane[c] + i, V::div(V::set1(1.f), V::load(R.d.lane[c] + i)));
+            return 0;
+        });
+        return R;
+    }
+
+    template<std::size_t W>
+    inline int ray_triangle_packet(const ray_packet<W>& R, const vec3& a, const vec3& b, const vec3& c,
+                                   vec<float, W>& t) noexcept {
+        const vec3 e1 = vec_sub(b, a);
+        const vec3 e2 = vec_sub(c, a);
+        return detail::packet_lanes<W>([&](auto V_, std::size_t i) {
+            using V = decltype(V_);
+            using reg = typename V::reg;
+            reg d[3], s[3], p[3], q[3];
+            for (std::size_t k = 0; k < 3; ++k) {
+                d[k] = V::load(R.d.lane[k] + i);
+                s[k] = V::sub(V::load(R.o.lane[k] + i), V::set1(a[k]));
+            }
+
+            detail::cross_lanes<V>(d, e2, p);
+            const reg inv_det = V::div(V::set1(1.f), detail::dot_lanes<V>(e1, p));
+            const reg u = V::mul(detail::dot_lanes<V>(s, p), inv_det);
+            // q = s x e1
+            detail::cross_lanes<V>(s, e1, q);
+            const reg v = V::mul(detail::dot_lanes<V>(d, q), inv_det);
+            const reg th = V::mul(detail::dot_lanes<V>(e2, q), inv_det);
+
+            const reg t_old = V::load(t.v + i);
+            auto hit = V::mask_and(V::cmpge(u, V::zero()), V::cmpge(v, V::zero()));
+            hit = V::mask_and(hit, V::cmple(V::add(u, v), V::set1(1.f)));
+            hit = V::mask_and(hit, V::mask_and(V::cmpgt(th, V::zero()), V::cmplt(th, t_old)));
+            V::store(t.v + i, V::select(hit, th, t_old));
+            return V::movemask(hit);
+        });
+    }
+
+    template<std::size_t W>
+    inline int ray_sphere_packet(const ray_packet<W>& R, const sphere3& S, vec<float, W>& t) noexcept {
+        return detail::packet_lanes<W>([&](auto V_, std::size_t i) {
+            using V = decltype(V_);
+            using reg = typename V::reg;
+            reg d[3], oc[3];
+            for (std::size_t k = 0; k < 3; ++k) {
+                d[k] = V::load(R.d.lane[k] + i);
+                oc[k] = V::sub(V::load(R.o.lane[k] + i), V::set1(S.c[k]));
+            }
+
+            const reg a = detail::dot_lanes<V>(d, d);
+            const reg b = detail::dot_lanes<V>(oc, d);
+            const reg c = V::sub(detail::dot_lanes<V>(oc, oc), V::set1(S.r * S.r));
+            // disc < 0: sqrt gives NaN, which fails every compare below
+            const reg sq = V::sqrt(V::sub(V::mul(b, b), V::mul(a, c)));
+            const reg nb = V::sub(V::zero(), b);
+            const reg t0 = V::div(V::sub(nb, sq), a);
+            const reg t1 = V::div(V::add(nb, sq), a);
+            const reg th = V::select(V::cmpgt(t0, V::zero()), t0, t1);
+
+            const reg t_old = V::load(t.v + i);
+            const auto hit = V::mask_and(V::cmpgt(th, V::zero()), V::cmplt(th, t_old));
+            V::store(t.v + i, V::select(hit, th, t_old));
+            return V::movemask(hit);
+        });
+    }
+
+    template<std::size_t W>
+    inline int ray_aabb_packet(const ray_packet<W>& R, const aabb3& B, const vec<float, W>& t_max,
+                               vec<float, W>& t_near) noexcept {
+        return detail::packet_lanes<W>([&](auto V_, std::size_t i) {
+            using V = decltype(V_);
+            using reg = typename V::reg;
+            reg lo = V::zero();
+            reg hi = V::load(t_max.v + i);
+            for (std::size_t k = 0; k < 3; ++k) {
+                const reg o = V::load(R.o.lane[k] + i);
+                const reg inv = V::load(R.inv_d.lane[k] + i);
+                const reg t1 = V::mul(V::sub(V::set1(B.lo[k]), o), inv);
+                const reg t2 = V::mul(V::sub(V::set1(B.hi[k]), o), inv);
+                lo = V::max(V::min(t1, t2), lo);
+                hi = V::min(V::max(t1, t2), hi);
+            }
+
+            const auto hit = V::cmple(lo, hi);
+            V::store(t_near.v + i, V::select(hit, lo, V::load(t_near.v + i)));
+            return V::movemask(hit);
+        });
+    }
+
+} // namespace lm
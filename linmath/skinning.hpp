@@ -0,0 +1,265 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "detail/feature_detection.hpp"
+#include "libc_integration.hpp"
+#include "vec.hpp"
+#include "mat.hpp"
+
+namespace lm {
+
+    // ============================================================
+    // Linear-blend skinning (CPU)
+    //
+    // Vertex i has four influences: joint indices joints[4i .. 4i+3] into
+    // `palette` (joint matrices, already multiplied by their inverse bind
+    // pose) and weights weights[4i .. 4i+3], normally summing to 1; unused
+    // slots carry weight 0 and any valid index. The four matrices are
+    // blended entry by entry,
+    //     B = ((P[j0] w0 + P[j1] w1) + P[j2] w2) + P[j3] w3,
+    // and B transforms the position (w = 1) and, when `nrm` is given, the
+    // normal (w = 0). Only the affine 3x4 part of B is used. Normals are
+    // not renormalized, and are only exact for palettes without
+    // non-uniform scale.
+    //
+    // The SIMD paths blend one vertex at a time with whole columns in
+    // registers (SSE2 / NEON one column per register, AVX two), in the
+    // scalar operation order, so all levels agree bit for bit with
+    // skin_lbs_scalar (-ffp-contract=off).
+    //
+    // `out_pos` may alias `pos` and `out_nrm` may alias `nrm`; pass
+    // nrm = out_nrm = nullptr to skip normals.
+    // ============================================================
+
+    namespace detail {
+
+        template<typename J>
+        inline void skin_lbs_scalar(const ::lm::mat4* palette, const ::lm::vec3* pos, const ::lm::vec3* nrm,
+                                    const J* joints, const float* weights,
+                                    ::lm::vec3* out_pos, ::lm::vec3* out_nrm, std::size_t n) noexcept {
+            for (std::size_t i = 0; i < n; ++i) {
+                const J* j = joints + 4 * i;
+                const float* w = weights + 4 * i;
+                const ::lm::mat4& A = palette[j[0]];
+                const ::lm::mat4& B = palette[j[1]];
+                const ::lm::mat4& C = palette[j[2]];
+                const ::lm::mat4& D = palette[j[3]];
+
+                float m[4][3];
+                for (int c = 0; c < 4; ++c)
+                    for (int r = 0; r < 3; ++r)
+                        m[c][r] = ((A[c][r] * w[0] + B[c][r] * w[1]) + C[c][r] * w[2]) + D[c][r] * w[3];
+
+                const float x = pos[i][0], y = pos[i][1], z = pos[i][2];
+                for (int r = 0; r < 3; ++r)
+                    out_pos[i][r] = ((m[0][r] * x + m[1][r] * y) + m[2][r] * z) + m[3][r];
+
+                if (nrm) {
+                    const float nx = nrm[i][0], ny = nrm[i][1], nz = nrm[i][2];
+                    for (int r = 0; r < 3; ++r)
+                        out_nrm[i][r] = (m[0][r] * nx + m[1][r] * ny) + m[2][r] * nz;
+                }
+            }
+        }
+
+#if defined(__SSE2__)
+        // xyz of r to p[0..2], nothing past them
+        LMATH_FORCE_INLINE void skin_store3_sse2(float* p, __m128 r) noexcept {
+            _mm_storel_pi(reinterpret_cast<__m64*>(p), r);
+            _mm_store_ss(p + 2, _mm_movehl_ps(r, r));
+        }
+
+        template<typename J>
+        inline void skin_lbs_sse2(const ::lm::mat4* palette, const ::lm::vec3* pos, const ::lm::vec3* nrm,
+                                  const J* joints, const float* weights,
+                                  ::lm::vec3* out_pos, ::lm::vec3* out_nrm, std::size_t n) noexcept {
+            for (std::size_t i = 0; i < n; ++i) {
+                const J* j = joints + 4 * i;
+                const __m128 w = _mm_loadu_ps(weights + 4 * i);
+                const __m128 w0 = _mm_shuffle_ps(w, w, _MM_SHUFFLE(0, 0, 0, 0));
+                const __m128 w1 = _mm_shuffle_ps(w, w, _MM_SHUFFLE(1, 1, 1, 1));
+                const __m128 w2 = _mm_shuffle_ps(w, w, _MM_SHUFFLE(2, 2, 2, 2));
+                const __m128 w3 = _mm_shuffle_ps(w, w, _MM_SHUFFLE(3, 3, 3, 3));
+                const float* A = palette[j[0]][0].data();
+                const float* B = palette[j[1]][0].data();
+                const float* C = palette[j[2]][0].data();
+                const float* D = palette[j[3]][0].data();
+
+                __m128 m[4];
+                for (int c = 0; c < 4; ++c) {
+                    __m128 s = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(A + 4 * c), w0),
+                                          _mm_mul_ps(_mm_loadu_ps(B + 4 * c), w1));
+                    s = _mm_add_ps(s, _mm_mul_ps(_mm_loadu_ps(C + 4 * c), w2));
+                    m[c] = _mm_add_ps(s, _mm_mul_ps(_mm_loadu_ps(D + 4 * c), w3));
+                }
+
+                __m128 r = _mm_add_ps(_mm_mul_ps(m[0], _mm_set1_ps(pos[i][0])),
+                                      _mm_mul_ps(m[1], _mm_set1_ps(pos[i][1])));
+                r = _mm_add_ps(_mm_add_ps(r, _mm_mul_ps(m[2], _mm_set1_ps(pos[i][2]))), m[3]);
+                skin_store3_sse2(out_pos[i].data(), r);
+
+                if (nrm) {
+                    __m128 s = _mm_add_ps(_mm_mul_ps(m[0], _mm_set1_ps(nrm[i][0])),
+                                          _mm_mul_ps(m[1], _mm_set1_ps(nrm[i][1])));
+                    s = _mm_add_ps(s, _mm_mul_ps(m[2], _mm_set1_ps(nrm[i][2])));
+                    skin_store3_sse2(out_nrm[i].data(), s);
+                }
+            }
+        }
+#endif
+
+#if defined(__AVX__)
+        LMATH_FORCE_INLINE __m256 skin_pair_avx(float lo, float hi) noexcept {
+            return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_set1_ps(lo)), _mm_set1_ps(hi), 1);
+        }
+
+        // columns as [c0 | c1], [c2 | c3]: one 32-byte load each
+        template<typename J>
+        inline void skin_lbs_avx(const ::lm::mat4* palette, const ::lm::vec3* pos, const ::lm::vec3* nrm,
+                                 const J* joints, const float* weights,
+                                 ::lm::vec3* out_pos, ::lm::vec3* out_nrm, std::size_t n) noexcept {
+            for (std::size_t i = 0; i < n; ++i) {
+                const J* j = joints + 4 * i;
+                const float* w = weights + 4 * i;
+                const __m256 w0 = _mm256_set1_ps(w[0]);
+                const __m256 w1 = _mm256_set1_ps(w[1]);
+                const __m256 w2 = _mm256_set1_ps(w[2]);
+                const __m256 w3 = _mm256_set1_ps(w[3]);
+                const float* A = palette[j[0]][0].data();
+                const float* B = palette[j[1]][0].data();
+                const float* C = palette[j[2]][0].data();
+                const float* D = palette[j[3]][0].data();
+
+                __m256 m[2];
+                for (int h = 0; h < 2; ++h) {
+                    __m256 s = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(A + 8 * h), w0),
+                                             _mm256_mul_ps(_mm256_loadu_ps(B + 8 * h), w1));
+                    s = _mm256_add_ps(s, _mm256_mul_ps(_mm256_loadu_ps(C + 8 * h), w2));
+                    m[h] = _mm256_add_ps(s, _mm256_mul_ps(_mm256_loadu_ps(D + 8 * h), w3));
+                }
+
+                // [c0 x | c1 y], [c2 z | c3]: ((c0 x + c1 y) + c2 z) + c3
+                const __m256 a = _mm256_mul_ps(m[0], skin_pair_avx(pos[i][0], pos[i][1]));
+                const __m256 b = _mm256_mul_ps(m[1], skin_pair_avx(pos[i][2], 1.f));
+                __m128 r = _mm_add_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+                r = _mm_add_ps(_mm_add_ps(r, _mm256_castps256_ps128(b)), _mm256_extractf128_ps(b, 1));
+                skin_store3_sse2(out_pos[i].data(), r);
+
+                if (nrm) {
+                    const __m256 an = _mm256_mul_ps(m[0], skin_pair_avx(nrm[i][0], nrm[i][1]));
+                    const __m128 bn = _mm_mul_ps(_mm256_castps256_ps128(m[1]), _mm_set1_ps(nrm[i][2]));
+                    __m128 s = _mm_add_ps(_mm256_castps256_ps128(an), _mm256_extractf128_ps(an, 1));
+                    skin_store3_sse2(out_nrm[i].data(), _mm_add_ps(s, bn));
+                }
+            }
+        }
+#endif
+
+#if defined(__ARM_NEON)
+        LMATH_FORCE_INLINE void skin_store3_neon(float* p, float32x4_t r) noexcept {
+            vst1_f32(p, vget_low_f32(r));
+            vst1q_lane_f32(p + 2, r, 2);
+        }
+
+        // separate mul / add (no vmla) to keep the scalar rounding
+        template<typename J>
+        inline void skin_lbs_neon(const ::lm::mat4* palette, const ::lm::vec3* pos, const ::lm::vec3* nrm,
+                                  const J* joints, const float* weights,
+                                  ::lm::vec3* out_pos, ::lm::vec3* out_nrm, std::size_t n) noexcept {
+            for (std::size_t i = 0; i < n; ++i) {
+                const J* j = joints + 4 * i;
+                const float* w = weights + 4 * i;
+                const float* A = palette[j[0]][0].data();
+                const float* B = palette[j[1]][0].data();
+                const float* C = palette[j[2]][0].data();
+                const float* D = palette[j[3]][0].data();
+
+                float32x4_t m[4];
+                for (int c = 0; c < 4; ++c) {
+                    float32x4_t s = vaddq_f32(vmulq_n_f32(vld1q_f32(A + 4 * c), w[0]),
+                                              vmulq_n_f32(vld1q_f32(B + 4 * c), w[1]));
+                    s = vaddq_f32(s, vmulq_n_f32(vld1q_f32(C + 4 * c), w[2]));
+                    m[c] = vaddq_f32(s, vmulq_n_f32(vld1q_f32(D + 4 * c), w[3]));
+                }
+
+                float32x4_t r = vaddq_f32(vmulq_n_f32(m[0], pos[i][0]), vmulq_n_f32(m[1], pos[i][1]));
+                r = vaddq_f32(vaddq_f32(r, vmulq_n_f32(m[2], pos[i][2])), m[3]);
+                skin_store3_neon(out_pos[i].data(), r);
+
+                if (nrm) {
+                    float32x4_t s = vaddq_f32(vmulq_n_f32(m[0], nrm[i][0]), vmulq_n_f32(m[1], nrm[i][1]));
+                    s = vaddq_f32(s, vmulq_n_f32(m[2], nrm[i][2]));
+                    skin_store3_neon(out_nrm[i].data(), s);
+                }
+            }
+        }
+#endif
+
+        template<typename J>
+        inline void skin_lbs(const ::lm::mat4* palette, const ::lm::vec3* pos, const ::lm::vec3* nrm,
+                             const J* joints, const float* weights,
+                             ::lm::vec3* out_pos, ::lm::vec3* out_nrm, std::size_t n) noexcept {
+#if defined(LMATH_FORCE_NO_SIMD)
+            skin_lbs_scalar(palette, pos, nrm, joints, weights, out_pos, out_nrm, n);
+#else
+            switch (simd::max_level()) {
+#if defined(__ARM_NEON)
+            case simd::Level::neon:
+                skin_lbs_neon(palette, pos, nrm, joints, weights, out_pos, out_nrm, n);
+                return;
+#endif
+#if defined(__AVX__)
+            case simd::Level::avx:
+#if defined(__AVX2__)
+            case simd::Level::avx2:
+#endif
+#if defined(__AVX512F__)
+            case simd::Level::avx512:
+#endif
+                skin_lbs_avx(palette, pos, nrm, joints, weights, out_pos, out_nrm, n);
+                return;
+#endif
+#if defined(__SSE2__)
+            case simd::Level::sse2:
+                skin_lbs_sse2(palette, pos, nrm, joints, weights, out_pos, out_nrm, n);
+                return;
+#endif
+            default:
+                skin_lbs_scalar(palette, pos, nrm, joints, weights, out_pos, out_nrm, n);
+            } // switch
+#endif // LMATH_FORCE_NO_SIMD
+        }
+
+    } // namespace detail
+
+    /* LBS scalar */inline void
+    skin_lbs_scalar(const mat4* palette, const vec3* pos, const vec3* nrm,
+                    const std::uint8_t* joints, const float* weights,
+                    vec3* out_pos, vec3* out_nrm, std::size_t n) noexcept {
+        detail::skin_lbs_scalar(palette, pos, nrm, joints, weights, out_pos, out_nrm, n);
+    }
+
+    /* LBS scalar */inline void
+    skin_lbs_scalar(const mat4* palette, const vec3* pos, const vec3* nrm,
+                    const std::uint16_t* joints, const float* weights,
+                    vec3* out_pos, vec3* out_nrm, std::size_t n) noexcept {
+        detail::skin_lbs_scalar(palette, pos, nrm, joints, weights, out_pos, out_nrm, n);
+    }
+
+    /* LBS SIMD */inline void
+    skin_lbs(const mat4* palette, const vec3* pos, const vec3* nrm,
+             const std::uint8_t* joints, const float* weights,
+             vec3* out_pos, vec3* out_nrm, std::size_t n) noexcept {
+        detail::skin_lbs(palette, pos, nrm, joints, weights, out_pos, out_nrm, n);
+    }
+
+    /* LBS SIMD */inline void
+    skin_lbs(const mat4* palette, const vec3* pos, const vec3* nrm,
+             const std::uint16_t* joints, const float* weights,
+             vec3* out_pos, vec3* out_nrm, std::size_t n) noexcept {
+        detail::skin_lbs(palette, pos, nrm, joints, weights, out_pos, out_nrm, n);
+    }
+
+} // namespace lm
@@ -0,0 +1,587 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "detail/feature_detection.hpp"
+#include "detail/simd_lanes.hpp"
+
+#include "libc_integration.hpp"
+#include "vec.hpp"
+
+namespace lm {
+
+    // ============================================================
+    // Structure-of-arrays vectors
+    //
+    // vec_pack<N,W> : fixed block of W vectors, one row of W floats per
+    //                 component (P[0] = all x, P[1] = all y, ...).
+    // vec_soa<N>    : non-owning view of n vectors stored as N separate
+    //                 float streams.
+    // vec_soa_const<N> : the same over read-only streams; a vec_soa
+    //                 converts to it, so kernels take it for inputs.
+    //
+    // Kernels run 8 lanes on AVX/AVX2 and 4 on SSE2/NEON; the tail falls
+    // back to scalar. Outputs may alias inputs element-for-element.
+    // ============================================================
+
+    template<std::size_t N, std::size_t W>
+    struct vec_pack {
+        LMATH_CONSTEXPR       float* operator[](std::size_t c)       noexcept { return lane[c]; }
+        LMATH_CONSTEXPR const float* operator[](std::size_t c) const noexcept { return lane[c]; }
+
+        alignas(W * sizeof(float)) float lane[N][W]{};
+    };
+
+    template<std::size_t N>
+    struct vec_soa_const {
+        LMATH_CONSTEXPR const float* operator[](std::size_t c) const noexcept { return comp[c]; }
+
+        const float* comp[N]{};
+        std::size_t  n{};
+    };
+
+    template<std::size_t N>
+    struct vec_soa {
+        LMATH_CONSTEXPR float* operator[](std::size_t c) const noexcept { return comp[c]; }
+
+        LMATH_CONSTEXPR operator vec_soa_const<N>() const noexcept {
+            vec_soa_const<N> S{};
+            for (std::size_t c = 0; c < N; ++c) S.comp[c] = comp[c];
+            S.n = n;
+            return S;
+        }
+
+        float*      comp[N]{};
+        std::size_t n{};
+    };
+
+    // ============================================================
+    // Aliases
+    // ============================================================
+
+    using vec3x4 = vec_pack<3, 4>;
+    using vec3x8 = vec_pack<3, 8>;
+    using vec4x4 = vec_pack<4, 4>;
+    using vec4x8 = vec_pack<4, 8>;
+
+    using vec3_soa = vec_soa<3>;
+    using vec4_soa = vec_soa<4>;
+
+    // View over a pack (all W elements).
+    template<std::size_t N, std::size_t W>
+    LMATH_OUT vec_soa<N> vec_soa_view(vec_pack<N, W>& P) noexcept {
+        vec_soa<N> S{};
+        for (std::size_t c = 0; c < N; ++c) S.comp[c] = P.lane[c];
+        S.n = W;
+        return S;
+    }
+
+    template<std::size_t N, std::size_t W>
+    LMATH_OUT vec_soa_const<N> vec_soa_view(const vec_pack<N, W>& P) noexcept {
+        vec_soa_const<N> S{};
+        for (std::size_t c = 0; c < N; ++c) S.comp[c] = P.lane[c];
+        S.n = W;
+        return S;
+    }
+
+
+    namespace detail {
+
+        // vec_soa_const<N> with N left to the other arguments, so a
+        // vec_soa converts to it
+        template<std::size_t N>
+        struct soa_in { using type = vec_soa_const<N>; };
+
+        // ------------------------------------------------------------
+        // AoS -> SoA for one lane block starting at element i
+        // ------------------------------------------------------------
+        template<typename L, std::size_t N>
+        LMATH_FORCE_INLINE void soa_transpose_in(L, const vec<float, N>* p,
+                                                 const vec_soa<N>& out, std::size_t i) noexcept {
+            for (std::size_t j = 0; j < L::width; ++j)
+                for (std::size_t c = 0; c < N; ++c)
+                    out[c][i + j] = p[j][c];
+        }
+
+        template<typename L, std::size_t N>
+        LMATH_FORCE_INLINE void soa_transpose_out(L, const typename soa_in<N>::type& in, std::size_t i,
+                                                  vec<float, N>* p) noexcept {
+            for (std::size_t j = 0; j < L::width; ++j)
+                for (std::size_t c = 0; c < N; ++c)
+                    p[j][c] = in[c][i + j];
+        }
+
+#if defined(__SSE2__)
+        LMATH_FORCE_INLINE void soa_transpose_in(lanes_sse2, const vec3* p,
+                                                 const vec3_soa& out, std::size_t i) noexcept {
+            __m128 x, y, z;
+            vec3x4_load_sse2(p->data(), x, y, z);
+            _mm_storeu_ps(out[0] + i, x);
+            _mm_storeu_ps(out[1] + i, y);
+            _mm_storeu_ps(out[2] + i, z);
+        }
+
+        LMATH_FORCE_INLINE void soa_transpose_out(lanes_sse2, const vec_soa_const<3>& in, std::size_t i,
+                                                  vec3* p) noexcept {
+            vec3x4_store_sse2(p->data(), _mm_loadu_ps(in[0] + i),
+                                         _mm_loadu_ps(in[1] + i),
+                                         _mm_loadu_ps(in[2] + i));
+        }
+
+        LMATH_FORCE_INLINE void soa_transpose_in(lanes_sse2, const vec4* p,
+                                                 const vec4_soa& out, std::size_t i) noexcept {
+            __m128 r0 = _mm_loadu_ps(p[0].data());
+            __m128 r1 = _mm_loadu_ps(p[1].data());
+            __m128 r2 = _mm_loadu_ps(p[2].data());
+            __m128 r3 = _mm_loadu_ps(p[3].data());
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+            _mm_storeu_ps(out[0] + i, r0);
+            _mm_storeu_ps(out[1] + i, r1);
+            _mm_storeu_ps(out[2] + i, r2);
+            _mm_storeu_ps(out[3] + i, r3);
+        }
+
+        LMATH_FORCE_INLINE void soa_transpose_out(lanes_sse2, const vec_soa_const<4>& in, std::size_t i,
+                                                  vec4* p) noexcept {
+            __m128 r0 = _mm_loadu_ps(in[0] + i);
+            __m128 r1 = _mm_loadu_ps(in[1] + i);
+            __m128 r2 = _mm_loadu_ps(in[2] + i);
+            __m128 r3 = _mm_loadu_ps(in[3] + i);
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+            _mm_storeu_ps(p[0].data(), r0);
+            _mm_storeu_ps(p[1].data(), r1);
+            _mm_storeu_ps(p[2].data(), r2);
+            _mm_storeu_ps(p[3].data(), r3);
+        }
+#endif
+
+#if defined(__AVX__)
+        LMATH_FORCE_INLINE void soa_transpose_in(lanes_avx, const vec3* p,
+                                                 const vec3_soa& out, std::size_t i) noexcept {
+            __m256 x, y, z;
+            vec3x8_load_avx(p->data(), x, y, z);
+            _mm256_storeu_ps(out[0] + i, x);
+            _mm256_storeu_ps(out[1] + i, y);
+            _mm256_storeu_ps(out[2] + i, z);
+        }
+
+        LMATH_FORCE_INLINE void soa_transpose_out(lanes_avx, const vec_soa_const<3>& in, std::size_t i,
+                                                  vec3* p) noexcept {
+            vec3x8_store_avx(p->data(), _mm256_loadu_ps(in[0] + i),
+                                        _mm256_loadu_ps(in[1] + i),
+                                        _mm256_loadu_ps(in[2] + i));
+        }
+
+        // vec4: 4x4 transpose per 128-bit lane, lane 1 holds elements 4..7
+        LMATH_FORCE_INLINE void soa_transpose_in(lanes_avx, const vec4* p,
+                                                 const vec4_soa& out, std::size_t i) noexcept {
+            const __m256 r0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p[0].data())), _mm_loadu_ps(p[4].data()), 1);
+            const __m256 r1 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p[1].data())), _mm_loadu_ps(p[5].data()), 1);
+            const __m256 r2 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p[2].data())), _mm_loadu_ps(p[6].data()), 1);
+            const __m256 r3 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p[3].data())), _mm_loadu_ps(p[7].data()), 1);
+
+            const __m256 t0 = _mm256_unpacklo_ps(r0, r1); // x0 x1 y0 y1
+            const __m256 t1 = _mm256_unpacklo_ps(r2, r3); // x2 x3 y2 y3
+            const __m256 t2 = _mm256_unpackhi_ps(r0, r1); // z0 z1 w0 w1
+            const __m256 t3 = _mm256_unpackhi_ps(r2, r3); // z2 z3 w2 w3
+
+            _mm256_storeu_ps(out[0] + i, _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0)));
+            _mm256_storeu_ps(out[1] + i, _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2)));
+            _mm256_storeu_ps(out[2] + i, _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0)));
+            _mm256_storeu_ps(out[3] + i, _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2)));
+        }
+
+        LMATH_FORCE_INLINE void soa_transpose_out(lanes_avx, const vec_soa_const<4>& in, std::size_t i,
+                                                  vec4* p) noexcept {
+            const __m256 x = _mm256_loadu_ps(in[0] + i);
+            const __m256 y = _mm256_loadu_ps(in[1] + i);
+            const __m256 z = _mm256_loadu_ps(in[2] + i);
+            const __m256 w = _mm256_loadu_ps(in[3] + i);
+
+            const __m256 t0 = _mm256_unpacklo_ps(x, y); // x0 y0 x1 y1
+            const __m256 t1 = _mm256_unpacklo_ps(z, w); // z0 w0 z1 w1
+            const __m256 t2 = _mm256_unpackhi_ps(x, y); // x2 y2 x3 y3
+            const __m256 t3 = _mm256_unpackhi_ps(z, w); // z2 w2 z3 w3
+
+            {
+                const __m256 r = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+                _mm_storeu_ps(p[0].data(), _mm256_castps256_ps128(r));
+                _mm_storeu_ps(p[4].data(), _mm256_extractf128_ps(r, 1));
+            }
+            {
+                const __m256 r = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+                _mm_storeu_ps(p[1].data(), _mm256_castps256_ps128(r));
+                _mm_storeu_ps(p[5].data(), _mm256_extractf128_ps(r, 1));
+            }
+            {
+                const __m256 r = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+                _mm_storeu_ps(p[2].data(), _mm256_castps256_ps128(r));
+                _mm_storeu_ps(p[6].data(), _mm256_extractf128_ps(r, 1));
+            }
+            {
+                const __m256 r = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+                _mm_storeu_ps(p[3].data(), _mm256_castps256_ps128(r));
+                _mm_storeu_ps(p[7].data(), _mm256_extractf128_ps(r, 1));
+            }
+        }
+#endif
+
+#if defined(__ARM_NEON)
+        LMATH_FORCE_INLINE void soa_transpose_in(lanes_neon, const vec3* p,
+                                                 const vec3_soa& out, std::size_t i) noexcept {
+            const float32x4x3_t v = vld3q_f32(p->data());
+            vst1q_f32(out[0] + i, v.val[0]);
+            vst1q_f32(out[1] + i, v.val[1]);
+            vst1q_f32(out[2] + i, v.val[2]);
+        }
+
+        LMATH_FORCE_INLINE void soa_transpose_out(lanes_neon, const vec_soa_const<3>& in, std::size_t i,
+                                                  vec3* p) noexcept {
+            float32x4x3_t v;
+            v.val[0] = vld1q_f32(in[0] + i);
+            v.val[1] = vld1q_f32(in[1] + i);
+            v.val[2] = vld1q_f32(in[2] + i);
+            vst3q_f32(p->data(), v);
+        }
+
+        LMATH_FORCE_INLINE void soa_transpose_in(lanes_neon, const vec4* p,
+                                                 const vec4_soa& out, std::size_t i) noexcept {
+            const float32x4x4_t v = vld4q_f32(p->data());
+            vst1q_f32(out[0] + i, v.val[0]);
+            vst1q_f32(out[1] + i, v.val[1]);
+            vst1q_f32(out[2] + i, v.val[2]);
+            vst1q_f32(out[3] + i, v.val[3]);
+        }
+
+        LMATH_FORCE_INLINE void soa_transpose_out(lanes_neon, const vec_soa_const<4>& in, std::size_t i,
+                                                  vec4* p) noexcept {
+            float32x4x4_t v;
+            v.val[0] = vld1q_f32(in[0] + i);
+            v.val[1] = vld1q_f32(in[1] + i);
+            v.val[2] = vld1q_f32(in[2] + i);
+            v.val[3] = vld1q_f32(in[3] + i);
+            vst4q_f32(p->data(), v);
+        }
+#endif
+
+    } // namespace detail
+
+    // ============================================================
+    // AoS <-> SoA
+    // ============================================================
+
+    // out[c][i] = in[i][c] for i in [0, out.n)
+    template<std::size_t N>
+    inline void vec_soa_from_aos(const vec<float, N>* in, const vec_soa<N>& out) noexcept {
+        detail::with_lanes([&](auto L) {
+            detail::for_lanes<decltype(L)>(out.n, [&](auto S, std::size_t i) {
+                detail::soa_transpose_in(S, in + i, out, i);
+            });
+        });
+    }
+
+    // out[i][c] = in[c][i] for i in [0, in.n)
+    template<std::size_t N>
+    inline void vec_soa_to_aos(const vec_soa_const<N>& in, vec<float, N>* out) noexcept {
+        detail::with_lanes([&](auto L) {
+            detail::for_lanes<decltype(L)>(in.n, [&](auto S, std::size_t i) {
+                detail::soa_transpose_out(S, in, i, out + i);
+            });
+        });
+    }
+
+    template<std::size_t N>
+    inline void vec_soa_to_aos(const vec_soa<N>& in, vec<float, N>* out) noexcept {
+        vec_soa_to_aos(static_cast<vec_soa_const<N>>(in), out);
+    }
+
+    template<std::size_t W, std::size_t N>
+    inline vec_pack<N, W> vec_pack_load(const vec<float, N>* in) noexcept {
+        vec_pack<N, W> P{};
+        vec_soa_from_aos(in, vec_soa_view(P));
+        return P;
+    }
+
+    template<std::size_t N, std::size_t W>
+    inline void vec_pack_store(const vec_pack<N, W>& P, vec<float, N>* out) noexcept {
+        vec_soa_to_aos(vec_soa_view(P), out);
+    }
+
+    namespace detail {
+
+        // Lane type for blocks of W elements: the widest of L, the 4-wide
+        // lanes under it and scalar whose width divides W, so vec3x4 /
+        // vec4x4 run as one SSE2 / NEON step on AVX builds.
+        template<typename L, std::size_t W>
+        struct soa_lanes_for {
+            using H = typename lanes_half<L>::type;
+            using type = typename std::conditional<W % L::width == 0, L,
+                         typename std::conditional<W % H::width == 0, H, lanes_scalar>::type>::type;
+        };
+
+        // W = 0: views of any length, for_lanes on the runtime lanes
+        template<typename Body>
+        LMATH_FORCE_INLINE void soa_for_lanes_n(std::integral_constant<std::size_t, 0>, std::size_t n,
+                                                Body& body) noexcept {
+            with_lanes([&](auto L) { for_lanes<decltype(L)>(n, body); });
+        }
+
+        // W > 0: a pack, whole steps of the lane type picked from W
+        template<std::size_t W, typename Body>
+        LMATH_FORCE_INLINE void soa_for_lanes_n(std::integral_constant<std::size_t, W>, std::size_t,
+                                                Body& body) noexcept {
+            with_lanes([&](auto L) {
+                using U = typename soa_lanes_for<decltype(L), W>::type;
+                for (std::size_t i = 0; i < W; i += U::width) body(U{}, i);
+            });
+        }
+
+        template<std::size_t W, typename Body>
+        LMATH_FORCE_INLINE void soa_for_lanes(std::size_t n, Body&& body) noexcept {
+            soa_for_lanes_n(std::integral_constant<std::size_t, W>{}, n, body);
+        }
+
+        template<std::size_t W, std::size_t N>
+        inline void soa_add(const vec_soa_const<N>& A, const vec_soa_const<N>& B, const vec_soa<N>& out) noexcept {
+            soa_for_lanes<W>(out.n, [&](auto S, std::size_t i) {
+                using V = decltype(S);
+                for (std::size_t c = 0; c < N; ++c)
+                    V::store(out[c] + i, V::add(V::load(A[c] + i), V::load(B[c] + i)));
+            });
+        }
+
+        template<std::size_t W, std::size_t N>
+        inline void soa_sub(const vec_soa_const<N>& A, const vec_soa_const<N>& B, const vec_soa<N>& out) noexcept {
+            soa_for_lanes<W>(out.n, [&](auto S, std::size_t i) {
+                using V = decltype(S);
+                for (std::size_t c = 0; c < N; ++c)
+                    V::store(out[c] + i, V::sub(V::load(A[c] + i), V::load(B[c] + i)));
+            });
+        }
+
+        template<std::size_t W, std::size_t N>
+        inline void soa_min(const vec_soa_const<N>& A, const vec_soa_const<N>& B, const vec_soa<N>& out) noexcept {
+            soa_for_lanes<W>(out.n, [&](auto S, std::size_t i) {
+                using V = decltype(S);
+                for (std::size_t c = 0; c < N; ++c)
+                    V::store(out[c] + i, V::min(V::load(A[c] + i), V::load(B[c] + i)));
+            });
+        }
+
+        template<std::size_t W, std::size_t N>
+        inline void soa_max(const vec_soa_const<N>& A, const vec_soa_const<N>& B, const vec_soa<N>& out) noexcept {
+            soa_for_lanes<W>(out.n, [&](auto S, std::size_t i) {
+                using V = decltype(S);
+                for (std::size_t c = 0; c < N; ++c)
+                    V::store(out[c] + i, V::max(V::load(A[c] + i), V::load(B[c] + i)));
+            });
+        }
+
+        template<std::size_t W, std::size_t N>
+        inline void soa_scale(const vec_soa_const<N>& A, float s, const vec_soa<N>& out) noexcept {
+            soa_for_lanes<W>(out.n, [&](auto S, std::size_t i) {
+                using V = decltype(S);
+                const auto vs = V::set1(s);
+                for (std::size_t c = 0; c < N; ++c)
+                    V::store(out[c] + i, V::mul(V::load(A[c] + i), vs));
+            });
+        }
+
+        template<std::size_t W, std::size_t N>
+        inline void soa_dot(const vec_soa_const<N>& A, const vec_soa_const<N>& B, float* out, std::size_t n) noexcept {
+            soa_for_lanes<W>(n, [&](auto S, std::size_t i) {
+                using V = decltype(S);
+                auto d = V::mul(V::load(A[0] + i), V::load(B[0] + i));
+                for (std::size_t c = 1; c < N; ++c)
+                    d = V::add(d, V::mul(V::load(A[c] + i), V::load(B[c] + i)));
+                V::store(out + i, d);
+            });
+        }
+
+        template<std::size_t W>
+        inline void soa_cross(const vec_soa_const<3>& A, const vec_soa_const<3>& B, const vec3_soa& out) noexcept {
+            soa_for_lanes<W>(out.n, [&](auto S, std::size_t i) {
+                using V = decltype(S);
+                const auto ax = V::load(A[0] + i), ay = V::load(A[1] + i), az = V::load(A[2] + i);
+                const auto bx = V::load(B[0] + i), by = V::load(B[1] + i), bz = V::load(B[2] + i);
+                V::store(out[0] + i, V::sub(V::mul(ay, bz), V::mul(az, by)));
+                V::store(out[1] + i, V::sub(V::mul(az, bx), V::mul(ax, bz)));
+                V::store(out[2] + i, V::sub(V::mul(ax, by), V::mul(ay, bx)));
+            });
+        }
+
+        // a[c] *= 1/|a| per lane; zero-length lanes come out as zero (no branch)
+        template<typename V, std::size_t N>
+        LMATH_FORCE_INLINE void soa_norm_lanes(typename V::reg (&a)[N]) noexcept {
+            auto len2 = V::mul(a[0], a[0]);
+            for (std::size_t c = 1; c < N; ++c) len2 = V::add(len2, V::mul(a[c], a[c]));
+
+            const auto inv = V::select(V::cmpgt(len2, V::zero()), V::rsqrt(len2), V::zero());
+            for (std::size_t c = 0; c < N; ++c) a[c] = V::mul(a[c], inv);
+        }
+
+        template<std::size_t W, std::size_t N>
+        inline void soa_norm(const vec_soa_const<N>& A, const vec_soa<N>& out) noexcept {
+            soa_for_lanes<W>(out.n, [&](auto S, std::size_t i) {
+                using V = decltype(S);
+                typename V::reg a[N];
+                for (std::size_t c = 0; c < N; ++c) a[c] = V::load(A[c] + i);
+
+                soa_norm_lanes<V>(a);
+                for (std::size_t c = 0; c < N; ++c)
+                    V::store(out[c] + i, a[c]);
+            });
+        }
+
+    } // namespace detail
+
+    // ============================================================
+    // SoA ops (views)
+    // `out.n` elements are processed; inputs must be at least as long.
+    // ============================================================
+
+    // --- add / sub / min / max ---
+    template<std::size_t N>
+    inline void vec_soa_add(const vec_soa<N>& A, const vec_soa<N>& B, const vec_soa<N>& out) noexcept {
+        detail::soa_add<0, N>(A, B, out);
+    }
+
+    template<std::size_t N>
+    inline void vec_soa_sub(const vec_soa<N>& A, const vec_soa<N>& B, const vec_soa<N>& out) noexcept {
+        detail::soa_sub<0, N>(A, B, out);
+    }
+
+    template<std::size_t N>
+    inline void vec_soa_min(const vec_soa<N>& A, const vec_soa<N>& B, const vec_soa<N>& out) noexcept {
+        detail::soa_min<0, N>(A, B, out);
+    }
+
+    template<std::size_t N>
+    inline void vec_soa_max(const vec_soa<N>& A, const vec_soa<N>& B, const vec_soa<N>& out) noexcept {
+        detail::soa_max<0, N>(A, B, out);
+    }
+
+    // --- scale ---
+    template<std::size_t N>
+    inline void vec_soa_scale(const vec_soa<N>& A, float s, const vec_soa<N>& out) noexcept {
+        detail::soa_scale<0, N>(A, s, out);
+    }
+
+    // --- dot --- out[i] = dot(A[i], B[i]), same add order as vec_dot
+    template<std::size_t N>
+    inline void vec_soa_dot(const vec_soa<N>& A, const vec_soa<N>& B, float* out, std::size_t n) noexcept {
+        detail::soa_dot<0, N>(A, B, out, n);
+    }
+
+    // --- cross --- same formula as vec3_cross
+    inline void vec3_soa_cross(const vec3_soa& A, const vec3_soa& B, const vec3_soa& out) noexcept {
+        detail::soa_cross<0>(A, B, out);
+    }
+
+    // --- norm --- zero-length vectors come out as zero (no branch)
+    template<std::size_t N>
+    inline void vec_soa_norm(const vec_soa<N>& A, const vec_soa<N>& out) noexcept {
+        detail::soa_norm<0, N>(A, out);
+    }
+
+    // ============================================================
+    // AoS batch ops
+    // Each block of W vectors is transposed into a stack pack, processed
+    // with the SoA kernels above and transposed back, so callers keep
+    // their vec3/vec4 arrays. `out` may alias `in`.
+    // ============================================================
+
+    template<std::size_t N>
+    inline void vec_norm_batch(const vec<float, N>* in, vec<float, N>* out, std::size_t n) noexcept {
+        detail::with_lanes([&](auto L) {
+            detail::for_lanes<decltype(L)>(n, [&](auto S, std::size_t i) {
+                using V = decltype(S);
+                vec_pack<N, V::width> P;
+                const vec_soa<N> tmp = vec_soa_view(P);
+                detail::soa_transpose_in(S, in + i, tmp, 0);
+
+                typename V::reg a[N];
+                for (std::size_t c = 0; c < N; ++c) a[c] = V::load(P.lane[c]);
+                detail::soa_norm_lanes<V>(a);
+                for (std::size_t c = 0; c < N; ++c) V::store(P.lane[c], a[c]);
+
+                detail::soa_transpose_out(S, tmp, 0, out + i);
+            });
+        });
+    }
+
+    // out[i] = vec3_norm(in[i]), zero-length vectors come out as zero
+    inline void vec3_norm_batch(const vec3* in, vec3* out, std::size_t n) noexcept {
+        vec_norm_batch(in, out, n);
+    }
+
+    // out[i] = vec_norm(in[i]), zero-length vectors come out as zero
+    inline void vec4_norm_batch(const vec4* in, vec4* out, std::size_t n) noexcept {
+        vec_norm_batch(in, out, n);
+    }
+
+    // ============================================================
+    // Pack ops (fixed-width blocks)
+    // The lane type is picked from W at compile time (4-wide lanes for
+    // W = 4 on AVX builds), so a block is one or two vector steps.
+    // ============================================================
+
+    template<std::size_t N, std::size_t W>
+    inline vec_pack<N, W> vec_add(const vec_pack<N, W>& A, const vec_pack<N, W>& B) noexcept {
+        vec_pack<N, W> R{};
+        detail::soa_add<W>(vec_soa_view(A), vec_soa_view(B), vec_soa_view(R));
+        return R;
+    }
+
+    template<std::size_t N, std::size_t W>
+    inline vec_pack<N, W> vec_sub(const vec_pack<N, W>& A, const vec_pack<N, W>& B) noexcept {
+        vec_pack<N, W> R{};
+        detail::soa_sub<W>(vec_soa_view(A), vec_soa_view(B), vec_soa_view(R));
+        return R;
+    }
+
+    template<std::size_t N, std::size_t W>
+    inline vec_pack<N, W> vec_min(const vec_pack<N, W>& A, const vec_pack<N, W>& B) noexcept {
+        vec_pack<N, W> R{};
+        detail::soa_min<W>(vec_soa_view(A), vec_soa_view(B), vec_soa_view(R));
+        return R;
+    }
+
+    template<std::size_t N, std::size_t W>
+    inline vec_pack<N, W> vec_max(const vec_pack<N, W>& A, const vec_pack<N, W>& B) noexcept {
+        vec_pack<N, W> R{};
+        detail::soa_max<W>(vec_soa_view(A), vec_soa_view(B), vec_soa_view(R));
+        return R;
+    }
+
+    template<std::size_t N, std::size_t W>
+    inline vec_pack<N, W> vec_scale(const vec_pack<N, W>& A, float s) noexcept {
+        vec_pack<N, W> R{};
+        detail::soa_scale<W>(vec_soa_view(A), s, vec_soa_view(R));
+        return R;
+    }
+
+    template<std::size_t N, std::size_t W>
+    inline vec<float, W> vec_dot(const vec_pack<N, W>& A, const vec_pack<N, W>& B) noexcept {
+        vec<float, W> R{};
+        detail::soa_dot<W>(vec_soa_view(A), vec_soa_view(B), R.data(), W);
+        return R;
+    }
+
+    template<std::size_t W>
+    inline vec_pack<3, W> vec3_cross(const vec_pack<3, W>& A, const vec_pack<3, W>& B) noexcept {
+        vec_pack<3, W> R{};
+        detail::soa_cross<W>(vec_soa_view(A), vec_soa_view(B), vec_soa_view(R));
+        return R;
+    }
+
+    template<std::size_t N, std::size_t W>
+    inline vec_pack<N, W> vec_norm(const vec_pack<N, W>& A) noexcept {
+        vec_pack<N, W> R{};
+        detail::soa_norm<W>(vec_soa_view(A), vec_soa_view(R));
+        return R;
+    }
+
+} // namespace lm
@@ -0,0 +1,305 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "detail/feature_detection.hpp"
+#include "detail/simd_lanes.hpp"
+#include "libc_integration.hpp"
+#include "vec.hpp"
+#include "mat.hpp"
+#include "quat.hpp"
+#include "soa.hpp"
+
+namespace lm {
+
+    // ============================================================
+    // TRS (translation, rotation, scale)
+    //
+    // The matrix is T * R * S: scale along the local axes, rotate, then
+    // translate. 10 floats instead of 16, and components that blend
+    // sensibly (trs_lerp), so animation can stay in TRS space and convert
+    // to matrices once at the end (trs_to_mat4_batch).
+    //
+    // mat4_decompose goes the other way. Scale is the column lengths, with
+    // the sign of the first one carrying a mirror (det < 0). The rotation
+    // is the polar factor of the column-normalized 3x3 (three Newton
+    // steps, X <- (X + X^-T) / 2), so it is exact for T * R * S matrices
+    // and still the nearest rotation when a little shear or drift has
+    // crept in (converged to float precision for shear factors up to ~0.5).
+    // The 3x3 must be invertible; the projective row is ignored.
+    // ============================================================
+
+    template<typename T>
+    struct trs_of {
+        vec<T,3>   t{};                      // translation
+        quat_of<T> r{ vec<T,3>{}, T(1) };    // rotation (unit)
+        vec<T,3>   s{ T(1), T(1), T(1) };    // scale
+    };
+
+    using trs = trs_of<float>;
+
+    template<typename T = float>
+    LMATH_OUT trs_of<T> trs_identity() noexcept {
+        return {};
+    }
+
+    // builds on mat4_from_quat: columns scaled by s, translation in column 3
+    template<typename T>
+    LMATH_OUT mat4_of<T> mat4_from_trs(const trs_of<T>& X) noexcept {
+        mat4_of<T> M = mat4_from_quat(X.r);
+        for (std::size_t c = 0; c < 3; ++c)
+            for (std::size_t k = 0; k < 3; ++k)
+                M[c][k] = M[c][k] * X.s[c];
+        M[3][0] = X.t[0];
+        M[3][1] = X.t[1];
+        M[3][2] = X.t[2];
+        return M;
+    }
+
+    // component-wise: t and s lerped, r by quat_nlerp (shortest arc)
+    LMATH_NO_DISCARD inline trs trs_lerp(const trs& A, const trs& B, float t) noexcept {
+        trs R;
+        for (std::size_t k = 0; k < 3; ++k) {
+            R.t[k] = A.t[k] + (B.t[k] - A.t[k]) * t;
+            R.s[k] = A.s[k] + (B.s[k] - A.s[k]) * t;
+        }
+        R.r = quat_nlerp(A.r, B.r, t);
+        return R;
+    }
+
+    namespace detail {
+
+        // ------------------------------------------------------------
+        // Lane kernels, one component per register
+        // ------------------------------------------------------------
+
+        // m[c][k] = mat4_from_trs(...)[c][k], rows 0..2; same expressions as
+        // mat4_from_quat
+        template<typename V>
+        LMATH_FORCE_INLINE void trs_to_mat4_lanes(const typename V::reg (&t)[3], const typename V::reg (&r)[4],
+                                                  const typename V::reg (&s)[3],
+                                                  typename V::reg (&m)[4][3]) noexcept {
+            using reg = typename V::reg;
+            const reg A = r[3], B = r[0], C = r[1], D = r[2];
+            const reg A2 = V::mul(A, A), B2 = V::mul(B, B), C2 = V::mul(C, C), D2 = V::mul(D, D);
+            const reg two = V::set1(2.f);
+            const reg BC = V::mul(B, C), AD = V::mul(A, D), BD = V::mul(B, D);
+            const reg AC = V::mul(A, C), CD = V::mul(C, D), AB = V::mul(A, B);
+
+            m[0][0] = V::sub(V::sub(V::add(A2, B2), C2), D2);
+            m[0][1] = V::mul(two, V::add(BC, AD));
+            m[0][2] = V::mul(two, V::sub(BD, AC));
+
+            m[1][0] = V::mul(two, V::sub(BC, AD));
+            m[1][1] = V::sub(V::add(V::sub(A2, B2), C2), D2);
+            m[1][2] = V::mul(two, V::add(CD, AB));
+
+            m[2][0] = V::mul(two, V::add(BD, AC));
+            m[2][1] = V::mul(two, V::sub(CD, AB));
+            m[2][2] = V::add(V::sub(V::sub(A2, B2), C2), D2);
+
+            for (std::size_t c = 0; c < 3; ++c)
+                for (std::size_t k = 0; k < 3; ++k)
+                    m[c][k] = V::mul(m[c][k], s[c]);
+            for (std::size_t k = 0; k < 3; ++k) m[3][k] = t[k];
+        }
+
+        template<typename V>
+        LMATH_FORCE_INLINE void trs_cross_lanes(const typename V::reg (&a)[3], const typename V::reg (&b)[3],
+                                                typename V::reg (&r)[3]) noexcept {
+            r[0] = V::sub(V::mul(a[1], b[2]), V::mul(a[2], b[1]));
+            r[1] = V::sub(V::mul(a[2], b[0]), V::mul(a[0], b[2]));
+            r[2] = V::sub(V::mul(a[0], b[1]), V::mul(a[1], b[0]));
+        }
+
+        template<typename V>
+        LMATH_FORCE_INLINE typename V::reg trs_dot3_lanes(const typename V::reg (&a)[3],
+                                                          const typename V::reg (&b)[3]) noexcept {
+            return V::add(V::add(V::mul(a[0], b[0]), V::mul(a[1], b[1])), V::mul(a[2], b[2]));
+        }
+
+        // a: columns 0..2 (rows 0..2) of the matrix; outputs rotation and scale
+        template<typename V>
+        LMATH_FORCE_INLINE void mat4_decompose_lanes(const typename V::reg (&a)[3][3],
+                                                     typename V::reg (&r)[4],
+                                                     typename V::reg (&s)[3]) noexcept {
+            using reg = typename V::reg;
+            const reg one = V::set1(1.f), half = V::set1(0.5f), quarter = V::set1(0.25f);
+
+            // scale; a mirror goes into s[0]
+            reg x[3][3];
+            {
+                reg cof[3];
+                trs_cross_lanes<V>(a[1], a[2], cof);
+                const reg det = trs_dot3_lanes<V>(a[0], cof);
+                for (std::size_t c = 0; c < 3; ++c) s[c] = V::sqrt(trs_dot3_lanes<V>(a[c], a[c]));
+                s[0] = V::select(V::cmplt(det, V::zero()), V::sub(V::zero(), s[0]), s[0]);
+                for (std::size_t c = 0; c < 3; ++c) {
+                    const reg inv = V::div(one, s[c]);
+                    for (std::size_t k = 0; k < 3; ++k) x[c][k] = V::mul(a[c][k], inv);
+                }
+            }
+
+            // polar factor: X <- (X + X^-T) / 2; columns of X^-T are the
+            // pairwise cross products over det
+            for (int it = 0; it < 3; ++it) {
+                reg cof[3][3];
+                trs_cross_lanes<V>(x[1], x[2], cof[0]);
+                trs_cross_lanes<V>(x[2], x[0], cof[1]);
+                trs_cross_lanes<V>(x[0], x[1], cof[2]);
+                const reg h = V::div(half, trs_dot3_lanes<V>(x[0], cof[0]));
+                for (std::size_t c = 0; c < 3; ++c)
+                    for (std::size_t k = 0; k < 3; ++k)
+                        x[c][k] = V::add(V::mul(x[c][k], half), V::mul(cof[c][k], h));
+            }
+
+            // quat_from_mat4 (Shepperd): the branch is picked by select up
+            // front, so there is one sqrt and one divide for all four
+            const reg m00 = x[0][0], m11 = x[1][1], m22 = x[2][2];
+            const reg tr = V::add(V::add(m00, m11), m22);
+            const typename V::mask use_t = V::cmpgt(tr, V::zero());
+            const typename V::mask use_x = V::mask_and(V::cmpge(m00, m11), V::cmpge(m00, m22));
+            const typename V::mask use_y = V::cmpge(m11, m22);
+            auto pick = [&](reg bt, reg bx, reg by, reg bz) noexcept {
+                return V::select(use_t, bt, V::select(use_x, bx, V::select(use_y, by, bz)));
+            };
+
+            const reg s4 = V::mul(V::sqrt(pick(V::add(tr, one),
+                                               V::sub(V::sub(V::add(one, m00), m11), m22),
+                                               V::sub(V::sub(V::add(one, m11), m00), m22),
+                                               V::sub(V::sub(V::add(one, m22), m00), m11))),
+                                  V::set1(2.f));
+            const reg inv = V::div(one, s4);
+            const reg big = V::mul(s4, quarter);
+            const reg d12 = V::mul(V::sub(x[1][2], x[2][1]), inv), p12 = V::mul(V::add(x[1][2], x[2][1]), inv);
+            const reg d20 = V::mul(V::sub(x[2][0], x[0][2]), inv), p20 = V::mul(V::add(x[2][0], x[0][2]), inv);
+            const reg d01 = V::mul(V::sub(x[0][1], x[1][0]), inv), p01 = V::mul(V::add(x[0][1], x[1][0]), inv);
+            r[0] = pick(d12, big, p01, p20);
+            r[1] = pick(d20, p01, big, p12);
+            r[2] = pick(d01, p20, p12, big);
+            r[3] = pick(big, d12, d20, d01);
+        }
+
+        // AoS <-> registers for W elements; the strides (10 floats for trs,
+        // 16 for mat4 columns) go through small contiguous staging arrays so
+        // the vec3 / vec4 transposes apply
+        template<typename V>
+        LMATH_FORCE_INLINE void trs_load_lanes(V S, const trs* X, typename V::reg (&t)[3],
+                                               typename V::reg (&r)[4], typename V::reg (&s)[3]) noexcept {
+            vec3 tt[V::width], ss[V::width];
+            vec4 rr[V::width];
+            for (std::size_t j = 0; j < V::width; ++j) {
+                tt[j] = X[j].t;
+                rr[j] = *quat_as_vec4(&X[j].r);
+                ss[j] = X[j].s;
+            }
+            vec_pack<3, V::width> PT, PS;
+            vec_pack<4, V::width> PR;
+            soa_transpose_in(S, tt, vec_soa_view(PT), 0);
+            soa_transpose_in(S, rr, vec_soa_view(PR), 0);
+            soa_transpose_in(S, ss, vec_soa_view(PS), 0);
+            for (std::size_t k = 0; k < 3; ++k) {
+                t[k] = V::load(PT.lane[k]);
+                s[k] = V::load(PS.lane[k]);
+            }
+            for (std::size_t k = 0; k < 4; ++k) r[k] = V::load(PR.lane[k]);
+        }
+
+        template<typename V>
+        LMATH_FORCE_INLINE void trs_store_lanes(V S, const typename V::reg (&t)[3], const typename V::reg (&r)[4],
+                                                const typename V::reg (&s)[3], trs* X) noexcept {
+            vec_pack<3, V::width> PT, PS;
+            vec_pack<4, V::width> PR;
+            for (std::size_t k = 0; k < 3; ++k) {
+                V::store(PT.lane[k], t[k]);
+                V::store(PS.lane[k], s[k]);
+            }
+            for (std::size_t k = 0; k < 4; ++k) V::store(PR.lane[k], r[k]);
+            vec3 tt[V::width], ss[V::width];
+            vec4 rr[V::width];
+            soa_transpose_out(S, vec_soa_view(PT), 0, tt);
+            soa_transpose_out(S, vec_soa_view(PR), 0, rr);
+            soa_transpose_out(S, vec_soa_view(PS), 0, ss);
+            for (std::size_t j = 0; j < V::width; ++j) {
+                X[j].t = tt[j];
+                *quat_as_vec4(&X[j].r) = rr[j];
+                X[j].s = ss[j];
+            }
+        }
+
+        // column c (rows 0..3) of W matrices
+        template<typename V>
+        LMATH_FORCE_INLINE void mat4_col_load_lanes(V S, const mat4* M, std::size_t c,
+                                                    typename V::reg (&col)[4]) noexcept {
+            vec4 cc[V::width];
+            for (std::size_t j = 0; j < V::width; ++j) cc[j] = M[j][c];
+            vec_pack<4, V::width> P;
+            soa_transpose_in(S, cc, vec_soa_view(P), 0);
+            for (std::size_t k = 0; k < 4; ++k) col[k] = V::load(P.lane[k]);
+        }
+
+        template<typename V>
+        LMATH_FORCE_INLINE void mat4_col_store_lanes(V S, const typename V::reg (&col)[4], std::size_t c,
+                                                     mat4* M) noexcept {
+            vec_pack<4, V::width> P;
+            for (std::size_t k = 0; k < 4; ++k) V::store(P.lane[k], col[k]);
+            vec4 cc[V::width];
+            soa_transpose_out(S, vec_soa_view(P), 0, cc);
+            for (std::size_t j = 0; j < V::width; ++j) M[j][c] = cc[j];
+        }
+
+    } // namespace detail
+
+    // trs from the matrix M = T * R * S; see the notes at the top. Same
+    // kernel as mat4_decompose_batch, one lane wide.
+    LMATH_NO_DISCARD inline trs mat4_decompose(const mat4& M) noexcept {
+        using V = detail::lanes_scalar;
+        float a[3][3];
+        for (std::size_t c = 0; c < 3; ++c)
+            for (std::size_t k = 0; k < 3; ++k) a[c][k] = M[c][k];
+        float r[4], s[3];
+        detail::mat4_decompose_lanes<V>(a, r, s);
+        trs X;
+        X.t = { M[3][0], M[3][1], M[3][2] };
+        X.r = { { r[0], r[1], r[2] }, r[3] };
+        X.s = { s[0], s[1], s[2] };
+        return X;
+    }
+
+    // out[i] = mat4_from_trs(in[i]), bit for bit
+    /* TRS[] SIMD */inline void
+    trs_to_mat4_batch(const trs* in, mat4* out, std::size_t n) noexcept {
+        detail::with_lanes([&](auto L) {
+            detail::for_lanes<decltype(L)>(n, [&](auto S, std::size_t i) {
+                using V = decltype(S);
+                typename V::reg t[3], r[4], s[3], m[4][3];
+                detail::trs_load_lanes(S, in + i, t, r, s);
+                detail::trs_to_mat4_lanes<V>(t, r, s, m);
+                for (std::size_t c = 0; c < 4; ++c) {
+                    const typename V::reg col[4] = { m[c][0], m[c][1], m[c][2],
+                                                     c == 3 ? V::set1(1.f) : V::zero() };
+                    detail::mat4_col_store_lanes(S, col, c, out + i);
+                }
+            });
+        });
+    }
+
+    // out[i] = mat4_decompose(in[i]), bit for bit
+    /* M4->TRS[] SIMD */inline void
+    mat4_decompose_batch(const mat4* in, trs* out, std::size_t n) noexcept {
+        detail::with_lanes([&](auto L) {
+            detail::for_lanes<decltype(L)>(n, [&](auto S, std::size_t i) {
+                using V = decltype(S);
+                typename V::reg col[4][4], a[3][3], t[3], r[4], s[3];
+                for (std::size_t c = 0; c < 4; ++c) detail::mat4_col_load_lanes(S, in + i, c, col[c]);
+                for (std::size_t c = 0; c < 3; ++c)
+                    for (std::size_t k = 0; k < 3; ++k) a[c][k] = col[c][k];
+                for (std::size_t k = 0; k < 3; ++k) t[k] = col[3][k];
+                detail::mat4_decompose_lanes<V>(a, r, s);
+                detail::trs_store_lanes(S, t, r, s, out + i);
+            });
+        });
+    }
+
+} // namespace lm
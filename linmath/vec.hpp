@@ -5,16 +5,18 @@
 
 #include "detail/feature_detection.hpp"
 #include "detail/simd_integration.hpp"
+#include "detail/simd_lanes.hpp"
 
 #include "libc_integration.hpp"
 
-#if !defined(LMATH_FORCE_NO_SIMD)
-#   if defined(__x86_64__) || defined(_M_X64) || defined(__i386) || defined(_M_IX86)
-#      include <xmmintrin.h>
-#      include <immintrin.h>
-#   elif defined(__arm__) || defined(__aarch64__)
-#       include <arm_neon.h>
-#   endif
+// Intrinsic headers are pulled in even with LMATH_FORCE_NO_SIMD: GCC/Clang
+// keep __SSE2__ defined on x86-64, so the detail kernels still get parsed
+// (the dispatchers never call them).
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386) || defined(_M_IX86)
+#   include <xmmintrin.h>
+#   include <immintrin.h>
+#elif defined(__ARM_NEON)
+#   include <arm_neon.h>
 #endif
 
 namespace lm {
@@ -84,6 +86,125 @@ namespace lm {
         }
 #endif
 
+        // ------------------------------------------------------------
+        // FMA dot: (a0*b0 + a2*b2) + (a1*b1 + a3*b3), the inner adds fused.
+        // Not bit-identical to dot_sse2/dot_neon; only used under LMATH_USE_FMA.
+        // ------------------------------------------------------------
+#if LMATH_HAS_FMA && defined(__FMA__)
+        inline float dot_fma(const float* a, const float* b) noexcept {
+            const __m128 va = _mm_loadu_ps(a);
+            const __m128 vb = _mm_loadu_ps(b);
+            const __m128 lo = _mm_mul_ps(va, vb);
+            const __m128 s  = _mm_fmadd_ps(_mm_movehl_ps(va, va), _mm_movehl_ps(vb, vb), lo);
+            const __m128 s1 = _mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 1, 1, 1));
+            return _mm_cvtss_f32(_mm_add_ss(s, s1));
+        }
+#endif
+
+#if LMATH_HAS_FMA && defined(__ARM_NEON)
+        inline float dot_fma(const float* a, const float* b) noexcept {
+            const float32x4_t va = vld1q_f32(a);
+            const float32x4_t vb = vld1q_f32(b);
+            const float32x2_t lo = vmul_f32(vget_low_f32(va), vget_low_f32(vb));
+            const float32x2_t s  = vfma_f32(lo, vget_high_f32(va), vget_high_f32(vb));
+            return vget_lane_f32(s, 0) + vget_lane_f32(s, 1);
+        }
+#endif
+
+        // ------------------------------------------------------------
+        // Packed vec3 <-> SoA (in-register transpose)
+        //
+        // p points at 4 (SSE2) or 8 (AVX) tightly packed vec3, i.e. 12 or
+        // 24 floats. x/y/z receive one component per lane in vertex order.
+        // ------------------------------------------------------------
+#if defined(__SSE2__)
+        // [x0 y0 z0 x1] [y1 z1 x2 y2] [z2 x3 y3 z3] -> [x0..x3] [y0..y3] [z0..z3]
+        LMATH_FORCE_INLINE void vec3x4_transpose_in_sse2(__m128 a, __m128 b, __m128 c,
+                                                         __m128& x, __m128& y, __m128& z) noexcept {
+            const __m128 bc_x = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)); // x2 x2 x3 x3
+            const __m128 ab_y = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)); // y0 y0 y1 y1
+            const __m128 bc_y = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)); // y2 y2 y3 y3
+            const __m128 ab_z = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)); // z0 z0 z1 z1
+            const __m128 cc_z = _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)); // z2 z2 z3 z3
+
+            x = _mm_shuffle_ps(a,    bc_x, _MM_SHUFFLE(2, 0, 3, 0));
+            y = _mm_shuffle_ps(ab_y, bc_y, _MM_SHUFFLE(2, 0, 2, 0));
+            z = _mm_shuffle_ps(ab_z, cc_z, _MM_SHUFFLE(2, 0, 2, 0));
+        }
+
+        // inverse of vec3x4_transpose_in_sse2
+        LMATH_FORCE_INLINE void vec3x4_transpose_out_sse2(__m128 x, __m128 y, __m128 z,
+                                                          __m128& a, __m128& b, __m128& c) noexcept {
+            const __m128 xy0 = _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0)); // x0 x0 y0 y0
+            const __m128 zx0 = _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)); // z0 z0 x1 x1
+            const __m128 yz1 = _mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)); // y1 y1 z1 z1
+            const __m128 xy2 = _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)); // x2 x2 y2 y2
+            const __m128 zx2 = _mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)); // z2 z2 x3 x3
+            const __m128 yz3 = _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)); // y3 y3 z3 z3
+
+            a = _mm_shuffle_ps(xy0, zx0, _MM_SHUFFLE(2, 0, 2, 0));
+            b = _mm_shuffle_ps(yz1, xy2, _MM_SHUFFLE(2, 0, 2, 0));
+            c = _mm_shuffle_ps(zx2, yz3, _MM_SHUFFLE(2, 0, 2, 0));
+        }
+
+        LMATH_FORCE_INLINE void vec3x4_load_sse2(const float* p,
+                                                 __m128& x, __m128& y, __m128& z) noexcept {
+            vec3x4_transpose_in_sse2(_mm_loadu_ps(p), _mm_loadu_ps(p + 4), _mm_loadu_ps(p + 8),
+                                     x, y, z);
+        }
+
+        LMATH_FORCE_INLINE void vec3x4_store_sse2(float* p,
+                                                  __m128 x, __m128 y, __m128 z) noexcept {
+            __m128 a, b, c;
+            vec3x4_transpose_out_sse2(x, y, z, a, b, c);
+            _mm_storeu_ps(p,     a);
+            _mm_storeu_ps(p + 4, b);
+            _mm_storeu_ps(p + 8, c);
+        }
+#endif
+
+#if defined(__AVX__)
+        // Same shuffles as the SSE2 pair, one group of 4 vertices per 128-bit lane:
+        // lane 0 holds vertices 0..3, lane 1 holds vertices 4..7.
+        LMATH_FORCE_INLINE void vec3x8_load_avx(const float* p,
+                                                __m256& x, __m256& y, __m256& z) noexcept {
+            const __m256 a = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p)),     _mm_loadu_ps(p + 12), 1);
+            const __m256 b = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 4)), _mm_loadu_ps(p + 16), 1);
+            const __m256 c = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 8)), _mm_loadu_ps(p + 20), 1);
+
+            const __m256 bc_x = _mm256_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2));
+            const __m256 ab_y = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1));
+            const __m256 bc_y = _mm256_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3));
+            const __m256 ab_z = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2));
+            const __m256 cc_z = _mm256_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0));
+
+            x = _mm256_shuffle_ps(a,    bc_x, _MM_SHUFFLE(2, 0, 3, 0));
+            y = _mm256_shuffle_ps(ab_y, bc_y, _MM_SHUFFLE(2, 0, 2, 0));
+            z = _mm256_shuffle_ps(ab_z, cc_z, _MM_SHUFFLE(2, 0, 2, 0));
+        }
+
+        LMATH_FORCE_INLINE void vec3x8_store_avx(float* p,
+                                                 __m256 x, __m256 y, __m256 z) noexcept {
+            const __m256 xy0 = _mm256_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0));
+            const __m256 zx0 = _mm256_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0));
+            const __m256 yz1 = _mm256_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1));
+            const __m256 xy2 = _mm256_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2));
+            const __m256 zx2 = _mm256_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2));
+            const __m256 yz3 = _mm256_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3));
+
+            const __m256 a = _mm256_shuffle_ps(xy0, zx0, _MM_SHUFFLE(2, 0, 2, 0));
+            const __m256 b = _mm256_shuffle_ps(yz1, xy2, _MM_SHUFFLE(2, 0, 2, 0));
+            const __m256 c = _mm256_shuffle_ps(zx2, yz3, _MM_SHUFFLE(2, 0, 2, 0));
+
+            _mm_storeu_ps(p,      _mm256_castps256_ps128(a));
+            _mm_storeu_ps(p + 4,  _mm256_castps256_ps128(b));
+            _mm_storeu_ps(p + 8,  _mm256_castps256_ps128(c));
+            _mm_storeu_ps(p + 12, _mm256_extractf128_ps(a, 1));
+            _mm_storeu_ps(p + 16, _mm256_extractf128_ps(b, 1));
+            _mm_storeu_ps(p + 20, _mm256_extractf128_ps(c, 1));
+        }
+#endif
+
     } // namespace detail
 
     // ============================================================
@@ -400,6 +521,11 @@ namespace lm {
         const float* a = A.v;
         const float* b = B.v;
 
+#if defined(LMATH_USE_FMA) && LMATH_HAS_FMA
+        if (simd::has_fma())
+            return detail::dot_fma(a, b);
+#endif
+
         switch (simd::max_level()) {
 
 #if defined(__ARM_NEON)
@@ -411,6 +537,7 @@ namespace lm {
         case simd::Level::sse2:
         case simd::Level::avx:
         case simd::Level::avx2:
+        case simd::Level::avx512:
             return detail::dot_sse2(a, b);
 #endif
 
@@ -420,4 +547,214 @@ namespace lm {
 #endif // LMATH_FORCE_NO_SIMD
     } // vec4_dot
 
+    // ============================================================
+    // Vector trig (4 / 8 lanes, runtime-detect)
+    // ============================================================
+    // Cody-Waite reduction + minimax polynomials (detail::sincos_lanes),
+    // constant cost for any x, unlike the scalar lm::sinf.
+    //
+    // Max error against sin/cos evaluated in double:
+    //   |x| <= 8192           2 ulp where |result| > 1e-3, absolute 8e-8
+    //   |x| <= 2^16 * pi/2    absolute 1e-6
+    // Past that the reduction loses bits and the error grows with |x|.
+    // tan4/tan8 are sin/cos, so they add one division rounding.
+    // Non-finite input gives NaN.
+
+    inline void sincos4(const vec4& X, vec4* S, vec4* C) noexcept {
+#if defined(LMATH_FORCE_NO_SIMD)
+        for (std::size_t i = 0; i < 4; ++i)
+            detail::sincos_lanes<detail::lanes_scalar>(X[i], (*S)[i], (*C)[i]);
+#else
+        switch (simd::max_level()) {
+#if defined(__ARM_NEON)
+        case simd::Level::neon: {
+            float32x4_t s, c;
+            detail::sincos_lanes<detail::lanes_neon>(vld1q_f32(X.v), s, c);
+            vst1q_f32(S->v, s);
+            vst1q_f32(C->v, c);
+            return;
+        }
+#endif
+#if defined(__SSE2__)
+        case simd::Level::sse2:
+        case simd::Level::avx:
+        case simd::Level::avx2:
+        case simd::Level::avx512: {
+            __m128 s, c;
+            detail::sincos_lanes<detail::lanes_sse2>(_mm_loadu_ps(X.v), s, c);
+            _mm_storeu_ps(S->v, s);
+            _mm_storeu_ps(C->v, c);
+            return;
+        }
+#endif
+        default:
+            for (std::size_t i = 0; i < 4; ++i)
+                detail::sincos_lanes<detail::lanes_scalar>(X[i], (*S)[i], (*C)[i]);
+            return;
+        } // switch
+#endif // LMATH_FORCE_NO_SIMD
+    } // sincos4
+
+    LMATH_NO_DISCARD inline vec4 sin4(const vec4& X) noexcept {
+        vec4 s, c;
+        sincos4(X, &s, &c);
+        return s;
+    }
+
+    LMATH_NO_DISCARD inline vec4 cos4(const vec4& X) noexcept {
+        vec4 s, c;
+        sincos4(X, &s, &c);
+        return c;
+    }
+
+    LMATH_NO_DISCARD inline vec4 tan4(const vec4& X) noexcept {
+        vec4 s, c;
+        sincos4(X, &s, &c);
+        return { s[0] / c[0], s[1] / c[1], s[2] / c[2], s[3] / c[3] };
+    }
+
+    // 8 lanes: one AVX register, otherwise two 4-lane halves
+    inline void sincos8(const vec<float,8>& X, vec<float,8>* S, vec<float,8>* C) noexcept {
+#if !defined(LMATH_FORCE_NO_SIMD) && defined(__AVX__)
+        switch (simd::max_level()) {
+        case simd::Level::avx:
+        case simd::Level::avx2:
+        case simd::Level::avx512: {
+            __m256 s, c;
+            detail::sincos_lanes<detail::lanes_avx>(_mm256_loadu_ps(X.v), s, c);
+            _mm256_storeu_ps(S->v, s);
+            _mm256_storeu_ps(C->v, c);
+            return;
+        }
+        default:
+            break;
+        } // switch
+#endif
+        vec4 lo, hi, s_lo, c_lo, s_hi, c_hi;
+        for (std::size_t i = 0; i < 4; ++i) {
+            lo[i] = X[i];
+            hi[i] = X[i + 4];
+        }
+        sincos4(lo, &s_lo, &c_lo);
+        sincos4(hi, &s_hi, &c_hi);
+        for (std::size_t i = 0; i < 4; ++i) {
+            (*S)[i] = s_lo[i];  (*S)[i + 4] = s_hi[i];
+            (*C)[i] = c_lo[i];  (*C)[i + 4] = c_hi[i];
+        }
+    } // sincos8
+
+    LMATH_NO_DISCARD inline vec<float,8> sin8(const vec<float,8>& X) noexcept {
+        vec<float,8> s, c;
+        sincos8(X, &s, &c);
+        return s;
+    }
+
+    LMATH_NO_DISCARD inline vec<float,8> cos8(const vec<float,8>& X) noexcept {
+        vec<float,8> s, c;
+        sincos8(X, &s, &c);
+        return c;
+    }
+
+    LMATH_NO_DISCARD inline vec<float,8> tan8(const vec<float,8>& X) noexcept {
+        vec<float,8> s, c;
+        sincos8(X, &s, &c);
+        vec<float,8> t;
+        for (std::size_t i = 0; i < 8; ++i)
+            t[i] = s[i] / c[i];
+        return t;
+    }
+
+    // ============================================================
+    // Array sqrt / rsqrt (runtime-detect)
+    // ============================================================
+    // One dispatch per call, widest lanes available. `in` and `out` may
+    // be the same array.
+    //
+    //   estimate  raw hardware estimate: ~12 bits on x86, ~8 on NEON
+    //   newton    estimate + one Newton step, same as lm::rsqrtf:
+    //             ~22 bits on x86, ~16 on NEON
+    //   exact     IEEE sqrt (sqrtps / vsqrtq_f32); rsqrt is 1 / sqrt
+    //
+    // estimate and newton give 0 for x <= 0, like lm::rsqrtf / lm::sqrtf,
+    // and sqrt(+inf) = +inf, rsqrt(+inf) = 0.
+    // exact follows IEEE: sqrt(-x) is NaN, rsqrt(0) is +inf.
+    // Without SIMD, estimate is the same as newton.
+
+    enum class sqrt_precision {
+        estimate,
+        newton,
+        exact,
+    };
+
+    namespace detail {
+        template<sqrt_precision P> struct sqrt_tier;
+
+        // x * rsqrt(x) is inf * 0 for +inf, and the Newton step NaNs there
+        // too: +inf takes the IEEE answers (sqrt +inf, rsqrt 0) by select
+        template<bool Estimate> struct sqrt_tier_approx {
+            template<typename L>
+            static LMATH_FORCE_INLINE typename L::reg rsqrt_of(typename L::reg x) noexcept {
+                return Estimate ? L::rsqrt_est(x) : L::rsqrt(x);
+            }
+            template<typename L>
+            static LMATH_FORCE_INLINE typename L::reg rsqrt(typename L::reg x) noexcept {
+                const typename L::mask ok = L::mask_and(L::cmpgt(x, L::zero()),
+                                                        L::cmple(x, L::set1(3.402823466e+38f)));
+                return L::select(ok, rsqrt_of<L>(x), L::zero());
+            }
+            template<typename L>
+            static LMATH_FORCE_INLINE typename L::reg sqrt(typename L::reg x) noexcept {
+                const typename L::reg r = L::select(L::cmple(x, L::set1(3.402823466e+38f)),
+                                                    L::mul(x, rsqrt_of<L>(x)), x);
+                return L::select(L::cmpgt(x, L::zero()), r, L::zero());
+            }
+        };
+
+        template<> struct sqrt_tier<sqrt_precision::estimate> : sqrt_tier_approx<true> {};
+        template<> struct sqrt_tier<sqrt_precision::newton>   : sqrt_tier_approx<false> {};
+
+        template<> struct sqrt_tier<sqrt_precision::exact> {
+            template<typename L>
+            static LMATH_FORCE_INLINE typename L::reg rsqrt(typename L::reg x) noexcept {
+                return L::div(L::set1(1.f), L::sqrt(x));
+            }
+            template<typename L>
+            static LMATH_FORCE_INLINE typename L::reg sqrt(typename L::reg x) noexcept {
+                return L::sqrt(x);
+            }
+        };
+
+        template<sqrt_precision P, bool Rsqrt>
+        inline void sqrt_array(const float* in, float* out, std::size_t n) noexcept {
+            with_lanes([&](auto L) {
+                for_lanes<decltype(L)>(n, [&](auto S, std::size_t i) {
+                    using T = decltype(S);
+                    const typename T::reg x = T::load(in + i);
+                    T::store(out + i, Rsqrt ? sqrt_tier<P>::template rsqrt<T>(x)
+                                            : sqrt_tier<P>::template sqrt<T>(x));
+                });
+            });
+        }
+    } // namespace detail
+
+    // out[i] = 1 / sqrt(in[i])
+    inline void rsqrt_batch(const float* in, float* out, std::size_t n,
+                            sqrt_precision p = sqrt_precision::newton) noexcept {
+        switch (p) {
+        case sqrt_precision::estimate: detail::sqrt_array<sqrt_precision::estimate, true>(in, out, n); return;
+        case sqrt_precision::exact:    detail::sqrt_array<sqrt_precision::exact,    true>(in, out, n); return;
+        default:                       detail::sqrt_array<sqrt_precision::newton,   true>(in, out, n); return;
+        }
+    }
+
+    // out[i] = sqrt(in[i])
+    inline void sqrt_batch(const float* in, float* out, std::size_t n,
+                           sqrt_precision p = sqrt_precision::newton) noexcept {
+        switch (p) {
+        case sqrt_precision::estimate: detail::sqrt_array<sqrt_precision::estimate, false>(in, out, n); return;
+        case sqrt_precision::exact:    detail::sqrt_array<sqrt_precision::exact,    false>(in, out, n); return;
+        default:                       detail::sqrt_array<sqrt_precision::newton,   false>(in, out, n); return;
+        }
+    }
+
 } // namespace lm
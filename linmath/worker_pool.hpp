@@ -0,0 +1,170 @@
+#pragma once
+
+#include <cstddef>
+
+#include "detail/feature_detection.hpp"
+
+#if !defined(LMATH_FREESTANDING)
+#   include <atomic>
+#   include <condition_variable>
+#   include <mutex>
+#   include <thread>
+#   include <vector>
+#endif
+
+namespace lm {
+
+    // ============================================================
+    // Worker pools
+    //
+    // run(self, count, fn, ctx) calls fn(ctx, 0) .. fn(ctx, count - 1) and
+    // returns once all of them have finished. Calls may run concurrently
+    // and in any order; `workers` is how many can run at once, counting
+    // the calling thread. Anything with that shape plugs in (an engine's
+    // job system, a test harness); the library ships two:
+    //
+    //   serial_pool()  runs every task on the calling thread
+    //   thread_pool    std::threads parked between runs (hosted builds)
+    //
+    // default_pool() is a process-wide thread_pool, or serial_pool() when
+    // LMATH_FREESTANDING is defined (no <thread>, no CRT).
+    // ============================================================
+
+    struct worker_pool {
+        void        (*run)(void* self, std::size_t count,
+                           void (*fn)(void* ctx, std::size_t task), void* ctx) noexcept;
+        void*         self;
+        std::size_t   workers;
+    };
+
+    namespace detail {
+        inline void serial_run(void*, std::size_t count,
+                               void (*fn)(void*, std::size_t), void* ctx) noexcept {
+            for (std::size_t i = 0; i < count; ++i)
+                fn(ctx, i);
+        }
+    } // namespace detail
+
+    LMATH_NO_DISCARD inline worker_pool serial_pool() noexcept {
+        return { &detail::serial_run, nullptr, 1 };
+    }
+
+#if !defined(LMATH_FREESTANDING)
+    // `workers - 1` threads plus the caller, which takes tasks too.
+    // 0 picks std::thread::hardware_concurrency(). One run at a time:
+    // concurrent run() calls on the same pool are serialized.
+    class thread_pool {
+    public:
+        explicit thread_pool(std::size_t workers = 0) {
+            if (workers == 0)
+                workers = std::thread::hardware_concurrency();
+            for (std::size_t i = 1; i < workers; ++i)
+                threads.emplace_back([this] { work(); });
+        }
+
+        ~thread_pool() {
+            {
+                std::lock_guard<std::mutex> lock(m);
+                stop = true;
+            }
+            wake.notify_all();
+            for (std::thread& t : threads)
+                t.join();
+        }
+
+        thread_pool(const thread_pool&) = delete;
+        thread_pool& operator=(const thread_pool&) = delete;
+
+        LMATH_NO_DISCARD worker_pool pool() noexcept {
+            return { &thread_pool::run, this, threads.size() + 1 };
+        }
+
+    private:
+        static void run(void* self, std::size_t count,
+                        void (*fn)(void*, std::size_t), void* ctx) noexcept {
+            thread_pool& P = *static_cast<thread_pool*>(self);
+            if (count <= 1 || P.threads.empty()) {
+                detail::serial_run(nullptr, count, fn, ctx);
+                return;
+            }
+
+            std::unique_lock<std::mutex> lock(P.run_m);
+            {
+                // a worker still inside the previous job would claim from
+                // the new counter with the old fn, so wait it out first
+                std::unique_lock<std::mutex> job(P.m);
+                P.idle.wait(job, [&] { return P.busy == 0; });
+                P.job_fn = fn;
+                P.job_ctx = ctx;
+                P.job_count = count;
+                P.next.store(0, std::memory_order_relaxed);
+                ++P.generation;
+            }
+            P.wake.notify_all();
+
+            P.claim(fn, ctx, count);
+
+            // every task is claimed; wait for the workers still running one
+            std::unique_lock<std::mutex> job(P.m);
+            P.idle.wait(job, [&] { return P.busy == 0; });
+        }
+
+        void claim(void (*fn)(void*, std::size_t), void* ctx, std::size_t count) noexcept {
+            for (;;) {
+                const std::size_t i = next.fetch_add(1, std::memory_order_relaxed);
+                if (i >= count)
+                    return;
+                fn(ctx, i);
+            }
+        }
+
+        void work() noexcept {
+            std::size_t seen = 0;
+            std::unique_lock<std::mutex> lock(m);
+            for (;;) {
+                wake.wait(lock, [&] { return stop || generation != seen; });
+                if (stop)
+                    return;
+                seen = generation;
+                void (*fn)(void*, std::size_t) = job_fn;
+                void* ctx = job_ctx;
+                const std::size_t count = job_count;
+                ++busy;
+                lock.unlock();
+
+                claim(fn, ctx, count);
+
+                lock.lock();
+                if (--busy == 0)
+                    idle.notify_all();
+            }
+        }
+
+        std::vector<std::thread> threads;
+
+        std::mutex              run_m; // one run() at a time
+        std::mutex              m;     // guards everything below but `next`
+        std::condition_variable wake;
+        std::condition_variable idle;
+
+        void                  (*job_fn)(void*, std::size_t) = nullptr;
+        void*                   job_ctx = nullptr;
+        std::size_t             job_count = 0;
+        std::size_t             generation = 0;
+        std::size_t             busy = 0;
+        bool                    stop = false;
+
+        std::atomic<std::size_t> next{ 0 };
+    };
+
+    inline worker_pool default_pool() noexcept {
+        static thread_pool pool;
+        return pool.pool();
+    }
+#else
+    inline worker_pool default_pool() noexcept {
+        return serial_pool();
+    }
+#endif
+
+} // namespace lm
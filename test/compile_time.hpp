@@ -226,6 +226,24 @@ namespace lm {
 
             return true;
 }
+
+        // ------------------------------------------------------------
+        // sincosf and the rotation builders on top of it
+        // ------------------------------------------------------------
+        LMATH_CONSTEVAL bool test_sincos() noexcept {
+            constexpr sincos_f a = sincosf(0.5f);
+            static_assert(a.s > 0.4794255f && a.s < 0.4794256f);
+            static_assert(a.c > 0.8775825f && a.c < 0.8775827f);
+
+            constexpr sincos_f b = sincosf(-4.f); // third quadrant
+            static_assert(b.s > 0.7568024f && b.s < 0.7568026f);
+            static_assert(b.c < -0.6536435f && b.c > -0.6536437f);
+
+            constexpr mat4 R = mat4_rotate_z(0.5f);
+            static_assert(R[0][0] == a.c && R[0][1] == a.s && R[1][0] == -a.s);
+
+            return true;
+        }
     } // namespace ct (compile-time)
 } // namespace lm
 #endif // LMATH_CXX17
\ No newline at end of file
@@ -5,6 +5,17 @@
 #include "../linmath/vec.hpp"
 #include "../linmath/mat.hpp"
 #include "../linmath/quat.hpp"
+#include "../linmath/dualquat.hpp"
+#include "../linmath/skinning.hpp"
+#include "../linmath/trs.hpp"
+#include "../linmath/soa.hpp"
+#include "../linmath/affine.hpp"
+#include "../linmath/hierarchy.hpp"
+#include "../linmath/bounds.hpp"
+#include "../linmath/ray.hpp"
+#include "../linmath/bvh.hpp"
+#include "../linmath/frustum.hpp"
+#include "../linmath/par_kernels.hpp"
 
 extern "C" {
 #   include "../3rd-party/linmath.h" // original copy
@@ -12,6 +23,15 @@ extern "C" {
 
 #include "../3rd-party/glm-1.0.3/glm/glm.hpp" // 3rd-party 'glm' also
 #include "../3rd-party/glm-1.0.3/glm/gtc/matrix_transform.hpp"
+#include "../3rd-party/glm-1.0.3/glm/gtc/quaternion.hpp"
+#include "../3rd-party/glm-1.0.3/glm/gtc/type_ptr.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+#include <vector>
 
 // Compile-time tests for C++17 version or higher
 #ifdef LMATH_CXX17
@@ -21,6 +41,7 @@ extern "C" {
     static_assert(lm::ct::test_vec_arithmetic(), "constexpr vec arithmetic failed");
     static_assert(lm::ct::test_mat_arithmetic(), "constexpr mat arithmetic failed");
     static_assert(lm::ct::test_quat_arithmetic(), "constexpr quat arithmetic failed");
+    static_assert(lm::ct::test_sincos(), "constexpr sincosf failed");
 #endif
 
 namespace {
@@ -54,6 +75,246 @@ namespace {
         REQUIRE(::lm::sqrtf(59.f) == Approx(7.6811457f).margin(1e-6f));
     }
 
+    TEST_CASE("roundf matches std::round", "[math]") {
+        for (const float x : { 0.5f, 1.5f, 2.5f, -0.5f, -2.5f, 0.49999997f, 1e9f, 4194303.5f })
+            REQUIRE(::lm::roundf(x) == std::round(x));
+        // [2^22, 2^23) still has halves
+        REQUIRE(::lm::roundf(4194304.5f) == 4194305.f);
+        for (float x = 4194304.f; x < 8388608.f; x += 65536.5f) {
+            REQUIRE(::lm::roundf(x) == std::round(x));
+            REQUIRE(::lm::roundf(-x) == std::round(-x));
+        }
+    }
+
+    TEST_CASE("sin4/cos4/sin8/cos8 accuracy and lane agreement", "[math][trig][simd]") {
+        // ulp of the float nearest to `ref`
+        auto ulp = [](double ref) {
+            const float f = float(ref);
+            return std::fabs(double(std::nextafter(f, 2.f)) - double(f));
+        };
+
+        double max_ulp = 0.0, max_abs = 0.0;
+        constexpr int steps = 20000;
+        for (int k = 0; k < steps; k += 8) {
+            lm::vec<float, 8> x{};
+            for (int i = 0; i < 8; ++i)
+                x[i] = float(-8192.0 + 16384.0 * double(k + i) / steps);
+
+            lm::vec<float, 8> s8{}, c8{};
+            lm::sincos8(x, &s8, &c8);
+
+            const lm::vec4 lo = { x[0], x[1], x[2], x[3] };
+            const lm::vec4 s4 = lm::sin4(lo);
+            const lm::vec4 c4 = lm::cos4(lo);
+
+            for (int i = 0; i < 4; ++i) {
+                // every lane width (and the scalar lane) computes the same bits
+                float ss = 0.f, cs = 0.f;
+                lm::detail::sincos_lanes<lm::detail::lanes_scalar>(x[i], ss, cs);
+                REQUIRE(byte_equal(s4[i], s8[i]));
+                REQUIRE(byte_equal(c4[i], c8[i]));
+                REQUIRE(byte_equal(ss, s8[i]));
+                REQUIRE(byte_equal(cs, c8[i]));
+            }
+
+            for (int i = 0; i < 8; ++i) {
+                const double rs = std::sin(double(x[i]));
+                const double rc = std::cos(double(x[i]));
+                max_abs = std::fmax(max_abs, std::fabs(s8[i] - rs));
+                max_abs = std::fmax(max_abs, std::fabs(c8[i] - rc));
+                if (std::fabs(rs) > 1e-3) max_ulp = std::fmax(max_ulp, std::fabs(s8[i] - rs) / ulp(rs));
+                if (std::fabs(rc) > 1e-3) max_ulp = std::fmax(max_ulp, std::fabs(c8[i] - rc) / ulp(rc));
+            }
+        }
+
+        // multiples of pi/4 and their neighbours land on x * 2/pi == n + 0.5,
+        // where every lane has to round the same way (ties to even)
+        auto lanes_agree = [](const float (&x)[8]) {
+            lm::vec<float, 8> v{};
+            for (int i = 0; i < 8; ++i) v[i] = x[i];
+            lm::vec<float, 8> s8{}, c8{};
+            lm::sincos8(v, &s8, &c8);
+            for (int h = 0; h < 8; h += 4) {
+                const lm::vec4 q = { x[h], x[h + 1], x[h + 2], x[h + 3] };
+                const lm::vec4 s4 = lm::sin4(q), c4 = lm::cos4(q);
+                for (int i = 0; i < 4; ++i) {
+                    float ss = 0.f, cs = 0.f;
+                    lm::detail::sincos_lanes<lm::detail::lanes_scalar>(x[h + i], ss, cs);
+                    REQUIRE(byte_equal(s4[i], s8[h + i]));
+                    REQUIRE(byte_equal(c4[i], c8[h + i]));
+                    REQUIRE(byte_equal(ss, s8[h + i]));
+                    REQUIRE(byte_equal(cs, c8[h + i]));
+                }
+            }
+        };
+        {
+            const float known[8] = { 0.785398185f, 7.06858397f, 10.2101765f, -0.785398185f,
+                                     lm::PI / 4.f, 3.f * lm::PI / 4.f, -5.f * lm::PI / 4.f, 0.f };
+            lanes_agree(known);
+        }
+        for (int m = -4096; m < 4096; m += 2) {
+            float x[8];
+            for (int h = 0; h < 2; ++h) {
+                const float t = float((double(m + h) + 0.5) * 1.5707963267948966);
+                x[4 * h + 0] = t;
+                x[4 * h + 1] = std::nextafter(t, 1e9f);
+                x[4 * h + 2] = std::nextafter(t, -1e9f);
+                x[4 * h + 3] = float(m + h) * (lm::PI / 4.f);
+            }
+            lanes_agree(x);
+        }
+
+        // [2^22, 2^23) still has halves: x * 2/pi == n + 0.5 there as well
+        REQUIRE(lm::roundevenf(-4194305.5f) == -4194306.f);
+        REQUIRE(lm::roundevenf(4194304.5f) == 4194304.f);
+        REQUIRE(lm::roundevenf(8388607.5f) == 8388608.f);
+        for (float r = 4194304.f; r < 8388608.f; r += 65536.5f) {
+            REQUIRE(lm::roundevenf(r) == std::nearbyint(r));
+            REQUIRE(lm::roundevenf(-r) == std::nearbyint(-r));
+            float x[8];
+            for (int i = 0; i < 8; ++i) x[i] = (r + 0.5f * float(i)) * (lm::PI / 2.f);
+            lanes_agree(x);
+        }
+#if defined(__SSE2__) && !defined(LMATH_FORCE_NO_SIMD)
+        for (float r = 4194304.5f; r < 8388608.f; r += 131071.f) {
+            alignas(16) float o[4];
+            const float in[4] = { r, -r, r + 1.f, -(r + 1.f) };
+            _mm_store_ps(o, lm::detail::lanes_sse2::round(_mm_loadu_ps(in)));
+            for (int i = 0; i < 4; ++i)
+                REQUIRE(byte_equal(o[i], lm::detail::lanes_scalar::round(in[i])));
+        }
+#endif
+
+        // documented bounds for |x| <= 8192 (vec.hpp)
+        REQUIRE(max_ulp <= 2.0);
+        REQUIRE(max_abs <= 8e-8);
+
+        const lm::vec4 t = lm::tan4({ 0.f, 0.5f, -1.f, 1.2f });
+        REQUIRE(t[1] == Approx(std::tan(0.5)).epsilon(1e-6));
+        REQUIRE(t[2] == Approx(std::tan(-1.0)).epsilon(1e-6));
+        REQUIRE(t[3] == Approx(std::tan(1.2)).epsilon(1e-6));
+    }
+
+    TEST_CASE("sincosf matches the lane kernel and feeds the rotation builders", "[math][trig]") {
+        for (int k = -2000; k <= 2000; ++k) {
+            const float x = 0.0371f * float(k);
+            const lm::sincos_f sc = lm::sincosf(x);
+
+            float s = 0.f, c = 0.f;
+            lm::detail::sincos_lanes<lm::detail::lanes_scalar>(x, s, c);
+            REQUIRE(byte_equal(sc.s, s));
+            REQUIRE(byte_equal(sc.c, c));
+
+            lm::sincosf(x, &s, &c);
+            REQUIRE(byte_equal(sc.s, s));
+            REQUIRE(byte_equal(sc.c, c));
+
+            REQUIRE(sc.s == Approx(std::sin(double(x))).margin(1e-7));
+            REQUIRE(sc.c == Approx(std::cos(double(x))).margin(1e-7));
+        }
+
+        // x * 2/pi == n + 0.5 for multiples of pi/4: same tie rule as sin4
+        for (int k = -64; k < 64; k += 4) {
+            const lm::vec4 x = { float(k) * (lm::PI / 4.f), float(k + 1) * (lm::PI / 4.f),
+                                 float(k + 2) * (lm::PI / 4.f), float(k + 3) * (lm::PI / 4.f) };
+            const lm::vec4 s4 = lm::sin4(x), c4 = lm::cos4(x);
+            for (int i = 0; i < 4; ++i) {
+                const lm::sincos_f sc = lm::sincosf(x[i]);
+                REQUIRE(byte_equal(sc.s, s4[i]));
+                REQUIRE(byte_equal(sc.c, c4[i]));
+            }
+        }
+        {
+            const float a = lm::PI / 4.f;
+            const lm::vec4 s4 = lm::sin4({ a, a, a, a }), c4 = lm::cos4({ a, a, a, a });
+            const lm::mat4 rx = lm::mat4_rotate_x(a);
+            REQUIRE((byte_equal(rx[1][1], c4[0]) && byte_equal(rx[1][2], s4[0])));
+        }
+
+        const float a = 2.3f;
+        const lm::sincos_f sc = lm::sincosf(a);
+        const lm::mat4 rx = lm::mat4_rotate_x(a);
+        const lm::mat4 ry = lm::mat4_rotate_y(a);
+        const lm::mat4 rz = lm::mat4_rotate_z(a);
+        const lm::mat3 r2 = lm::mat3_rotate(a);
+        REQUIRE((rx[1][1] == sc.c && rx[1][2] == sc.s));
+        REQUIRE((ry[0][0] == sc.c && ry[2][0] == sc.s));
+        REQUIRE((rz[0][0] == sc.c && rz[0][1] == sc.s));
+        REQUIRE((r2[0][0] == sc.c && r2[0][1] == sc.s));
+
+        const lm::quat q = lm::quat_rotate(a, lm::vec3{ 0.f, 0.f, 1.f });
+        const lm::sincos_f half = lm::sincosf(0.5f * a);
+        REQUIRE(q[2] == Approx(half.s));
+        REQUIRE(q[3] == half.c);
+    }
+
+    TEST_CASE("rsqrt_batch / sqrt_batch precision tiers", "[math][batch][simd]") {
+        // odd count so every lane width leaves a scalar tail
+        constexpr std::size_t n = 45;
+        float in[n]{}, r[n]{}, q[n]{};
+        for (std::size_t i = 0; i < n; ++i)
+            in[i] = 0.01f + 3.7f * float(i) * float(i);
+        in[3] = 0.f;
+
+        SECTION("exact is IEEE sqrt") {
+            lm::sqrt_batch(in, q, n, lm::sqrt_precision::exact);
+            lm::rsqrt_batch(in, r, n, lm::sqrt_precision::exact);
+            for (std::size_t i = 0; i < n; ++i) {
+                REQUIRE(byte_equal(q[i], std::sqrt(in[i])));
+                if (in[i] > 0.f)
+                    REQUIRE(byte_equal(r[i], 1.f / std::sqrt(in[i])));
+            }
+        }
+
+        SECTION("newton matches lm::rsqrtf") {
+            lm::rsqrt_batch(in, r, n);
+            lm::sqrt_batch(in, q, n, lm::sqrt_precision::newton);
+            for (std::size_t i = 0; i < n; ++i) {
+                REQUIRE(r[i] == Approx(lm::rsqrtf(in[i])).epsilon(1e-6));
+                if (in[i] > 0.f) {
+                    REQUIRE(r[i] == Approx(1.0 / std::sqrt(double(in[i]))).epsilon(2e-5));
+                    REQUIRE(q[i] == Approx(std::sqrt(double(in[i]))).epsilon(2e-5));
+                }
+            }
+            REQUIRE(r[3] == 0.f);
+            REQUIRE(q[3] == 0.f);
+        }
+
+        SECTION("estimate is within the hardware bound") {
+            lm::rsqrt_batch(in, r, n, lm::sqrt_precision::estimate);
+            lm::sqrt_batch(in, q, n, lm::sqrt_precision::estimate);
+            for (std::size_t i = 0; i < n; ++i) {
+                if (in[i] > 0.f) {
+                    REQUIRE(r[i] == Approx(1.0 / std::sqrt(double(in[i]))).epsilon(4e-3));
+                    REQUIRE(q[i] == Approx(std::sqrt(double(in[i]))).epsilon(4e-3));
+                }
+            }
+            REQUIRE(r[3] == 0.f);
+            REQUIRE(q[3] == 0.f);
+        }
+
+        SECTION("+inf gives +inf / 0 in every tier") {
+            const float inf = std::numeric_limits<float>::infinity();
+            for (std::size_t i = 0; i < n; i += 4) in[i] = inf; // vector lanes and the tail
+            for (const lm::sqrt_precision p : { lm::sqrt_precision::estimate, lm::sqrt_precision::newton,
+                                                lm::sqrt_precision::exact }) {
+                lm::sqrt_batch(in, q, n, p);
+                lm::rsqrt_batch(in, r, n, p);
+                for (std::size_t i = 0; i < n; i += 4) {
+                    REQUIRE(q[i] == inf);
+                    REQUIRE(r[i] == 0.f);
+                }
+                REQUIRE(q[1] == Approx(std::sqrt(double(in[1]))).epsilon(4e-3));
+            }
+        }
+
+        SECTION("in place") {
+            lm::rsqrt_batch(in, r, n);
+            lm::rsqrt_batch(in, in, n);
+            REQUIRE(std::memcmp(in, r, sizeof(in)) == 0);
+        }
+    }
+
     TEST_CASE("vec3 normalize sanity", "[vec3][math]") {
         lm::vec3 v{ -1.f, 3.f, -7.f };
         auto n = lm::vec_norm(v);
@@ -219,7 +480,1309 @@ namespace {
         REQUIRE(byte_equal(R1, R2));
     }
 
+    TEST_CASE("mat4 inverse matches linmath.h & glm", "[mat4][inverse][glm][simd]") {
+        lm::mat4 M = lm::mat4_mul(lm::mat4_translate(1.f, -2.f, 3.f),
+                                  lm::mat4_mul(lm::mat4_rotate_y(0.7f), lm::mat4_scale(2.f, 0.5f, 3.f)));
+        M[0][3] = 0.1f; // projective row, so only the general path applies
+        M[2][3] = -0.3f;
+
+        for (const lm::mat4& X : { M, lm::mat4_identity(), lm::mat4_rotate_x(1.1f) }) {
+            const lm::mat4 I = lm::mat4_inverse_scalar(X);
+
+            ::mat4x4 cX{}, cI{};
+            std::memcpy(cX, &X, sizeof(cX));
+            ::mat4x4_invert(cI, cX);
+            REQUIRE(byte_equal(I, cI)); // same cofactor order as linmath.h
+
+            const glm::mat4 gX = glm::make_mat4(X[0].data());
+            REQUIRE(mat4_approx_equal(I, glm::inverse(gX)));
+
+            REQUIRE(byte_equal(lm::mat4_inverse(X), I));
+#if defined(__SSE2__) && !defined(LMATH_FORCE_NO_SIMD)
+            REQUIRE(byte_equal(lm::detail::mat4_inverse_sse2(X), I));
+#endif
+#if defined(__ARM_NEON) && !defined(LMATH_FORCE_NO_SIMD)
+            REQUIRE(byte_equal(lm::detail::mat4_inverse_neon(X), I));
+#endif
+            REQUIRE(mat4_approx_equal(lm::mat4_mul_scalar(X, I), lm::mat4_identity()));
+        }
+    }
+
+    TEST_CASE("mat4 affine / rigid inverse", "[mat4][inverse][simd]") {
+        const lm::mat4 A = lm::mat4_mul(lm::mat4_translate(1.f, -2.f, 3.f),
+                                        lm::mat4_mul(lm::mat4_rotate_y(0.7f), lm::mat4_scale(2.f, 0.5f, 3.f)));
+        const lm::mat4 R = lm::mat4_mul(lm::mat4_translate(-4.f, 0.5f, 2.f),
+                                        lm::mat4_mul(lm::mat4_rotate_x(1.1f), lm::mat4_rotate_z(-0.3f)));
+
+        const lm::mat4 IA = lm::mat4_inverse_affine_scalar(A);
+        const lm::mat4 IR = lm::mat4_inverse_rigid_scalar(R);
+
+        REQUIRE(mat4_approx_equal(IA, lm::mat4_inverse_scalar(A)));
+        REQUIRE(mat4_approx_equal(IR, lm::mat4_inverse_scalar(R)));
+        REQUIRE(mat4_approx_equal(lm::mat4_mul_scalar(A, IA), lm::mat4_identity()));
+        REQUIRE(mat4_approx_equal(lm::mat4_mul_scalar(R, IR), lm::mat4_identity()));
+        REQUIRE(IA[3][3] == 1.f);
+        REQUIRE(IR[3][3] == 1.f);
+
+        REQUIRE(byte_equal(lm::mat4_inverse_affine(A), IA));
+        REQUIRE(byte_equal(lm::mat4_inverse_rigid(R), IR));
+#if defined(__SSE2__) && !defined(LMATH_FORCE_NO_SIMD)
+        REQUIRE(byte_equal(lm::detail::mat4_inverse_affine_sse2(A), IA));
+        REQUIRE(byte_equal(lm::detail::mat4_inverse_rigid_sse2(R), IR));
+#endif
+#if defined(__ARM_NEON) && !defined(LMATH_FORCE_NO_SIMD)
+        REQUIRE(byte_equal(lm::detail::mat4_inverse_affine_neon(A), IA));
+        REQUIRE(byte_equal(lm::detail::mat4_inverse_rigid_neon(R), IR));
+#endif
+    }
+
+    TEST_CASE("affine3x4 matches mat4 affine ops", "[affine][mat4][simd]") {
+        const lm::mat4 MA = lm::mat4_mul(lm::mat4_translate(1.f, -2.f, 3.f),
+                                         lm::mat4_mul(lm::mat4_rotate_y(0.7f), lm::mat4_scale(2.f, 0.5f, 3.f)));
+        const lm::mat4 MB = lm::mat4_mul(lm::mat4_translate(-4.f, 0.5f, 2.f),
+                                         lm::mat4_mul(lm::mat4_rotate_x(1.1f), lm::mat4_rotate_z(-0.3f)));
+        const lm::affine3x4 A = lm::affine_from_mat4(MA);
+        const lm::affine3x4 B = lm::affine_from_mat4(MB);
+
+        REQUIRE(sizeof(lm::affine3x4) == 48);
+        REQUIRE(byte_equal(lm::mat4_from_affine(A), MA)); // lossless round trip
+        REQUIRE(byte_equal(lm::mat4_from_affine(lm::affine_identity()), lm::mat4_identity()));
+
+        // compose
+        const lm::affine3x4 AB = lm::affine_mul_scalar(A, B);
+        REQUIRE(mat4_approx_equal(lm::mat4_from_affine(AB), lm::mat4_mul_scalar(MA, MB)));
+        REQUIRE(byte_equal(lm::affine_mul(A, B), AB));
+        REQUIRE(byte_equal(A * B, AB));
+#if defined(__SSE2__) && !defined(LMATH_FORCE_NO_SIMD)
+        REQUIRE(byte_equal(lm::detail::affine_mul_sse2(A, B), AB));
+#endif
+#if defined(__AVX__) && !defined(LMATH_FORCE_NO_SIMD)
+        REQUIRE(byte_equal(lm::detail::affine_mul_avx(A, B), AB));
+#endif
+#if defined(__ARM_NEON) && !defined(LMATH_FORCE_NO_SIMD)
+        REQUIRE(byte_equal(lm::detail::affine_mul_neon(A, B), AB));
+#endif
+
+        // inverse: same bits as the mat4 affine / rigid paths
+        const lm::affine3x4 IA = lm::affine_inverse_scalar(A);
+        const lm::affine3x4 IB = lm::affine_inverse_rigid_scalar(B);
+        REQUIRE(byte_equal(lm::mat4_from_affine(IA), lm::mat4_inverse_affine_scalar(MA)));
+        REQUIRE(byte_equal(lm::mat4_from_affine(IB), lm::mat4_inverse_rigid_scalar(MB)));
+        REQUIRE(byte_equal(lm::affine_inverse(A), IA));
+        REQUIRE(byte_equal(lm::affine_inverse_rigid(B), IB));
+#if defined(__SSE2__) && !defined(LMATH_FORCE_NO_SIMD)
+        REQUIRE(byte_equal(lm::detail::affine_inverse_sse2(A), IA));
+        REQUIRE(byte_equal(lm::detail::affine_inverse_rigid_sse2(B), IB));
+#endif
+#if defined(__AVX__) && !defined(LMATH_FORCE_NO_SIMD)
+        REQUIRE(byte_equal(lm::detail::affine_inverse_avx(A), IA));
+        REQUIRE(byte_equal(lm::detail::affine_inverse_rigid_avx(B), IB));
+#endif
+#if defined(__ARM_NEON) && !defined(LMATH_FORCE_NO_SIMD)
+        REQUIRE(byte_equal(lm::detail::affine_inverse_neon(A), IA));
+        REQUIRE(byte_equal(lm::detail::affine_inverse_rigid_neon(B), IB));
+#endif
+        REQUIRE(mat4_approx_equal(lm::mat4_from_affine(lm::affine_mul_scalar(A, IA)), lm::mat4_identity()));
+
+        // point / dir transforms
+        const std::size_t n = 11;
+        lm::vec3 in[n], pts[n], dirs[n], ref_p[n], ref_d[n];
+        for (std::size_t i = 0; i < n; ++i)
+            in[i] = { 0.5f * float(i), 1.f - float(i), 0.25f * float(i * i) };
+        lm::affine_transform_points(A, in, pts, n);
+        lm::affine_transform_dirs(A, in, dirs, n);
+        lm::mat4_transform_points_scalar(MA, in, ref_p, n);
+        lm::mat4_transform_dirs_scalar(MA, in, ref_d, n);
+        for (std::size_t i = 0; i < n; ++i) {
+            REQUIRE(byte_equal(pts[i], ref_p[i]));
+            REQUIRE(byte_equal(dirs[i], ref_d[i]));
+            REQUIRE(byte_equal(lm::affine_transform_point(A, in[i]), ref_p[i]));
+            REQUIRE(byte_equal(lm::affine_transform_dir(A, in[i]), ref_d[i]));
+        }
+    }
+
+    TEST_CASE("mat4 / mat3 determinant, adjugate & batch", "[mat4][mat3][determinant][batch][simd]") {
+        lm::mat4 M = lm::mat4_mul(lm::mat4_translate(1.f, -2.f, 3.f),
+                                  lm::mat4_mul(lm::mat4_rotate_y(0.7f), lm::mat4_scale(2.f, 0.5f, 3.f)));
+        M[0][3] = 0.1f;
+        M[2][3] = -0.3f;
+
+        const float d = lm::mat4_determinant_scalar(M);
+        const lm::mat4 adj = lm::mat4_adjugate_scalar(M);
+
+        const glm::mat4 gM = glm::make_mat4(M[0].data());
+        REQUIRE(d == Approx(glm::determinant(gM)).epsilon(1e-5));
+        REQUIRE(lm::mat4_determinant_scalar(lm::mat4_mul(lm::mat4_rotate_y(0.7f), lm::mat4_scale(2.f, 0.5f, 3.f)))
+                == Approx(3.f).epsilon(1e-5));
+
+        REQUIRE(byte_equal(lm::mat_determinant(M), d));
+        REQUIRE(byte_equal(lm::mat_adjugate(M), adj));
+#if defined(__SSE2__) && !defined(LMATH_FORCE_NO_SIMD)
+        REQUIRE(byte_equal(lm::detail::mat4_determinant_sse2(M), d));
+        REQUIRE(byte_equal(lm::detail::mat4_adjugate_sse2(M), adj));
+#endif
+#if defined(__ARM_NEON) && !defined(LMATH_FORCE_NO_SIMD)
+        REQUIRE(byte_equal(lm::detail::mat4_determinant_neon(M), d));
+        REQUIRE(byte_equal(lm::detail::mat4_adjugate_neon(M), adj));
+#endif
+
+        // M * adj(M) = det(M) * I
+        lm::mat4 dI = lm::mat4_identity();
+        for (int i = 0; i < 4; ++i) dI[i][i] = d;
+        REQUIRE(mat4_approx_equal(lm::mat4_mul_scalar(M, adj), dI));
+
+        const lm::mat3 N{ { { 2.f, 1.f, -1.f }, { 0.5f, 3.f, 2.f }, { -1.f, 0.25f, 4.f } } };
+        const glm::mat3 gN = glm::make_mat3(N[0].data());
+        const float d3 = lm::mat_determinant(N);
+        REQUIRE(d3 == Approx(glm::determinant(gN)).epsilon(1e-6));
+
+        const lm::mat3 adj3 = lm::mat_adjugate(N);
+        const glm::mat3 gadj3 = glm::inverse(gN) * glm::determinant(gN);
+        for (int c = 0; c < 3; ++c)
+            for (int r = 0; r < 3; ++r)
+                REQUIRE(adj3[c][r] == Approx(gadj3[c][r]).margin(1e-5));
+
+        // 8- and 4-wide blocks plus a scalar tail
+        const std::size_t n = 23;
+        std::vector<lm::mat4> ms(n);
+        std::vector<lm::mat3> ns(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            const float t = 0.37f * float(i);
+            ms[i] = lm::mat4_mul(lm::mat4_rotate_z(t), lm::mat4_scale(1.f + t, 0.5f, 2.f - 0.1f * t));
+            ms[i][1][3] = 0.05f * t;
+            for (int c = 0; c < 3; ++c)
+                for (int r = 0; r < 3; ++r)
+                    ns[i][c][r] = ms[i][c][r] + 0.125f * float(c - r);
+        }
+
+        std::vector<float> d4s(n), d3s(n);
+        lm::mat_determinant_batch(ms.data(), d4s.data(), n);
+        lm::mat_determinant_batch(ns.data(), d3s.data(), n);
+        for (std::size_t i = 0; i < n; ++i) {
+            REQUIRE(byte_equal(d4s[i], lm::mat4_determinant_scalar(ms[i])));
+            REQUIRE(byte_equal(d3s[i], lm::mat_determinant(ns[i])));
+        }
+    }
+
+    TEST_CASE("mat4 * vec4 batch equals single calls", "[mat4][vec4][batch][simd]") {
+        const lm::mat4 M = lm::mat4_mul(lm::mat4_rotate_x(0.7f),
+                                        lm::mat4_translate(1.f, -2.f, 3.f));
 
+        // odd count: exercises the unrolled body and every tail path
+        constexpr std::size_t n = 37;
+        lm::vec4 in[n]{}, out[n]{}, out_scalar[n]{};
+        for (std::size_t i = 0; i < n; ++i)
+            in[i] = { 0.25f * float(i), -1.5f + float(i), 3.f / float(i + 1), 1.f };
+
+        lm::mat4_mul_vec_batch(M, in, out, n);
+        lm::mat4_mul_vec_batch_scalar(M, in, out_scalar, n);
+
+        for (std::size_t i = 0; i < n; ++i) {
+            REQUIRE(byte_equal(out[i], lm::mat4_mul_vec(M, in[i])));
+            REQUIRE(byte_equal(out_scalar[i], lm::mat4_mul_vec_scalar(M, in[i])));
+        }
+
+        // in place
+        lm::mat4_mul_vec_batch(M, in, in, n);
+        REQUIRE(std::memcmp(in, out, sizeof(in)) == 0);
+    }
+
+    TEST_CASE("mat4 packed vec3 point/dir transforms", "[mat4][vec3][batch][simd]") {
+        const lm::mat4 M = lm::mat4_mul(lm::mat4_rotate_y(1.1f),
+                                        lm::mat4_translate(-4.f, 0.5f, 2.f));
+
+        // 8-wide and 4-wide blocks plus a scalar tail
+        constexpr std::size_t n = 23;
+        lm::vec3 in[n]{}, pts[n]{}, dirs[n]{}, pts_scalar[n]{}, dirs_scalar[n]{};
+        for (std::size_t i = 0; i < n; ++i)
+            in[i] = { 1.f + float(i), -0.5f * float(i), 2.f / float(i + 1) };
+
+        lm::mat4_transform_points(M, in, pts, n);
+        lm::mat4_transform_dirs(M, in, dirs, n);
+        lm::mat4_transform_points_scalar(M, in, pts_scalar, n);
+        lm::mat4_transform_dirs_scalar(M, in, dirs_scalar, n);
+
+        REQUIRE(std::memcmp(pts, pts_scalar, sizeof(pts)) == 0);
+        REQUIRE(std::memcmp(dirs, dirs_scalar, sizeof(dirs)) == 0);
+
+        for (std::size_t i = 0; i < n; ++i) {
+            const lm::vec4 p = lm::mat4_mul_vec_scalar(M, { in[i][0], in[i][1], in[i][2], 1.f });
+            const lm::vec4 d = lm::mat4_mul_vec_scalar(M, { in[i][0], in[i][1], in[i][2], 0.f });
+            for (int k = 0; k < 3; ++k) {
+                REQUIRE(pts[i][k]  == Approx(p[k]).margin(1e-5f));
+                REQUIRE(dirs[i][k] == Approx(d[k]).margin(1e-5f));
+            }
+        }
+
+        // in place, and no write past n
+        lm::vec3 buf[n + 1]{};
+        std::memcpy(buf, in, sizeof(in));
+        buf[n] = { 42.f, 42.f, 42.f };
+        lm::mat4_transform_points(M, buf, buf, n);
+        REQUIRE(std::memcmp(buf, pts, sizeof(pts)) == 0);
+        REQUIRE(buf[n] == lm::vec3{ 42.f, 42.f, 42.f });
+    }
+
+    TEST_CASE("mat4 * mat4 batch equals single calls", "[mat4][batch][simd]") {
+        const lm::mat4 P = lm::mat4_mul(lm::mat4_rotate_z(0.3f), lm::mat4_translate(2.f, 1.f, -1.f));
+
+        // odd count: pairs plus a single-matrix tail
+        constexpr std::size_t n = 11;
+        lm::mat4 A[n]{}, B[n]{}, ref[n]{}, ref_left[n]{}, out[n]{};
+        for (std::size_t i = 0; i < n; ++i) {
+            const float t = 0.2f * float(i);
+            A[i] = lm::mat4_mul(lm::mat4_rotate_y(t), lm::mat4_translate(t, -1.f, 2.f - t));
+            B[i] = lm::mat4_mul(lm::mat4_rotate_x(1.f - t), lm::mat4_scale(1.f + t, 0.5f, 3.f));
+            ref[i] = lm::mat4_mul(A[i], B[i]);
+            ref_left[i] = lm::mat4_mul(P, B[i]);
+        }
+
+        lm::mat4_mul_batch(A, B, out, n);
+        REQUIRE(std::memcmp(out, ref, sizeof(out)) == 0);
+        lm::mat4_mul_batch_left(P, B, out, n);
+        REQUIRE(std::memcmp(out, ref_left, sizeof(out)) == 0);
+
+        lm::mat4_mul_batch_scalar(A, B, out, n);
+        for (std::size_t i = 0; i < n; ++i)
+            REQUIRE(byte_equal(out[i], lm::mat4_mul_scalar(A[i], B[i])));
+
+        // streaming: aligned output takes non-temporal stores, misaligned
+        // output falls back to cached ones; same values either way
+        alignas(64) float buf[(n + 1) * 16]{};
+        lm::mat4* aligned = reinterpret_cast<lm::mat4*>(buf);
+        lm::mat4* misaligned = reinterpret_cast<lm::mat4*>(buf + 1);
+        for (lm::mat4* dst : { aligned, misaligned }) {
+            lm::mat4_mul_batch(A, B, dst, n, lm::store_mode::streaming);
+            REQUIRE(std::memcmp(dst, ref, sizeof(ref)) == 0);
+            lm::mat4_mul_batch_left(P, B, dst, n, lm::store_mode::streaming);
+            REQUIRE(std::memcmp(dst, ref_left, sizeof(ref_left)) == 0);
+        }
+
+        // in place on either operand; the left operand may live in `out`
+        std::memcpy(out, B, sizeof(B));
+        lm::mat4_mul_batch(A, out, out, n);
+        REQUIRE(std::memcmp(out, ref, sizeof(out)) == 0);
+        std::memcpy(out, A, sizeof(A));
+        lm::mat4_mul_batch(out, B, out, n);
+        REQUIRE(std::memcmp(out, ref, sizeof(out)) == 0);
+        std::memcpy(out, B, sizeof(B));
+        out[0] = P;
+        lm::mat4_mul_batch_left(out[0], B, out, n);
+        REQUIRE(std::memcmp(out, ref_left, sizeof(out)) == 0);
+    }
+
+
+
+    template<typename T>
+    void check_bvh_queries(const T& tree, const std::vector<lm::vec3>& tri,
+                           const std::vector<lm::aabb3>& box, const std::vector<lm::ray3>& rays,
+                           const std::vector<lm::aabb3>& queries) {
+        for (const lm::ray3& R : rays) {
+            float ref = 1e30f, t = 1e30f;
+            for (std::size_t k = 0; k < box.size(); ++k)
+                lm::ray_triangle(R, tri[3 * k], tri[3 * k + 1], tri[3 * k + 2], ref);
+            const std::uint32_t p = lm::bvh_intersect(tree, tri.data(), R, t);
+            REQUIRE(std::memcmp(&ref, &t, sizeof(float)) == 0);
+            if (p != lm::bvh_none) {
+                // ties may pick either triangle, but at the same distance
+                float tp = 1e30f;
+                REQUIRE(lm::ray_triangle(R, tri[3 * p], tri[3 * p + 1], tri[3 * p + 2], tp));
+                REQUIRE(tp == t);
+            } else {
+                REQUIRE(ref == 1e30f);
+            }
+        }
+
+        std::vector<std::uint32_t> got(box.size()), want;
+        for (const lm::aabb3& Q : queries) {
+            want.clear();
+            for (std::size_t k = 0; k < box.size(); ++k)
+                if (lm::aabb_overlaps(Q, box[k]))
+                    want.push_back(std::uint32_t(k));
+            const std::size_t n = lm::bvh_overlap(tree, box.data(), Q, got.data(), got.size());
+            REQUIRE(n == want.size());
+            std::sort(got.begin(), got.begin() + n);
+            REQUIRE(std::equal(want.begin(), want.end(), got.begin()));
+            // cap limits the writes, not the count
+            REQUIRE(lm::bvh_overlap(tree, box.data(), Q, got.data(), 1) == n);
+        }
+    }
+
+    TEST_CASE("BVH build, wide collapse and ray / box queries match brute force", "[bvh][ray][bounds][pool]") {
+        std::uint32_t seed = 11u;
+        auto rnd = [&seed](float lo, float hi) {
+            seed = seed * 1664525u + 1013904223u;
+            return lo + (hi - lo) * float(seed >> 8) * (1.f / 16777216.f);
+        };
+        // enough triangles for several parallel build jobs
+        constexpr std::size_t n = 20000;
+        std::vector<lm::vec3> tri(3 * n);
+        for (std::size_t i = 0; i < n; ++i) {
+            const lm::vec3 c{ rnd(-20.f, 20.f), rnd(-20.f, 20.f), rnd(-5.f, 5.f) };
+            for (std::size_t j = 0; j < 3; ++j)
+                tri[3 * i + j] = { c[0] + rnd(-.5f, .5f), c[1] + rnd(-.5f, .5f), c[2] + rnd(-.5f, .5f) };
+        }
+        for (std::size_t j = 0; j < 3; ++j)   // a duplicate, for ties
+            tri[3 * (n - 1) + j] = tri[j];
+        std::vector<lm::aabb3> box(n);
+        lm::bvh_triangle_bounds(tri.data(), n, box.data());
+
+        std::vector<lm::bvh_node> nodes(lm::bvh_node_capacity(n));
+        std::vector<std::uint32_t> prims(n);
+        const std::size_t count = lm::bvh_build(box.data(), n, nodes.data(), prims.data());
+        REQUIRE(count > 1);
+        REQUIRE(count <= 2 * n - 1);
+        const lm::bvh tree{ nodes.data(), prims.data(), count };
+
+        // every prim in exactly one leaf; children inside their parent
+        std::vector<int> seen(n, 0);
+        std::size_t leaves = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            const lm::bvh_node& N = nodes[i];
+            const lm::aabb3 B{ N.lo, N.hi };
+            if (N.count) {
+                ++leaves;
+                REQUIRE(N.first + N.count <= n);
+                for (std::uint32_t k = N.first; k < N.first + N.count; ++k) {
+                    ++seen[prims[k]];
+                    REQUIRE(lm::aabb_contains(B, box[prims[k]]));
+                }
+            } else {
+                REQUIRE(N.first > i);
+                REQUIRE(N.first + 1 < count);
+                REQUIRE(lm::aabb_contains(B, lm::aabb3{ nodes[N.first].lo, nodes[N.first].hi }));
+                REQUIRE(lm::aabb_contains(B, lm::aabb3{ nodes[N.first + 1].lo, nodes[N.first + 1].hi }));
+            }
+        }
+        REQUIRE(std::all_of(seen.begin(), seen.end(), [](int s) { return s == 1; }));
+        REQUIRE(count == 2 * leaves - 1);
+
+#if !defined(LMATH_FREESTANDING)
+        // same tree on a pool, bit for bit
+        lm::thread_pool threads(4);
+        std::vector<lm::bvh_node> pnodes(nodes.size());
+        std::vector<std::uint32_t> pprims(n);
+        REQUIRE(lm::bvh_build(box.data(), n, pnodes.data(), pprims.data(), threads.pool()) == count);
+        REQUIRE(std::memcmp(nodes.data(), pnodes.data(), count * sizeof(lm::bvh_node)) == 0);
+        REQUIRE(pprims == prims);
+#endif
+
+        std::vector<lm::bvh_wide_node<4>> w4(count / 2 + 1);
+        std::vector<lm::bvh_wide_node<8>> w8(count / 2 + 1);
+        const lm::bvh4 tree4{ w4.data(), prims.data(), lm::bvh_collapse<4>(tree, w4.data()) };
+        const lm::bvh8 tree8{ w8.data(), prims.data(), lm::bvh_collapse<8>(tree, w8.data()) };
+        REQUIRE(tree8.node_count < tree4.node_count);
+        REQUIRE(tree4.node_count < count / 2);
+
+        std::vector<lm::ray3> rays(256);
+        for (lm::ray3& r : rays) {
+            r.o = { rnd(-25.f, 25.f), rnd(-25.f, 25.f), rnd(10.f, 20.f) };
+            r.d = { rnd(-1.f, 1.f), rnd(-1.f, 1.f), -1.f };
+        }
+        rays[0].o = tri[0];                       // starts on a triangle
+        rays[1].d = { 0.f, 0.f, -1.f };           // axis-aligned
+        rays[2].d = { 0.f, 0.f, 1.f };            // points away: misses
+        rays[3] = { lm::aabb_center(box[0]), { 0.f, 0.f, -1.f } };
+        rays[3].o[2] = 30.f;                      // hits the duplicated triangle
+        std::vector<lm::aabb3> queries(64);
+        for (lm::aabb3& Q : queries) {
+            const lm::vec3 c{ rnd(-22.f, 22.f), rnd(-22.f, 22.f), rnd(-6.f, 6.f) };
+            const lm::vec3 e{ rnd(0.f, 3.f), rnd(0.f, 3.f), rnd(0.f, 3.f) };
+            Q = { lm::vec_sub(c, e), lm::vec_add(c, e) };
+        }
+        queries[0] = { { 100.f, 100.f, 100.f }, { 101.f, 101.f, 101.f } };  // empty result
+        queries[1] = { { -30.f, -30.f, -30.f }, { 30.f, 30.f, 30.f } };      // everything
+
+        check_bvh_queries(tree, tri, box, rays, queries);
+        check_bvh_queries(tree4, tri, box, rays, queries);
+        check_bvh_queries(tree8, tri, box, rays, queries);
+
+        // degenerate input: identical boxes still split down to small leaves
+        std::vector<lm::aabb3> same(100, lm::aabb3{ { 1.f, 1.f, 1.f }, { 2.f, 2.f, 2.f } });
+        const std::size_t c2 = lm::bvh_build(same.data(), same.size(), nodes.data(), prims.data());
+        for (std::size_t i = 0; i < c2; ++i)
+            REQUIRE(nodes[i].count <= lm::bvh_max_leaf);
+        REQUIRE(lm::bvh_build(box.data(), 0, nodes.data(), prims.data()) == 0);
+        float t = 1.f;
+        REQUIRE(lm::bvh_intersect(lm::bvh{}, tri.data(), rays[0], t) == lm::bvh_none);
+    }
+
+    TEST_CASE("worker pools run every task once", "[pool]") {
+        constexpr std::size_t n = 1000;
+        std::vector<int> hits(n, 0);
+        auto count = [](void* ctx, std::size_t task) { ++static_cast<int*>(ctx)[task]; };
+
+        const lm::worker_pool serial = lm::serial_pool();
+        REQUIRE(serial.workers == 1);
+        serial.run(serial.self, n, count, hits.data());
+        for (std::size_t i = 0; i < n; ++i)
+            REQUIRE(hits[i] == 1);
+
+#if !defined(LMATH_FREESTANDING)
+        lm::thread_pool threads(4);
+        const lm::worker_pool pool = threads.pool();
+        REQUIRE(pool.workers == 4);
+        for (int rep = 0; rep < 50; ++rep)
+            pool.run(pool.self, n, count, hits.data());
+        pool.run(pool.self, 0, count, hits.data());
+        for (std::size_t i = 0; i < n; ++i)
+            REQUIRE(hits[i] == 51);
+#endif
+    }
+
+    TEST_CASE("par::parallel_for blocks and batch kernels on a pool", "[par][pool][batch]") {
+        // whole cache lines per block
+        REQUIRE(lm::par::block_for<lm::vec3>() % 16 == 0);
+        REQUIRE(lm::par::block_for<lm::vec4>() % 4 == 0);
+        REQUIRE(lm::par::block_for<float>(1) == 16);
+        REQUIRE(lm::par::block_for<lm::mat4>(1) == 1);
+        REQUIRE(lm::par::block_for<lm::vec3>() * sizeof(lm::vec3) >= lm::par::default_block_bytes);
+
+#if !defined(LMATH_FREESTANDING)
+        lm::thread_pool threads(4);
+        const lm::worker_pool pool = threads.pool();
+#else
+        const lm::worker_pool pool = lm::serial_pool();
+#endif
+
+        // every element exactly once, blocks in order, uneven work per block
+        constexpr std::size_t n = 100003;
+        std::vector<int> hits(n, 0);
+        for (std::size_t block : { std::size_t(1), std::size_t(7), std::size_t(4096), n, 2 * n }) {
+            std::fill(hits.begin(), hits.end(), 0);
+            // Catch isn't thread-safe; count misplaced blocks instead
+            std::atomic<int> misplaced{ 0 };
+            lm::par::parallel_for(pool, n, block, [&](std::size_t b, std::size_t e) {
+                if (b % block != 0 || e - b > block || e <= b)
+                    misplaced.fetch_add(1, std::memory_order_relaxed);
+                volatile float spin = 0.f;
+                if ((b / block) % 3 == 0)
+                    for (int k = 0; k < 200; ++k) spin = spin + 1.f;
+                for (std::size_t i = b; i < e; ++i) ++hits[i];
+            });
+            REQUIRE(misplaced.load() == 0);
+            REQUIRE(std::count(hits.begin(), hits.end(), 1) == std::ptrdiff_t(n));
+        }
+        bool ran = false;
+        lm::par::parallel_for(pool, 0, 16, [&](std::size_t, std::size_t) { ran = true; });
+        REQUIRE_FALSE(ran);
+
+        // pooled batch kernels equal the single-threaded ones
+        const std::size_t m = 3 * lm::par::block_for<lm::vec3>() + 5;
+        const lm::mat4 M = lm::mat4_mul(lm::mat4_translate(1.f, -2.f, 0.5f), lm::mat4_rotate_z(0.8f));
+        std::vector<lm::vec3> in3(m), ref3(m), out3(m);
+        std::vector<lm::vec4> in4(m), ref4(m), out4(m);
+        for (std::size_t i = 0; i < m; ++i) {
+            in3[i] = { float(i), 0.5f - float(i % 7), 0.01f * float(i) };
+            in4[i] = { in3[i][0], in3[i][1], in3[i][2], float(i % 2) };
+        }
+
+        lm::mat4_transform_points(M, in3.data(), ref3.data(), m);
+        lm::mat4_transform_points(M, in3.data(), out3.data(), m, pool);
+        REQUIRE(std::memcmp(ref3.data(), out3.data(), m * sizeof(lm::vec3)) == 0);
+        lm::mat4_transform_dirs(M, in3.data(), ref3.data(), m);
+        lm::mat4_transform_dirs(M, in3.data(), out3.data(), m, pool);
+        REQUIRE(std::memcmp(ref3.data(), out3.data(), m * sizeof(lm::vec3)) == 0);
+        lm::vec3_norm_batch(in3.data(), ref3.data(), m);
+        lm::vec3_norm_batch(in3.data(), out3.data(), m, pool);
+        REQUIRE(std::memcmp(ref3.data(), out3.data(), m * sizeof(lm::vec3)) == 0);
+
+        lm::mat4_mul_vec_batch(M, in4.data(), ref4.data(), m);
+        lm::mat4_mul_vec_batch(M, in4.data(), out4.data(), m, pool);
+        REQUIRE(std::memcmp(ref4.data(), out4.data(), m * sizeof(lm::vec4)) == 0);
+        lm::vec4_norm_batch(in4.data(), ref4.data(), m);
+        lm::vec4_norm_batch(in4.data(), out4.data(), m, pool);
+        REQUIRE(std::memcmp(ref4.data(), out4.data(), m * sizeof(lm::vec4)) == 0);
+
+        const std::size_t k = 2 * lm::par::block_for<lm::mat4>() + 3;
+        std::vector<lm::mat4> A(k), B(k), refm(k), outm(k);
+        for (std::size_t i = 0; i < k; ++i) {
+            A[i] = lm::mat4_mul(M, lm::mat4_rotate_x(0.001f * float(i)));
+            B[i] = lm::mat4_translate(float(i), 1.f, -1.f);
+        }
+        lm::mat4_mul_batch(A.data(), B.data(), refm.data(), k);
+        lm::mat4_mul_batch(A.data(), B.data(), outm.data(), k, pool);
+        REQUIRE(std::memcmp(refm.data(), outm.data(), k * sizeof(lm::mat4)) == 0);
+        lm::mat4_mul_batch_left(M, B.data(), refm.data(), k);
+        lm::mat4_mul_batch_left(M, B.data(), outm.data(), k, pool, lm::store_mode::streaming);
+        REQUIRE(std::memcmp(refm.data(), outm.data(), k * sizeof(lm::mat4)) == 0);
+    }
+
+    TEST_CASE("hierarchy sort and world-matrix update", "[hierarchy][mat4]") {
+        // random forest in topological order (parent before child), wide
+        // enough that levels get split across the pool, then shuffled so
+        // hierarchy_sort has to find the levels itself
+        constexpr std::size_t n = 20000;
+        std::vector<std::uint32_t> topo_parent(n), perm(n), in_parent(n);
+        std::uint32_t seed = 12345u;
+        auto rnd = [&seed] { seed = seed * 1664525u + 1013904223u; return seed >> 8; };
+        for (std::size_t i = 0; i < n; ++i) {
+            topo_parent[i] = i < 3 ? lm::hierarchy_root : std::uint32_t(rnd() % ((i + 7) / 8));
+            perm[i] = std::uint32_t(i);
+        }
+        for (std::size_t i = n - 1; i > 0; --i)
+            std::swap(perm[i], perm[rnd() % (i + 1)]);
+        for (std::size_t i = 0; i < n; ++i)
+            in_parent[perm[i]] = topo_parent[i] == lm::hierarchy_root ? lm::hierarchy_root
+                                                                      : perm[topo_parent[i]];
+
+        std::vector<lm::mat4> in_local(n), ref(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            const float t = 0.001f * float(i);
+            in_local[perm[i]] = lm::mat4_mul(lm::mat4_translate(t, 1.f, -t), lm::mat4_rotate_y(0.3f + t));
+        }
+        auto reference = [&] {
+            for (std::size_t i = 0; i < n; ++i) {
+                const std::uint32_t p = topo_parent[i];
+                ref[perm[i]] = p == lm::hierarchy_root ? in_local[perm[i]]
+                                                       : lm::mat4_mul(ref[perm[p]], in_local[perm[i]]);
+            }
+        };
+        reference();
+
+        std::vector<std::uint32_t> order(n), parent(n), level(n + 1), scratch(2 * n + 1);
+        const std::size_t levels = lm::hierarchy_sort(in_parent.data(), n, order.data(), parent.data(),
+                                                      level.data(), scratch.data());
+        REQUIRE(levels > 3);
+        REQUIRE(level[0] == 0);
+        REQUIRE(level[levels] == n);
+        REQUIRE(level[1] == 3);
+        for (std::size_t l = 1; l < levels; ++l)
+            for (std::size_t k = level[l]; k < level[l + 1]; ++k) {
+                // parent in the previous level, siblings grouped by parent
+                REQUIRE((parent[k] >= level[l - 1] && parent[k] < level[l]));
+                if (k > level[l])
+                    REQUIRE(parent[k - 1] <= parent[k]);
+            }
+
+        std::vector<lm::mat4> local(n), world(n), world_threads(n);
+        for (std::size_t k = 0; k < n; ++k)
+            local[k] = in_local[order[k]];
+
+        lm::hierarchy H{ parent.data(), local.data(), world.data(), nullptr, level.data(), levels };
+        lm::hierarchy_update(H, lm::serial_pool());
+        for (std::size_t k = 0; k < n; ++k)
+            REQUIRE(byte_equal(world[k], ref[order[k]]));
+
+#if !defined(LMATH_FREESTANDING)
+        lm::thread_pool threads(4);
+        lm::hierarchy Ht = H;
+        Ht.world = world_threads.data();
+        lm::hierarchy_update(Ht, threads.pool());
+        REQUIRE(std::memcmp(world.data(), world_threads.data(), n * sizeof(lm::mat4)) == 0);
+        lm::hierarchy_update(Ht);
+        REQUIRE(std::memcmp(world.data(), world_threads.data(), n * sizeof(lm::mat4)) == 0);
+#endif
+
+        // incremental: change a root, an inner node and the last node;
+        // only they and their descendants may be written
+        std::vector<std::uint8_t> dirty(n, 0);
+        const std::size_t changed[] = { 1, level[2] + 5, n - 1 };
+        for (std::size_t k : changed) {
+            in_local[order[k]] = lm::mat4_mul(in_local[order[k]], lm::mat4_rotate_x(0.5f));
+            local[k] = in_local[order[k]];
+            dirty[k] = 1;
+        }
+        reference();
+
+        std::vector<std::uint8_t> affected(n, 0);
+        for (std::size_t k : changed) affected[k] = 1;
+        for (std::size_t k = level[1]; k < n; ++k)
+            affected[k] = affected[k] | affected[parent[k]];
+
+        // ancestors of changed nodes are read, everything else is poisoned
+        std::vector<std::uint8_t> read(n, 0);
+        for (std::size_t k = n; k-- > level[1];)
+            if (affected[k] || read[k]) read[parent[k]] = 1;
+
+        const lm::mat4 poison = lm::mat4_scale(-7.f, -7.f, -7.f);
+        for (std::size_t k = 0; k < n; ++k)
+            if (!affected[k] && !read[k]) world[k] = poison;
+
+        H.dirty = dirty.data();
+        lm::hierarchy_update(H);
+        for (std::size_t k = 0; k < n; ++k) {
+            REQUIRE(dirty[k] == 0);
+            if (affected[k] || read[k])
+                REQUIRE(byte_equal(world[k], ref[order[k]]));
+            else
+                REQUIRE(byte_equal(world[k], poison));
+        }
+
+        // a cycle can't be ordered
+        const std::uint32_t cyclic[] = { lm::hierarchy_root, 2, 1 };
+        REQUIRE(lm::hierarchy_sort(cyclic, 3, order.data(), parent.data(), level.data(), scratch.data()) == 0);
+    }
+
+#if !defined(LMATH_FORCE_NO_SIMD)
+    TEST_CASE("dispatch table kernels match entry points", "[dispatch][simd]") {
+        const lm::mat4 A = lm::mat4_mul(lm::mat4_rotate_z(0.3f), lm::mat4_translate(2.f, 1.f, -1.f));
+        const lm::mat4 B = lm::mat4_rotate_x(-1.2f);
+        const lm::vec4 v = { 0.5f, -2.f, 3.25f, 1.f };
+
+        constexpr std::size_t n = 13;
+        lm::vec4 in4[n]{}, out4[n]{}, ref4[n]{};
+        lm::vec3 in3[n]{}, pts[n]{}, dirs[n]{}, ref_pts[n]{}, ref_dirs[n]{};
+        for (std::size_t i = 0; i < n; ++i) {
+            in4[i] = { float(i), 1.f - float(i), 0.5f * float(i), 1.f };
+            in3[i] = { float(i), 2.f, -0.25f * float(i) };
+        }
+
+        // the cached table is the one the entry points use
+        const lm::simd::dispatch_table& t = lm::simd::dispatch();
+        REQUIRE(t.level == lm::simd::max_level());
+        REQUIRE(byte_equal(t.mat4_mul(A, B), lm::mat4_mul(A, B)));
+        REQUIRE(byte_equal(t.mat4_mul_vec(A, v), lm::mat4_mul_vec(A, v)));
+        REQUIRE(t.vec4_dot(v, in4[3]) == lm::vec4_dot(v, in4[3]));
+        REQUIRE(t.rsqrtf(7.f) == lm::rsqrtf(7.f));
+        REQUIRE(t.rsqrtf(0.f) == 0.f);
+
+        lm::mat4_mul_vec_batch_scalar(A, in4, ref4, n);
+        lm::mat4_transform_points_scalar(A, in3, ref_pts, n);
+        lm::mat4_transform_dirs_scalar(A, in3, ref_dirs, n);
+
+        // every level this CPU can run agrees with scalar
+        const lm::simd::Level levels[] = {
+            lm::simd::Level::none, lm::simd::Level::neon, lm::simd::Level::sse2,
+            lm::simd::Level::avx, lm::simd::Level::avx2,
+        };
+        for (lm::simd::Level lvl : levels) {
+            if (int(lvl) > int(lm::simd::max_level())) continue;
+            const lm::simd::dispatch_table r = lm::simd::resolve_dispatch(lvl);
+
+            const lm::mat4 M = r.mat4_mul(A, B);
+            const lm::mat4 M_ref = lm::mat4_mul_scalar(A, B);
+            for (int c = 0; c < 4; ++c)
+                for (int k = 0; k < 4; ++k)
+                    REQUIRE(M[c][k] == Approx(M_ref[c][k]).margin(1e-5f));
+
+            r.mat4_mul_vec_batch(A, in4, out4, n);
+            r.mat4_transform_points(A, in3, pts, n);
+            r.mat4_transform_dirs(A, in3, dirs, n);
+            for (std::size_t i = 0; i < n; ++i)
+                for (int k = 0; k < 3; ++k) {
+                    REQUIRE(out4[i][k] == Approx(ref4[i][k]).margin(1e-5f));
+                    REQUIRE(pts[i][k]  == Approx(ref_pts[i][k]).margin(1e-5f));
+                    REQUIRE(dirs[i][k] == Approx(ref_dirs[i][k]).margin(1e-5f));
+                }
+
+            // batches match the level's own single-call kernel
+            const lm::mat4 As[3] = { A, B, M };
+            const lm::mat4 Bs[3] = { B, M, A };
+            lm::mat4 Ms[3]{};
+            r.mat4_mul_batch(As, Bs, Ms, 3, lm::store_mode::cached);
+            for (int i = 0; i < 3; ++i)
+                REQUIRE(byte_equal(Ms[i], r.mat4_mul(As[i], Bs[i])));
+            r.mat4_mul_batch_left(A, Bs, Ms, 3, lm::store_mode::streaming);
+            for (int i = 0; i < 3; ++i)
+                REQUIRE(byte_equal(Ms[i], r.mat4_mul(A, Bs[i])));
+
+            REQUIRE(r.vec4_dot(v, in4[5]) == Approx(lm::vec_dot(v, in4[5])));
+            REQUIRE(r.rsqrtf(4.f) == Approx(0.5f).epsilon(1e-5f));
+        }
+    }
+#endif
+
+#if defined(__AVX512F__) && !defined(LMATH_FORCE_NO_SIMD)
+    TEST_CASE("AVX-512 kernels equal scalar / AVX paths", "[mat4][vec4][avx512][simd]") {
+        if (lm::simd::max_level() != lm::simd::Level::avx512)
+            return; // built for AVX-512, running elsewhere
+
+        const lm::mat4 A = lm::mat4_mul(lm::mat4_rotate_y(0.4f), lm::mat4_translate(3.f, -1.f, 0.5f));
+        const lm::mat4 B = lm::mat4_mul(lm::mat4_rotate_x(1.3f), lm::mat4_translate(-2.f, 4.f, 1.f));
+
+        // pairwise adds like the SSE2/AVX kernels; the scalar path sums left to right
+        REQUIRE(byte_equal(lm::detail::mat4_mul_avx512(A, B), lm::detail::mat4_mul_avx(A, B)));
+        REQUIRE(byte_equal(lm::detail::mat4_mul_avx512(A, B), lm::detail::mat4_mul_sse2(A, B)));
+        REQUIRE(mat4_approx_equal(lm::detail::mat4_mul_avx512(A, B), lm::mat4_mul_scalar(A, B)));
+
+        // every count up to two full 8-blocks, so each tail path runs
+        constexpr std::size_t max_n = 19;
+        lm::vec4 in[max_n]{}, out[max_n]{}, ref[max_n]{};
+        for (std::size_t i = 0; i < max_n; ++i)
+            in[i] = { 1.f / float(i + 1), float(i) - 7.f, 0.125f * float(i), 1.f };
+
+        for (std::size_t n = 0; n <= max_n; ++n) {
+            std::fill(out, out + max_n, lm::vec4{});
+            std::fill(ref, ref + max_n, lm::vec4{});
+            lm::detail::mat4_mul_vec_batch_avx512(A, in, out, n);
+            lm::detail::mat4_mul_vec_batch_avx(A, in, ref, n);
+            REQUIRE(std::memcmp(out, ref, sizeof(out)) == 0);
+        }
+
+        lm::mat4 As[5]{}, Bs[5]{}, Ms[5]{}, Ms_ref[5]{};
+        for (int i = 0; i < 5; ++i) {
+            As[i] = lm::mat4_mul(A, lm::mat4_rotate_z(0.5f * float(i)));
+            Bs[i] = lm::mat4_mul(lm::mat4_scale(1.f + float(i), 2.f, 0.5f), B);
+        }
+        lm::detail::mat4_mul_batch_avx512(As, Bs, Ms, 5, lm::store_mode::cached);
+        lm::detail::mat4_mul_batch_avx(As, Bs, Ms_ref, 5, lm::store_mode::cached);
+        REQUIRE(std::memcmp(Ms, Ms_ref, sizeof(Ms)) == 0);
+        lm::detail::mat4_mul_batch_left_avx512(A, Bs, Ms, 5, lm::store_mode::cached);
+        lm::detail::mat4_mul_batch_left_sse2(A, Bs, Ms_ref, 5, lm::store_mode::cached);
+        REQUIRE(std::memcmp(Ms, Ms_ref, sizeof(Ms)) == 0);
+    }
+#endif
+
+#if LMATH_HAS_FMA && !defined(LMATH_FORCE_NO_SIMD)
+    TEST_CASE("FMA kernels stay within rounding of mul/add paths", "[mat4][vec4][fma][simd]") {
+        const lm::simd::dispatch_table t = lm::simd::resolve_dispatch(lm::simd::max_level(), true);
+        REQUIRE(t.fma == lm::simd::has_fma());
+        if (!t.fma)
+            return;
+
+        const lm::mat4 A = lm::mat4_mul(lm::mat4_rotate_z(0.9f), lm::mat4_translate(1.5f, -3.f, 2.f));
+        const lm::mat4 B = lm::mat4_mul(lm::mat4_rotate_x(-0.6f), lm::mat4_translate(0.f, 7.f, -1.f));
+        const lm::vec4 v = { 1.25f, -0.5f, 3.f, 1.f };
+        const lm::vec4 u = { -2.f, 0.75f, 1.f / 3.f, 0.5f };
+
+        const lm::mat4 R = t.mat4_mul(A, B);
+        const lm::mat4 R_ref = lm::mat4_mul_scalar(A, B);
+        for (int c = 0; c < 4; ++c)
+            for (int k = 0; k < 4; ++k)
+                REQUIRE(R[c][k] == Approx(R_ref[c][k]).margin(1e-5f));
+
+        const lm::vec4 r = t.mat4_mul_vec(A, v);
+        const lm::vec4 r_ref = lm::mat4_mul_vec_scalar(A, v);
+        for (int k = 0; k < 4; ++k)
+            REQUIRE(r[k] == Approx(r_ref[k]).margin(1e-5f));
+
+        REQUIRE(t.vec4_dot(v, u) == Approx(lm::vec_dot(v, u)).margin(1e-6f));
+    }
+#endif
+
+    TEST_CASE("SoA vec3/vec4 kernels match AoS ops","[soa][vec3][vec4][simd]") {
+        // 8-wide and 4-wide blocks plus a scalar tail
+        constexpr std::size_t n = 19;
+        lm::vec3 a3[n]{}, b3[n]{}, back3[n]{};
+        lm::vec4 a4[n]{}, back4[n]{};
+        for (std::size_t i = 0; i < n; ++i) {
+            a3[i] = { 1.f + float(i), -0.5f * float(i), 3.f / float(i + 1) };
+            b3[i] = { 2.f - float(i), 0.25f * float(i), -1.f };
+            a4[i] = { float(i), -2.f * float(i), 0.5f, 1.f / float(i + 1) };
+        }
+        a3[5] = { 0.f, 0.f, 0.f }; // zero-length for norm
+
+        float ax[n], ay[n], az[n], bx[n], by[n], bz[n], rx[n], ry[n], rz[n];
+        float x4[n], y4[n], z4[n], w4[n], d[n];
+        const lm::vec3_soa A{ { ax, ay, az }, n };
+        const lm::vec3_soa B{ { bx, by, bz }, n };
+        const lm::vec3_soa R{ { rx, ry, rz }, n };
+        const lm::vec4_soa A4{ { x4, y4, z4, w4 }, n };
+
+        lm::vec_soa_from_aos(a3, A);
+        lm::vec_soa_from_aos(b3, B);
+        lm::vec_soa_from_aos(a4, A4);
+
+        SECTION("for_lanes: full blocks, then a 4-wide step, then the scalar tail") {
+            for (std::size_t m : { std::size_t(3), std::size_t(4), std::size_t(7), n }) {
+                lm::detail::with_lanes([&](auto L) {
+                    const std::size_t w = decltype(L)::width;
+                    std::vector<std::size_t> steps;
+                    lm::detail::for_lanes<decltype(L)>(m, [&](auto S, std::size_t i) {
+                        REQUIRE(i == std::accumulate(steps.begin(), steps.end(), std::size_t(0)));
+                        steps.push_back(std::size_t(decltype(S)::width));
+                    });
+                    std::size_t i = 0, k = 0;
+                    for (; i + w <= m; i += w) REQUIRE(steps[k++] == w);
+                    if (w > 4 && i + 4 <= m) { REQUIRE(steps[k++] == 4u); i += 4; }
+                    for (; i < m; ++i) REQUIRE(steps[k++] == 1u);
+                    REQUIRE(k == steps.size());
+                });
+            }
+
+            // vec3x4 / vec4x4 pack ops match the AoS ops on every lane width
+            const lm::vec3x4 P = lm::vec_pack_load<4>(a3), Q = lm::vec_pack_load<4>(b3);
+            const lm::vec3x4 sum = lm::vec_add(P, Q), crs = lm::vec3_cross(P, Q);
+            for (std::size_t i = 0; i < 4; ++i) {
+                const lm::vec3 s_ref = lm::vec_add(a3[i], b3[i]), c_ref = lm::vec3_cross(a3[i], b3[i]);
+                for (std::size_t c = 0; c < 3; ++c) {
+                    REQUIRE(sum.lane[c][i] == s_ref[c]);
+                    REQUIRE(crs.lane[c][i] == c_ref[c]);
+                }
+            }
+        }
+
+        SECTION("transpose round trip") {
+            for (std::size_t i = 0; i < n; ++i) {
+                REQUIRE(ax[i] == a3[i][0]);
+                REQUIRE(az[i] == a3[i][2]);
+                REQUIRE(w4[i] == a4[i][3]);
+            }
+            lm::vec_soa_to_aos(A, back3);
+            lm::vec_soa_to_aos(A4, back4);
+            REQUIRE(std::memcmp(back3, a3, sizeof(a3)) == 0);
+            REQUIRE(std::memcmp(back4, a4, sizeof(a4)) == 0);
+        }
+
+        SECTION("add / sub / min / max / scale / cross") {
+            lm::vec_soa_add(A, B, R);
+            lm::vec_soa_to_aos(R, back3);
+            for (std::size_t i = 0; i < n; ++i) REQUIRE(byte_equal(back3[i], a3[i] + b3[i]));
+
+            lm::vec_soa_sub(A, B, R);
+            lm::vec_soa_to_aos(R, back3);
+            for (std::size_t i = 0; i < n; ++i) REQUIRE(byte_equal(back3[i], a3[i] - b3[i]));
+
+            lm::vec_soa_min(A, B, R);
+            lm::vec_soa_to_aos(R, back3);
+            for (std::size_t i = 0; i < n; ++i) REQUIRE(byte_equal(back3[i], lm::vec_min(a3[i], b3[i])));
+
+            lm::vec_soa_max(A, B, R);
+            lm::vec_soa_to_aos(R, back3);
+            for (std::size_t i = 0; i < n; ++i) REQUIRE(byte_equal(back3[i], lm::vec_max(a3[i], b3[i])));
+
+            lm::vec_soa_scale(A, 1.5f, R);
+            lm::vec_soa_to_aos(R, back3);
+            for (std::size_t i = 0; i < n; ++i) REQUIRE(byte_equal(back3[i], a3[i] * 1.5f));
+
+            lm::vec3_soa_cross(A, B, R);
+            lm::vec_soa_to_aos(R, back3);
+            for (std::size_t i = 0; i < n; ++i) REQUIRE(byte_equal(back3[i], lm::vec3_cross(a3[i], b3[i])));
+        }
+
+        SECTION("dot / norm") {
+            lm::vec_soa_dot(A, B, d, n);
+            for (std::size_t i = 0; i < n; ++i) REQUIRE(d[i] == lm::vec_dot(a3[i], b3[i]));
+
+            lm::vec_soa_dot(A4, A4, d, n);
+            for (std::size_t i = 0; i < n; ++i) REQUIRE(d[i] == lm::vec_dot(a4[i], a4[i]));
+
+            lm::vec_soa_norm(A, R);
+            lm::vec_soa_to_aos(R, back3);
+            for (std::size_t i = 0; i < n; ++i) {
+                const lm::vec3 ref = lm::vec3_norm(a3[i]);
+                for (int k = 0; k < 3; ++k)
+                    REQUIRE(back3[i][k] == Approx(ref[k]).margin(1e-6f));
+            }
+            REQUIRE(back3[5] == lm::vec3{});
+        }
+
+        SECTION("vec3x8 / vec3x4 packs") {
+            const lm::vec3x8 P = lm::vec_pack_load<8>(a3);
+            const lm::vec3x8 Q = lm::vec_pack_load<8>(b3);
+            const lm::vec3x8 S = lm::vec_add(P, Q);
+            const lm::vec<float, 8> D = lm::vec_dot(P, Q);
+            lm::vec_pack_store(lm::vec3_cross(P, Q), back3);
+            for (std::size_t i = 0; i < 8; ++i) {
+                REQUIRE(S[0][i] == a3[i][0] + b3[i][0]);
+                REQUIRE(D[i] == lm::vec_dot(a3[i], b3[i]));
+                REQUIRE(byte_equal(back3[i], lm::vec3_cross(a3[i], b3[i])));
+            }
+
+            const lm::vec3x4 P4 = lm::vec_pack_load<4>(a3 + 8);
+            const lm::vec3x4 N4 = lm::vec_norm(P4);
+            REQUIRE(N4[1][2] == Approx(lm::vec3_norm(a3[10])[1]).margin(1e-6f));
+
+            // a const pack gives a read-only view
+            const lm::vec_soa_const<3> V = lm::vec_soa_view(P4);
+            static_assert(std::is_same<decltype(V[0]), const float*>::value, "read-only view");
+            lm::vec_soa_to_aos(V, back3);
+            for (std::size_t i = 0; i < 4; ++i) REQUIRE(byte_equal(back3[i], a3[8 + i]));
+        }
+    }
+
+    TEST_CASE("vec3/vec4 norm batch matches scalar norm","[soa][vec3][vec4][simd]") {
+        // 8-wide and 4-wide blocks plus a scalar tail
+        constexpr std::size_t n = 37;
+        lm::vec3 a3[n]{}, r3[n]{}, s3[n]{};
+        lm::vec4 a4[n]{}, r4[n]{}, s4[n]{};
+        for (std::size_t i = 0; i < n; ++i) {
+            const float f = float(i);
+            a3[i] = { 1.f + f, -0.5f * f, 3.f / (f + 1.f) };
+            a4[i] = { f - 7.f, 1e3f * f, -0.125f, 1.f / (f + 1.f) };
+        }
+        a3[0] = {};  a3[9] = {};  a3[n - 1] = {};   // zero-length in every path
+        a4[3] = {};  a4[12] = {}; a4[n - 2] = {};
+        a3[20] = { 1e-24f, -2e-25f, 3e-24f };        // len2 underflows to zero
+        a4[21] = { 1e17f, -3e17f, 2e16f, 5e17f };    // len2 still finite
+
+        // ulp of the float nearest to `ref`
+        auto ulp = [](float ref) {
+            return std::fabs(std::nextafter(ref, 2.f) - ref);
+        };
+
+        lm::vec3_norm_batch(a3, r3, n);
+        lm::vec4_norm_batch(a4, r4, n);
+
+        float max_ulp = 0.f;
+        for (std::size_t i = 0; i < n; ++i) {
+            const lm::vec3 ref3 = lm::vec3_norm(a3[i]);
+            const lm::vec4 ref4 = lm::vec_norm(a4[i]);
+            for (int k = 0; k < 3; ++k) max_ulp = std::fmax(max_ulp, std::fabs(r3[i][k] - ref3[k]) / ulp(ref3[k]));
+            for (int k = 0; k < 4; ++k) max_ulp = std::fmax(max_ulp, std::fabs(r4[i][k] - ref4[k]) / ulp(ref4[k]));
+        }
+        REQUIRE(max_ulp <= 2.f);
+
+        REQUIRE(byte_equal(r3[0], lm::vec3{}));
+        REQUIRE(byte_equal(r3[9], lm::vec3{}));
+        REQUIRE(byte_equal(r3[n - 1], lm::vec3{}));
+        REQUIRE(r3[20] == lm::vec3{}); // signed zeros
+        REQUIRE(byte_equal(r4[3], lm::vec4{}));
+        REQUIRE(byte_equal(r4[12], lm::vec4{}));
+        REQUIRE(byte_equal(r4[n - 2], lm::vec4{}));
+
+        // same lane kernel as the SoA view path
+        float x[n], y[n], z[n];
+        const lm::vec3_soa S{ { x, y, z }, n };
+        lm::vec_soa_from_aos(a3, S);
+        lm::vec_soa_norm(S, S);
+        lm::vec_soa_to_aos(S, s3);
+        REQUIRE(std::memcmp(s3, r3, sizeof(r3)) == 0);
+
+        // in place
+        std::memcpy(s3, a3, sizeof(a3));
+        std::memcpy(s4, a4, sizeof(a4));
+        lm::vec3_norm_batch(s3, s3, n);
+        lm::vec4_norm_batch(s4, s4, n);
+        REQUIRE(std::memcmp(s3, r3, sizeof(r3)) == 0);
+        REQUIRE(std::memcmp(s4, r4, sizeof(r4)) == 0);
+    }
+
+    TEST_CASE("frustum planes and SoA sphere / AABB culling", "[frustum][soa][simd]") {
+        // camera at (0, 0, 5) looking down -z, 90 degree vertical fov
+        const lm::mat4 V = lm::mat4_look_at({ 0.f, 0.f, 5.f }, { 0.f, 0.f, 0.f }, { 0.f, 1.f, 0.f });
+        const lm::mat4 P = lm::mat4_perspective(1.5707963f, 2.f, 1.f, 101.f);
+        const lm::frustum F = lm::frustum_from_mat4(lm::mat4_mul(P, V));
+
+        for (const lm::vec4& p : F.planes)
+            REQUIRE(std::sqrt(double(p[0]) * p[0] + double(p[1]) * p[1] + double(p[2]) * p[2]) ==
+                    Approx(1.0).epsilon(3e-7)); // IEEE sqrt: a few ulp, not lm::sqrtf's
+        // near plane 1 unit ahead, far plane 101 units ahead, world units
+        REQUIRE(lm::plane_dist(F.planes[4], 0.f, 0.f, 3.f) == Approx(1.f).margin(1e-4f));
+        REQUIRE(lm::plane_dist(F.planes[5], 0.f, 0.f, 3.f) == Approx(99.f).epsilon(1e-5f));
+        // top plane passes through the eye and y = 1 / P[1][1] one unit ahead
+        REQUIRE(lm::plane_dist(F.planes[3], 0.f, 0.f, 5.f) == Approx(0.f).margin(1e-5f));
+        REQUIRE(lm::plane_dist(F.planes[3], 0.f, 1.f / P[1][1], 4.f) == Approx(0.f).margin(1e-5f));
+
+        REQUIRE(lm::frustum_test_sphere(F, { 0.f, 0.f, 0.f }, 0.1f));
+        REQUIRE_FALSE(lm::frustum_test_sphere(F, { 0.f, 0.f, 6.f }, 0.5f));   // behind the eye
+        REQUIRE(lm::frustum_test_sphere(F, { 0.f, 0.f, 6.f }, 2.5f));         // reaches past near
+        REQUIRE_FALSE(lm::frustum_test_sphere(F, { 0.f, 0.f, -100.f }, 3.f)); // past far
+        REQUIRE_FALSE(lm::frustum_test_sphere(F, { 25.f, 0.f, -5.f }, 1.f));  // right of x = 2|z - 5|
+        REQUIRE(lm::frustum_test_aabb(F, { 19.f, -1.f, -6.f }, { 21.f, 1.f, -4.f }));
+        REQUIRE_FALSE(lm::frustum_test_aabb(F, { 24.f, -1.f, -6.f }, { 26.f, 1.f, -4.f }));
+        REQUIRE_FALSE(lm::frustum_test_aabb(F, { -1.f, 12.f, -6.f }, { 1.f, 14.f, -4.f }));
+
+        // batches: every lane width, a scalar tail and a partial last word
+        constexpr std::size_t n = 1037;
+        std::vector<float> sx(n), sy(n), sz(n), sr(n), lx(n), ly(n), lz(n), hx(n), hy(n), hz(n);
+        std::uint32_t seed = 7u;
+        auto rnd = [&seed](float lo, float hi) {
+            seed = seed * 1664525u + 1013904223u;
+            return lo + (hi - lo) * float(seed >> 8) * (1.f / 16777216.f);
+        };
+        for (std::size_t i = 0; i < n; ++i) {
+            sx[i] = rnd(-150.f, 150.f); sy[i] = rnd(-80.f, 80.f); sz[i] = rnd(-110.f, 10.f);
+            sr[i] = rnd(0.f, 8.f);
+            lx[i] = sx[i] - rnd(0.f, 6.f); ly[i] = sy[i] - rnd(0.f, 6.f); lz[i] = sz[i] - rnd(0.f, 6.f);
+            hx[i] = sx[i] + rnd(0.f, 6.f); hy[i] = sy[i] + rnd(0.f, 6.f); hz[i] = sz[i] + rnd(0.f, 6.f);
+        }
+        const lm::vec4_soa S{ { sx.data(), sy.data(), sz.data(), sr.data() }, n };
+        const lm::vec3_soa lo{ { lx.data(), ly.data(), lz.data() }, n };
+        const lm::vec3_soa hi{ { hx.data(), hy.data(), hz.data() }, n };
+
+        constexpr std::size_t words = (n + 31) / 32;
+        std::vector<std::uint32_t> vis_s(words, 0xdeadbeefu), vis_b(words, 0xdeadbeefu);
+        lm::frustum_cull_spheres(F, S, vis_s.data());
+        lm::frustum_cull_aabbs(F, lo, hi, vis_b.data());
+
+        std::size_t seen_s = 0, seen_b = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            const bool ref_s = lm::frustum_test_sphere(F, { sx[i], sy[i], sz[i] }, sr[i]);
+            const bool ref_b = lm::frustum_test_aabb(F, { lx[i], ly[i], lz[i] }, { hx[i], hy[i], hz[i] });
+            REQUIRE(((vis_s[i / 32] >> (i % 32)) & 1u) == std::uint32_t(ref_s));
+            REQUIRE(((vis_b[i / 32] >> (i % 32)) & 1u) == std::uint32_t(ref_b));
+            seen_s += ref_s;
+            seen_b += ref_b;
+        }
+        REQUIRE(seen_s > n / 8);           // both outcomes are exercised
+        REQUIRE(seen_s < n - n / 8);
+        REQUIRE(seen_b > n / 8);
+        REQUIRE(seen_b < n - n / 8);
+        REQUIRE((vis_s[words - 1] >> (n % 32)) == 0u);
+        REQUIRE((vis_b[words - 1] >> (n % 32)) == 0u);
+
+        // on a pool: blocks own whole mask words
+        std::vector<std::uint32_t> par_s(words), par_b(words);
+#if !defined(LMATH_FREESTANDING)
+        lm::thread_pool threads(3);
+        const lm::worker_pool pool = threads.pool();
+#else
+        const lm::worker_pool pool = lm::serial_pool();
+#endif
+        constexpr std::size_t m = 5000; // several culling blocks
+        std::vector<float> big[4];
+        for (std::vector<float>& c : big) c.resize(m);
+        for (std::size_t i = 0; i < m; ++i)
+            for (std::size_t c = 0; c < 4; ++c) big[c][i] = S[c][i % n];
+        const lm::vec4_soa B{ { big[0].data(), big[1].data(), big[2].data(), big[3].data() }, m };
+        std::vector<std::uint32_t> big_ref((m + 31) / 32), big_par((m + 31) / 32);
+        lm::frustum_cull_spheres(F, B, big_ref.data());
+        lm::frustum_cull_spheres(F, B, big_par.data(), pool);
+        REQUIRE(big_ref == big_par);
+
+        lm::frustum_cull_spheres(F, S, par_s.data(), pool);
+        lm::frustum_cull_aabbs(F, lo, hi, par_b.data(), pool);
+        REQUIRE(par_s == vis_s);
+        REQUIRE(par_b == vis_b);
+    }
+
+    TEST_CASE("aabb3 / sphere3 ops and SoA batches", "[bounds][soa][simd]") {
+        const lm::aabb3 A{ { -1.f, -2.f, -3.f }, { 1.f, 2.f, 3.f } };
+        const lm::aabb3 B{ { 0.5f, 1.f, 3.f }, { 4.f, 5.f, 6.f } };   // touches A at z = 3
+        const lm::aabb3 C{ { 1.5f, -1.f, -1.f }, { 2.f, 1.f, 1.f } };
+
+        const lm::aabb3 U = lm::aabb_merge(A, B);
+        REQUIRE(U.lo == lm::vec3{ -1.f, -2.f, -3.f });
+        REQUIRE(U.hi == lm::vec3{ 4.f, 5.f, 6.f });
+        REQUIRE(lm::aabb_merge(lm::aabb_empty(), A).lo == A.lo);
+        REQUIRE(lm::aabb_merge(lm::aabb_empty(), A).hi == A.hi);
+        REQUIRE(lm::aabb_center(B) == lm::vec3{ 2.25f, 3.f, 4.5f });
+        REQUIRE(lm::aabb_extent(A) == lm::vec3{ 1.f, 2.f, 3.f });
+        REQUIRE(lm::aabb_overlaps(A, B));
+        REQUIRE_FALSE(lm::aabb_overlaps(A, C));
+        REQUIRE(lm::aabb_contains(U, A));
+        REQUIRE(lm::aabb_contains(A, A));
+        REQUIRE_FALSE(lm::aabb_contains(A, U));
+        REQUIRE(lm::aabb_contains(A, lm::vec3{ 1.f, 0.f, 0.f }));
+        REQUIRE_FALSE(lm::aabb_overlaps(lm::aabb_empty(), A));
+
+        const lm::sphere3 s0{ { 0.f, 0.f, 0.f }, 2.f };
+        const lm::sphere3 s1{ { 3.f, 0.f, 0.f }, 1.f };                // touches s0
+        const lm::sphere3 s2{ { 0.5f, 0.f, 0.f }, 1.f };
+        REQUIRE(lm::sphere_overlaps(s0, s1));
+        REQUIRE_FALSE(lm::sphere_overlaps(s0, lm::sphere3{ { 3.1f, 0.f, 0.f }, 1.f }));
+        REQUIRE(lm::sphere_contains(s0, s2));
+        REQUIRE_FALSE(lm::sphere_contains(s2, s0));
+        REQUIRE(lm::sphere_overlaps(s0, C));
+        REQUIRE_FALSE(lm::sphere_overlaps(lm::sphere3{ { 3.f, 3.f, 0.f }, 1.f }, C)); // corner is 1.12 away
+
+        const lm::sphere3 m = lm::sphere_merge(s0, s1);
+        REQUIRE(m.r == Approx(3.f));          // spans x in [-2, 4]
+        REQUIRE(m.c[0] == Approx(1.f));
+        REQUIRE(lm::sphere_merge(s0, s2).r == s0.r);
+        REQUIRE(lm::sphere_from_aabb(A).r == Approx(std::sqrt(14.f)));
+
+        // Arvo transform equals the bounds of the 8 transformed corners
+        const lm::mat4 M = lm::mat4_mul(lm::mat4_translate(1.f, -2.f, 3.f),
+                                        lm::mat4_mul(lm::mat4_rotate_y(0.7f), lm::mat4_scale(2.f, 1.f, 0.5f)));
+        lm::vec3 corners[8];
+        for (std::size_t k = 0; k < 8; ++k)
+            corners[k] = { (k & 1) ? A.hi[0] : A.lo[0], (k & 2) ? A.hi[1] : A.lo[1], (k & 4) ? A.hi[2] : A.lo[2] };
+        lm::mat4_transform_points(M, corners, corners, 8);
+        const lm::aabb3 T = lm::aabb_transform(M, A);
+        const lm::aabb3 Tc = lm::aabb_from_points(corners, 8);
+        const lm::aabb3 Ts = lm::detail::aabb_transform_scalar(M, A);
+        for (std::size_t c = 0; c < 3; ++c) {
+            REQUIRE(T.lo[c] == Approx(Tc.lo[c]).margin(1e-5f));
+            REQUIRE(T.hi[c] == Approx(Tc.hi[c]).margin(1e-5f));
+        }
+        REQUIRE(std::memcmp(&T, &Ts, sizeof(T)) == 0);
+
+        const lm::sphere3 ts = lm::sphere_transform(M, s1);
+        REQUIRE(ts.r == Approx(2.f));
+        REQUIRE(ts.c[1] == Approx(-2.f));
+
+        // batches vs single objects: every lane width and a scalar tail
+        constexpr std::size_t n = 1037;
+        std::vector<float> lx(n), ly(n), lz(n), hx(n), hy(n), hz(n), sx(n), sy(n), sz(n), sr(n);
+        std::uint32_t seed = 11u;
+        auto rnd = [&seed](float lo, float hi) {
+            seed = seed * 1664525u + 1013904223u;
+            return lo + (hi - lo) * float(seed >> 8) * (1.f / 16777216.f);
+        };
+        for (std::size_t i = 0; i < n; ++i) {
+            lx[i] = rnd(-10.f, 10.f); ly[i] = rnd(-10.f, 10.f); lz[i] = rnd(-10.f, 10.f);
+            hx[i] = lx[i] + rnd(0.f, 4.f); hy[i] = ly[i] + rnd(0.f, 4.f); hz[i] = lz[i] + rnd(0.f, 4.f);
+            sx[i] = rnd(-10.f, 10.f); sy[i] = rnd(-10.f, 10.f); sz[i] = rnd(-10.f, 10.f);
+            sr[i] = rnd(0.f, 5.f);
+        }
+        const lm::vec3_soa lo{ { lx.data(), ly.data(), lz.data() }, n };
+        const lm::vec3_soa hi{ { hx.data(), hy.data(), hz.data() }, n };
+        const lm::vec4_soa S{ { sx.data(), sy.data(), sz.data(), sr.data() }, n };
+        auto box = [&](std::size_t i) {
+            return lm::aabb3{ { lx[i], ly[i], lz[i] }, { hx[i], hy[i], hz[i] } };
+        };
+        auto sph = [&](std::size_t i) { return lm::sphere3{ { sx[i], sy[i], sz[i] }, sr[i] }; };
+
+        lm::aabb3 ref = lm::aabb_empty();
+        for (std::size_t i = 0; i < n; ++i) ref = lm::aabb_merge(ref, box(i));
+        const lm::aabb3 all = lm::aabb_merge_batch(lo, hi);
+        REQUIRE(std::memcmp(&all, &ref, sizeof(ref)) == 0);
+        const lm::aabb3 pts = lm::aabb_from_points(lo);
+        REQUIRE(pts.lo == ref.lo);
+        std::vector<lm::vec3> aos(n);
+        lm::vec_soa_to_aos(hi, aos.data());
+        REQUIRE(lm::aabb_from_points(aos.data(), n).hi == ref.hi);
+        REQUIRE(lm::aabb_from_points(aos.data(), 0).lo == lm::aabb_empty().lo);
+
+        std::vector<float> o[7];
+        for (std::vector<float>& v : o) v.resize(n);
+        const lm::vec3_soa olo{ { o[0].data(), o[1].data(), o[2].data() }, n };
+        const lm::vec3_soa ohi{ { o[3].data(), o[4].data(), o[5].data() }, n };
+        lm::aabb_transform_batch(M, lo, hi, olo, ohi);
+        for (std::size_t i = 0; i < n; ++i) {
+            const lm::aabb3 t = lm::aabb_transform(M, box(i));
+            const lm::aabb3 b{ { olo[0][i], olo[1][i], olo[2][i] }, { ohi[0][i], ohi[1][i], ohi[2][i] } };
+            REQUIRE(std::memcmp(&t, &b, sizeof(t)) == 0);
+        }
+        const lm::vec4_soa os{ { o[3].data(), o[4].data(), o[5].data(), o[6].data() }, n };
+        lm::sphere_transform_batch(M, S, os);
+        for (std::size_t i = 0; i < n; ++i) {
+            const lm::sphere3 t = lm::sphere_transform(M, sph(i));
+            const lm::sphere3 b{ { os[0][i], os[1][i], os[2][i] }, os[3][i] };
+            REQUIRE(std::memcmp(&t, &b, sizeof(t)) == 0);
+        }
+
+        constexpr std::size_t words = (n + 31) / 32;
+        const lm::aabb3 Q{ { -6.f, -6.f, -6.f }, { 7.f, 7.f, 7.f } };
+        const lm::sphere3 Qs{ { 1.f, -1.f, 2.f }, 9.f };
+        std::vector<std::uint32_t> ov(words, 0xdeadbeefu), in(words, 0xdeadbeefu),
+                                   sov(words, 0xdeadbeefu), sin(words, 0xdeadbeefu);
+        lm::aabb_overlap_batch(Q, lo, hi, ov.data());
+        lm::aabb_contains_batch(Q, lo, hi, in.data());
+        lm::sphere_overlap_batch(Qs, S, sov.data());
+        lm::sphere_contains_batch(Qs, S, sin.data());
+
+        std::size_t seen[4] = {};
+        for (std::size_t i = 0; i < n; ++i) {
+            const bool ref_ov = lm::aabb_overlaps(Q, box(i));
+            const bool ref_in = lm::aabb_contains(Q, box(i));
+            const bool ref_sov = lm::sphere_overlaps(Qs, sph(i));
+            const bool ref_sin = lm::sphere_contains(Qs, sph(i));
+            REQUIRE(((ov[i / 32] >> (i % 32)) & 1u) == std::uint32_t(ref_ov));
+            REQUIRE(((in[i / 32] >> (i % 32)) & 1u) == std::uint32_t(ref_in));
+            REQUIRE(((sov[i / 32] >> (i % 32)) & 1u) == std::uint32_t(ref_sov));
+            REQUIRE(((sin[i / 32] >> (i % 32)) & 1u) == std::uint32_t(ref_sin));
+            seen[0] += ref_ov; seen[1] += ref_in; seen[2] += ref_sov; seen[3] += ref_sin;
+        }
+        for (std::size_t k : seen) {
+            REQUIRE(k > n / 16);           // both outcomes are exercised
+            REQUIRE(k < n - n / 16);
+        }
+        REQUIRE((ov[words - 1] >> (n % 32)) == 0u);
+        REQUIRE((sin[words - 1] >> (n % 32)) == 0u);
+
+        // pool overloads give the same bits / floats
+#if !defined(LMATH_FREESTANDING)
+        lm::thread_pool threads(3);
+        const lm::worker_pool pool = threads.pool();
+#else
+        const lm::worker_pool pool = lm::serial_pool();
+#endif
+        std::vector<std::uint32_t> par_ov(words), par_sin(words);
+        lm::aabb_overlap_batch(Q, lo, hi, par_ov.data(), pool);
+        lm::sphere_contains_batch(Qs, S, par_sin.data(), pool);
+        REQUIRE(par_ov == ov);
+        REQUIRE(par_sin == sin);
+
+        std::vector<float> p[6];
+        for (std::vector<float>& v : p) v.resize(n);
+        const lm::vec3_soa plo{ { p[0].data(), p[1].data(), p[2].data() }, n };
+        const lm::vec3_soa phi{ { p[3].data(), p[4].data(), p[5].data() }, n };
+        lm::aabb_transform_batch(M, lo, hi, plo, phi, pool);
+        lm::aabb_transform_batch(M, lo, hi, olo, ohi);
+        for (std::size_t c = 0; c < 6; ++c)
+            REQUIRE(std::memcmp(p[c].data(), o[c].data(), n * sizeof(float)) == 0);
+
+        // frustum tests take the bounding types directly
+        const lm::frustum F = lm::frustum_from_mat4(lm::mat4_ortho(-1.f, 1.f, -1.f, 1.f, -1.f, 1.f));
+        REQUIRE(lm::frustum_test_aabb(F, C) == lm::frustum_test_aabb(F, C.lo, C.hi));
+        REQUIRE(lm::frustum_test_sphere(F, s1) == lm::frustum_test_sphere(F, s1.c, s1.r));
+    }
+
+    template<std::size_t W>
+    void check_ray_packets(const std::vector<lm::ray3>& rays, const std::vector<lm::vec3>& tri,
+                           const std::vector<lm::sphere3>& sph, const std::vector<lm::aabb3>& box,
+                           std::size_t (&hits)[3]) {
+        for (std::size_t r0 = 0; r0 + W <= rays.size(); r0 += W) {
+            const lm::ray_packet<W> P = lm::ray_packet_load<W>(rays.data() + r0);
+            lm::vec<float, W> t_tri, t_sph, t_max, t_near;
+            float ref_tri[W], ref_sph[W];
+            for (std::size_t i = 0; i < W; ++i) {
+                t_tri[i] = t_sph[i] = ref_tri[i] = ref_sph[i] = 1e30f;
+                t_max[i] = 40.f + float(i);
+            }
+
+            for (std::size_t k = 0; k < sph.size(); ++k) {
+                const int m_tri = lm::ray_triangle_packet(P, tri[3 * k], tri[3 * k + 1], tri[3 * k + 2], t_tri);
+                const int m_sph = lm::ray_sphere_packet(P, sph[k], t_sph);
+                const int m_box = lm::ray_aabb_packet(P, box[k], t_max, t_near);
+                for (std::size_t i = 0; i < W; ++i) {
+                    const lm::ray3& R = rays[r0 + i];
+                    float tn = -1.f;
+                    const bool h_tri = lm::ray_triangle(R, tri[3 * k], tri[3 * k + 1], tri[3 * k + 2], ref_tri[i]);
+                    const bool h_sph = lm::ray_sphere(R, sph[k], ref_sph[i]);
+                    const bool h_box = lm::ray_aabb(R, box[k], t_max[i], tn);
+                    REQUIRE(((m_tri >> i) & 1) == int(h_tri));
+                    REQUIRE(((m_sph >> i) & 1) == int(h_sph));
+                    REQUIRE(((m_box >> i) & 1) == int(h_box));
+                    if (h_box)
+                        REQUIRE(std::memcmp(&tn, &t_near[i], sizeof(float)) == 0);
+                    hits[0] += h_tri; hits[1] += h_sph; hits[2] += h_box;
+                }
+            }
+            REQUIRE(std::memcmp(ref_tri, t_tri.v, sizeof(ref_tri)) == 0);
+            REQUIRE(std::memcmp(ref_sph, t_sph.v, sizeof(ref_sph)) == 0);
+        }
+    }
+
+    TEST_CASE("ray packets match single-ray triangle / sphere / AABB tests", "[ray][simd]") {
+        // known answers
+        const lm::ray3 R{ { 0.f, 0.f, 5.f }, { 0.f, 0.f, -2.f } };
+        float t = 100.f;
+        REQUIRE(lm::ray_triangle(R, { -1.f, -1.f, 0.f }, { 1.f, -1.f, 0.f }, { 0.f, 1.f, 0.f }, t));
+        REQUIRE(t == 2.5f);
+        REQUIRE_FALSE(lm::ray_triangle(R, { -1.f, -1.f, 1.f }, { 1.f, -1.f, 1.f }, { 0.f, 1.f, 1.f }, t = 1.f));
+        REQUIRE_FALSE(lm::ray_triangle(R, { 1.f, 1.f, 0.f }, { 2.f, 1.f, 0.f }, { 1.f, 2.f, 0.f }, t = 100.f));
+        REQUIRE(lm::ray_sphere(R, { { 0.f, 0.f, 0.f }, 1.f }, t = 100.f));
+        REQUIRE(t == 2.f);
+        REQUIRE(lm::ray_sphere(R, { { 0.f, 0.f, 5.f }, 1.f }, t = 100.f)); // origin inside: far root
+        REQUIRE(t == 0.5f);
+        REQUIRE_FALSE(lm::ray_sphere(R, { { 0.f, 0.f, 6.5f }, 1.f }, t = 100.f));
+        float tn = -1.f;
+        REQUIRE(lm::ray_aabb(R, { { -1.f, -1.f, -1.f }, { 1.f, 1.f, 1.f } }, 100.f, tn));
+        REQUIRE(tn == 2.f);
+        REQUIRE_FALSE(lm::ray_aabb(R, { { -1.f, -1.f, -1.f }, { 1.f, 1.f, 1.f } }, 1.5f, tn));
+        REQUIRE(lm::ray_aabb(R, { { -1.f, -1.f, 4.f }, { 1.f, 1.f, 6.f } }, 100.f, tn));
+        REQUIRE(tn == 0.f);
+        REQUIRE_FALSE(lm::ray_aabb(R, { { 1.5f, -1.f, -1.f }, { 2.f, 1.f, 1.f } }, 100.f, tn));
+
+        // random scenes, 4- and 8-wide packets against the scalar tests
+        std::uint32_t seed = 5u;
+        auto rnd = [&seed](float lo, float hi) {
+            seed = seed * 1664525u + 1013904223u;
+            return lo + (hi - lo) * float(seed >> 8) * (1.f / 16777216.f);
+        };
+        std::vector<lm::ray3> rays(64);
+        for (lm::ray3& r : rays) {
+            r.o = { rnd(-2.f, 2.f), rnd(-2.f, 2.f), rnd(8.f, 12.f) };
+            r.d = { rnd(-0.6f, 0.6f), rnd(-0.6f, 0.6f), -1.f };
+        }
+        rays[3].d = { 0.f, 0.f, -1.f }; // axis-aligned: infinite inv_d
+        constexpr std::size_t k = 96;
+        std::vector<lm::vec3> tri(3 * k);
+        std::vector<lm::sphere3> sph(k);
+        std::vector<lm::aabb3> box(k);
+        for (std::size_t i = 0; i < k; ++i) {
+            const lm::vec3 c{ rnd(-6.f, 6.f), rnd(-6.f, 6.f), rnd(-8.f, 4.f) };
+            for (std::size_t j = 0; j < 3; ++j)
+                tri[3 * i + j] = { c[0] + rnd(-3.f, 3.f), c[1] + rnd(-3.f, 3.f), c[2] + rnd(-1.f, 1.f) };
+            sph[i] = { c, rnd(0.2f, 2.f) };
+            box[i] = { { c[0] - rnd(0.f, 2.f), c[1] - rnd(0.f, 2.f), c[2] - rnd(0.f, 2.f) },
+                       { c[0] + rnd(0.f, 2.f), c[1] + rnd(0.f, 2.f), c[2] + rnd(0.f, 2.f) } };
+        }
+
+        std::size_t hits4[3] = {}, hits8[3] = {};
+        check_ray_packets<4>(rays, tri, sph, box, hits4);
+        check_ray_packets<8>(rays, tri, sph, box, hits8);
+        for (std::size_t h : hits4) {
+            REQUIRE(h > 32);               // hits and misses both exercised
+            REQUIRE(h < 64 * k - 64);
+        }
+        REQUIRE(std::equal(hits4, hits4 + 3, hits8));
+    }
 
     TEST_CASE("mat3 basic operations", "[mat3]") {
         lm::mat3 m{ lm::mat_identity<float, 3>() };
@@ -275,6 +1838,598 @@ namespace {
     }
 
 
+    TEST_CASE("quat mul / rotate batches equal the scalar templates", "[quat][batch][simd]") {
+        std::uint32_t seed = 17u;
+        auto rnd = [&seed](float lo, float hi) {
+            seed = seed * 1664525u + 1013904223u;
+            return lo + (hi - lo) * float(seed >> 8) * (1.f / 16777216.f);
+        };
+        constexpr std::size_t n = 1003; // full 4/8-lane blocks plus a tail
+        std::vector<lm::quat> qa(n), qb(n), qr(n), ref(n);
+        std::vector<lm::vec3> v(n), vr(n), vref(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            // unit and non-unit quaternions alike
+            qa[i] = { { rnd(-2.f, 2.f), rnd(-2.f, 2.f), rnd(-2.f, 2.f) }, rnd(-2.f, 2.f) };
+            // by hand: linmath.h #defines quat_norm
+            const lm::vec4 u = lm::vec_norm(lm::vec4{ rnd(-1.f, 1.f), rnd(-1.f, 1.f), rnd(-1.f, 1.f), rnd(-1.f, 1.f) });
+            qb[i] = { { u[0], u[1], u[2] }, u[3] };
+            v[i] = { rnd(-10.f, 10.f), rnd(-10.f, 10.f), rnd(-10.f, 10.f) };
+        }
+        qb[0] = lm::quat_identity();
+        v[1] = {};
+
+        for (std::size_t i = 0; i < n; ++i) {
+            ref[i] = lm::quat_mul(qa[i], qb[i]);
+            const lm::quat t = qa[i] * qb[i];
+            REQUIRE(std::memcmp(&t, &ref[i], sizeof(lm::quat)) == 0);
+            vref[i] = lm::quat_mul_vec3(qb[7], v[i]);
+        }
+
+        // rotation agrees with glm for unit quaternions (glm takes w first)
+        const glm::quat gq(qb[7].w, qb[7].v[0], qb[7].v[1], qb[7].v[2]);
+        for (std::size_t i = 0; i < 16; ++i) {
+            const glm::vec3 g = gq * glm::vec3(v[i][0], v[i][1], v[i][2]);
+            for (int k = 0; k < 3; ++k)
+                REQUIRE(std::fabs(g[k] - vref[i][k]) <= 1e-4f * (1.f + std::fabs(g[k])));
+        }
+
+        for (std::size_t m : { std::size_t(0), std::size_t(1), std::size_t(7), std::size_t(8), n }) {
+            std::fill(qr.begin(), qr.end(), lm::quat{});
+            std::fill(vr.begin(), vr.end(), lm::vec3{});
+            lm::quat_mul_batch(qa.data(), qb.data(), qr.data(), m);
+            lm::quat_mul_vec3_batch(qb[7], v.data(), vr.data(), m);
+            REQUIRE(std::memcmp(qr.data(), ref.data(), m * sizeof(lm::quat)) == 0);
+            REQUIRE(std::memcmp(vr.data(), vref.data(), m * sizeof(lm::vec3)) == 0);
+            if (m < n) {
+                REQUIRE(qr[m] == lm::quat{});
+                REQUIRE(vr[m] == lm::vec3{});
+            }
+        }
+
+        // in place
+        qr = qa;
+        lm::quat_mul_batch(qr.data(), qb.data(), qr.data(), n);
+        REQUIRE(std::memcmp(qr.data(), ref.data(), n * sizeof(lm::quat)) == 0);
+        vr = v;
+        lm::quat_mul_vec3_batch(qb[7], vr.data(), vr.data(), n);
+        REQUIRE(std::memcmp(vr.data(), vref.data(), n * sizeof(lm::vec3)) == 0);
+
+#if !defined(LMATH_FREESTANDING)
+        lm::thread_pool threads(4);
+        std::fill(qr.begin(), qr.end(), lm::quat{});
+        std::fill(vr.begin(), vr.end(), lm::vec3{});
+        lm::quat_mul_batch(qa.data(), qb.data(), qr.data(), n, threads.pool());
+        lm::quat_mul_vec3_batch(qb[7], v.data(), vr.data(), n, threads.pool());
+        REQUIRE(std::memcmp(qr.data(), ref.data(), n * sizeof(lm::quat)) == 0);
+        REQUIRE(std::memcmp(vr.data(), vref.data(), n * sizeof(lm::vec3)) == 0);
+#endif
+    }
+
+    TEST_CASE("quat nlerp / slerp / fast slerp: accuracy, shortest path, SoA batches", "[quat][slerp][batch][simd]") {
+        std::uint32_t seed = 23u;
+        auto rnd = [&seed](float lo, float hi) {
+            seed = seed * 1664525u + 1013904223u;
+            return lo + (hi - lo) * float(seed >> 8) * (1.f / 16777216.f);
+        };
+        // by hand: linmath.h #defines quat_norm
+        auto unit = [&rnd]() {
+            const lm::vec4 u = lm::vec_norm(lm::vec4{ rnd(-1.f, 1.f), rnd(-1.f, 1.f), rnd(-1.f, 1.f), rnd(-1.f, 1.f) });
+            return lm::quat{ { u[0], u[1], u[2] }, u[3] };
+        };
+        auto neg = [](const lm::quat& q) { return lm::quat{ { -q.v[0], -q.v[1], -q.v[2] }, -q.w }; };
+        auto near = [](const lm::quat& a, const lm::quat& b, float eps) {
+            for (std::size_t k = 0; k < 4; ++k)
+                if (!(std::fabs(a[k] - b[k]) <= eps)) return false;
+            return true;
+        };
+
+        constexpr std::size_t n = 1003; // full 4/8-lane blocks plus a tail
+        std::vector<lm::quat> qa(n), qb(n);
+        std::vector<float> t(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            qa[i] = unit();
+            qb[i] = unit();
+            t[i] = rnd(0.f, 1.f);
+        }
+        qb[0] = qa[0];                                            // identical
+        qb[1] = neg(qa[1]);                                       // same rotation, opposite sign
+        {   // ~0.01 degrees apart: the nlerp fallback
+            const lm::vec4 u = lm::vec_norm(lm::vec4{ qa[2].v[0] + 1e-4f, qa[2].v[1], qa[2].v[2], qa[2].w });
+            qb[2] = { { u[0], u[1], u[2] }, u[3] };
+        }
+        t[3] = 0.f;
+        t[4] = 1.f;
+
+        SECTION("against the closed form about one axis") {
+            // rotations about z: angle a -> (0, 0, sin(a/2), cos(a/2)); all
+            // pairs less than pi apart, so the short arc is the direct one
+            for (float a0 : { -1.2f, 0.f, 0.7f })
+                for (float a1 : { -1.f, 0.3f, 1.9f })
+                    for (float tt : { 0.f, 0.25f, 0.5f, 0.9f, 1.f }) {
+                        const lm::quat A{ { 0.f, 0.f, std::sin(a0 * 0.5f) }, std::cos(a0 * 0.5f) };
+                        const lm::quat B{ { 0.f, 0.f, std::sin(a1 * 0.5f) }, std::cos(a1 * 0.5f) };
+                        const float a = a0 + (a1 - a0) * tt;
+                        const lm::quat R{ { 0.f, 0.f, std::sin(a * 0.5f) }, std::cos(a * 0.5f) };
+                        REQUIRE(near(lm::quat_slerp(A, B, tt), R, 2e-6f));
+                        REQUIRE(near(lm::quat_slerp_fast(A, B, tt), R, 1e-3f));
+                    }
+        }
+
+        SECTION("endpoints, unit length, shortest path, glm") {
+            for (std::size_t i = 0; i < n; ++i) {
+                const lm::quat A = qa[i], B = qb[i];
+                const lm::quat nl = lm::quat_nlerp(A, B, t[i]);
+                const lm::quat sl = lm::quat_slerp(A, B, t[i]);
+                const lm::quat fs = lm::quat_slerp_fast(A, B, t[i]);
+                for (const lm::quat& q : { nl, sl, fs })
+                    REQUIRE(std::fabs(lm::quat_dot(q, q) - 1.f) <= 1e-5f);
+
+                // B and -B are the same rotation: results are bitwise equal
+                const lm::quat sl2 = lm::quat_slerp(A, neg(B), t[i]);
+                const lm::quat nl2 = lm::quat_nlerp(A, neg(B), t[i]);
+                const lm::quat fs2 = lm::quat_slerp_fast(A, neg(B), t[i]);
+                REQUIRE(std::memcmp(&sl, &sl2, sizeof(lm::quat)) == 0);
+                REQUIRE(std::memcmp(&nl, &nl2, sizeof(lm::quat)) == 0);
+                REQUIRE(std::memcmp(&fs, &fs2, sizeof(lm::quat)) == 0);
+
+                // the fast variant tracks slerp, nlerp alone does not need to
+                REQUIRE(near(fs, sl, 1e-3f));
+
+                // glm (w first) also takes the short way
+                const glm::quat g = glm::slerp(glm::quat(A.w, A.v[0], A.v[1], A.v[2]),
+                                               glm::quat(B.w, B.v[0], B.v[1], B.v[2]), t[i]);
+                REQUIRE(near(sl, lm::quat{ { g.x, g.y, g.z }, g.w }, 1e-5f));
+
+                // endpoints come back renormalized: the inputs are only unit to
+                // ~1e-5 when vec_norm runs without SIMD
+                const float s = lm::quat_dot(A, B) < 0.f ? -1.f : 1.f;
+                for (const lm::quat& q : { lm::quat_slerp(A, B, 0.f), lm::quat_slerp_fast(A, B, 0.f),
+                                           lm::quat_nlerp(A, B, 0.f) })
+                    REQUIRE(near(q, A, 1e-5f));
+                for (const lm::quat& q : { lm::quat_slerp(A, B, 1.f), lm::quat_slerp_fast(A, B, 1.f),
+                                           lm::quat_nlerp(A, B, 1.f) })
+                    REQUIRE(near(q, lm::quat{ { s * B.v[0], s * B.v[1], s * B.v[2] }, s * B.w }, 1e-5f));
+            }
+            const lm::quat same = lm::quat_slerp(qa[0], qa[0], 0.3f);
+            REQUIRE(near(same, qa[0], 1e-5f));
+        }
+
+        SECTION("SoA batches equal the single-quaternion calls") {
+            std::vector<float> a(4 * n), b(4 * n), r(4 * n);
+            for (std::size_t i = 0; i < n; ++i)
+                for (std::size_t k = 0; k < 4; ++k) {
+                    a[k * n + i] = qa[i][k];
+                    b[k * n + i] = qb[i][k];
+                }
+            auto soa = [n](std::vector<float>& v, std::size_t m) {
+                return lm::quat_soa{ { v.data(), v.data() + n, v.data() + 2 * n, v.data() + 3 * n }, m };
+            };
+            auto check = [&](std::size_t m, auto one, const float* tt, float t0) {
+                for (std::size_t i = 0; i < n; ++i) {
+                    lm::quat ref = i < m ? one(qa[i], qb[i], tt ? tt[i] : t0) : lm::quat{};
+                    for (std::size_t k = 0; k < 4; ++k)
+                        REQUIRE(std::memcmp(&r[k * n + i], &ref[k], sizeof(float)) == 0);
+                }
+            };
+            auto nl = [](const lm::quat& A, const lm::quat& B, float x) { return lm::quat_nlerp(A, B, x); };
+            auto sl = [](const lm::quat& A, const lm::quat& B, float x) { return lm::quat_slerp(A, B, x); };
+            auto fs = [](const lm::quat& A, const lm::quat& B, float x) { return lm::quat_slerp_fast(A, B, x); };
+
+            for (std::size_t m : { std::size_t(0), std::size_t(1), std::size_t(7), std::size_t(8), n }) {
+                std::fill(r.begin(), r.end(), 0.f);
+                lm::quat_soa_nlerp(soa(a, m), soa(b, m), t.data(), soa(r, m));
+                check(m, nl, t.data(), 0.f);
+                std::fill(r.begin(), r.end(), 0.f);
+                lm::quat_soa_slerp(soa(a, m), soa(b, m), t.data(), soa(r, m));
+                check(m, sl, t.data(), 0.f);
+                std::fill(r.begin(), r.end(), 0.f);
+                lm::quat_soa_slerp_fast(soa(a, m), soa(b, m), t.data(), soa(r, m));
+                check(m, fs, t.data(), 0.f);
+                std::fill(r.begin(), r.end(), 0.f);
+                lm::quat_soa_slerp(soa(a, m), soa(b, m), 0.375f, soa(r, m));
+                check(m, sl, nullptr, 0.375f);
+            }
+
+            // in place
+            std::vector<float> c = a;
+            lm::quat_soa_slerp(soa(c, n), soa(b, n), t.data(), soa(c, n));
+            r = c;
+            check(n, sl, t.data(), 0.f);
+
+#if !defined(LMATH_FREESTANDING)
+            lm::thread_pool threads(4);
+            std::fill(r.begin(), r.end(), 0.f);
+            lm::quat_soa_slerp(soa(a, n), soa(b, n), t.data(), soa(r, n), threads.pool());
+            check(n, sl, t.data(), 0.f);
+            std::fill(r.begin(), r.end(), 0.f);
+            lm::quat_soa_slerp_fast(soa(a, n), soa(b, n), 0.6f, soa(r, n), threads.pool());
+            check(n, fs, nullptr, 0.6f);
+#endif
+        }
+
+        SECTION("single call and SoA agree where the sincos reduction hits a tie") {
+            // A = identity, B at angle th about z: (1 - t) * th == pi/4 makes
+            // x * 2/pi land on 0.5 for the t around 1 - (pi/4) / th
+            std::vector<lm::quat> ta, tb;
+            std::vector<float> tt;
+            for (float th : { 0.8f, 0.81f, 0.82f, 1.3f, 2.9f }) {
+                float x = 1.f - 0.785398163f / th;
+                for (int k = 0; k < 64; ++k) x = std::nextafter(x, 0.f);
+                for (int k = 0; k < 128; ++k, x = std::nextafter(x, 1.f)) {
+                    ta.push_back(lm::quat{ { 0.f, 0.f, 0.f }, 1.f });
+                    tb.push_back(lm::quat{ { 0.f, 0.f, std::sin(th) }, std::cos(th) });
+                    tt.push_back(x);
+                }
+            }
+            tt[0] = 0.0182521287f;
+            const std::size_t m = tt.size();
+            std::vector<float> a(4 * m), b(4 * m), r(4 * m);
+            for (std::size_t i = 0; i < m; ++i)
+                for (std::size_t k = 0; k < 4; ++k) {
+                    a[k * m + i] = ta[i][k];
+                    b[k * m + i] = tb[i][k];
+                }
+            auto soa = [m](std::vector<float>& v) {
+                return lm::quat_soa{ { v.data(), v.data() + m, v.data() + 2 * m, v.data() + 3 * m }, m };
+            };
+            lm::quat_soa_slerp(soa(a), soa(b), tt.data(), soa(r));
+            for (std::size_t i = 0; i < m; ++i) {
+                lm::quat ref = lm::quat_slerp(ta[i], tb[i], tt[i]);
+                for (std::size_t k = 0; k < 4; ++k)
+                    REQUIRE(std::memcmp(&r[k * m + i], &ref[k], sizeof(float)) == 0);
+            }
+        }
+    }
+
+    TEST_CASE("dualquat compose / transform / conversions, SIMD and batches", "[dualquat][batch][simd]") {
+        std::uint32_t seed = 29u;
+        auto rnd = [&seed](float lo, float hi) {
+            seed = seed * 1664525u + 1013904223u;
+            return lo + (hi - lo) * float(seed >> 8) * (1.f / 16777216.f);
+        };
+        // by hand (linmath.h #defines quat_norm), with an IEEE sqrt: the
+        // errors below scale with |real|^2 - 1 times the point's size
+        auto unit = [&rnd]() {
+            const lm::vec4 u{ rnd(-1.f, 1.f), rnd(-1.f, 1.f), rnd(-1.f, 1.f), rnd(-1.f, 1.f) };
+            const float inv = 1.f / std::sqrt(lm::vec_dot(u, u));
+            return lm::quat{ { u[0] * inv, u[1] * inv, u[2] * inv }, u[3] * inv };
+        };
+        auto near3 = [](const lm::vec3& a, const lm::vec3& b, float eps) {
+            for (std::size_t k = 0; k < 3; ++k)
+                if (!(std::fabs(a[k] - b[k]) <= eps * (1.f + std::fabs(b[k])))) return false;
+            return true;
+        };
+        auto near_m = [](const lm::mat4& a, const lm::mat4& b, float eps) {
+            for (std::size_t c = 0; c < 4; ++c)
+                for (std::size_t r = 0; r < 4; ++r)
+                    if (!(std::fabs(a[c][r] - b[c][r]) <= eps * (1.f + std::fabs(b[c][r])))) return false;
+            return true;
+        };
+
+        constexpr std::size_t n = 1003; // full 4/8-lane blocks plus a tail
+        std::vector<lm::quat> rot(n);
+        std::vector<lm::vec3> tr(n), p(n);
+        std::vector<lm::dualquat> da(n), db(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            rot[i] = unit();
+            tr[i] = { rnd(-20.f, 20.f), rnd(-20.f, 20.f), rnd(-20.f, 20.f) };
+            p[i] = { rnd(-10.f, 10.f), rnd(-10.f, 10.f), rnd(-10.f, 10.f) };
+            da[i] = lm::dualquat_from_rt(rot[i], tr[i]);
+        }
+        for (std::size_t i = 0; i < n; ++i) db[i] = da[(i * 7 + 3) % n];
+        da[0] = lm::dualquat_identity();
+
+        SECTION("rotation + translation, mat4 round trips") {
+            for (std::size_t i = 1; i < n; ++i) {
+                const lm::dualquat& D = da[i];
+                REQUIRE(D.real == rot[i]);
+                REQUIRE(near3(lm::dualquat_translation(D), tr[i], 1e-5f));
+
+                lm::mat4 M = lm::mat4_from_quat(rot[i]);
+                M[3] = { tr[i][0], tr[i][1], tr[i][2], 1.f };
+                REQUIRE(near_m(lm::mat4_from_dualquat(D), M, 1e-5f));
+
+                const lm::vec4 h = lm::mat4_mul_vec(M, lm::vec4{ p[i][0], p[i][1], p[i][2], 1.f });
+                REQUIRE(near3(lm::dualquat_transform_point(D, p[i]), lm::vec3{ h[0], h[1], h[2] }, 1e-5f));
+                REQUIRE(near3(lm::dualquat_transform_dir(D, p[i]), lm::quat_mul_vec3(rot[i], p[i]), 0.f));
+
+                // mat4 -> dualquat -> mat4; the quat may come back negated
+                const lm::dualquat E = lm::dualquat_from_mat4(M);
+                REQUIRE(near_m(lm::mat4_from_dualquat(E), M, 1e-5f));
+                const lm::quat q = lm::quat_from_mat4(lm::mat4_from_quat(rot[i]));
+                REQUIRE(std::fabs(std::fabs(lm::quat_dot(q, rot[i])) - 1.f) <= 1e-5f);
+            }
+            const lm::dualquat I = lm::dualquat_from_mat4(lm::mat4_identity());
+            REQUIRE(near_m(lm::mat4_from_dualquat(I), lm::mat4_identity(), 1e-5f));
+        }
+
+        SECTION("compose, inverse, normalize, blend") {
+            for (std::size_t i = 1; i < n; ++i) {
+                const lm::dualquat& A = da[i];
+                const lm::dualquat& B = db[i];
+                const lm::vec3 ab = lm::dualquat_transform_point(A * B, p[i]);
+                REQUIRE(near3(ab, lm::dualquat_transform_point(A, lm::dualquat_transform_point(B, p[i])), 1e-4f));
+
+                const lm::vec3 back = lm::dualquat_transform_point(lm::dualquat_conj(A),
+                                                                   lm::dualquat_transform_point(A, p[i]));
+                REQUIRE(near3(back, p[i], 1e-4f));
+
+                // scaled and skewed: norm brings back the same transform
+                lm::dualquat S{ A.real * 3.f, A.dual * 3.f + A.real * 0.5f };
+                S = lm::dualquat_norm(S);
+                REQUIRE(std::fabs(lm::quat_dot(S.real, S.real) - 1.f) <= 1e-5f);
+                REQUIRE(std::fabs(lm::quat_dot(S.real, S.dual)) <= 1e-4f);
+                REQUIRE(near3(lm::dualquat_transform_point(S, p[i]), lm::dualquat_transform_point(A, p[i]), 1e-4f));
+
+                // blending a transform with itself (either sign) is that transform
+                const lm::dualquat pair[2] = { A, { A.real * -1.f, A.dual * -1.f } };
+                const float w[2] = { 0.3f, 0.7f };
+                const lm::dualquat C = lm::dualquat_blend(pair, w, 2);
+                REQUIRE(near3(lm::dualquat_translation(C), tr[i], 1e-4f));
+                REQUIRE(std::fabs(lm::quat_dot(C.real, A.real) - 1.f) <= 1e-5f);
+            }
+            // half-way between two translations, no rotation
+            const lm::dualquat T2[2] = { lm::dualquat_from_rt(lm::quat_identity(), lm::vec3{ 2.f, 0.f, 0.f }),
+                                         lm::dualquat_from_rt(lm::quat_identity(), lm::vec3{ 0.f, 4.f, 0.f }) };
+            const float half[2] = { 0.5f, 0.5f };
+            REQUIRE(near3(lm::dualquat_translation(lm::dualquat_blend(T2, half, 2)), lm::vec3{ 1.f, 2.f, 0.f }, 1e-5f));
+        }
+
+        SECTION("SIMD and batches equal the scalar templates") {
+            std::vector<lm::dualquat> ref(n), out(n);
+            std::vector<lm::vec3> pref(n), pout(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                ref[i] = lm::dualquat_mul_scalar(da[i], db[i]);
+                // the _scalar versions are built from the scalar quat templates
+                const lm::dualquat s{ lm::quat_mul(da[i].real, db[i].real),
+                                      lm::quat_mul(da[i].real, db[i].dual) +
+                                      lm::quat_mul(da[i].dual, db[i].real) };
+                REQUIRE(std::memcmp(&s, &ref[i], sizeof(lm::dualquat)) == 0);
+                const lm::dualquat r = lm::dualquat_mul(da[i], db[i]);
+                REQUIRE(std::memcmp(&r, &ref[i], sizeof(lm::dualquat)) == 0);
+
+                pref[i] = lm::dualquat_transform_point_scalar(da[i], p[i]);
+                const lm::vec3 sp = lm::quat_mul_vec3(da[i].real, p[i]) + lm::dualquat_translation(da[i]);
+                REQUIRE(std::memcmp(&sp, &pref[i], sizeof(lm::vec3)) == 0);
+                const lm::vec3 q = lm::dualquat_transform_point(da[i], p[i]);
+                REQUIRE(std::memcmp(&q, &pref[i], sizeof(lm::vec3)) == 0);
+            }
+
+            for (std::size_t m : { std::size_t(0), std::size_t(1), std::size_t(7), std::size_t(8), n }) {
+                std::fill(out.begin(), out.end(), lm::dualquat{});
+                std::fill(pout.begin(), pout.end(), lm::vec3{});
+                lm::dualquat_mul_batch(da.data(), db.data(), out.data(), m);
+                lm::dualquat_transform_point_batch(da.data(), p.data(), pout.data(), m);
+                REQUIRE(std::memcmp(out.data(), ref.data(), m * sizeof(lm::dualquat)) == 0);
+                REQUIRE(std::memcmp(pout.data(), pref.data(), m * sizeof(lm::vec3)) == 0);
+                if (m < n) {
+                    REQUIRE(out[m] == lm::dualquat{});
+                    REQUIRE(pout[m] == lm::vec3{});
+                }
+            }
+
+            // in place
+            out = db;
+            lm::dualquat_mul_batch(da.data(), out.data(), out.data(), n);
+            REQUIRE(std::memcmp(out.data(), ref.data(), n * sizeof(lm::dualquat)) == 0);
+            pout = p;
+            lm::dualquat_transform_point_batch(da.data(), pout.data(), pout.data(), n);
+            REQUIRE(std::memcmp(pout.data(), pref.data(), n * sizeof(lm::vec3)) == 0);
+
+#if !defined(LMATH_FREESTANDING)
+            lm::thread_pool threads(4);
+            std::fill(out.begin(), out.end(), lm::dualquat{});
+            std::fill(pout.begin(), pout.end(), lm::vec3{});
+            lm::dualquat_mul_batch(da.data(), db.data(), out.data(), n, threads.pool());
+            lm::dualquat_transform_point_batch(da.data(), p.data(), pout.data(), n, threads.pool());
+            REQUIRE(std::memcmp(out.data(), ref.data(), n * sizeof(lm::dualquat)) == 0);
+            REQUIRE(std::memcmp(pout.data(), pref.data(), n * sizeof(lm::vec3)) == 0);
+#endif
+        }
+    }
+
+    TEST_CASE("skin_lbs: SIMD equals scalar, scalar matches a mat4_mul_vec blend", "[skinning][batch][simd]") {
+        std::uint32_t seed = 31u;
+        auto rnd = [&seed](float lo, float hi) {
+            seed = seed * 1664525u + 1013904223u;
+            return lo + (hi - lo) * float(seed >> 8) * (1.f / 16777216.f);
+        };
+        constexpr std::size_t joint_count = 40;
+        constexpr std::size_t n = 1003;
+        std::vector<lm::mat4> palette(joint_count);
+        for (lm::mat4& M : palette) {
+            for (std::size_t c = 0; c < 4; ++c)
+                for (std::size_t r = 0; r < 4; ++r)
+                    M[c][r] = rnd(-2.f, 2.f);
+            M[0][3] = M[1][3] = M[2][3] = 0.f;
+            M[3][3] = 1.f;
+        }
+        std::vector<lm::vec3> pos(n), nrm(n);
+        std::vector<std::uint8_t> j8(4 * n);
+        std::vector<std::uint16_t> j16(4 * n);
+        std::vector<float> w(4 * n);
+        for (std::size_t i = 0; i < n; ++i) {
+            pos[i] = { rnd(-10.f, 10.f), rnd(-10.f, 10.f), rnd(-10.f, 10.f) };
+            nrm[i] = { rnd(-1.f, 1.f), rnd(-1.f, 1.f), rnd(-1.f, 1.f) };
+            for (std::size_t k = 0; k < 4; ++k) {
+                j16[4 * i + k] = std::uint16_t(std::size_t(rnd(0.f, float(joint_count))) % joint_count);
+                j8[4 * i + k] = std::uint8_t(j16[4 * i + k]);
+                w[4 * i + k] = k == 3 && i % 3 == 0 ? 0.f : rnd(0.f, 1.f); // some unused slots
+            }
+        }
+
+        std::vector<lm::vec3> ref_p(n), ref_n(n), out_p(n), out_n(n);
+        lm::skin_lbs_scalar(palette.data(), pos.data(), nrm.data(), j16.data(), w.data(),
+                            ref_p.data(), ref_n.data(), n);
+
+        // blend of the four transformed vertices, through mat4_mul_vec
+        for (std::size_t i = 0; i < n; ++i) {
+            lm::vec4 sp{}, sn{};
+            for (std::size_t k = 0; k < 4; ++k) {
+                const lm::mat4& M = palette[j16[4 * i + k]];
+                sp = sp + lm::mat4_mul_vec(M, lm::vec4{ pos[i][0], pos[i][1], pos[i][2], 1.f }) * w[4 * i + k];
+                sn = sn + lm::mat4_mul_vec(M, lm::vec4{ nrm[i][0], nrm[i][1], nrm[i][2], 0.f }) * w[4 * i + k];
+            }
+            for (std::size_t k = 0; k < 3; ++k) {
+                REQUIRE(std::fabs(ref_p[i][k] - sp[k]) <= 1e-4f * (1.f + std::fabs(sp[k])));
+                REQUIRE(std::fabs(ref_n[i][k] - sn[k]) <= 1e-4f * (1.f + std::fabs(sn[k])));
+            }
+        }
+
+        for (std::size_t m : { std::size_t(0), std::size_t(1), std::size_t(7), std::size_t(8), n }) {
+            std::fill(out_p.begin(), out_p.end(), lm::vec3{});
+            std::fill(out_n.begin(), out_n.end(), lm::vec3{});
+            lm::skin_lbs(palette.data(), pos.data(), nrm.data(), j16.data(), w.data(), out_p.data(), out_n.data(), m);
+            REQUIRE(std::memcmp(out_p.data(), ref_p.data(), m * sizeof(lm::vec3)) == 0);
+            REQUIRE(std::memcmp(out_n.data(), ref_n.data(), m * sizeof(lm::vec3)) == 0);
+            if (m < n) {
+                REQUIRE(out_p[m] == lm::vec3{});
+                REQUIRE(out_n[m] == lm::vec3{});
+            }
+
+            // u8 indices, positions only
+            std::fill(out_p.begin(), out_p.end(), lm::vec3{});
+            std::fill(out_n.begin(), out_n.end(), lm::vec3{});
+            lm::skin_lbs(palette.data(), pos.data(), nullptr, j8.data(), w.data(), out_p.data(), nullptr, m);
+            REQUIRE(std::memcmp(out_p.data(), ref_p.data(), m * sizeof(lm::vec3)) == 0);
+            REQUIRE(out_n[0] == lm::vec3{});
+        }
+
+        // in place
+        out_p = pos;
+        out_n = nrm;
+        lm::skin_lbs(palette.data(), out_p.data(), out_n.data(), j8.data(), w.data(), out_p.data(), out_n.data(), n);
+        REQUIRE(std::memcmp(out_p.data(), ref_p.data(), n * sizeof(lm::vec3)) == 0);
+        REQUIRE(std::memcmp(out_n.data(), ref_n.data(), n * sizeof(lm::vec3)) == 0);
+
+#if !defined(LMATH_FREESTANDING)
+        lm::thread_pool threads(4);
+        std::fill(out_p.begin(), out_p.end(), lm::vec3{});
+        std::fill(out_n.begin(), out_n.end(), lm::vec3{});
+        lm::skin_lbs(palette.data(), pos.data(), nrm.data(), j16.data(), w.data(), out_p.data(), out_n.data(), n,
+                     threads.pool());
+        REQUIRE(std::memcmp(out_p.data(), ref_p.data(), n * sizeof(lm::vec3)) == 0);
+        REQUIRE(std::memcmp(out_n.data(), ref_n.data(), n * sizeof(lm::vec3)) == 0);
+        std::fill(out_p.begin(), out_p.end(), lm::vec3{});
+        lm::skin_lbs(palette.data(), pos.data(), nullptr, j8.data(), w.data(), out_p.data(), nullptr, n,
+                     threads.pool());
+        REQUIRE(std::memcmp(out_p.data(), ref_p.data(), n * sizeof(lm::vec3)) == 0);
+#endif
+    }
+
+    TEST_CASE("trs to mat4 / mat4_decompose round trip, SIMD batches equal single calls", "[trs][mat4][batch][simd]") {
+        std::uint32_t seed = 41u;
+        auto rnd = [&seed](float lo, float hi) {
+            seed = seed * 1664525u + 1013904223u;
+            return lo + (hi - lo) * float(seed >> 8) * (1.f / 16777216.f);
+        };
+        auto unit_quat = [&] {
+            const float x = rnd(-1.f, 1.f), y = rnd(-1.f, 1.f), z = rnd(-1.f, 1.f), w = rnd(-1.f, 1.f);
+            const float l = std::sqrt(((x * x + y * y) + z * z) + w * w);
+            return lm::quat{ { x / l, y / l, z / l }, w / l };
+        };
+
+        constexpr std::size_t n = 203;
+        std::vector<lm::trs> X(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            X[i].t = { rnd(-50.f, 50.f), rnd(-50.f, 50.f), rnd(-50.f, 50.f) };
+            X[i].r = unit_quat();
+            X[i].s = { rnd(0.1f, 4.f), rnd(0.1f, 4.f), rnd(0.1f, 4.f) };
+            if (i % 5 == 0) X[i].s[0] = -X[i].s[0]; // mirrored
+        }
+
+        SECTION("identity and mat4_from_trs") {
+            REQUIRE(lm::mat4_from_trs(lm::trs_identity()) == lm::mat4_identity());
+            for (std::size_t i = 0; i < n; ++i) {
+                const lm::mat4 M = lm::mat4_from_trs(X[i]);
+                const lm::mat4 ref = lm::mat4_mul(lm::mat4_mul(lm::mat4_translate(X[i].t[0], X[i].t[1], X[i].t[2]),
+                                                               lm::mat4_from_quat(X[i].r)),
+                                                  lm::mat4_scale(X[i].s[0], X[i].s[1], X[i].s[2]));
+                for (std::size_t c = 0; c < 4; ++c)
+                    for (std::size_t k = 0; k < 4; ++k)
+                        REQUIRE(std::fabs(M[c][k] - ref[c][k]) <= 1e-5f * (1.f + std::fabs(ref[c][k])));
+            }
+        }
+
+        SECTION("mat4_decompose recovers t, s and +/-r") {
+            for (std::size_t i = 0; i < n; ++i) {
+                const lm::trs D = lm::mat4_decompose(lm::mat4_from_trs(X[i]));
+                for (std::size_t k = 0; k < 3; ++k) {
+                    REQUIRE(D.t[k] == X[i].t[k]);
+                    REQUIRE(std::fabs(D.s[k] - X[i].s[k]) <= 2e-5f * std::fabs(X[i].s[k]));
+                }
+                float d = 0.f, l = 0.f;
+                for (std::size_t k = 0; k < 4; ++k) {
+                    d += D.r[k] * X[i].r[k];
+                    l += D.r[k] * D.r[k];
+                }
+                REQUIRE(std::fabs(l - 1.f) <= 1e-5f);
+                REQUIRE(std::fabs(d) >= 1.f - 1e-5f); // q and -q are the same rotation
+            }
+
+            // a little shear: still a unit rotation, close to the sheared-away one
+            lm::mat4 M = lm::mat4_from_trs(X[1]);
+            for (std::size_t k = 0; k < 3; ++k) M[1][k] = M[1][k] + M[0][k] * 0.05f;
+            const lm::trs D = lm::mat4_decompose(M);
+            float d = 0.f, l = 0.f;
+            for (std::size_t k = 0; k < 4; ++k) {
+                d += D.r[k] * X[1].r[k];
+                l += D.r[k] * D.r[k];
+            }
+            REQUIRE(std::fabs(l - 1.f) <= 1e-5f);
+            REQUIRE(std::fabs(d) >= 0.99f);
+        }
+
+        SECTION("trs_lerp endpoints") {
+            const lm::trs A = lm::trs_lerp(X[3], X[4], 0.f);
+            const lm::trs B = lm::trs_lerp(X[3], X[4], 1.f);
+            for (std::size_t k = 0; k < 3; ++k) {
+                REQUIRE(A.t[k] == X[3].t[k]);
+                REQUIRE(A.s[k] == X[3].s[k]);
+                REQUIRE(std::fabs(B.t[k] - X[4].t[k]) <= 1e-5f * (1.f + std::fabs(X[4].t[k])));
+                REQUIRE(std::fabs(B.s[k] - X[4].s[k]) <= 1e-5f * (1.f + std::fabs(X[4].s[k])));
+            }
+            float da = 0.f, db = 0.f;
+            for (std::size_t k = 0; k < 4; ++k) {
+                da += A.r[k] * X[3].r[k];
+                db += B.r[k] * X[4].r[k];
+            }
+            REQUIRE(std::fabs(da) >= 1.f - 1e-5f);
+            REQUIRE(std::fabs(db) >= 1.f - 1e-5f);
+        }
+
+        SECTION("batches equal single calls") {
+            std::vector<lm::mat4> ref_m(n), out_m(n);
+            std::vector<lm::trs> ref_x(n), out_x(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                ref_m[i] = lm::mat4_from_trs(X[i]);
+                ref_x[i] = lm::mat4_decompose(ref_m[i]);
+            }
+            const lm::mat4 zero_m{};
+            for (std::size_t m : { std::size_t(0), std::size_t(1), std::size_t(7), std::size_t(8), n }) {
+                std::fill(out_m.begin(), out_m.end(), zero_m);
+                lm::trs_to_mat4_batch(X.data(), out_m.data(), m);
+                REQUIRE(std::memcmp(out_m.data(), ref_m.data(), m * sizeof(lm::mat4)) == 0);
+                if (m < n) REQUIRE(out_m[m] == zero_m);
+
+                std::fill(out_x.begin(), out_x.end(), lm::trs{});
+                lm::mat4_decompose_batch(ref_m.data(), out_x.data(), m);
+                REQUIRE(std::memcmp(out_x.data(), ref_x.data(), m * sizeof(lm::trs)) == 0);
+                if (m < n) REQUIRE(std::memcmp(&out_x[m], &out_x[n - 1], sizeof(lm::trs)) == 0);
+            }
+
+#if !defined(LMATH_FREESTANDING)
+            lm::thread_pool threads(4);
+            std::fill(out_m.begin(), out_m.end(), zero_m);
+            std::fill(out_x.begin(), out_x.end(), lm::trs{});
+            lm::trs_to_mat4_batch(X.data(), out_m.data(), n, threads.pool());
+            lm::mat4_decompose_batch(ref_m.data(), out_x.data(), n, threads.pool());
+            REQUIRE(std::memcmp(out_m.data(), ref_m.data(), n * sizeof(lm::mat4)) == 0);
+            REQUIRE(std::memcmp(out_x.data(), ref_x.data(), n * sizeof(lm::trs)) == 0);
+#endif
+        }
+    }
+
     TEST_CASE("mat4 look_at matches glm & linmath.h", "[mat4][look_at][glm]") {
         // test data
         lm::vec3 eye{ 1.5f, -2.0f,  4.0f };